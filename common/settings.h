@@ -17,6 +17,7 @@
 #include "flutter/fml/build_config.h"
 #include "flutter/fml/closure.h"
 #include "flutter/fml/mapping.h"
+#include "flutter/fml/time/time_delta.h"
 #include "flutter/fml/time/time_point.h"
 #include "flutter/fml/unique_fd.h"
 
@@ -369,6 +370,38 @@ struct Settings {
   ///
   /// This is currently only used by iOS.
   bool enable_embedder_api = false;
+
+  // Dispatch the pointer events received within a frame as a single packet,
+  // with coalesced and resampled move events. See
+  // `BatchingPointerDataDispatcher`.
+  bool enable_pointer_batching = false;
+
+  // The maximum number of rectangles in the damage region of a partially
+  // repainted frame. Changes that are far apart are repainted separately
+  // instead of repainting their bounds. A value of 1 repaints the bounds.
+  size_t max_damage_rects = 1;
+
+  // The maximum size of the images in the raster cache, or 0 for no limit.
+  // With a limit, entries that go offscreen are kept for a few frames and the
+  // entries that save the least rasterization per byte are evicted first.
+  // See `RasterCache::SetMaxBytes`.
+  size_t raster_cache_max_bytes = 0;
+
+  // Rasterize new raster cache entries after the frame that decides to cache
+  // them is submitted, in the remaining frame budget, instead of within the
+  // frame. See `RasterCache::SetDeferEntryRasterization`.
+  bool defer_raster_cache_fills = false;
+
+  // Pack small raster cache entries into shared atlas pages, so that they
+  // don't each need a texture and can be drawn in batches. See
+  // `RasterCache::SetUseAtlas`.
+  bool enable_raster_cache_atlas = false;
+
+  // How much later than requested the message loops of the process may wake
+  // up to run a delayed task, so that nearby wakeups are served by one timer
+  // fire. Zero wakes up at the exact time of each task. See
+  // `fml::TimerCoalescer::SetSlack`.
+  fml::TimeDelta timer_slack = fml::TimeDelta::Zero();
 };
 
 }  // namespace flutter
@@ -33,8 +33,9 @@ static void InvokeAllRenderingOps(DisplayListBuilder& builder) {
   }
 }
 
-static void Complete(DisplayListBuilder& builder,
-                     DisplayListBuilderBenchmarkType type) {
+// Builds the list and returns its size.
+static size_t Complete(DisplayListBuilder& builder,
+                       DisplayListBuilderBenchmarkType type) {
   auto display_list = builder.Build();
   switch (type) {
     case DisplayListBuilderBenchmarkType::kBounds:
@@ -50,6 +51,7 @@ static void Complete(DisplayListBuilder& builder,
     case DisplayListBuilderBenchmarkType::kDefault:
       break;
   }
+  return display_list->bytes(false);
 }
 
 bool NeedPrepareRTree(DisplayListBuilderBenchmarkType type) {
@@ -69,6 +71,38 @@ static void BM_DisplayListBuilderDefault(benchmark::State& state,
   }
 }
 
+// Records a new list every iteration like a frame does, with storage
+// reserved for the size of the list of the previous iteration.
+static void BM_DisplayListBuilderWithSizeHint(
+    benchmark::State& state,
+    DisplayListBuilderBenchmarkType type) {
+  bool prepare_rtree = NeedPrepareRTree(type);
+  size_t previous_bytes = 0;
+  while (state.KeepRunning()) {
+    DisplayListBuilder builder(prepare_rtree);
+    builder.SetStorageSizeHint(previous_bytes);
+    InvokeAllRenderingOps(builder);
+    previous_bytes = Complete(builder, type);
+  }
+}
+
+// Same as |BM_DisplayListBuilderWithSizeHint|, with the storage of the list
+// of the previous iteration reused through a pool.
+static void BM_DisplayListBuilderWithStoragePool(
+    benchmark::State& state,
+    DisplayListBuilderBenchmarkType type) {
+  bool prepare_rtree = NeedPrepareRTree(type);
+  auto pool = std::make_shared<DisplayListStoragePool>();
+  size_t previous_bytes = 0;
+  while (state.KeepRunning()) {
+    DisplayListBuilder builder(prepare_rtree);
+    builder.SetStoragePool(pool);
+    builder.SetStorageSizeHint(previous_bytes);
+    InvokeAllRenderingOps(builder);
+    previous_bytes = Complete(builder, type);
+  }
+}
+
 static void BM_DisplayListBuilderWithScaleAndTranslate(
     benchmark::State& state,
     DisplayListBuilderBenchmarkType type) {
@@ -188,6 +222,40 @@ BENCHMARK_CAPTURE(BM_DisplayListBuilderDefault,
                   DisplayListBuilderBenchmarkType::kBoundsAndRtree)
     ->Unit(benchmark::kMicrosecond);
 
+BENCHMARK_CAPTURE(BM_DisplayListBuilderWithSizeHint,
+                  kDefault,
+                  DisplayListBuilderBenchmarkType::kDefault)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_DisplayListBuilderWithSizeHint,
+                  kBounds,
+                  DisplayListBuilderBenchmarkType::kBounds)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_DisplayListBuilderWithSizeHint,
+                  kRtree,
+                  DisplayListBuilderBenchmarkType::kRtree)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_DisplayListBuilderWithSizeHint,
+                  kBoundsAndRtree,
+                  DisplayListBuilderBenchmarkType::kBoundsAndRtree)
+    ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_CAPTURE(BM_DisplayListBuilderWithStoragePool,
+                  kDefault,
+                  DisplayListBuilderBenchmarkType::kDefault)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_DisplayListBuilderWithStoragePool,
+                  kBounds,
+                  DisplayListBuilderBenchmarkType::kBounds)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_DisplayListBuilderWithStoragePool,
+                  kRtree,
+                  DisplayListBuilderBenchmarkType::kRtree)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_DisplayListBuilderWithStoragePool,
+                  kBoundsAndRtree,
+                  DisplayListBuilderBenchmarkType::kBoundsAndRtree)
+    ->Unit(benchmark::kMicrosecond);
+
 BENCHMARK_CAPTURE(BM_DisplayListBuilderWithScaleAndTranslate,
                   kDefault,
                   DisplayListBuilderBenchmarkType::kDefault)
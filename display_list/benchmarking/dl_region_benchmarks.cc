@@ -8,6 +8,7 @@
 #include "flutter/fml/logging.h"
 #include "third_party/skia/include/core/SkRegion.h"
 
+#include <cmath>
 #include <random>
 
 namespace {
@@ -202,6 +203,75 @@ void RunRegionOpBenchmark(benchmark::State& state,
   }
 }
 
+// Returns |count| rectangles over an area that grows with the count, so that
+// the regions made of them have about the same density and lines with more
+// spans as the count grows.
+template <typename RNG>
+std::vector<SkIRect> GenerateRectsWithDensity(RNG& rng, int count) {
+  int32_t size = 100 + 20 * std::sqrt(count);
+  return GenerateRects(rng, SkIRect::MakeWH(size, size), count, 40);
+}
+
+// Measures the rectangles per second of unions or intersections of two
+// regions made of state.range(0) rectangles each.
+template <typename Region>
+void RunRegionOpThroughputBenchmark(benchmark::State& state, RegionOp op) {
+  std::seed_seq seed{2, 1, 3};
+  std::mt19937 rng(seed);
+
+  int count = state.range(0);
+  Region region1(GenerateRectsWithDensity(rng, count));
+  Region region2(GenerateRectsWithDensity(rng, count));
+
+  switch (op) {
+    case kUnion:
+      while (state.KeepRunning()) {
+        Region::unionRegions(region1, region2);
+      }
+      break;
+    case kIntersection:
+      while (state.KeepRunning()) {
+        Region::intersectRegions(region1, region2);
+      }
+      break;
+  }
+  state.SetItemsProcessed(state.iterations() * 2 * count);
+}
+
+// Measures the rectangles per second of accumulating the union of 10
+// regions made of state.range(0) / 10 rectangles each, as the embedder
+// does for the contents of a layer.
+void RunAccumulateBenchmark(benchmark::State& state, bool use_accumulator) {
+  std::seed_seq seed{2, 1, 3};
+  std::mt19937 rng(seed);
+
+  int count = state.range(0);
+  auto rects = GenerateRectsWithDensity(rng, count);
+  std::vector<flutter::DlRegion> regions;
+  for (int i = 0; i < 10; i++) {
+    regions.emplace_back(std::vector<SkIRect>(
+        rects.begin() + count * i / 10, rects.begin() + count * (i + 1) / 10));
+  }
+
+  flutter::DlRegionAccumulator accumulator;
+  while (state.KeepRunning()) {
+    if (use_accumulator) {
+      accumulator.reset();
+      for (const auto& region : regions) {
+        accumulator.addRegion(region);
+      }
+      benchmark::DoNotOptimize(accumulator.region());
+    } else {
+      flutter::DlRegion result;
+      for (const auto& region : regions) {
+        result = flutter::DlRegion::MakeUnion(result, region);
+      }
+      benchmark::DoNotOptimize(result);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * count);
+}
+
 template <typename Region>
 void RunIntersectsRegionBenchmark(benchmark::State& state,
                                   int maxSize,
@@ -291,6 +361,21 @@ static void BM_SkRegion_Operation(benchmark::State& state,
                                         sizeFactor);
 }
 
+static void BM_DlRegion_OperationThroughput(benchmark::State& state,
+                                           RegionOp op) {
+  RunRegionOpThroughputBenchmark<DlRegionAdapter>(state, op);
+}
+
+static void BM_SkRegion_OperationThroughput(benchmark::State& state,
+                                           RegionOp op) {
+  RunRegionOpThroughputBenchmark<SkRegionAdapter>(state, op);
+}
+
+static void BM_DlRegion_Accumulate(benchmark::State& state,
+                                   bool use_accumulator) {
+  RunAccumulateBenchmark(state, use_accumulator);
+}
+
 static void BM_DlRegion_IntersectsRegion(benchmark::State& state,
                                          int maxSize,
                                          double sizeFactor) {
@@ -709,4 +794,40 @@ BENCHMARK_CAPTURE(BM_DlRegion_GetRects, Large, 1500)
 BENCHMARK_CAPTURE(BM_SkRegion_GetRects, Large, 1500)
     ->Unit(benchmark::kMicrosecond);
 
+BENCHMARK_CAPTURE(BM_DlRegion_OperationThroughput, Union, RegionOp::kUnion)
+    ->Arg(10)
+    ->Arg(1000)
+    ->Arg(100000)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_SkRegion_OperationThroughput, Union, RegionOp::kUnion)
+    ->Arg(10)
+    ->Arg(1000)
+    ->Arg(100000)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_DlRegion_OperationThroughput,
+                  Intersection,
+                  RegionOp::kIntersection)
+    ->Arg(10)
+    ->Arg(1000)
+    ->Arg(100000)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_SkRegion_OperationThroughput,
+                  Intersection,
+                  RegionOp::kIntersection)
+    ->Arg(10)
+    ->Arg(1000)
+    ->Arg(100000)
+    ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_CAPTURE(BM_DlRegion_Accumulate, MakeUnion, false)
+    ->Arg(10)
+    ->Arg(1000)
+    ->Arg(100000)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_DlRegion_Accumulate, Accumulator, true)
+    ->Arg(10)
+    ->Arg(1000)
+    ->Arg(100000)
+    ->Unit(benchmark::kMicrosecond);
+
 }  // namespace flutter
\ No newline at end of file
@@ -0,0 +1,338 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+// Replays captured DisplayLists through the rendering backends to measure
+// the cost of real application content.
+//
+// Frames are files in the directory passed as --frames-dir, each holding a
+// DisplayList written by |DlSerialization::Serialize|. Each frame is
+// registered as a benchmark per backend, which reports the time to dispatch
+// the frame, the number of heap allocations made while doing so and the
+// number of operations of each type in the frame.
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <map>
+#include <new>
+#include <string>
+
+#include "benchmark/benchmark.h"
+#include "flutter/display_list/skia/dl_sk_dispatcher.h"
+#include "flutter/display_list/utils/dl_serialization.h"
+#include "flutter/fml/command_line.h"
+#include "flutter/fml/file.h"
+#include "flutter/fml/logging.h"
+#include "flutter/fml/mapping.h"
+#include "third_party/skia/include/core/SkSurface.h"
+
+#if IMPELLER_SUPPORTS_RENDERING
+#include "flutter/impeller/display_list/dl_dispatcher.h"  // nogncheck
+#endif  // IMPELLER_SUPPORTS_RENDERING
+
+namespace {
+
+std::atomic<int64_t> allocation_count = 0;
+
+}  // namespace
+
+// Counts the allocations made through operator new. Skia and the
+// DisplayList storage also allocate with malloc, which isn't counted.
+void* operator new(size_t size) {
+  allocation_count.fetch_add(1, std::memory_order_relaxed);
+  void* pointer = std::malloc(size == 0 ? 1 : size);
+  if (!pointer) {
+    std::abort();
+  }
+  return pointer;
+}
+
+void* operator new[](size_t size) {
+  return operator new(size);
+}
+
+void operator delete(void* pointer) noexcept {
+  std::free(pointer);
+}
+
+void operator delete[](void* pointer) noexcept {
+  std::free(pointer);
+}
+
+void operator delete(void* pointer, size_t size) noexcept {
+  std::free(pointer);
+}
+
+void operator delete[](void* pointer, size_t size) noexcept {
+  std::free(pointer);
+}
+
+namespace flutter {
+namespace {
+
+// Counts the operations of a DisplayList by type, including those of the
+// DisplayLists it draws.
+class DlOpCounter final : public DlOpReceiver {
+ public:
+  const std::map<std::string, int>& counts() const { return counts_; }
+
+  void setAntiAlias(bool aa) override { Count("SetAntiAlias"); }
+  void setDrawStyle(DlDrawStyle style) override { Count("SetStyle"); }
+  void setColor(DlColor color) override { Count("SetColor"); }
+  void setStrokeWidth(float width) override { Count("SetStrokeWidth"); }
+  void setStrokeMiter(float limit) override { Count("SetStrokeMiter"); }
+  void setStrokeCap(DlStrokeCap cap) override { Count("SetStrokeCap"); }
+  void setStrokeJoin(DlStrokeJoin join) override { Count("SetStrokeJoin"); }
+  void setColorSource(const DlColorSource* source) override {
+    Count("SetColorSource");
+  }
+  void setColorFilter(const DlColorFilter* filter) override {
+    Count("SetColorFilter");
+  }
+  void setInvertColors(bool invert) override { Count("SetInvertColors"); }
+  void setBlendMode(DlBlendMode mode) override { Count("SetBlendMode"); }
+  void setPathEffect(const DlPathEffect* effect) override {
+    Count("SetPathEffect");
+  }
+  void setMaskFilter(const DlMaskFilter* filter) override {
+    Count("SetMaskFilter");
+  }
+  void setImageFilter(const DlImageFilter* filter) override {
+    Count("SetImageFilter");
+  }
+  void save() override { Count("Save"); }
+  void saveLayer(const SkRect& bounds,
+                 const SaveLayerOptions options,
+                 const DlImageFilter* backdrop) override {
+    Count(backdrop ? "SaveLayerBackdrop" : "SaveLayer");
+  }
+  void restore() override { Count("Restore"); }
+  void translate(SkScalar tx, SkScalar ty) override { Count("Translate"); }
+  void scale(SkScalar sx, SkScalar sy) override { Count("Scale"); }
+  void rotate(SkScalar degrees) override { Count("Rotate"); }
+  void skew(SkScalar sx, SkScalar sy) override { Count("Skew"); }
+  // clang-format off
+  void transform2DAffine(SkScalar mxx, SkScalar mxy, SkScalar mxt,
+                         SkScalar myx, SkScalar myy, SkScalar myt) override {
+    Count("Transform2DAffine");
+  }
+  void transformFullPerspective(
+      SkScalar mxx, SkScalar mxy, SkScalar mxz, SkScalar mxt,
+      SkScalar myx, SkScalar myy, SkScalar myz, SkScalar myt,
+      SkScalar mzx, SkScalar mzy, SkScalar mzz, SkScalar mzt,
+      SkScalar mwx, SkScalar mwy, SkScalar mwz, SkScalar mwt) override {
+    Count("TransformFullPerspective");
+  }
+  // clang-format on
+  void transformReset() override { Count("TransformReset"); }
+  void clipRect(const SkRect& rect, ClipOp clip_op, bool is_aa) override {
+    Count("ClipRect");
+  }
+  void clipRRect(const SkRRect& rrect, ClipOp clip_op, bool is_aa) override {
+    Count("ClipRRect");
+  }
+  void clipPath(const SkPath& path, ClipOp clip_op, bool is_aa) override {
+    Count("ClipPath");
+  }
+  void drawColor(DlColor color, DlBlendMode mode) override {
+    Count("DrawColor");
+  }
+  void drawPaint() override { Count("DrawPaint"); }
+  void drawLine(const SkPoint& p0, const SkPoint& p1) override {
+    Count("DrawLine");
+  }
+  void drawRect(const SkRect& rect) override { Count("DrawRect"); }
+  void drawOval(const SkRect& bounds) override { Count("DrawOval"); }
+  void drawCircle(const SkPoint& center, SkScalar radius) override {
+    Count("DrawCircle");
+  }
+  void drawRRect(const SkRRect& rrect) override { Count("DrawRRect"); }
+  void drawDRRect(const SkRRect& outer, const SkRRect& inner) override {
+    Count("DrawDRRect");
+  }
+  void drawPath(const SkPath& path) override { Count("DrawPath"); }
+  void drawArc(const SkRect& oval_bounds,
+               SkScalar start_degrees,
+               SkScalar sweep_degrees,
+               bool use_center) override {
+    Count("DrawArc");
+  }
+  void drawPoints(PointMode mode,
+                  uint32_t count,
+                  const SkPoint points[]) override {
+    Count("DrawPoints");
+  }
+  void drawVertices(const DlVertices* vertices, DlBlendMode mode) override {
+    Count("DrawVertices");
+  }
+  void drawImage(const sk_sp<DlImage> image,
+                 const SkPoint point,
+                 DlImageSampling sampling,
+                 bool render_with_attributes) override {
+    Count("DrawImage");
+  }
+  void drawImageRect(const sk_sp<DlImage> image,
+                     const SkRect& src,
+                     const SkRect& dst,
+                     DlImageSampling sampling,
+                     bool render_with_attributes,
+                     SrcRectConstraint constraint) override {
+    Count("DrawImageRect");
+  }
+  void drawImageNine(const sk_sp<DlImage> image,
+                     const SkIRect& center,
+                     const SkRect& dst,
+                     DlFilterMode filter,
+                     bool render_with_attributes) override {
+    Count("DrawImageNine");
+  }
+  void drawAtlas(const sk_sp<DlImage> atlas,
+                 const SkRSXform xform[],
+                 const SkRect tex[],
+                 const DlColor colors[],
+                 int count,
+                 DlBlendMode mode,
+                 DlImageSampling sampling,
+                 const SkRect* cull_rect,
+                 bool render_with_attributes) override {
+    Count("DrawAtlas");
+  }
+  void drawDisplayList(const sk_sp<DisplayList> display_list,
+                       SkScalar opacity) override {
+    Count("DrawDisplayList");
+    display_list->Dispatch(*this);
+  }
+  void drawTextBlob(const sk_sp<SkTextBlob> blob,
+                    SkScalar x,
+                    SkScalar y) override {
+    Count("DrawTextBlob");
+  }
+  void drawTextFrame(const std::shared_ptr<impeller::TextFrame>& text_frame,
+                     SkScalar x,
+                     SkScalar y) override {
+    Count("DrawTextFrame");
+  }
+  void drawShadow(const SkPath& path,
+                  const DlColor color,
+                  const SkScalar elevation,
+                  bool transparent_occluder,
+                  SkScalar dpr) override {
+    Count("DrawShadow");
+  }
+
+ private:
+  std::map<std::string, int> counts_;
+
+  void Count(const char* op) { counts_[op]++; }
+};
+
+void ReportFrame(benchmark::State& state,
+                 const DisplayList& display_list,
+                 int64_t allocations) {
+  DlOpCounter counter;
+  display_list.Dispatch(counter);
+  for (const auto& [op, count] : counter.counts()) {
+    state.counters["Ops:" + op] = count;
+  }
+  state.counters["Ops"] = display_list.op_count(true);
+  state.counters["Allocations"] =
+      benchmark::Counter(allocations, benchmark::Counter::kAvgIterations);
+}
+
+void BM_ReplaySoftware(benchmark::State& state,
+                       const sk_sp<DisplayList>& display_list) {
+  const SkIRect bounds = display_list->bounds().roundOut();
+  sk_sp<SkSurface> surface = SkSurfaces::Raster(
+      SkImageInfo::MakeN32Premul(std::max(bounds.width(), 1),
+                                 std::max(bounds.height(), 1)));
+  SkCanvas* canvas = surface->getCanvas();
+  canvas->translate(-bounds.fLeft, -bounds.fTop);
+
+  int64_t allocations = 0;
+  for (auto _ : state) {
+    canvas->clear(SK_ColorTRANSPARENT);
+    const int64_t start = allocation_count.load(std::memory_order_relaxed);
+    DlSkCanvasDispatcher dispatcher(canvas);
+    display_list->Dispatch(dispatcher);
+    allocations += allocation_count.load(std::memory_order_relaxed) - start;
+  }
+  ReportFrame(state, *display_list, allocations);
+}
+
+#if IMPELLER_SUPPORTS_RENDERING
+// Only converts the frame to an Impeller picture, as rendering it needs a
+// GPU.
+void BM_ReplayImpeller(benchmark::State& state,
+                       const sk_sp<DisplayList>& display_list) {
+  int64_t allocations = 0;
+  for (auto _ : state) {
+    const int64_t start = allocation_count.load(std::memory_order_relaxed);
+    impeller::DlDispatcher dispatcher;
+    display_list->Dispatch(dispatcher);
+    impeller::Picture picture = dispatcher.EndRecordingAsPicture();
+    allocations += allocation_count.load(std::memory_order_relaxed) - start;
+    benchmark::DoNotOptimize(picture);
+  }
+  ReportFrame(state, *display_list, allocations);
+}
+#endif  // IMPELLER_SUPPORTS_RENDERING
+
+bool RegisterFrames(const std::string& frames_dir) {
+  fml::UniqueFD directory =
+      fml::OpenDirectory(frames_dir.c_str(), false, fml::FilePermission::kRead);
+  if (!directory.is_valid()) {
+    FML_LOG(ERROR) << "Could not open " << frames_dir;
+    return false;
+  }
+  // Frames are registered in name order so that runs are comparable.
+  std::map<std::string, sk_sp<DisplayList>> frames;
+  fml::VisitFiles(directory, [&frames](const fml::UniqueFD& dir,
+                                       const std::string& filename) {
+    std::shared_ptr<const fml::Mapping> mapping =
+        fml::FileMapping::CreateReadOnly(dir, filename);
+    sk_sp<DisplayList> display_list =
+        mapping ? DlSerialization::Deserialize(mapping) : nullptr;
+    if (display_list) {
+      frames[filename] = std::move(display_list);
+    } else {
+      FML_LOG(WARNING) << "Skipping " << filename
+                       << ", which is not a serialized DisplayList";
+    }
+    return true;
+  });
+  if (frames.empty()) {
+    FML_LOG(ERROR) << "No frames found in " << frames_dir;
+    return false;
+  }
+  for (const auto& [name, display_list] : frames) {
+    benchmark::RegisterBenchmark(("BM_ReplaySoftware/" + name).c_str(),
+                                 BM_ReplaySoftware, display_list)
+        ->Unit(benchmark::kMicrosecond);
+#if IMPELLER_SUPPORTS_RENDERING
+    benchmark::RegisterBenchmark(("BM_ReplayImpeller/" + name).c_str(),
+                                 BM_ReplayImpeller, display_list)
+        ->Unit(benchmark::kMicrosecond);
+#endif  // IMPELLER_SUPPORTS_RENDERING
+  }
+  return true;
+}
+
+}  // namespace
+}  // namespace flutter
+
+int main(int argc, char** argv) {
+  benchmark::Initialize(&argc, argv);
+  fml::CommandLine command_line = fml::CommandLineFromArgcArgv(argc, argv);
+  std::string frames_dir;
+  if (!command_line.GetOptionValue("frames-dir", &frames_dir)) {
+    FML_LOG(ERROR) << "Usage: " << argv[0]
+                   << " --frames-dir=<directory of serialized DisplayLists>";
+    return 1;
+  }
+  if (!flutter::RegisterFrames(frames_dir)) {
+    return 1;
+  }
+  benchmark::RunSpecifiedBenchmarks();
+  return 0;
+}
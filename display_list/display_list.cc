@@ -2,10 +2,13 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <string_view>
 #include <type_traits>
+#include <utility>
 
 #include "flutter/display_list/display_list.h"
 #include "flutter/display_list/dl_op_records.h"
+#include "flutter/fml/hash_combine.h"
 #include "flutter/fml/trace_event.h"
 
 namespace flutter {
@@ -14,6 +17,82 @@ const SaveLayerOptions SaveLayerOptions::kNoAttributes = SaveLayerOptions();
 const SaveLayerOptions SaveLayerOptions::kWithAttributes =
     kNoAttributes.with_renders_with_attributes();
 
+DisplayListStorage::DisplayListStorage(DisplayListStorage&& other)
+    : ptr_(std::move(other.ptr_)),
+      capacity_(std::exchange(other.capacity_, 0)),
+      pool_(std::move(other.pool_)) {}
+
+DisplayListStorage& DisplayListStorage::operator=(DisplayListStorage&& other) {
+  if (this != &other) {
+    Release();
+    ptr_ = std::move(other.ptr_);
+    capacity_ = std::exchange(other.capacity_, 0);
+    pool_ = std::move(other.pool_);
+  }
+  return *this;
+}
+
+DisplayListStorage::~DisplayListStorage() {
+  Release();
+}
+
+void DisplayListStorage::Release() {
+  if (pool_ && ptr_) {
+    pool_->Recycle(std::move(ptr_), capacity_);
+  }
+  ptr_.reset();
+  capacity_ = 0;
+  pool_.reset();
+}
+
+DisplayListStoragePool::DisplayListStoragePool(size_t max_bytes)
+    : max_bytes_(max_bytes) {}
+
+DisplayListStoragePool::~DisplayListStoragePool() = default;
+
+DisplayListStorage DisplayListStoragePool::Take(size_t capacity) {
+  DisplayListStorage storage;
+  {
+    std::scoped_lock lock(mutex_);
+    auto best = buffers_.end();
+    for (auto it = buffers_.begin(); it != buffers_.end(); ++it) {
+      if (it->capacity >= capacity && it->capacity / 2 <= capacity &&
+          (best == buffers_.end() || it->capacity < best->capacity)) {
+        best = it;
+      }
+    }
+    if (best != buffers_.end()) {
+      storage.ptr_ = std::move(best->ptr);
+      storage.capacity_ = best->capacity;
+      pooled_bytes_ -= best->capacity;
+      buffers_.erase(best);
+    }
+  }
+  if (!storage.ptr_) {
+    storage.realloc(capacity);
+  }
+  storage.pool_ = shared_from_this();
+  return storage;
+}
+
+size_t DisplayListStoragePool::pooled_bytes() const {
+  std::scoped_lock lock(mutex_);
+  return pooled_bytes_;
+}
+
+void DisplayListStoragePool::Recycle(
+    std::unique_ptr<uint8_t, DisplayListStorage::FreeDeleter> ptr,
+    size_t capacity) {
+  std::scoped_lock lock(mutex_);
+  if (pooled_bytes_ + capacity > max_bytes_ ||
+      buffers_.size() >= kMaxBuffers) {
+    // |ptr| frees the buffer.
+    return;
+  }
+  pooled_bytes_ += capacity;
+  buffers_.push_back({std::move(ptr), capacity});
+}
+
 DisplayList::DisplayList()
     : byte_count_(0),
       op_count_(0),
@@ -61,6 +140,10 @@ uint32_t DisplayList::next_unique_id() {
   return id;
 }
 
+// The number of R-Tree search results that a culled dispatch keeps on the
+// stack before it falls back to a vector.
+static constexpr int kMaxInlineCullIndices = 128;
+
 class Culler {
  public:
   virtual ~Culler() = default;
@@ -85,12 +168,12 @@ class NopCuller final : public Culler {
   void update(DispatchContext& context) override {}
 };
 NopCuller NopCuller::instance = NopCuller();
-class VectorCuller final : public Culler {
+class IndexCuller final : public Culler {
  public:
-  VectorCuller(const DlRTree* rtree, const std::vector<int>& rect_indices)
-      : rtree_(rtree), cur_(rect_indices.begin()), end_(rect_indices.end()) {}
+  IndexCuller(const DlRTree* rtree, const int* begin, const int* end)
+      : rtree_(rtree), cur_(begin), end_(end) {}
 
-  ~VectorCuller() = default;
+  ~IndexCuller() = default;
 
   bool init(DispatchContext& context) override {
     if (cur_ < end_) {
@@ -134,8 +217,8 @@ class VectorCuller final : public Culler {
 
  private:
   const DlRTree* rtree_;
-  std::vector<int>::const_iterator cur_;
-  std::vector<int>::const_iterator end_;
+  const int* cur_;
+  const int* end_;
 };
 
 void DisplayList::Dispatch(DlOpReceiver& receiver) const {
@@ -160,9 +243,18 @@ void DisplayList::Dispatch(DlOpReceiver& receiver,
   const DlRTree* rtree = this->rtree().get();
   FML_DCHECK(rtree != nullptr);
   uint8_t* ptr = storage_.get();
-  std::vector<int> rect_indices;
-  rtree->search(cull_rect, &rect_indices);
-  VectorCuller culler(rtree, rect_indices);
+  // Most cull rects hit few enough ops for the indices to fit on the stack,
+  // so culled dispatches usually don't allocate.
+  int inline_indices[kMaxInlineCullIndices];
+  int count = rtree->search(cull_rect, inline_indices, kMaxInlineCullIndices);
+  if (count <= kMaxInlineCullIndices) {
+    IndexCuller culler(rtree, inline_indices, inline_indices + count);
+    Dispatch(receiver, ptr, ptr + byte_count_, culler);
+    return;
+  }
+  std::vector<int> rect_indices(count);
+  rtree->search(cull_rect, rect_indices.data(), count);
+  IndexCuller culler(rtree, rect_indices.data(), rect_indices.data() + count);
   Dispatch(receiver, ptr, ptr + byte_count_, culler);
 }
 
@@ -315,4 +407,20 @@ bool DisplayList::Equals(const DisplayList* other) const {
   return CompareOps(ptr, ptr + byte_count_, o_ptr, o_ptr + other->byte_count_);
 }
 
+size_t DisplayList::content_hash() const {
+  size_t hash = content_hash_.load(std::memory_order_relaxed);
+  if (hash == 0) {
+    // The ops hold their attributes by pointer, so equal bytes also mean
+    // equal attributes.
+    std::string_view ops(reinterpret_cast<const char*>(storage_.get()),
+                         byte_count_);
+    hash = fml::HashCombine(ops, op_count_);
+    if (hash == 0) {
+      hash = 1;
+    }
+    content_hash_.store(hash, std::memory_order_relaxed);
+  }
+  return hash;
+}
+
 }  // namespace flutter
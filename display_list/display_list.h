@@ -5,12 +5,16 @@
 #ifndef FLUTTER_DISPLAY_LIST_DISPLAY_LIST_H_
 #define FLUTTER_DISPLAY_LIST_DISPLAY_LIST_H_
 
+#include <atomic>
 #include <memory>
+#include <mutex>
 #include <optional>
+#include <vector>
 
 #include "flutter/display_list/dl_sampling_options.h"
 #include "flutter/display_list/geometry/dl_rtree.h"
 #include "flutter/fml/logging.h"
+#include "flutter/fml/macros.h"
 
 // The Flutter DisplayList mechanism encapsulates a persistent sequence of
 // rendering operations.
@@ -231,24 +235,88 @@ class SaveLayerOptions {
   };
 };
 
+class DisplayListStoragePool;
+
 // Manages a buffer allocated with malloc.
+//
+// A buffer that was taken from a |DisplayListStoragePool| is given back to
+// that pool instead of being freed.
 class DisplayListStorage {
  public:
   DisplayListStorage() = default;
-  DisplayListStorage(DisplayListStorage&&) = default;
+  DisplayListStorage(DisplayListStorage&& other);
+  DisplayListStorage& operator=(DisplayListStorage&& other);
+
+  ~DisplayListStorage();
 
   uint8_t* get() const { return ptr_.get(); }
 
+  // The number of bytes allocated for the buffer.
+  size_t capacity() const { return capacity_; }
+
   void realloc(size_t count) {
     ptr_.reset(static_cast<uint8_t*>(std::realloc(ptr_.release(), count)));
     FML_CHECK(ptr_);
+    capacity_ = count;
   }
 
  private:
+  friend class DisplayListStoragePool;
+
   struct FreeDeleter {
     void operator()(uint8_t* p) { std::free(p); }
   };
   std::unique_ptr<uint8_t, FreeDeleter> ptr_;
+  size_t capacity_ = 0;
+  std::shared_ptr<DisplayListStoragePool> pool_;
+
+  void Release();
+
+  FML_DISALLOW_COPY_AND_ASSIGN(DisplayListStorage);
+};
+
+// A thread-safe cache of the buffers of DisplayLists that were destroyed,
+// so that a |DisplayListBuilder| that records a list of about the same size
+// every frame can reuse the buffer of an earlier frame instead of growing a
+// new one from scratch.
+//
+// The pool holds at most |max_bytes| and frees any buffer that doesn't fit.
+class DisplayListStoragePool
+    : public std::enable_shared_from_this<DisplayListStoragePool> {
+ public:
+  static constexpr size_t kDefaultMaxBytes = 4 * 1024 * 1024;
+  static constexpr size_t kMaxBuffers = 8;
+
+  explicit DisplayListStoragePool(size_t max_bytes = kDefaultMaxBytes);
+
+  ~DisplayListStoragePool();
+
+  // Returns storage of at least |capacity| bytes that is given back to this
+  // pool when it is destroyed. The smallest pooled buffer that is large
+  // enough, but not more than twice as large, is reused if there is one, and
+  // a new buffer is allocated otherwise. The contents are uninitialized.
+  DisplayListStorage Take(size_t capacity);
+
+  // The number of bytes in the buffers that are waiting to be reused.
+  size_t pooled_bytes() const;
+
+ private:
+  friend class DisplayListStorage;
+
+  struct Buffer {
+    std::unique_ptr<uint8_t, DisplayListStorage::FreeDeleter> ptr;
+    size_t capacity;
+  };
+
+  void Recycle(std::unique_ptr<uint8_t, DisplayListStorage::FreeDeleter> ptr,
+               size_t capacity);
+
+  const size_t max_bytes_;
+  mutable std::mutex mutex_;
+  std::vector<Buffer> buffers_;
+  size_t pooled_bytes_ = 0;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(DisplayListStoragePool);
 };
 
 class Culler;
@@ -291,6 +359,13 @@ class DisplayList : public SkRefCnt {
     return Equals(other.get());
   }
 
+  // A hash of the recorded operations, computed on first use. Lists that
+  // record the same operations on the same objects hash equally, but equal
+  // hashes don't imply |Equals| since hashes can collide, so callers must
+  // confirm a match with |Equals|. Lists that are |Equals| but hold different
+  // instances of their attributes usually hash differently.
+  size_t content_hash() const;
+
   bool can_apply_group_opacity() const { return can_apply_group_opacity_; }
   bool isUIThreadSafe() const { return is_ui_thread_safe_; }
 
@@ -339,6 +414,9 @@ class DisplayList : public SkRefCnt {
 
   const sk_sp<const DlRTree> rtree_;
 
+  // 0 until content_hash() is first called.
+  mutable std::atomic<size_t> content_hash_ = 0;
+
   void Dispatch(DlOpReceiver& ctx,
                 uint8_t* ptr,
                 uint8_t* end,
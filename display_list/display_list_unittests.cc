@@ -251,6 +251,20 @@ TEST_F(DisplayListTest, BuilderCanBeReused) {
   ASSERT_TRUE(dl->Equals(dl2));
 }
 
+TEST_F(DisplayListTest, ContentHashMatchesForSameOps) {
+  DisplayListBuilder builder(kTestBounds);
+  builder.DrawRect(kTestBounds, DlPaint());
+  auto dl = builder.Build();
+  builder.DrawRect(kTestBounds, DlPaint());
+  auto dl2 = builder.Build();
+  builder.DrawRect(kTestBounds, DlPaint(DlColor::kRed()));
+  auto dl3 = builder.Build();
+  EXPECT_EQ(dl->content_hash(), dl2->content_hash());
+  EXPECT_NE(dl->content_hash(), dl3->content_hash());
+  // The hash is cached.
+  EXPECT_EQ(dl3->content_hash(), dl3->content_hash());
+}
+
 TEST_F(DisplayListTest, SaveRestoreRestoresTransform) {
   SkRect cull_rect = SkRect::MakeLTRB(-10.0f, -10.0f, 500.0f, 500.0f);
   DisplayListBuilder builder(cull_rect);
@@ -3016,6 +3030,27 @@ TEST_F(DisplayListTest, RTreeRenderCulling) {
   }
 }
 
+TEST_F(DisplayListTest, RTreeRenderCullingWithManyHits) {
+  // More hits than the culler keeps on the stack.
+  DisplayListBuilder main_builder(true);
+  DlOpReceiver& main_receiver = ToReceiver(main_builder);
+  DisplayListBuilder expected_builder;
+  DlOpReceiver& expected_receiver = ToReceiver(expected_builder);
+  for (int i = 0; i < 300; i++) {
+    SkRect rect = SkRect::MakeXYWH((i % 20) * 10, (i / 20) * 10, 5, 5);
+    main_receiver.drawRect(rect);
+    expected_receiver.drawRect(rect);
+  }
+  main_receiver.drawRect({500, 500, 510, 510});
+  auto main = main_builder.Build();
+  auto expected = expected_builder.Build();
+
+  DisplayListBuilder culling_builder;
+  main->Dispatch(ToReceiver(culling_builder), SkRect::MakeLTRB(0, 0, 200, 150));
+
+  EXPECT_TRUE(DisplayListsEQ_Verbose(culling_builder.Build(), expected));
+}
+
 TEST_F(DisplayListTest, DrawSaveDrawCannotInheritOpacity) {
   DisplayListBuilder builder;
   builder.DrawCircle({10, 10}, 5, DlPaint());
@@ -3781,5 +3816,93 @@ TEST_F(DisplayListTest, SaveLayerBoundsClipDetectionSimpleClippedRect) {
   EXPECT_TRUE(expector.all_bounds_checked());
 }
 
+TEST_F(DisplayListTest, StoragePoolReusesStorageOfDestroyedLists) {
+  auto pool = std::make_shared<DisplayListStoragePool>();
+  DisplayListBuilder builder;
+  builder.SetStoragePool(pool);
+
+  // Fill the storage with every kind of op so that a list recorded into it
+  // later would differ from a fresh one if any stale bytes were left.
+  for (auto& group : allGroups) {
+    for (size_t i = 0; i < group.variants.size(); i++) {
+      group.variants[i].Invoke(ToReceiver(builder));
+    }
+  }
+  auto first = builder.Build();
+  EXPECT_EQ(pool->pooled_bytes(), 0u);
+  first.reset();
+  size_t pooled_bytes = pool->pooled_bytes();
+  EXPECT_GT(pooled_bytes, 0u);
+
+  auto record = [](DisplayListBuilder& recorder) {
+    recorder.Translate(5, 7);
+    recorder.DrawRect({10, 10, 20, 20}, DlPaint(DlColor::kRed()));
+    recorder.DrawCircle({50, 50}, 10, DlPaint(DlColor::kBlue()));
+  };
+  record(builder);
+  DisplayListBuilder expected_builder;
+  record(expected_builder);
+  auto second = builder.Build();
+  auto expected = expected_builder.Build();
+  // The builder reserved storage for the first list and took it back from
+  // the pool.
+  EXPECT_EQ(pool->pooled_bytes(), 0u);
+  EXPECT_TRUE(second->Equals(expected));
+
+  second.reset();
+  EXPECT_EQ(pool->pooled_bytes(), pooled_bytes);
+}
+
+TEST_F(DisplayListTest, StorageSizeHintReservesStorage) {
+  auto record = [](DisplayListBuilder& builder) {
+    for (int i = 0; i < 1000; i++) {
+      builder.DrawRect({10, 10, 20, 20 + i * 1.0f}, DlPaint());
+    }
+    return builder.Build();
+  };
+  DisplayListBuilder unpooled_builder;
+  const size_t bytes = record(unpooled_builder)->bytes(false);
+
+  auto pool = std::make_shared<DisplayListStoragePool>();
+  DisplayListBuilder builder;
+  builder.SetStoragePool(pool);
+  builder.SetStorageSizeHint(bytes + bytes / 2);
+  record(builder).reset();
+  EXPECT_EQ(pool->pooled_bytes(), bytes + bytes / 2);
+}
+
+TEST_F(DisplayListTest, PooledListsGiveBackStorageTheyMostlyDontUse) {
+  auto pool = std::make_shared<DisplayListStoragePool>();
+  DisplayListBuilder builder;
+  builder.SetStoragePool(pool);
+  builder.SetStorageSizeHint(64 * 1024);
+  builder.DrawRect({10, 10, 20, 20}, DlPaint());
+  auto display_list = builder.Build();
+  const size_t op_bytes = display_list->bytes(false) - sizeof(DisplayList);
+  ASSERT_LT(op_bytes, 32u * 1024u);
+  display_list.reset();
+  EXPECT_EQ(pool->pooled_bytes(), op_bytes);
+}
+
+TEST_F(DisplayListTest, StoragePoolIsBounded) {
+  auto pool = std::make_shared<DisplayListStoragePool>(16 * 1024);
+  std::vector<DisplayListStorage> storages;
+  for (size_t i = 0; i < DisplayListStoragePool::kMaxBuffers + 1; i++) {
+    storages.push_back(pool->Take(1024));
+  }
+  storages.push_back(pool->Take(32 * 1024));
+  storages.clear();
+  EXPECT_EQ(pool->pooled_bytes(),
+            DisplayListStoragePool::kMaxBuffers * 1024u);
+
+  // Buffers that are more than twice as large as requested are not used.
+  auto storage = pool->Take(256);
+  EXPECT_EQ(storage.capacity(), 256u);
+  EXPECT_EQ(pool->pooled_bytes(),
+            DisplayListStoragePool::kMaxBuffers * 1024u);
+  storage = pool->Take(1000);
+  EXPECT_EQ(storage.capacity(), 1024u);
+}
+
 }  // namespace testing
 }  // namespace flutter
@@ -4,6 +4,8 @@
 
 #include "flutter/display_list/dl_builder.h"
 
+#include <algorithm>
+
 #include "flutter/display_list/display_list.h"
 #include "flutter/display_list/dl_blend_mode.h"
 #include "flutter/display_list/dl_op_flags.h"
@@ -47,14 +49,27 @@ void* DisplayListBuilder::Push(size_t pod, int render_op_inc, Args&&... args) {
     static_assert(is_power_of_two(DL_BUILDER_PAGE),
                   "This math needs updating for non-pow2.");
     // Next greater multiple of DL_BUILDER_PAGE.
-    allocated_ = (used_ + size + DL_BUILDER_PAGE) & ~(DL_BUILDER_PAGE - 1);
-    storage_.realloc(allocated_);
+    size_t needed = (used_ + size + DL_BUILDER_PAGE) & ~(DL_BUILDER_PAGE - 1);
+    if (!storage_.get()) {
+      needed = std::max(needed, storage_size_hint_);
+      if (storage_pool_) {
+        storage_ = storage_pool_->Take(needed);
+      } else {
+        storage_.realloc(needed);
+      }
+    } else {
+      storage_.realloc(needed);
+    }
+    allocated_ = storage_.capacity();
     FML_DCHECK(storage_.get());
-    memset(storage_.get() + used_, 0, allocated_ - used_);
   }
   FML_DCHECK(used_ + size <= allocated_);
   auto op = reinterpret_cast<T*>(storage_.get() + used_);
   used_ += size;
+  // Most ops are compared with memcmp by |DisplayList::Equals|, so their
+  // padding must be zero. Clearing just the bytes of the op rather than all
+  // of the storage when it is allocated also covers storage that is reused.
+  memset(op, 0, size);
   new (op) T{std::forward<Args>(args)...};
   op->type = T::kType;
   op->size = size;
@@ -82,7 +97,14 @@ sk_sp<DisplayList> DisplayListBuilder::Build() {
   used_ = allocated_ = render_op_count_ = op_index_ = 0;
   nested_bytes_ = nested_op_count_ = 0;
   is_ui_thread_safe_ = true;
-  storage_.realloc(bytes);
+  if (storage_pool_) {
+    storage_size_hint_ = bytes;
+  }
+  // Pooled storage keeps the capacity the list didn't use, unless the list
+  // uses less than half of it, as would happen after a much larger hint.
+  if (!storage_pool_ || !storage_.get() || storage_.capacity() / 2 > bytes) {
+    storage_.realloc(bytes);
+  }
   layer_stack_.pop_back();
   layer_stack_.emplace_back();
   current_layer_ = &layer_stack_.back();
@@ -246,11 +246,30 @@ class DisplayListBuilder final : public virtual DlCanvas,
 
   sk_sp<DisplayList> Build();
 
+  // Reserves |bytes| of storage when the first operation is recorded, so
+  // that a list of about that size is recorded without growing the storage.
+  // A good hint is the |DisplayList::bytes(false)| of the list that the one
+  // being recorded replaces, for example that of the previous frame. For a
+  // builder that uses a storage pool, the hint is updated to the size of the
+  // list whenever |Build| is called.
+  void SetStorageSizeHint(size_t bytes) { storage_size_hint_ = bytes; }
+
+  // Takes the storage of the lists that are built from |pool| instead of
+  // allocating it. The lists keep the capacity they didn't use, rather than
+  // shrinking it to fit, unless they use less than half of it, and give their
+  // storage back to |pool| when they are destroyed, so that a builder that
+  // records a list of about the same size every frame reuses the storage of
+  // an earlier frame.
+  void SetStoragePool(std::shared_ptr<DisplayListStoragePool> pool) {
+    storage_pool_ = std::move(pool);
+  }
+
  private:
   // This method exposes the internal stateful DlOpReceiver implementation
   // of the DisplayListBuilder, primarily for testing purposes. Its use
   // is obsolete and forbidden in every other case and is only shared to a
-  // pair of "friend" accessors in the benchmark/unittest files.
+  // pair of "friend" accessors in the benchmark/unittest files and to the
+  // DisplayList deserializer, which replays recorded operations through it.
   DlOpReceiver& asReceiver() { return *this; }
 
   friend DlOpReceiver& DisplayListBuilderBenchmarkAccessor(
@@ -259,6 +278,7 @@ class DisplayListBuilder final : public virtual DlCanvas,
       DisplayListBuilder& builder);
   friend DlPaint DisplayListBuilderTestingAttributes(
       DisplayListBuilder& builder);
+  friend class DlSerializationReader;
 
   void SetAttributesFromPaint(const DlPaint& paint,
                               const DisplayListAttributeFlags flags);
@@ -488,6 +508,8 @@ class DisplayListBuilder final : public virtual DlCanvas,
   DisplayListStorage storage_;
   size_t used_ = 0;
   size_t allocated_ = 0;
+  size_t storage_size_hint_ = 0;
+  std::shared_ptr<DisplayListStoragePool> storage_pool_;
   int render_op_count_ = 0;
   int op_index_ = 0;
 
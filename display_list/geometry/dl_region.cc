@@ -6,12 +6,93 @@
 
 #include "flutter/fml/logging.h"
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define DL_REGION_SIMD_SPANS
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define DL_REGION_SIMD_SPANS
+#endif
+
 namespace flutter {
 
 // Threshold for switching from linear search through span lines to binary
 // search.
 const int kBinarySearchThreshold = 10;
 
+// Number of spans of one line in a row after which a union looks for the
+// rest of the run rather than merging them one at a time.
+const int kSpanRunThreshold = 4;
+
+namespace {
+
+#ifdef DL_REGION_SIMD_SPANS
+
+// Number of spans compared at a time by the SIMD span searches.
+constexpr int kSimdSpans = 4;
+
+// The SIMD span searches below take the spans as consecutive (left, right)
+// pairs of int32_t and return the index of the first of the four spans at
+// |spans| that matches, or -1 if none does.
+
+#if defined(__SSE2__)
+
+void LoadSpans(const int32_t* spans, __m128i& lefts, __m128i& rights) {
+  // l0 r0 l1 r1 and l2 r2 l3 r3 to l0 l1 r0 r1 and l2 l3 r2 r3.
+  __m128i a = _mm_shuffle_epi32(
+      _mm_loadu_si128(reinterpret_cast<const __m128i*>(spans)),
+      _MM_SHUFFLE(3, 1, 2, 0));
+  __m128i b = _mm_shuffle_epi32(
+      _mm_loadu_si128(reinterpret_cast<const __m128i*>(spans + 4)),
+      _MM_SHUFFLE(3, 1, 2, 0));
+  lefts = _mm_unpacklo_epi64(a, b);
+  rights = _mm_unpackhi_epi64(a, b);
+}
+
+int FirstLane(__m128i mask) {
+  int bits = _mm_movemask_ps(_mm_castsi128_ps(mask));
+  return bits == 0 ? -1 : __builtin_ctz(bits);
+}
+
+int FindLeftAtOrAfter(const int32_t* spans, int32_t x) {
+  __m128i lefts, rights;
+  LoadSpans(spans, lefts, rights);
+  // SSE2 only has a signed greater than, so look for the first left that
+  // isn't before x.
+  __m128i before = _mm_cmpgt_epi32(_mm_set1_epi32(x), lefts);
+  return FirstLane(_mm_xor_si128(before, _mm_set1_epi32(-1)));
+}
+
+int FindRightAfter(const int32_t* spans, int32_t x) {
+  __m128i lefts, rights;
+  LoadSpans(spans, lefts, rights);
+  return FirstLane(_mm_cmpgt_epi32(rights, _mm_set1_epi32(x)));
+}
+
+#else  // defined(__ARM_NEON)
+
+int FirstLane(uint32x4_t mask) {
+  // Narrow the lanes to 16 bits so that the mask fits in 64.
+  uint64_t bits = vget_lane_u64(vreinterpret_u64_u16(vmovn_u32(mask)), 0);
+  return bits == 0 ? -1 : __builtin_ctzll(bits) / 16;
+}
+
+int FindLeftAtOrAfter(const int32_t* spans, int32_t x) {
+  // Loads the lefts into val[0] and the rights into val[1].
+  int32x4x2_t lefts_rights = vld2q_s32(spans);
+  return FirstLane(vcgeq_s32(lefts_rights.val[0], vdupq_n_s32(x)));
+}
+
+int FindRightAfter(const int32_t* spans, int32_t x) {
+  int32x4x2_t lefts_rights = vld2q_s32(spans);
+  return FirstLane(vcgtq_s32(lefts_rights.val[1], vdupq_n_s32(x)));
+}
+
+#endif
+#endif  // DL_REGION_SIMD_SPANS
+
+}  // namespace
+
 DlRegion::SpanBuffer::SpanBuffer(DlRegion::SpanBuffer&& m)
     : capacity_(m.capacity_), size_(m.size_), spans_(m.spans_) {
   m.size_ = 0;
@@ -31,8 +112,15 @@ DlRegion::SpanBuffer::SpanBuffer(const DlRegion::SpanBuffer& m)
 
 DlRegion::SpanBuffer& DlRegion::SpanBuffer::operator=(
     const DlRegion::SpanBuffer& buffer) {
-  SpanBuffer copy(buffer);
-  std::swap(*this, copy);
+  // Reuse the memory we already have if it's large enough.
+  if (this != &buffer) {
+    size_ = 0;
+    reserve(buffer.size_);
+    size_ = buffer.size_;
+    if (size_ > 0) {
+      memcpy(spans_, buffer.spans_, size_ * sizeof(Span));
+    }
+  }
   return *this;
 }
 
@@ -98,11 +186,66 @@ DlRegion::DlRegion(const std::vector<SkIRect>& rects) {
   setRects(rects);
 }
 
-DlRegion::DlRegion(const SkIRect& rect) : bounds_(rect) {
+DlRegion::DlRegion(const SkIRect& rect) {
+  setRect(rect);
+}
+
+void DlRegion::setRect(const SkIRect& rect) {
+  clear();
+  bounds_ = rect;
   Span span{rect.left(), rect.right()};
   lines_.push_back(makeLine(rect.top(), rect.bottom(), &span, &span + 1));
 }
 
+void DlRegion::clear() {
+  lines_.clear();
+  bounds_ = SkIRect::MakeEmpty();
+  span_buffer_.clear();
+}
+
+const DlRegion::Span* DlRegion::findSpanStartingAtOrAfter(const Span* begin,
+                                                          const Span* end,
+                                                          int32_t x) {
+  // Most runs are short, so check the first span before comparing several.
+  if (begin == end || begin->left >= x) {
+    return begin;
+  }
+  ++begin;
+#ifdef DL_REGION_SIMD_SPANS
+  for (; end - begin >= kSimdSpans; begin += kSimdSpans) {
+    int lane = FindLeftAtOrAfter(&begin->left, x);
+    if (lane >= 0) {
+      return begin + lane;
+    }
+  }
+#endif
+  while (begin != end && begin->left < x) {
+    ++begin;
+  }
+  return begin;
+}
+
+const DlRegion::Span* DlRegion::findSpanEndingAfter(const Span* begin,
+                                                    const Span* end,
+                                                    int32_t x) {
+  if (begin == end || begin->right > x) {
+    return begin;
+  }
+  ++begin;
+#ifdef DL_REGION_SIMD_SPANS
+  for (; end - begin >= kSimdSpans; begin += kSimdSpans) {
+    int lane = FindRightAfter(&begin->left, x);
+    if (lane >= 0) {
+      return begin + lane;
+    }
+  }
+#endif
+  while (begin != end && begin->right <= x) {
+    ++begin;
+  }
+  return begin;
+}
+
 bool DlRegion::spansEqual(SpanLine& line,
                           const Span* begin,
                           const Span* end) const {
@@ -153,6 +296,34 @@ size_t DlRegion::unionLineSpans(std::vector<Span>& res,
       }
     }
 
+    // Accumulates the spans in [begin, end), which must come from the same
+    // line and must not start before any span accumulated so far. The spans
+    // that end within the last accumulated span are covered by it and only
+    // the one after them can merge with it. As the spans of a line don't
+    // touch, the rest are copied as they are.
+    void accumulateRun(const Span* begin, const Span* end) {
+      if (end - begin <= 1) {
+        if (begin != end) {
+          accumulate(*begin);
+        }
+        return;
+      }
+      if (len > 0) {
+        begin = findSpanEndingAfter(begin, end, last_);
+        if (begin == end) {
+          return;
+        }
+        accumulate(*begin++);
+      }
+      if (begin != end) {
+        size_t count = end - begin;
+        FML_DCHECK(len == 0 || begin->left > last_);
+        memcpy(&res[len], begin, count * sizeof(Span));
+        len += count;
+        last_ = (end - 1)->right;
+      }
+    }
+
     size_t len = 0;
     std::vector<Span>& res;
 
@@ -173,16 +344,38 @@ size_t DlRegion::unionLineSpans(std::vector<Span>& res,
 
   OrderedSpanAccumulator accumulator(res);
 
+  // Most runs of spans of one line that start before the next span of the
+  // other are short, so spans are taken one at a time until a run is long
+  // enough for the rest of it to be worth looking for and taking at once.
+  int run1 = 0;
+  int run2 = 0;
   while (true) {
     if (begin1->left < begin2->left) {
-      accumulator.accumulate(*begin1++);
+      run2 = 0;
+      if (++run1 < kSpanRunThreshold) {
+        accumulator.accumulate(*begin1++);
+      } else {
+        auto run_end = findSpanStartingAtOrAfter(begin1, end1, begin2->left);
+        accumulator.accumulateRun(begin1, run_end);
+        begin1 = run_end;
+        run1 = 0;
+      }
       if (begin1 == end1) {
         break;
       }
     } else {
       // Either 2 is first, or they are equal, in which case add 2 now
       // and we might combine 1 with it next time around
-      accumulator.accumulate(*begin2++);
+      run1 = 0;
+      if (++run2 < kSpanRunThreshold) {
+        accumulator.accumulate(*begin2++);
+      } else {
+        auto run_end =
+            findSpanStartingAtOrAfter(begin2, end2, begin1->left + 1);
+        accumulator.accumulateRun(begin2, run_end);
+        begin2 = run_end;
+        run2 = 0;
+      }
       if (begin2 == end2) {
         break;
       }
@@ -191,14 +384,8 @@ size_t DlRegion::unionLineSpans(std::vector<Span>& res,
 
   FML_DCHECK(begin1 == end1 || begin2 == end2);
 
-  while (begin1 < end1) {
-    accumulator.accumulate(*begin1++);
-  }
-  while (begin2 < end2) {
-    accumulator.accumulate(*begin2++);
-  }
-
-  FML_DCHECK(begin1 == end1 && begin2 == end2);
+  accumulator.accumulateRun(begin1, end1);
+  accumulator.accumulateRun(begin2, end2);
 
   return accumulator.len;
 }
@@ -227,9 +414,9 @@ size_t DlRegion::intersectLineSpans(std::vector<Span>& res,
 
   while (begin1 != end1 && begin2 != end2) {
     if (begin1->right <= begin2->left) {
-      ++begin1;
+      begin1 = findSpanEndingAfter(begin1 + 1, end1, begin2->left);
     } else if (begin2->right <= begin1->left) {
-      ++begin2;
+      begin2 = findSpanEndingAfter(begin2 + 1, end2, begin1->left);
     } else {
       int32_t left = std::max(begin1->left, begin2->left);
       int32_t right = std::min(begin1->right, begin2->right);
@@ -414,10 +601,20 @@ DlRegion DlRegion::MakeUnion(const DlRegion& a, const DlRegion& b) {
   }
 
   DlRegion res;
-  res.bounds_ = a.bounds_;
-  res.bounds_.join(b.bounds_);
   res.span_buffer_.reserve(a.span_buffer_.capacity() +
                            b.span_buffer_.capacity());
+  std::vector<Span> tmp;
+  unionRegions(a, b, res, tmp);
+  return res;
+}
+
+void DlRegion::unionRegions(const DlRegion& a,
+                            const DlRegion& b,
+                            DlRegion& res,
+                            SpanVec& tmp) {
+  FML_DCHECK(res.isEmpty());
+  res.bounds_ = a.bounds_;
+  res.bounds_.join(b.bounds_);
 
   auto& lines = res.lines_;
   lines.reserve(a.lines_.size() + b.lines_.size());
@@ -432,8 +629,6 @@ DlRegion DlRegion::MakeUnion(const DlRegion& a, const DlRegion& b) {
   auto& a_buffer = a.span_buffer_;
   auto& b_buffer = b.span_buffer_;
 
-  std::vector<Span> tmp;
-
   int32_t cur_top = std::numeric_limits<int32_t>::min();
 
   while (a_it != a_end && b_it != b_end) {
@@ -490,8 +685,6 @@ DlRegion DlRegion::MakeUnion(const DlRegion& a, const DlRegion& b) {
     res.appendLine(b_top, b_it->bottom, b_buffer, b_it->chunk_handle);
     ++b_it;
   }
-
-  return res;
 }
 
 DlRegion DlRegion::MakeIntersection(const DlRegion& a, const DlRegion& b) {
@@ -646,11 +839,11 @@ bool DlRegion::intersects(const SkIRect& rect) const {
     FML_DCHECK(rect.fTop < it->bottom && it->top < rect.fBottom);
     const Span *begin, *end;
     span_buffer_.getSpans(it->chunk_handle, begin, end);
-    while (begin != end && begin->left < rect.fRight) {
-      if (begin->right > rect.fLeft) {
-        return true;
-      }
-      ++begin;
+    // The first span that ends after the left of the rectangle is the only
+    // one that can intersect it without starting after it.
+    begin = findSpanEndingAfter(begin, end, rect.fLeft);
+    if (begin != end && begin->left < rect.fRight) {
+      return true;
     }
     ++it;
   }
@@ -664,9 +857,9 @@ bool DlRegion::spansIntersect(const Span* begin1,
                               const Span* end2) {
   while (begin1 != end1 && begin2 != end2) {
     if (begin1->right <= begin2->left) {
-      ++begin1;
+      begin1 = findSpanEndingAfter(begin1 + 1, end1, begin2->left);
     } else if (begin2->right <= begin1->left) {
-      ++begin2;
+      begin2 = findSpanEndingAfter(begin2 + 1, end2, begin1->left);
     } else {
       return true;
     }
@@ -757,4 +950,55 @@ bool DlRegion::intersects(const DlRegion& region) const {
   return false;
 }
 
+void DlRegionAccumulator::addRect(const SkIRect& rect) {
+  if (rect.isEmpty()) {
+    return;
+  }
+  if (region_.isSimple() && !region_.isEmpty() &&
+      region_.bounds_.contains(rect)) {
+    return;
+  }
+  if (region_.isEmpty() || rect.contains(region_.bounds_)) {
+    region_.setRect(rect);
+    return;
+  }
+  rect_.setRect(rect);
+  addNonEmptyRegion(rect_);
+}
+
+void DlRegionAccumulator::addRegion(const DlRegion& region) {
+  if (region.isEmpty()) {
+    return;
+  }
+  if (region.isSimple()) {
+    addRect(region.bounds_);
+    return;
+  }
+  if (region_.isEmpty()) {
+    region_ = region;
+    return;
+  }
+  if (region_.isSimple() && region_.bounds_.contains(region.bounds_)) {
+    return;
+  }
+  addNonEmptyRegion(region);
+}
+
+void DlRegionAccumulator::addNonEmptyRegion(const DlRegion& region) {
+  FML_DCHECK(!region_.isEmpty() && !region.isEmpty());
+  scratch_.clear();
+  // Unlike DlRegion::MakeUnion, reserve for the spans in use rather than the
+  // capacity, which would keep growing as the two regions trade places.
+  scratch_.span_buffer_.reserve(region_.span_buffer_.size() +
+                                region.span_buffer_.size());
+  DlRegion::unionRegions(region_, region, scratch_, spans_);
+  std::swap(region_, scratch_);
+}
+
+DlRegion DlRegionAccumulator::takeRegion() {
+  DlRegion region = std::move(region_);
+  region_.clear();
+  return region;
+}
+
 }  // namespace flutter
@@ -69,6 +69,8 @@ class DlRegion {
   bool isSimple() const { return !isComplex(); }
 
  private:
+  friend class DlRegionAccumulator;
+
   typedef std::uint32_t SpanChunkHandle;
 
   struct Span {
@@ -92,6 +94,10 @@ class DlRegion {
 
     void reserve(size_t capacity);
     size_t capacity() const { return capacity_; }
+    size_t size() const { return size_; }
+
+    /// Removes all chunks, keeping the allocated memory.
+    void clear() { size_ = 0; }
 
     SpanChunkHandle storeChunk(const Span* begin, const Span* end);
     size_t getChunkSize(SpanChunkHandle handle) const;
@@ -120,6 +126,13 @@ class DlRegion {
 
   void setRects(const std::vector<SkIRect>& rects);
 
+  /// Makes this region cover the area of |rect|, reusing the memory of the
+  /// lines and spans.
+  void setRect(const SkIRect& rect);
+
+  /// Makes this region empty, keeping the memory of the lines and spans.
+  void clear();
+
   void appendLine(int32_t top,
                   int32_t bottom,
                   const Span* begin,
@@ -139,6 +152,13 @@ class DlRegion {
                     int32_t bottom,
                     const Span* begin,
                     const Span* end);
+  /// Computes the union of the non-empty regions a and b into res, which
+  /// must be empty.
+  static void unionRegions(const DlRegion& a,
+                           const DlRegion& b,
+                           DlRegion& res,
+                           SpanVec& tmp);
+
   static size_t unionLineSpans(std::vector<Span>& res,
                                const SpanBuffer& a_buffer,
                                SpanChunkHandle a_handle,
@@ -152,6 +172,19 @@ class DlRegion {
 
   bool spansEqual(SpanLine& line, const Span* begin, const Span* end) const;
 
+  /// Returns the first span in [begin, end) whose left edge is at or after
+  /// x, or end if there is none. The spans must be ordered as they are in a
+  /// line. Compares several spans at a time where SIMD is available.
+  static const Span* findSpanStartingAtOrAfter(const Span* begin,
+                                               const Span* end,
+                                               int32_t x);
+
+  /// Returns the first span in [begin, end) whose right edge is after x, or
+  /// end if there is none. The spans must be ordered as they are in a line.
+  static const Span* findSpanEndingAfter(const Span* begin,
+                                         const Span* end,
+                                         int32_t x);
+
   static bool spansIntersect(const Span* begin1,
                              const Span* end1,
                              const Span* begin2,
@@ -168,6 +201,43 @@ class DlRegion {
   SpanBuffer span_buffer_;
 };
 
+/// Accumulates the union of many regions and rectangles, such as the
+/// contents of the layers of a frame.
+///
+/// Calling |DlRegion::MakeUnion| repeatedly allocates the lines and spans of
+/// a new region for every step and then throws away the previous one. The
+/// accumulator instead alternates between two regions whose memory it keeps,
+/// so once these have grown to the size of the result adding to it doesn't
+/// allocate.
+class DlRegionAccumulator {
+ public:
+  DlRegionAccumulator() = default;
+
+  /// Adds the area of the rectangle to the accumulated region.
+  void addRect(const SkIRect& rect);
+
+  /// Adds the area of the region to the accumulated region.
+  void addRegion(const DlRegion& region);
+
+  /// Returns the union of everything added since the accumulator was
+  /// created or last reset.
+  const DlRegion& region() const { return region_; }
+
+  /// Empties the accumulated region, keeping its memory for reuse.
+  void reset() { region_.clear(); }
+
+  /// Returns the accumulated region and leaves the accumulator empty.
+  DlRegion takeRegion();
+
+ private:
+  void addNonEmptyRegion(const DlRegion& region);
+
+  DlRegion region_;
+  DlRegion scratch_;
+  DlRegion rect_;
+  std::vector<DlRegion::Span> spans_;
+};
+
 }  // namespace flutter
 
 #endif  // FLUTTER_DISPLAY_LIST_GEOMETRY_DL_REGION_H_
@@ -341,6 +341,128 @@ TEST(DisplayListRegion, UnionEmpty) {
   }
 }
 
+// Lines with many spans go through the paths that skip and copy several
+// spans at a time.
+TEST(DisplayListRegion, LinesWithManySpans) {
+  constexpr int32_t kWidth = 2000;
+  std::seed_seq seed{::testing::UnitTest::GetInstance()->random_seed()};
+  std::mt19937 rng(seed);
+  std::uniform_int_distribution count(1, 200);
+  std::uniform_int_distribution pos(0, kWidth - 1);
+
+  // Returns the rects of a line of random spans and marks what they cover.
+  auto make_rects = [&](int max_size, std::vector<bool>& covered) {
+    std::uniform_int_distribution size(1, max_size);
+    std::vector<SkIRect> rects;
+    for (int i = count(rng); i > 0; i--) {
+      int32_t left = pos(rng);
+      int32_t right = std::min(left + size(rng), kWidth);
+      rects.push_back(SkIRect::MakeLTRB(left, 0, right, 10));
+      std::fill(covered.begin() + left, covered.begin() + right, true);
+    }
+    return rects;
+  };
+  // Returns the rects covering the marked area of a line.
+  auto covered_rects = [](const std::vector<bool>& covered) {
+    std::vector<SkIRect> rects;
+    for (int32_t left = 0; left < kWidth; left++) {
+      if (covered[left]) {
+        int32_t right = left;
+        while (right < kWidth && covered[right]) {
+          right++;
+        }
+        rects.push_back(SkIRect::MakeLTRB(left, 0, right, 10));
+        left = right;
+      }
+    }
+    return rects;
+  };
+
+  for (int max_size : {1, 5, 20, 100}) {
+    for (int i = 0; i < 50; i++) {
+      std::vector<bool> covered1(kWidth);
+      std::vector<bool> covered2(kWidth);
+      DlRegion region1(make_rects(max_size, covered1));
+      DlRegion region2(make_rects(max_size, covered2));
+
+      std::vector<bool> covered_union(kWidth);
+      std::vector<bool> covered_intersection(kWidth);
+      for (int32_t x = 0; x < kWidth; x++) {
+        covered_union[x] = covered1[x] || covered2[x];
+        covered_intersection[x] = covered1[x] && covered2[x];
+      }
+      auto intersection_rects = covered_rects(covered_intersection);
+
+      EXPECT_EQ(DlRegion::MakeUnion(region1, region2).getRects(false),
+                covered_rects(covered_union));
+      EXPECT_EQ(DlRegion::MakeIntersection(region1, region2).getRects(false),
+                intersection_rects);
+      EXPECT_EQ(region1.intersects(region2), !intersection_rects.empty());
+
+      for (int j = 0; j < 10; j++) {
+        int32_t left = pos(rng);
+        int32_t right = std::min(left + max_size, kWidth);
+        bool expected = std::find(covered1.begin() + left,
+                                  covered1.begin() + right,
+                                  true) != covered1.begin() + right;
+        EXPECT_EQ(region1.intersects(SkIRect::MakeLTRB(left, 5, right, 15)),
+                  expected);
+      }
+    }
+  }
+}
+
+TEST(DisplayListRegion, Accumulator) {
+  std::seed_seq seed{::testing::UnitTest::GetInstance()->random_seed()};
+  std::mt19937 rng(seed);
+  std::uniform_int_distribution pos(0, 1000);
+  std::uniform_int_distribution size(1, 200);
+
+  DlRegionAccumulator accumulator;
+  EXPECT_TRUE(accumulator.region().isEmpty());
+
+  for (size_t count : {1, 10, 100, 1000}) {
+    accumulator.reset();
+    EXPECT_TRUE(accumulator.region().isEmpty());
+    EXPECT_EQ(accumulator.region().bounds(), SkIRect::MakeEmpty());
+
+    std::vector<SkIRect> rects;
+    while (rects.size() < count) {
+      // Alternate between single rectangles and regions of several.
+      std::vector<SkIRect> added;
+      for (size_t i = rects.size() % 3; i < 3; i++) {
+        added.push_back(
+            SkIRect::MakeXYWH(pos(rng), pos(rng), size(rng), size(rng)));
+      }
+      if (added.size() == 1) {
+        accumulator.addRect(added[0]);
+      } else {
+        accumulator.addRegion(DlRegion(added));
+      }
+      rects.insert(rects.end(), added.begin(), added.end());
+
+      DlRegion expected(rects);
+      EXPECT_EQ(accumulator.region().bounds(), expected.bounds());
+      EXPECT_EQ(accumulator.region().getRects(false),
+                expected.getRects(false));
+    }
+  }
+
+  accumulator.addRegion(DlRegion());
+  accumulator.addRect(SkIRect::MakeEmpty());
+  auto rects = accumulator.region().getRects();
+  DlRegion region = accumulator.takeRegion();
+  EXPECT_EQ(region.getRects(), rects);
+  EXPECT_TRUE(accumulator.region().isEmpty());
+
+  // A rectangle covering the region replaces it.
+  accumulator.addRegion(region);
+  accumulator.addRect(SkIRect::MakeLTRB(-10, -10, 2000, 2000));
+  EXPECT_TRUE(accumulator.region().isSimple());
+  EXPECT_EQ(accumulator.region().bounds(),
+            SkIRect::MakeLTRB(-10, -10, 2000, 2000));
+}
+
 void CheckEquality(const DlRegion& dl_region, const SkRegion& sk_region) {
   EXPECT_EQ(dl_region.bounds(), sk_region.getBounds());
 
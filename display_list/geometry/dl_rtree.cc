@@ -139,8 +139,8 @@ DlRTree::DlRTree(const SkRect rects[],
   FML_DCHECK(gen_start + gen_count == total_node_count);
 }
 
-void DlRTree::search(const SkRect& query, std::vector<int>* results) const {
-  FML_DCHECK(results != nullptr);
+template <typename Visitor>
+void DlRTree::Visit(const SkRect& query, Visitor& visitor) const {
   if (query.isEmpty()) {
     return;
   }
@@ -153,13 +153,53 @@ void DlRTree::search(const SkRect& query, std::vector<int>* results) const {
     if (nodes_.size() == 1) {
       FML_DCHECK(leaf_count_ == 1);
       // The root node is the only node and it is a leaf node
-      results->push_back(0);
+      visitor(0);
     } else {
-      search(root, query, results);
+      Visit(root, query, visitor);
+    }
+  }
+}
+
+template <typename Visitor>
+void DlRTree::Visit(const Node& parent,
+                    const SkRect& query,
+                    Visitor& visitor) const {
+  // Caller protects against empty query
+  int start = parent.child.index;
+  int end = start + parent.child.count;
+  for (int i = start; i < end; i++) {
+    const Node& node = nodes_[i];
+    if (node.bounds.intersects(query)) {
+      if (i < leaf_count_) {
+        visitor(i);
+      } else {
+        Visit(node, query, visitor);
+      }
     }
   }
 }
 
+void DlRTree::search(const SkRect& query, std::vector<int>* results) const {
+  FML_DCHECK(results != nullptr);
+  auto visitor = [results](int index) { results->push_back(index); };
+  Visit(query, visitor);
+}
+
+int DlRTree::search(const SkRect& query,
+                    int results[],
+                    int max_results) const {
+  FML_DCHECK(results != nullptr || max_results == 0);
+  int count = 0;
+  auto visitor = [results, max_results, &count](int index) {
+    if (count < max_results) {
+      results[count] = index;
+    }
+    count++;
+  };
+  Visit(query, visitor);
+  return count;
+}
+
 std::list<SkRect> DlRTree::searchAndConsolidateRects(const SkRect& query,
                                                      bool deband) const {
   // Get the indexes for the operations that intersect with the query rect.
@@ -183,24 +223,6 @@ std::list<SkRect> DlRTree::searchAndConsolidateRects(const SkRect& query,
   return final_results;
 }
 
-void DlRTree::search(const Node& parent,
-                     const SkRect& query,
-                     std::vector<int>* results) const {
-  // Caller protects against empty query
-  int start = parent.child.index;
-  int end = start + parent.child.count;
-  for (int i = start; i < end; i++) {
-    const Node& node = nodes_[i];
-    if (node.bounds.intersects(query)) {
-      if (i < leaf_count_) {
-        results->push_back(i);
-      } else {
-        search(node, query, results);
-      }
-    }
-  }
-}
-
 const DlRegion& DlRTree::region() const {
   if (!region_) {
     std::vector<SkIRect> rects;
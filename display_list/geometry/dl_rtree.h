@@ -80,6 +80,15 @@ class DlRTree : public SkRefCnt {
   /// |DlRTree::id| and |DlRTree::bounds| methods.
   void search(const SkRect& query, std::vector<int>* results) const;
 
+  /// Search the rectangles like the method above, but store the leaf node
+  /// indices in the |max_results| entries of the caller's |results| buffer
+  /// instead of a vector, so that the search doesn't allocate.
+  ///
+  /// Returns the number of rectangles that intersect the query. If that is
+  /// more than |max_results|, the buffer holds only the first |max_results|
+  /// of them and the search should be repeated with a larger buffer.
+  int search(const SkRect& query, int results[], int max_results) const;
+
   /// Return the ID for the indicated result of a query or
   /// invalid_id if the index is not a valid leaf node index.
   int id(int result_index) const {
@@ -139,9 +148,12 @@ class DlRTree : public SkRefCnt {
  private:
   static constexpr SkRect kEmpty = SkRect::MakeEmpty();
 
-  void search(const Node& parent,
-              const SkRect& query,
-              std::vector<int>* results) const;
+  // Calls |visitor| with the index of every leaf node that intersects
+  // |query|, in the order of the leaf nodes.
+  template <typename Visitor>
+  void Visit(const SkRect& query, Visitor& visitor) const;
+  template <typename Visitor>
+  void Visit(const Node& parent, const SkRect& query, Visitor& visitor) const;
 
   std::vector<Node> nodes_;
   int leaf_count_ = 0;
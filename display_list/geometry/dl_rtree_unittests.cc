@@ -2,6 +2,8 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <random>
+
 #include "flutter/display_list/geometry/dl_rtree.h"
 #include "gtest/gtest.h"
 
@@ -319,5 +321,97 @@ TEST(DisplayListRTree, Region) {
   EXPECT_EQ(rects.size(), expected_rects.size());
 }
 
+namespace {
+
+// Rectangles in a random order that overlap each other, with ids that don't
+// match their index.
+std::vector<SkRect> MakeScatteredRects(int count, std::vector<int>* ids) {
+  std::mt19937 random(count);
+  std::uniform_real_distribution<float> position(0, 2000);
+  std::uniform_real_distribution<float> size(1, 50);
+  std::vector<SkRect> rects;
+  for (int i = 0; i < count; i++) {
+    // Every 10th rectangle is empty and isn't stored in the tree.
+    float width = i % 10 == 9 ? 0 : size(random);
+    rects.push_back(
+        SkRect::MakeXYWH(position(random), position(random), width,
+                         size(random)));
+    ids->push_back(i * 3 + 7);
+  }
+  return rects;
+}
+
+// Checks that |tree| finds the same rectangles in the same order as a
+// linear search of the |rects| that the tree was built from.
+void ExpectSearchesMatchLinearSearch(const DlRTree& tree,
+                                     const std::vector<SkRect>& rects,
+                                     const std::vector<int>& ids) {
+  std::vector<int> leaf_ids;
+  for (size_t i = 0; i < rects.size(); i++) {
+    if (!rects[i].isEmpty()) {
+      leaf_ids.push_back(ids[i]);
+    }
+  }
+  ASSERT_EQ(tree.leaf_count(), static_cast<int>(leaf_ids.size()));
+
+  std::mt19937 random(42);
+  std::uniform_real_distribution<float> position(-100, 2100);
+  std::uniform_real_distribution<float> size(1, 400);
+  std::vector<int> results;
+  std::vector<int> buffer(rects.size());
+  for (int q = 0; q < 200; q++) {
+    SkRect query = SkRect::MakeXYWH(position(random), position(random),
+                                    size(random), size(random));
+    std::vector<int> expected;
+    for (size_t i = 0; i < rects.size(); i++) {
+      if (!rects[i].isEmpty() && rects[i].intersects(query)) {
+        expected.push_back(ids[i]);
+      }
+    }
+
+    results.clear();
+    tree.search(query, &results);
+    ASSERT_EQ(results.size(), expected.size()) << q;
+    for (size_t i = 0; i < results.size(); i++) {
+      ASSERT_EQ(tree.id(results[i]), expected[i]) << q;
+    }
+
+    int count = tree.search(query, buffer.data(), buffer.size());
+    ASSERT_EQ(count, static_cast<int>(expected.size())) << q;
+    for (int i = 0; i < count; i++) {
+      ASSERT_EQ(buffer[i], results[i]) << q;
+    }
+  }
+}
+
+}  // namespace
+
+TEST(DisplayListRTree, SearchesMatchLinearSearch) {
+  for (int count : {0, 1, 2, 11, 12, 121, 122, 1000}) {
+    std::vector<int> ids;
+    auto rects = MakeScatteredRects(count, &ids);
+    DlRTree tree(rects.data(), count, ids.data());
+    ExpectSearchesMatchLinearSearch(tree, rects, ids);
+  }
+}
+
+TEST(DisplayListRTree, SearchIntoBufferReportsOverflow) {
+  SkRect rects[5];
+  for (int i = 0; i < 5; i++) {
+    rects[i] = SkRect::MakeXYWH(i * 10, 0, 15, 10);
+  }
+  DlRTree tree(rects, 5);
+  int results[3] = {-1, -1, -1};
+  EXPECT_EQ(tree.search(SkRect::MakeLTRB(0, 0, 100, 10), results, 3), 5);
+  EXPECT_EQ(results[0], 0);
+  EXPECT_EQ(results[1], 1);
+  EXPECT_EQ(results[2], 2);
+  EXPECT_EQ(tree.search(SkRect::MakeLTRB(12, 2, 18, 8), results, 3), 2);
+  EXPECT_EQ(results[0], 0);
+  EXPECT_EQ(results[1], 1);
+  EXPECT_EQ(tree.search(SkRect::MakeEmpty(), results, 3), 0);
+  EXPECT_EQ(tree.search(SkRect::MakeLTRB(0, 0, 100, 10), nullptr, 0), 5);
+}
+
 }  // namespace testing
 }  // namespace flutter
@@ -0,0 +1,1672 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/display_list/utils/dl_serialization.h"
+
+#include <cstring>
+#include <deque>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include "flutter/display_list/dl_builder.h"
+#include "flutter/display_list/dl_op_receiver.h"
+#include "flutter/fml/logging.h"
+#include "flutter/fml/trace_event.h"
+#include "third_party/skia/include/core/SkColorSpace.h"
+#include "third_party/skia/include/core/SkData.h"
+#include "third_party/skia/include/core/SkImage.h"
+#include "third_party/skia/include/core/SkPixmap.h"
+#include "third_party/skia/include/core/SkRSXform.h"
+
+namespace flutter {
+
+namespace {
+
+// The operations in the stream, each of which is followed by the arguments
+// of the |DlOpReceiver| method of the same name. New operations must be added
+// at the end.
+enum class SerializedOp : uint8_t {
+  kEnd,
+
+  kSetAntiAlias,
+  kSetDrawStyle,
+  kSetColor,
+  kSetStrokeWidth,
+  kSetStrokeMiter,
+  kSetStrokeCap,
+  kSetStrokeJoin,
+  kSetColorSource,
+  kSetColorFilter,
+  kSetInvertColors,
+  kSetBlendMode,
+  kSetPathEffect,
+  kSetMaskFilter,
+  kSetImageFilter,
+
+  kSave,
+  kSaveLayer,
+  kRestore,
+
+  kTranslate,
+  kScale,
+  kRotate,
+  kSkew,
+  kTransform2DAffine,
+  kTransformFullPerspective,
+  kTransformReset,
+
+  kClipRect,
+  kClipRRect,
+  kClipPath,
+
+  kDrawColor,
+  kDrawPaint,
+  kDrawLine,
+  kDrawRect,
+  kDrawOval,
+  kDrawCircle,
+  kDrawRRect,
+  kDrawDRRect,
+  kDrawPath,
+  kDrawArc,
+  kDrawPoints,
+  kDrawVertices,
+  kDrawImage,
+  kDrawImageRect,
+  kDrawImageNine,
+  kDrawAtlas,
+  kDrawDisplayList,
+  kDrawShadow,
+
+  kLastOp = kDrawShadow,
+};
+
+// Objects are referred to by their index in the table of objects of their
+// kind, in the order in which they were first written. The first reference
+// to an object is |kNewReference| followed by its definition.
+constexpr uint32_t kNullReference = 0xFFFFFFFE;
+constexpr uint32_t kNewReference = 0xFFFFFFFF;
+
+// Arrays are aligned to the size of their largest element type and pixels
+// to that of the largest pixel format, relative to the start of the data.
+constexpr size_t kArrayAlignment = 4;
+constexpr size_t kPixelAlignment = 16;
+
+// Deeper nesting of DisplayLists and image filters is considered corrupt.
+constexpr int kMaxNestingDepth = 64;
+
+struct SerializedHeader {
+  uint32_t magic;
+  uint32_t version;
+};
+
+// Writes the operations it receives to a byte stream.
+class DlSerializationWriter final : public DlOpReceiver {
+ public:
+  DlSerializationWriter() {
+    Write(SerializedHeader{DlSerialization::kMagic, DlSerialization::kVersion});
+  }
+
+  bool is_valid() const { return is_valid_; }
+
+  std::vector<uint8_t> TakeData() { return std::move(data_); }
+
+  void WriteDisplayList(const DisplayList& display_list) {
+    Write<uint8_t>(display_list.has_rtree());
+    display_list.Dispatch(*this);
+    WriteOp(SerializedOp::kEnd);
+  }
+
+  void setAntiAlias(bool aa) override {
+    WriteOp(SerializedOp::kSetAntiAlias);
+    Write<uint8_t>(aa);
+  }
+  void setDrawStyle(DlDrawStyle style) override {
+    WriteOp(SerializedOp::kSetDrawStyle);
+    WriteEnum(style);
+  }
+  void setColor(DlColor color) override {
+    WriteOp(SerializedOp::kSetColor);
+    Write(color.argb());
+  }
+  void setStrokeWidth(float width) override {
+    WriteOp(SerializedOp::kSetStrokeWidth);
+    Write(width);
+  }
+  void setStrokeMiter(float limit) override {
+    WriteOp(SerializedOp::kSetStrokeMiter);
+    Write(limit);
+  }
+  void setStrokeCap(DlStrokeCap cap) override {
+    WriteOp(SerializedOp::kSetStrokeCap);
+    WriteEnum(cap);
+  }
+  void setStrokeJoin(DlStrokeJoin join) override {
+    WriteOp(SerializedOp::kSetStrokeJoin);
+    WriteEnum(join);
+  }
+  void setColorSource(const DlColorSource* source) override {
+    WriteOp(SerializedOp::kSetColorSource);
+    WriteColorSource(source);
+  }
+  void setColorFilter(const DlColorFilter* filter) override {
+    WriteOp(SerializedOp::kSetColorFilter);
+    WriteColorFilter(filter);
+  }
+  void setInvertColors(bool invert) override {
+    WriteOp(SerializedOp::kSetInvertColors);
+    Write<uint8_t>(invert);
+  }
+  void setBlendMode(DlBlendMode mode) override {
+    WriteOp(SerializedOp::kSetBlendMode);
+    WriteEnum(mode);
+  }
+  void setPathEffect(const DlPathEffect* effect) override {
+    WriteOp(SerializedOp::kSetPathEffect);
+    WritePathEffect(effect);
+  }
+  void setMaskFilter(const DlMaskFilter* filter) override {
+    WriteOp(SerializedOp::kSetMaskFilter);
+    WriteMaskFilter(filter);
+  }
+  void setImageFilter(const DlImageFilter* filter) override {
+    WriteOp(SerializedOp::kSetImageFilter);
+    WriteImageFilter(filter);
+  }
+
+  void save() override { WriteOp(SerializedOp::kSave); }
+  void saveLayer(const SkRect& bounds,
+                 const SaveLayerOptions options,
+                 const DlImageFilter* backdrop) override {
+    WriteOp(SerializedOp::kSaveLayer);
+    Write(bounds);
+    Write<uint8_t>(options.renders_with_attributes());
+    Write<uint8_t>(options.bounds_from_caller());
+    WriteImageFilter(backdrop);
+  }
+  void restore() override { WriteOp(SerializedOp::kRestore); }
+
+  void translate(SkScalar tx, SkScalar ty) override {
+    WriteOp(SerializedOp::kTranslate);
+    Write(tx);
+    Write(ty);
+  }
+  void scale(SkScalar sx, SkScalar sy) override {
+    WriteOp(SerializedOp::kScale);
+    Write(sx);
+    Write(sy);
+  }
+  void rotate(SkScalar degrees) override {
+    WriteOp(SerializedOp::kRotate);
+    Write(degrees);
+  }
+  void skew(SkScalar sx, SkScalar sy) override {
+    WriteOp(SerializedOp::kSkew);
+    Write(sx);
+    Write(sy);
+  }
+  // clang-format off
+  void transform2DAffine(SkScalar mxx, SkScalar mxy, SkScalar mxt,
+                         SkScalar myx, SkScalar myy, SkScalar myt) override {
+    WriteOp(SerializedOp::kTransform2DAffine);
+    const SkScalar values[] = {mxx, mxy, mxt,
+                               myx, myy, myt};
+    Write(values);
+  }
+  void transformFullPerspective(
+      SkScalar mxx, SkScalar mxy, SkScalar mxz, SkScalar mxt,
+      SkScalar myx, SkScalar myy, SkScalar myz, SkScalar myt,
+      SkScalar mzx, SkScalar mzy, SkScalar mzz, SkScalar mzt,
+      SkScalar mwx, SkScalar mwy, SkScalar mwz, SkScalar mwt) override {
+    WriteOp(SerializedOp::kTransformFullPerspective);
+    const SkScalar values[] = {mxx, mxy, mxz, mxt,
+                               myx, myy, myz, myt,
+                               mzx, mzy, mzz, mzt,
+                               mwx, mwy, mwz, mwt};
+    Write(values);
+  }
+  // clang-format on
+  void transformReset() override { WriteOp(SerializedOp::kTransformReset); }
+
+  void clipRect(const SkRect& rect, ClipOp clip_op, bool is_aa) override {
+    WriteOp(SerializedOp::kClipRect);
+    Write(rect);
+    WriteEnum(clip_op);
+    Write<uint8_t>(is_aa);
+  }
+  void clipRRect(const SkRRect& rrect, ClipOp clip_op, bool is_aa) override {
+    WriteOp(SerializedOp::kClipRRect);
+    WriteRRect(rrect);
+    WriteEnum(clip_op);
+    Write<uint8_t>(is_aa);
+  }
+  void clipPath(const SkPath& path, ClipOp clip_op, bool is_aa) override {
+    WriteOp(SerializedOp::kClipPath);
+    WritePath(path);
+    WriteEnum(clip_op);
+    Write<uint8_t>(is_aa);
+  }
+
+  void drawColor(DlColor color, DlBlendMode mode) override {
+    WriteOp(SerializedOp::kDrawColor);
+    Write(color.argb());
+    WriteEnum(mode);
+  }
+  void drawPaint() override { WriteOp(SerializedOp::kDrawPaint); }
+  void drawLine(const SkPoint& p0, const SkPoint& p1) override {
+    WriteOp(SerializedOp::kDrawLine);
+    Write(p0);
+    Write(p1);
+  }
+  void drawRect(const SkRect& rect) override {
+    WriteOp(SerializedOp::kDrawRect);
+    Write(rect);
+  }
+  void drawOval(const SkRect& bounds) override {
+    WriteOp(SerializedOp::kDrawOval);
+    Write(bounds);
+  }
+  void drawCircle(const SkPoint& center, SkScalar radius) override {
+    WriteOp(SerializedOp::kDrawCircle);
+    Write(center);
+    Write(radius);
+  }
+  void drawRRect(const SkRRect& rrect) override {
+    WriteOp(SerializedOp::kDrawRRect);
+    WriteRRect(rrect);
+  }
+  void drawDRRect(const SkRRect& outer, const SkRRect& inner) override {
+    WriteOp(SerializedOp::kDrawDRRect);
+    WriteRRect(outer);
+    WriteRRect(inner);
+  }
+  void drawPath(const SkPath& path) override {
+    WriteOp(SerializedOp::kDrawPath);
+    WritePath(path);
+  }
+  void drawArc(const SkRect& oval_bounds,
+               SkScalar start_degrees,
+               SkScalar sweep_degrees,
+               bool use_center) override {
+    WriteOp(SerializedOp::kDrawArc);
+    Write(oval_bounds);
+    Write(start_degrees);
+    Write(sweep_degrees);
+    Write<uint8_t>(use_center);
+  }
+  void drawPoints(PointMode mode,
+                  uint32_t count,
+                  const SkPoint points[]) override {
+    WriteOp(SerializedOp::kDrawPoints);
+    WriteEnum(mode);
+    Write(count);
+    WriteArray(points, count);
+  }
+  void drawVertices(const DlVertices* vertices, DlBlendMode mode) override {
+    WriteOp(SerializedOp::kDrawVertices);
+    WriteEnum(vertices->mode());
+    Write<int32_t>(vertices->vertex_count());
+    Write<int32_t>(vertices->index_count());
+    Write<uint8_t>(vertices->texture_coordinates() != nullptr);
+    Write<uint8_t>(vertices->colors() != nullptr);
+    WriteArray(vertices->vertices(), vertices->vertex_count());
+    if (vertices->texture_coordinates()) {
+      WriteArray(vertices->texture_coordinates(), vertices->vertex_count());
+    }
+    if (vertices->colors()) {
+      WriteArray(vertices->colors(), vertices->vertex_count());
+    }
+    if (vertices->index_count() > 0) {
+      WriteArray(vertices->indices(), vertices->index_count());
+    }
+    WriteEnum(mode);
+  }
+  void drawImage(const sk_sp<DlImage> image,
+                 const SkPoint point,
+                 DlImageSampling sampling,
+                 bool render_with_attributes) override {
+    WriteOp(SerializedOp::kDrawImage);
+    WriteImage(image.get());
+    Write(point);
+    WriteEnum(sampling);
+    Write<uint8_t>(render_with_attributes);
+  }
+  void drawImageRect(const sk_sp<DlImage> image,
+                     const SkRect& src,
+                     const SkRect& dst,
+                     DlImageSampling sampling,
+                     bool render_with_attributes,
+                     SrcRectConstraint constraint) override {
+    WriteOp(SerializedOp::kDrawImageRect);
+    WriteImage(image.get());
+    Write(src);
+    Write(dst);
+    WriteEnum(sampling);
+    Write<uint8_t>(render_with_attributes);
+    WriteEnum(constraint);
+  }
+  void drawImageNine(const sk_sp<DlImage> image,
+                     const SkIRect& center,
+                     const SkRect& dst,
+                     DlFilterMode filter,
+                     bool render_with_attributes) override {
+    WriteOp(SerializedOp::kDrawImageNine);
+    WriteImage(image.get());
+    Write(center);
+    Write(dst);
+    WriteEnum(filter);
+    Write<uint8_t>(render_with_attributes);
+  }
+  void drawAtlas(const sk_sp<DlImage> atlas,
+                 const SkRSXform xform[],
+                 const SkRect tex[],
+                 const DlColor colors[],
+                 int count,
+                 DlBlendMode mode,
+                 DlImageSampling sampling,
+                 const SkRect* cull_rect,
+                 bool render_with_attributes) override {
+    WriteOp(SerializedOp::kDrawAtlas);
+    WriteImage(atlas.get());
+    Write<int32_t>(count);
+    Write<uint8_t>(colors != nullptr);
+    Write<uint8_t>(cull_rect != nullptr);
+    WriteArray(xform, count);
+    WriteArray(tex, count);
+    if (colors) {
+      WriteArray(colors, count);
+    }
+    if (cull_rect) {
+      Write(*cull_rect);
+    }
+    WriteEnum(mode);
+    WriteEnum(sampling);
+    Write<uint8_t>(render_with_attributes);
+  }
+  void drawDisplayList(const sk_sp<DisplayList> display_list,
+                       SkScalar opacity) override {
+    WriteOp(SerializedOp::kDrawDisplayList);
+    auto found = display_lists_.find(display_list.get());
+    if (found != display_lists_.end()) {
+      Write(found->second);
+    } else {
+      Write(kNewReference);
+      WriteDisplayList(*display_list);
+      const uint32_t index = display_lists_.size();
+      display_lists_[display_list.get()] = index;
+    }
+    Write(opacity);
+  }
+  void drawTextBlob(const sk_sp<SkTextBlob> blob,
+                    SkScalar x,
+                    SkScalar y) override {
+    is_valid_ = false;
+  }
+  void drawTextFrame(const std::shared_ptr<impeller::TextFrame>& text_frame,
+                     SkScalar x,
+                     SkScalar y) override {
+    is_valid_ = false;
+  }
+  void drawShadow(const SkPath& path,
+                  const DlColor color,
+                  const SkScalar elevation,
+                  bool transparent_occluder,
+                  SkScalar dpr) override {
+    WriteOp(SerializedOp::kDrawShadow);
+    WritePath(path);
+    Write(color.argb());
+    Write(elevation);
+    Write<uint8_t>(transparent_occluder);
+    Write(dpr);
+  }
+
+ private:
+  std::vector<uint8_t> data_;
+  bool is_valid_ = true;
+
+  std::unordered_map<uint32_t, uint32_t> paths_;
+  std::unordered_map<const DlImage*, uint32_t> images_;
+  std::unordered_map<const DisplayList*, uint32_t> display_lists_;
+  // Attributes are usually stored in the operations that use them, so equal
+  // attributes are not the same object and are deduplicated by value.
+  std::vector<const DlColorSource*> color_sources_;
+  std::vector<const DlColorFilter*> color_filters_;
+  std::vector<const DlImageFilter*> image_filters_;
+  std::vector<const DlMaskFilter*> mask_filters_;
+  std::vector<const DlPathEffect*> path_effects_;
+
+  template <typename T>
+  void Write(const T& value) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    WriteBytes(&value, sizeof(T));
+  }
+
+  void WriteBytes(const void* bytes, size_t size) {
+    const uint8_t* begin = static_cast<const uint8_t*>(bytes);
+    data_.insert(data_.end(), begin, begin + size);
+  }
+
+  void Align(size_t alignment) {
+    data_.resize((data_.size() + alignment - 1) / alignment * alignment, 0);
+  }
+
+  template <typename T>
+  void WriteArray(const T* values, size_t count) {
+    static_assert(alignof(T) <= kArrayAlignment);
+    Align(kArrayAlignment);
+    WriteBytes(values, sizeof(T) * count);
+  }
+
+  template <typename T>
+  void WriteEnum(T value) {
+    Write(static_cast<uint8_t>(value));
+  }
+
+  void WriteOp(SerializedOp op) { WriteEnum(op); }
+
+  void WriteMatrix(const SkMatrix& matrix) {
+    SkScalar values[9];
+    matrix.get9(values);
+    Write(values);
+  }
+
+  void WriteRRect(const SkRRect& rrect) {
+    uint8_t bytes[SkRRect::kSizeInMemory];
+    rrect.writeToMemory(bytes);
+    Write(bytes);
+  }
+
+  void WritePath(const SkPath& path) {
+    // Copies of a path share their generation ID until one of them is
+    // modified.
+    auto found = paths_.find(path.getGenerationID());
+    if (found != paths_.end()) {
+      Write(found->second);
+      return;
+    }
+    Write(kNewReference);
+    const size_t size = path.writeToMemory(nullptr);
+    Write<uint32_t>(size);
+    Align(kArrayAlignment);
+    const size_t offset = data_.size();
+    data_.resize(offset + size);
+    path.writeToMemory(data_.data() + offset);
+    const uint32_t index = paths_.size();
+    paths_[path.getGenerationID()] = index;
+  }
+
+  void WriteImage(const DlImage* image) {
+    auto found = images_.find(image);
+    if (found != images_.end()) {
+      Write(found->second);
+      return;
+    }
+    Write(kNewReference);
+    SkPixmap pixmap;
+    sk_sp<SkImage> sk_image;
+    if (!image->isTextureBacked()) {
+      sk_image = image->skia_image();
+    }
+    if (sk_image && !sk_image->peekPixels(&pixmap)) {
+      // Lazily decoded images have to be decoded to be saved.
+      sk_image = sk_image->makeRasterImage();
+    }
+    if (!sk_image || !sk_image->peekPixels(&pixmap)) {
+      is_valid_ = false;
+      return;
+    }
+    const SkImageInfo& info = pixmap.info();
+    sk_sp<SkData> color_space =
+        info.colorSpace() ? info.colorSpace()->serialize() : nullptr;
+    Write<int32_t>(info.width());
+    Write<int32_t>(info.height());
+    WriteEnum(info.colorType());
+    WriteEnum(info.alphaType());
+    Write<uint32_t>(color_space ? color_space->size() : 0);
+    if (color_space) {
+      WriteBytes(color_space->data(), color_space->size());
+    }
+    Align(kPixelAlignment);
+    for (int y = 0; y < info.height(); y++) {
+      WriteBytes(pixmap.addr(0, y), info.minRowBytes());
+    }
+    const uint32_t index = images_.size();
+    images_[image] = index;
+  }
+
+  // Writes the index of the attribute in |table| that is equal to
+  // |attribute| and returns true, or writes |kNewReference| and returns false
+  // if there is none, in which case the caller has to write its definition
+  // and then add it to the table.
+  template <typename T>
+  bool WriteAttributeReference(const std::vector<const T*>& table,
+                               const T* attribute) {
+    if (!attribute) {
+      Write(kNullReference);
+      return true;
+    }
+    for (size_t i = 0; i < table.size(); i++) {
+      if (*table[i] == *attribute) {
+        Write<uint32_t>(i);
+        return true;
+      }
+    }
+    Write(kNewReference);
+    return false;
+  }
+
+  template <typename T>
+  void WriteGradient(const T* gradient) {
+    Write<uint32_t>(gradient->stop_count());
+    WriteArray(gradient->colors(), gradient->stop_count());
+    WriteArray(gradient->stops(), gradient->stop_count());
+    WriteEnum(gradient->tile_mode());
+    WriteMatrix(gradient->matrix());
+  }
+
+  void WriteColorSource(const DlColorSource* source) {
+    if (WriteAttributeReference(color_sources_, source)) {
+      return;
+    }
+    WriteEnum(source->type());
+    switch (source->type()) {
+      case DlColorSourceType::kColor:
+        Write(source->asColor()->color().argb());
+        break;
+      case DlColorSourceType::kImage: {
+        const DlImageColorSource* image_source = source->asImage();
+        WriteImage(image_source->image().get());
+        WriteEnum(image_source->horizontal_tile_mode());
+        WriteEnum(image_source->vertical_tile_mode());
+        WriteEnum(image_source->sampling());
+        WriteMatrix(image_source->matrix());
+        break;
+      }
+      case DlColorSourceType::kLinearGradient: {
+        const DlLinearGradientColorSource* linear = source->asLinearGradient();
+        Write(linear->start_point());
+        Write(linear->end_point());
+        WriteGradient(linear);
+        break;
+      }
+      case DlColorSourceType::kRadialGradient: {
+        const DlRadialGradientColorSource* radial = source->asRadialGradient();
+        Write(radial->center());
+        Write(radial->radius());
+        WriteGradient(radial);
+        break;
+      }
+      case DlColorSourceType::kConicalGradient: {
+        const DlConicalGradientColorSource* conical =
+            source->asConicalGradient();
+        Write(conical->start_center());
+        Write(conical->start_radius());
+        Write(conical->end_center());
+        Write(conical->end_radius());
+        WriteGradient(conical);
+        break;
+      }
+      case DlColorSourceType::kSweepGradient: {
+        const DlSweepGradientColorSource* sweep = source->asSweepGradient();
+        Write(sweep->center());
+        Write(sweep->start());
+        Write(sweep->end());
+        WriteGradient(sweep);
+        break;
+      }
+      default:
+        is_valid_ = false;
+        return;
+    }
+    color_sources_.push_back(source);
+  }
+
+  void WriteColorFilter(const DlColorFilter* filter) {
+    if (WriteAttributeReference(color_filters_, filter)) {
+      return;
+    }
+    WriteEnum(filter->type());
+    switch (filter->type()) {
+      case DlColorFilterType::kBlend:
+        Write(filter->asBlend()->color().argb());
+        WriteEnum(filter->asBlend()->mode());
+        break;
+      case DlColorFilterType::kMatrix: {
+        float matrix[20];
+        filter->asMatrix()->get_matrix(matrix);
+        Write(matrix);
+        break;
+      }
+      case DlColorFilterType::kSrgbToLinearGamma:
+      case DlColorFilterType::kLinearToSrgbGamma:
+        break;
+    }
+    color_filters_.push_back(filter);
+  }
+
+  void WriteImageFilter(const DlImageFilter* filter) {
+    if (WriteAttributeReference(image_filters_, filter)) {
+      return;
+    }
+    WriteEnum(filter->type());
+    switch (filter->type()) {
+      case DlImageFilterType::kBlur:
+        Write(filter->asBlur()->sigma_x());
+        Write(filter->asBlur()->sigma_y());
+        WriteEnum(filter->asBlur()->tile_mode());
+        break;
+      case DlImageFilterType::kDilate:
+        Write(filter->asDilate()->radius_x());
+        Write(filter->asDilate()->radius_y());
+        break;
+      case DlImageFilterType::kErode:
+        Write(filter->asErode()->radius_x());
+        Write(filter->asErode()->radius_y());
+        break;
+      case DlImageFilterType::kMatrix:
+        WriteMatrix(filter->asMatrix()->matrix());
+        WriteEnum(filter->asMatrix()->sampling());
+        break;
+      case DlImageFilterType::kCompose:
+        WriteImageFilter(filter->asCompose()->outer().get());
+        WriteImageFilter(filter->asCompose()->inner().get());
+        break;
+      case DlImageFilterType::kColorFilter:
+        WriteColorFilter(filter->asColorFilter()->color_filter().get());
+        break;
+      case DlImageFilterType::kLocalMatrix:
+        WriteMatrix(filter->asLocalMatrix()->matrix());
+        WriteImageFilter(filter->asLocalMatrix()->image_filter().get());
+        break;
+    }
+    image_filters_.push_back(filter);
+  }
+
+  void WriteMaskFilter(const DlMaskFilter* filter) {
+    if (WriteAttributeReference(mask_filters_, filter)) {
+      return;
+    }
+    WriteEnum(filter->type());
+    switch (filter->type()) {
+      case DlMaskFilterType::kBlur:
+        WriteEnum(filter->asBlur()->style());
+        Write(filter->asBlur()->sigma());
+        Write<uint8_t>(filter->asBlur()->respectCTM());
+        break;
+    }
+    mask_filters_.push_back(filter);
+  }
+
+  void WritePathEffect(const DlPathEffect* effect) {
+    if (WriteAttributeReference(path_effects_, effect)) {
+      return;
+    }
+    WriteEnum(effect->type());
+    switch (effect->type()) {
+      case DlPathEffectType::kDash:
+        Write<int32_t>(effect->asDash()->count());
+        WriteArray(effect->asDash()->intervals(), effect->asDash()->count());
+        Write(effect->asDash()->phase());
+        break;
+    }
+    path_effects_.push_back(effect);
+  }
+};
+
+}  // namespace
+
+// Reads a byte stream written by |DlSerializationWriter| and replays it into
+// DisplayListBuilders. Any malformed data fails the whole read.
+class DlSerializationReader {
+ public:
+  explicit DlSerializationReader(std::shared_ptr<const fml::Mapping> mapping)
+      : mapping_(std::move(mapping)),
+        data_(mapping_->GetMapping()),
+        size_(mapping_->GetSize()) {}
+
+  sk_sp<DisplayList> ReadAll() {
+    SerializedHeader header;
+    if (!Read(&header) || header.magic != DlSerialization::kMagic ||
+        header.version != DlSerialization::kVersion) {
+      return nullptr;
+    }
+    sk_sp<DisplayList> display_list = ReadDisplayList();
+    if (offset_ != size_) {
+      return nullptr;
+    }
+    return display_list;
+  }
+
+ private:
+  const std::shared_ptr<const fml::Mapping> mapping_;
+  const uint8_t* data_;
+  const size_t size_;
+  size_t offset_ = 0;
+  int depth_ = 0;
+
+  // Arrays that had to be copied because the mapping isn't aligned, which
+  // are only needed until the operation that uses them has been replayed.
+  std::deque<std::vector<uint8_t>> copies_;
+
+  std::vector<SkPath> paths_;
+  std::vector<sk_sp<DlImage>> images_;
+  std::vector<sk_sp<DisplayList>> display_lists_;
+  std::vector<std::shared_ptr<DlColorSource>> color_sources_;
+  std::vector<std::shared_ptr<const DlColorFilter>> color_filters_;
+  std::vector<std::shared_ptr<DlImageFilter>> image_filters_;
+  std::vector<std::shared_ptr<DlMaskFilter>> mask_filters_;
+  std::vector<std::shared_ptr<DlPathEffect>> path_effects_;
+
+  class NestingScope {
+   public:
+    explicit NestingScope(int& depth) : depth_(++depth) {}
+    ~NestingScope() { --depth_; }
+    bool is_too_deep() const { return depth_ > kMaxNestingDepth; }
+
+   private:
+    int& depth_;
+  };
+
+  template <typename T>
+  bool Read(T* value) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    const void* bytes = ReadBytes(sizeof(T), 1);
+    if (!bytes) {
+      return false;
+    }
+    memcpy(value, bytes, sizeof(T));
+    return true;
+  }
+
+  // Returns a pointer to the next |size| bytes at |alignment| relative to the
+  // start of the data, or nullptr if there aren't enough of them.
+  const uint8_t* ReadBytes(size_t size, size_t alignment) {
+    const size_t offset = (offset_ + alignment - 1) / alignment * alignment;
+    if (offset > size_ || size > size_ - offset) {
+      return nullptr;
+    }
+    offset_ = offset + size;
+    return data_ + offset;
+  }
+
+  template <typename T>
+  bool ReadArray(size_t count, const T** values) {
+    if (count > (size_ - offset_) / sizeof(T)) {
+      return false;
+    }
+    const size_t size = sizeof(T) * count;
+    const uint8_t* bytes = ReadBytes(size, kArrayAlignment);
+    if (!bytes) {
+      return false;
+    }
+    if (reinterpret_cast<uintptr_t>(bytes) % alignof(T) != 0) {
+      bytes = copies_.emplace_back(bytes, bytes + size).data();
+    }
+    *values = reinterpret_cast<const T*>(bytes);
+    return true;
+  }
+
+  template <typename T>
+  bool ReadEnum(T* value, T last) {
+    uint8_t raw;
+    if (!Read(&raw) || raw > static_cast<uint8_t>(last)) {
+      return false;
+    }
+    *value = static_cast<T>(raw);
+    return true;
+  }
+
+  bool ReadBool(bool* value) {
+    uint8_t raw;
+    if (!Read(&raw) || raw > 1) {
+      return false;
+    }
+    *value = raw;
+    return true;
+  }
+
+  bool ReadColor(DlColor* color) {
+    uint32_t argb;
+    if (!Read(&argb)) {
+      return false;
+    }
+    *color = DlColor(argb);
+    return true;
+  }
+
+  bool ReadMatrix(SkMatrix* matrix) {
+    SkScalar values[9];
+    if (!Read(&values)) {
+      return false;
+    }
+    matrix->set9(values);
+    return true;
+  }
+
+  bool ReadRRect(SkRRect* rrect) {
+    uint8_t bytes[SkRRect::kSizeInMemory];
+    return Read(&bytes) &&
+           rrect->readFromMemory(bytes, sizeof(bytes)) == sizeof(bytes);
+  }
+
+  // Reads a reference to an object of |table|, calling |read_definition| to
+  // read the object and adding it to the table if this is its first use.
+  template <typename T, typename F>
+  bool ReadReference(std::vector<T>& table, T* object, F read_definition) {
+    uint32_t index;
+    if (!Read(&index)) {
+      return false;
+    }
+    if (index == kNullReference) {
+      *object = nullptr;
+      return true;
+    }
+    if (index != kNewReference) {
+      if (index >= table.size()) {
+        return false;
+      }
+      *object = table[index];
+      return true;
+    }
+    NestingScope scope(depth_);
+    if (scope.is_too_deep() || !read_definition(object) || !*object) {
+      return false;
+    }
+    table.push_back(*object);
+    return true;
+  }
+
+  bool ReadPath(const SkPath** path) {
+    uint32_t index;
+    if (!Read(&index)) {
+      return false;
+    }
+    if (index != kNewReference) {
+      if (index >= paths_.size()) {
+        return false;
+      }
+      *path = &paths_[index];
+      return true;
+    }
+    uint32_t size;
+    const uint8_t* bytes;
+    if (!Read(&size) || !ReadArray(size, &bytes)) {
+      return false;
+    }
+    SkPath& new_path = paths_.emplace_back();
+    if (new_path.readFromMemory(bytes, size) != size) {
+      return false;
+    }
+    *path = &new_path;
+    return true;
+  }
+
+  bool ReadImage(sk_sp<DlImage>* result) {
+    return ReadReference(images_, result, [this](sk_sp<DlImage>* image) {
+      int32_t width;
+      int32_t height;
+      uint8_t color_type;
+      uint8_t alpha_type;
+      uint32_t color_space_size;
+      if (!Read(&width) || !Read(&height) || !Read(&color_type) ||
+          !Read(&alpha_type) || !Read(&color_space_size) ||
+          color_type > kLastEnum_SkColorType ||
+          alpha_type > kLastEnum_SkAlphaType) {
+        return false;
+      }
+      sk_sp<SkColorSpace> color_space;
+      if (color_space_size > 0) {
+        const uint8_t* bytes = ReadBytes(color_space_size, 1);
+        if (bytes) {
+          color_space = SkColorSpace::Deserialize(bytes, color_space_size);
+        }
+        if (!color_space) {
+          return false;
+        }
+      }
+      SkImageInfo info = SkImageInfo::Make(
+          width, height, static_cast<SkColorType>(color_type),
+          static_cast<SkAlphaType>(alpha_type), std::move(color_space));
+      if (info.isEmpty() || !info.validRowBytes(info.minRowBytes())) {
+        return false;
+      }
+      const size_t size = info.computeMinByteSize();
+      if (SkImageInfo::ByteSizeOverflowed(size)) {
+        return false;
+      }
+      const uint8_t* pixels = ReadBytes(size, kPixelAlignment);
+      if (!pixels) {
+        return false;
+      }
+      sk_sp<SkData> data;
+      if (reinterpret_cast<uintptr_t>(pixels) % info.bytesPerPixel() == 0) {
+        // The pixels are used in place and keep the mapping alive.
+        data = SkData::MakeWithProc(
+            pixels, size,
+            [](const void* ptr, void* context) {
+              delete static_cast<std::shared_ptr<const fml::Mapping>*>(
+                  context);
+            },
+            new std::shared_ptr<const fml::Mapping>(mapping_));
+      } else {
+        data = SkData::MakeWithCopy(pixels, size);
+      }
+      sk_sp<SkImage> sk_image =
+          SkImages::RasterFromData(info, std::move(data), info.minRowBytes());
+      *image = sk_image ? DlImage::Make(std::move(sk_image)) : nullptr;
+      return true;
+    });
+  }
+
+  bool ReadGradientStops(uint32_t* stop_count,
+                         const DlColor** colors,
+                         const float** stops,
+                         DlTileMode* tile_mode,
+                         SkMatrix* matrix) {
+    return Read(stop_count) && ReadArray(*stop_count, colors) &&
+           ReadArray(*stop_count, stops) &&
+           ReadEnum(tile_mode, DlTileMode::kDecal) && ReadMatrix(matrix);
+  }
+
+  bool ReadColorSource(std::shared_ptr<DlColorSource>* result) {
+    return ReadReference(
+        color_sources_, result, [this](std::shared_ptr<DlColorSource>* source) {
+          DlColorSourceType type;
+          if (!ReadEnum(&type, DlColorSourceType::kSweepGradient)) {
+            return false;
+          }
+          uint32_t stop_count;
+          const DlColor* colors;
+          const float* stops;
+          DlTileMode tile_mode;
+          SkMatrix matrix;
+          switch (type) {
+            case DlColorSourceType::kColor: {
+              DlColor color;
+              if (!ReadColor(&color)) {
+                return false;
+              }
+              *source = std::make_shared<DlColorColorSource>(color);
+              return true;
+            }
+            case DlColorSourceType::kImage: {
+              sk_sp<DlImage> image;
+              DlTileMode vertical_tile_mode;
+              DlImageSampling sampling;
+              if (!ReadImage(&image) || !image ||
+                  !ReadEnum(&tile_mode, DlTileMode::kDecal) ||
+                  !ReadEnum(&vertical_tile_mode, DlTileMode::kDecal) ||
+                  !ReadEnum(&sampling, DlImageSampling::kCubic) ||
+                  !ReadMatrix(&matrix)) {
+                return false;
+              }
+              *source = std::make_shared<DlImageColorSource>(
+                  std::move(image), tile_mode, vertical_tile_mode, sampling,
+                  &matrix);
+              return true;
+            }
+            case DlColorSourceType::kLinearGradient: {
+              SkPoint start_point;
+              SkPoint end_point;
+              if (!Read(&start_point) || !Read(&end_point) ||
+                  !ReadGradientStops(
+                      &stop_count, &colors, &stops, &tile_mode, &matrix)) {
+                return false;
+              }
+              *source = DlColorSource::MakeLinear(start_point, end_point,
+                                                  stop_count, colors, stops,
+                                                  tile_mode, &matrix);
+              return true;
+            }
+            case DlColorSourceType::kRadialGradient: {
+              SkPoint center;
+              SkScalar radius;
+              if (!Read(&center) || !Read(&radius) ||
+                  !ReadGradientStops(
+                      &stop_count, &colors, &stops, &tile_mode, &matrix)) {
+                return false;
+              }
+              *source =
+                  DlColorSource::MakeRadial(center, radius, stop_count, colors,
+                                            stops, tile_mode, &matrix);
+              return true;
+            }
+            case DlColorSourceType::kConicalGradient: {
+              SkPoint start_center;
+              SkScalar start_radius;
+              SkPoint end_center;
+              SkScalar end_radius;
+              if (!Read(&start_center) || !Read(&start_radius) ||
+                  !Read(&end_center) || !Read(&end_radius) ||
+                  !ReadGradientStops(
+                      &stop_count, &colors, &stops, &tile_mode, &matrix)) {
+                return false;
+              }
+              *source = DlColorSource::MakeConical(
+                  start_center, start_radius, end_center, end_radius,
+                  stop_count, colors, stops, tile_mode, &matrix);
+              return true;
+            }
+            case DlColorSourceType::kSweepGradient: {
+              SkPoint center;
+              SkScalar start;
+              SkScalar end;
+              if (!Read(&center) || !Read(&start) || !Read(&end) ||
+                  !ReadGradientStops(
+                      &stop_count, &colors, &stops, &tile_mode, &matrix)) {
+                return false;
+              }
+              *source = DlColorSource::MakeSweep(center, start, end,
+                                                 stop_count, colors, stops,
+                                                 tile_mode, &matrix);
+              return true;
+            }
+            default:
+              return false;
+          }
+        });
+  }
+
+  bool ReadColorFilter(std::shared_ptr<const DlColorFilter>* result) {
+    return ReadReference(
+        color_filters_, result,
+        [this](std::shared_ptr<const DlColorFilter>* filter) {
+          DlColorFilterType type;
+          if (!ReadEnum(&type, DlColorFilterType::kLinearToSrgbGamma)) {
+            return false;
+          }
+          switch (type) {
+            case DlColorFilterType::kBlend: {
+              DlColor color;
+              DlBlendMode mode;
+              if (!ReadColor(&color) ||
+                  !ReadEnum(&mode, DlBlendMode::kLastMode)) {
+                return false;
+              }
+              *filter = std::make_shared<DlBlendColorFilter>(color, mode);
+              return true;
+            }
+            case DlColorFilterType::kMatrix: {
+              float matrix[20];
+              if (!Read(&matrix)) {
+                return false;
+              }
+              *filter = std::make_shared<DlMatrixColorFilter>(matrix);
+              return true;
+            }
+            case DlColorFilterType::kSrgbToLinearGamma:
+              *filter = DlSrgbToLinearGammaColorFilter::kInstance;
+              return true;
+            case DlColorFilterType::kLinearToSrgbGamma:
+              *filter = DlLinearToSrgbGammaColorFilter::kInstance;
+              return true;
+          }
+          FML_UNREACHABLE();
+        });
+  }
+
+  bool ReadImageFilter(std::shared_ptr<DlImageFilter>* result) {
+    return ReadReference(
+        image_filters_, result, [this](std::shared_ptr<DlImageFilter>* filter) {
+          DlImageFilterType type;
+          if (!ReadEnum(&type, DlImageFilterType::kLocalMatrix)) {
+            return false;
+          }
+          SkScalar x;
+          SkScalar y;
+          SkMatrix matrix;
+          switch (type) {
+            case DlImageFilterType::kBlur: {
+              DlTileMode tile_mode;
+              if (!Read(&x) || !Read(&y) ||
+                  !ReadEnum(&tile_mode, DlTileMode::kDecal)) {
+                return false;
+              }
+              *filter = std::make_shared<DlBlurImageFilter>(x, y, tile_mode);
+              return true;
+            }
+            case DlImageFilterType::kDilate:
+              if (!Read(&x) || !Read(&y)) {
+                return false;
+              }
+              *filter = std::make_shared<DlDilateImageFilter>(x, y);
+              return true;
+            case DlImageFilterType::kErode:
+              if (!Read(&x) || !Read(&y)) {
+                return false;
+              }
+              *filter = std::make_shared<DlErodeImageFilter>(x, y);
+              return true;
+            case DlImageFilterType::kMatrix: {
+              DlImageSampling sampling;
+              if (!ReadMatrix(&matrix) ||
+                  !ReadEnum(&sampling, DlImageSampling::kCubic)) {
+                return false;
+              }
+              *filter = std::make_shared<DlMatrixImageFilter>(matrix, sampling);
+              return true;
+            }
+            case DlImageFilterType::kCompose: {
+              std::shared_ptr<DlImageFilter> outer;
+              std::shared_ptr<DlImageFilter> inner;
+              if (!ReadImageFilter(&outer) || !outer ||
+                  !ReadImageFilter(&inner) || !inner) {
+                return false;
+              }
+              *filter = std::make_shared<DlComposeImageFilter>(
+                  std::move(outer), std::move(inner));
+              return true;
+            }
+            case DlImageFilterType::kColorFilter: {
+              std::shared_ptr<const DlColorFilter> color_filter;
+              if (!ReadColorFilter(&color_filter) || !color_filter) {
+                return false;
+              }
+              *filter = std::make_shared<DlColorFilterImageFilter>(
+                  std::move(color_filter));
+              return true;
+            }
+            case DlImageFilterType::kLocalMatrix: {
+              std::shared_ptr<DlImageFilter> image_filter;
+              if (!ReadMatrix(&matrix) || !ReadImageFilter(&image_filter) ||
+                  !image_filter) {
+                return false;
+              }
+              *filter = std::make_shared<DlLocalMatrixImageFilter>(
+                  matrix, std::move(image_filter));
+              return true;
+            }
+          }
+          FML_UNREACHABLE();
+        });
+  }
+
+  bool ReadMaskFilter(std::shared_ptr<DlMaskFilter>* result) {
+    return ReadReference(
+        mask_filters_, result, [this](std::shared_ptr<DlMaskFilter>* filter) {
+          DlMaskFilterType type;
+          DlBlurStyle style;
+          SkScalar sigma;
+          bool respect_ctm;
+          if (!ReadEnum(&type, DlMaskFilterType::kBlur) ||
+              !ReadEnum(&style, DlBlurStyle::kInner) || !Read(&sigma) ||
+              !ReadBool(&respect_ctm)) {
+            return false;
+          }
+          *filter =
+              std::make_shared<DlBlurMaskFilter>(style, sigma, respect_ctm);
+          return true;
+        });
+  }
+
+  bool ReadPathEffect(std::shared_ptr<DlPathEffect>* result) {
+    return ReadReference(
+        path_effects_, result, [this](std::shared_ptr<DlPathEffect>* effect) {
+          DlPathEffectType type;
+          int32_t count;
+          const SkScalar* intervals;
+          SkScalar phase;
+          if (!ReadEnum(&type, DlPathEffectType::kDash) || !Read(&count) ||
+              count < 0 || !ReadArray(count, &intervals) || !Read(&phase)) {
+            return false;
+          }
+          *effect = DlDashPathEffect::Make(intervals, count, phase);
+          return true;
+        });
+  }
+
+  bool ReadDisplayListReference(sk_sp<DisplayList>* result) {
+    return ReadReference(display_lists_, result,
+                         [this](sk_sp<DisplayList>* display_list) {
+                           *display_list = ReadDisplayList();
+                           return true;
+                         });
+  }
+
+  sk_sp<DisplayList> ReadDisplayList() {
+    bool has_rtree;
+    if (!ReadBool(&has_rtree)) {
+      return nullptr;
+    }
+    DisplayListBuilder builder(has_rtree);
+    DlOpReceiver& receiver = builder.asReceiver();
+    while (true) {
+      SerializedOp op;
+      if (!ReadEnum(&op, SerializedOp::kLastOp)) {
+        return nullptr;
+      }
+      if (op == SerializedOp::kEnd) {
+        break;
+      }
+      if (!ReadOp(op, receiver)) {
+        return nullptr;
+      }
+      copies_.clear();
+    }
+    return builder.Build();
+  }
+
+  bool ReadOp(SerializedOp op, DlOpReceiver& receiver) {
+    using ClipOp = DlCanvas::ClipOp;
+    using PointMode = DlCanvas::PointMode;
+    using SrcRectConstraint = DlCanvas::SrcRectConstraint;
+
+    bool flag;
+    SkScalar scalar;
+    DlColor color;
+    DlBlendMode mode;
+    SkRect rect;
+    SkRRect rrect;
+    const SkPath* path;
+    ClipOp clip_op;
+    sk_sp<DlImage> image;
+    DlImageSampling sampling;
+    bool render_with_attributes;
+
+    switch (op) {
+      case SerializedOp::kEnd:
+        return false;
+
+      case SerializedOp::kSetAntiAlias:
+        if (!ReadBool(&flag)) {
+          return false;
+        }
+        receiver.setAntiAlias(flag);
+        return true;
+      case SerializedOp::kSetDrawStyle: {
+        DlDrawStyle style;
+        if (!ReadEnum(&style, DlDrawStyle::kLastStyle)) {
+          return false;
+        }
+        receiver.setDrawStyle(style);
+        return true;
+      }
+      case SerializedOp::kSetColor:
+        if (!ReadColor(&color)) {
+          return false;
+        }
+        receiver.setColor(color);
+        return true;
+      case SerializedOp::kSetStrokeWidth:
+        if (!Read(&scalar)) {
+          return false;
+        }
+        receiver.setStrokeWidth(scalar);
+        return true;
+      case SerializedOp::kSetStrokeMiter:
+        if (!Read(&scalar)) {
+          return false;
+        }
+        receiver.setStrokeMiter(scalar);
+        return true;
+      case SerializedOp::kSetStrokeCap: {
+        DlStrokeCap cap;
+        if (!ReadEnum(&cap, DlStrokeCap::kLastCap)) {
+          return false;
+        }
+        receiver.setStrokeCap(cap);
+        return true;
+      }
+      case SerializedOp::kSetStrokeJoin: {
+        DlStrokeJoin join;
+        if (!ReadEnum(&join, DlStrokeJoin::kLastJoin)) {
+          return false;
+        }
+        receiver.setStrokeJoin(join);
+        return true;
+      }
+      case SerializedOp::kSetColorSource: {
+        std::shared_ptr<DlColorSource> source;
+        if (!ReadColorSource(&source)) {
+          return false;
+        }
+        receiver.setColorSource(source.get());
+        return true;
+      }
+      case SerializedOp::kSetColorFilter: {
+        std::shared_ptr<const DlColorFilter> filter;
+        if (!ReadColorFilter(&filter)) {
+          return false;
+        }
+        receiver.setColorFilter(filter.get());
+        return true;
+      }
+      case SerializedOp::kSetInvertColors:
+        if (!ReadBool(&flag)) {
+          return false;
+        }
+        receiver.setInvertColors(flag);
+        return true;
+      case SerializedOp::kSetBlendMode:
+        if (!ReadEnum(&mode, DlBlendMode::kLastMode)) {
+          return false;
+        }
+        receiver.setBlendMode(mode);
+        return true;
+      case SerializedOp::kSetPathEffect: {
+        std::shared_ptr<DlPathEffect> effect;
+        if (!ReadPathEffect(&effect)) {
+          return false;
+        }
+        receiver.setPathEffect(effect.get());
+        return true;
+      }
+      case SerializedOp::kSetMaskFilter: {
+        std::shared_ptr<DlMaskFilter> filter;
+        if (!ReadMaskFilter(&filter)) {
+          return false;
+        }
+        receiver.setMaskFilter(filter.get());
+        return true;
+      }
+      case SerializedOp::kSetImageFilter: {
+        std::shared_ptr<DlImageFilter> filter;
+        if (!ReadImageFilter(&filter)) {
+          return false;
+        }
+        receiver.setImageFilter(filter.get());
+        return true;
+      }
+
+      case SerializedOp::kSave:
+        receiver.save();
+        return true;
+      case SerializedOp::kSaveLayer: {
+        bool bounds_from_caller;
+        std::shared_ptr<DlImageFilter> backdrop;
+        if (!Read(&rect) || !ReadBool(&render_with_attributes) ||
+            !ReadBool(&bounds_from_caller) || !ReadImageFilter(&backdrop)) {
+          return false;
+        }
+        SaveLayerOptions options = render_with_attributes
+                                       ? SaveLayerOptions::kWithAttributes
+                                       : SaveLayerOptions::kNoAttributes;
+        options = bounds_from_caller ? options.with_bounds_from_caller()
+                                     : options.without_bounds_from_caller();
+        receiver.saveLayer(rect, options, backdrop.get());
+        return true;
+      }
+      case SerializedOp::kRestore:
+        receiver.restore();
+        return true;
+
+      case SerializedOp::kTranslate:
+      case SerializedOp::kScale:
+      case SerializedOp::kSkew: {
+        SkScalar x;
+        SkScalar y;
+        if (!Read(&x) || !Read(&y)) {
+          return false;
+        }
+        if (op == SerializedOp::kTranslate) {
+          receiver.translate(x, y);
+        } else if (op == SerializedOp::kScale) {
+          receiver.scale(x, y);
+        } else {
+          receiver.skew(x, y);
+        }
+        return true;
+      }
+      case SerializedOp::kRotate:
+        if (!Read(&scalar)) {
+          return false;
+        }
+        receiver.rotate(scalar);
+        return true;
+      case SerializedOp::kTransform2DAffine: {
+        SkScalar m[6];
+        if (!Read(&m)) {
+          return false;
+        }
+        receiver.transform2DAffine(m[0], m[1], m[2], m[3], m[4], m[5]);
+        return true;
+      }
+      case SerializedOp::kTransformFullPerspective: {
+        SkScalar m[16];
+        if (!Read(&m)) {
+          return false;
+        }
+        receiver.transformFullPerspective(m[0], m[1], m[2], m[3],    //
+                                          m[4], m[5], m[6], m[7],    //
+                                          m[8], m[9], m[10], m[11],  //
+                                          m[12], m[13], m[14], m[15]);
+        return true;
+      }
+      case SerializedOp::kTransformReset:
+        receiver.transformReset();
+        return true;
+
+      case SerializedOp::kClipRect:
+        if (!Read(&rect) || !ReadEnum(&clip_op, ClipOp::kIntersect) ||
+            !ReadBool(&flag)) {
+          return false;
+        }
+        receiver.clipRect(rect, clip_op, flag);
+        return true;
+      case SerializedOp::kClipRRect:
+        if (!ReadRRect(&rrect) || !ReadEnum(&clip_op, ClipOp::kIntersect) ||
+            !ReadBool(&flag)) {
+          return false;
+        }
+        receiver.clipRRect(rrect, clip_op, flag);
+        return true;
+      case SerializedOp::kClipPath:
+        if (!ReadPath(&path) || !ReadEnum(&clip_op, ClipOp::kIntersect) ||
+            !ReadBool(&flag)) {
+          return false;
+        }
+        receiver.clipPath(*path, clip_op, flag);
+        return true;
+
+      case SerializedOp::kDrawColor:
+        if (!ReadColor(&color) || !ReadEnum(&mode, DlBlendMode::kLastMode)) {
+          return false;
+        }
+        receiver.drawColor(color, mode);
+        return true;
+      case SerializedOp::kDrawPaint:
+        receiver.drawPaint();
+        return true;
+      case SerializedOp::kDrawLine: {
+        SkPoint p0;
+        SkPoint p1;
+        if (!Read(&p0) || !Read(&p1)) {
+          return false;
+        }
+        receiver.drawLine(p0, p1);
+        return true;
+      }
+      case SerializedOp::kDrawRect:
+        if (!Read(&rect)) {
+          return false;
+        }
+        receiver.drawRect(rect);
+        return true;
+      case SerializedOp::kDrawOval:
+        if (!Read(&rect)) {
+          return false;
+        }
+        receiver.drawOval(rect);
+        return true;
+      case SerializedOp::kDrawCircle: {
+        SkPoint center;
+        if (!Read(&center) || !Read(&scalar)) {
+          return false;
+        }
+        receiver.drawCircle(center, scalar);
+        return true;
+      }
+      case SerializedOp::kDrawRRect:
+        if (!ReadRRect(&rrect)) {
+          return false;
+        }
+        receiver.drawRRect(rrect);
+        return true;
+      case SerializedOp::kDrawDRRect: {
+        SkRRect inner;
+        if (!ReadRRect(&rrect) || !ReadRRect(&inner)) {
+          return false;
+        }
+        receiver.drawDRRect(rrect, inner);
+        return true;
+      }
+      case SerializedOp::kDrawPath:
+        if (!ReadPath(&path)) {
+          return false;
+        }
+        receiver.drawPath(*path);
+        return true;
+      case SerializedOp::kDrawArc: {
+        SkScalar start_degrees;
+        SkScalar sweep_degrees;
+        if (!Read(&rect) || !Read(&start_degrees) || !Read(&sweep_degrees) ||
+            !ReadBool(&flag)) {
+          return false;
+        }
+        receiver.drawArc(rect, start_degrees, sweep_degrees, flag);
+        return true;
+      }
+      case SerializedOp::kDrawPoints: {
+        PointMode point_mode;
+        uint32_t count;
+        const SkPoint* points;
+        if (!ReadEnum(&point_mode, PointMode::kPolygon) || !Read(&count) ||
+            count > DlOpReceiver::kMaxDrawPointsCount ||
+            !ReadArray(count, &points)) {
+          return false;
+        }
+        receiver.drawPoints(point_mode, count, points);
+        return true;
+      }
+      case SerializedOp::kDrawVertices: {
+        DlVertexMode vertex_mode;
+        int32_t vertex_count;
+        int32_t index_count;
+        bool has_texture_coordinates;
+        bool has_colors;
+        const SkPoint* vertices;
+        const SkPoint* texture_coordinates = nullptr;
+        const DlColor* colors = nullptr;
+        const uint16_t* indices = nullptr;
+        if (!ReadEnum(&vertex_mode, DlVertexMode::kTriangleFan) ||
+            !Read(&vertex_count) || !Read(&index_count) ||
+            !ReadBool(&has_texture_coordinates) || !ReadBool(&has_colors) ||
+            vertex_count < 0 || index_count < 0 ||
+            !ReadArray(vertex_count, &vertices) ||
+            (has_texture_coordinates &&
+             !ReadArray(vertex_count, &texture_coordinates)) ||
+            (has_colors && !ReadArray(vertex_count, &colors)) ||
+            (index_count > 0 && !ReadArray(index_count, &indices)) ||
+            !ReadEnum(&mode, DlBlendMode::kLastMode)) {
+          return false;
+        }
+        auto dl_vertices =
+            DlVertices::Make(vertex_mode, vertex_count, vertices,
+                             texture_coordinates, colors, index_count, indices);
+        receiver.drawVertices(dl_vertices.get(), mode);
+        return true;
+      }
+      case SerializedOp::kDrawImage: {
+        SkPoint point;
+        if (!ReadImage(&image) || !image || !Read(&point) ||
+            !ReadEnum(&sampling, DlImageSampling::kCubic) ||
+            !ReadBool(&render_with_attributes)) {
+          return false;
+        }
+        receiver.drawImage(image, point, sampling, render_with_attributes);
+        return true;
+      }
+      case SerializedOp::kDrawImageRect: {
+        SkRect src;
+        SrcRectConstraint constraint;
+        if (!ReadImage(&image) || !image || !Read(&src) || !Read(&rect) ||
+            !ReadEnum(&sampling, DlImageSampling::kCubic) ||
+            !ReadBool(&render_with_attributes) ||
+            !ReadEnum(&constraint, SrcRectConstraint::kFast)) {
+          return false;
+        }
+        receiver.drawImageRect(image, src, rect, sampling,
+                               render_with_attributes, constraint);
+        return true;
+      }
+      case SerializedOp::kDrawImageNine: {
+        SkIRect center;
+        DlFilterMode filter;
+        if (!ReadImage(&image) || !image || !Read(&center) || !Read(&rect) ||
+            !ReadEnum(&filter, DlFilterMode::kLast) ||
+            !ReadBool(&render_with_attributes)) {
+          return false;
+        }
+        receiver.drawImageNine(image, center, rect, filter,
+                               render_with_attributes);
+        return true;
+      }
+      case SerializedOp::kDrawAtlas: {
+        int32_t count;
+        bool has_colors;
+        bool has_cull_rect;
+        const SkRSXform* xforms;
+        const SkRect* tex;
+        const DlColor* colors = nullptr;
+        if (!ReadImage(&image) || !image || !Read(&count) || count < 0 ||
+            !ReadBool(&has_colors) || !ReadBool(&has_cull_rect) ||
+            !ReadArray(count, &xforms) || !ReadArray(count, &tex) ||
+            (has_colors && !ReadArray(count, &colors)) ||
+            (has_cull_rect && !Read(&rect)) ||
+            !ReadEnum(&mode, DlBlendMode::kLastMode) ||
+            !ReadEnum(&sampling, DlImageSampling::kCubic) ||
+            !ReadBool(&render_with_attributes)) {
+          return false;
+        }
+        receiver.drawAtlas(image, xforms, tex, colors, count, mode, sampling,
+                           has_cull_rect ? &rect : nullptr,
+                           render_with_attributes);
+        return true;
+      }
+      case SerializedOp::kDrawDisplayList: {
+        sk_sp<DisplayList> display_list;
+        if (!ReadDisplayListReference(&display_list) || !display_list ||
+            !Read(&scalar)) {
+          return false;
+        }
+        receiver.drawDisplayList(display_list, scalar);
+        return true;
+      }
+      case SerializedOp::kDrawShadow: {
+        SkScalar elevation;
+        SkScalar dpr;
+        if (!ReadPath(&path) || !ReadColor(&color) || !Read(&elevation) ||
+            !ReadBool(&flag) || !Read(&dpr)) {
+          return false;
+        }
+        receiver.drawShadow(*path, color, elevation, flag, dpr);
+        return true;
+      }
+    }
+    return false;
+  }
+};
+
+std::unique_ptr<fml::Mapping> DlSerialization::Serialize(
+    const DisplayList& display_list) {
+  TRACE_EVENT0("flutter", "DlSerialization::Serialize");
+  DlSerializationWriter writer;
+  writer.WriteDisplayList(display_list);
+  if (!writer.is_valid()) {
+    return nullptr;
+  }
+  return std::make_unique<fml::DataMapping>(writer.TakeData());
+}
+
+sk_sp<DisplayList> DlSerialization::Deserialize(
+    const std::shared_ptr<const fml::Mapping>& mapping) {
+  TRACE_EVENT0("flutter", "DlSerialization::Deserialize");
+  if (!mapping || !mapping->GetMapping()) {
+    return nullptr;
+  }
+  return DlSerializationReader(mapping).ReadAll();
+}
+
+}  // namespace flutter
@@ -0,0 +1,61 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_DISPLAY_LIST_UTILS_DL_SERIALIZATION_H_
+#define FLUTTER_DISPLAY_LIST_UTILS_DL_SERIALIZATION_H_
+
+#include <cstdint>
+#include <memory>
+
+#include "flutter/display_list/display_list.h"
+#include "flutter/fml/mapping.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief      Saves DisplayLists to and loads them from a compact binary
+///             format, for example to capture frames of an application and
+///             replay them in a benchmark.
+///
+///             The format is a header followed by the operations of the list
+///             in the order they are dispatched. Paths, images, effects and
+///             nested DisplayLists are written the first time they are used
+///             and are referred to by index afterwards, so an object that is
+///             shared by many operations is only stored once.
+///
+///             Data is stored in host byte order, and arrays and image pixels
+///             are aligned so that |Deserialize| can use them in place from
+///             the mapping instead of copying them. Images loaded from a
+///             mapping keep it alive.
+///
+///             A DisplayList that is loaded from a serialized copy is
+///             |DisplayList::Equals| to the original unless it contains
+///             images, which are considered equal only if they are the same
+///             object. The loaded images have the same pixels.
+///
+///             Text, runtime effects and images that only exist on the GPU
+///             can't be serialized.
+///
+class DlSerialization {
+ public:
+  static constexpr uint32_t kMagic = 0x53534c44;  // "DLSS"
+
+  /// The version of the format, which must be incremented whenever the
+  /// encoding of an operation or object changes.
+  static constexpr uint32_t kVersion = 1;
+
+  /// Returns the serialized form of |display_list|, or nullptr if it
+  /// contains something that can't be serialized.
+  static std::unique_ptr<fml::Mapping> Serialize(
+      const DisplayList& display_list);
+
+  /// Returns the DisplayList stored in |mapping|, or nullptr if the mapping
+  /// doesn't hold a valid DisplayList of the current |kVersion|.
+  static sk_sp<DisplayList> Deserialize(
+      const std::shared_ptr<const fml::Mapping>& mapping);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_DISPLAY_LIST_UTILS_DL_SERIALIZATION_H_
@@ -0,0 +1,197 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <cstring>
+
+#include "flutter/display_list/utils/dl_serialization.h"
+
+#include "flutter/display_list/dl_builder.h"
+#include "flutter/display_list/testing/dl_test_snippets.h"
+#include "flutter/display_list/utils/dl_receiver_utils.h"
+#include "gtest/gtest.h"
+
+namespace flutter {
+
+DlOpReceiver& DisplayListBuilderTestingAccessor(DisplayListBuilder& builder);
+
+namespace testing {
+
+namespace {
+
+// Detects the images in a DisplayList, which are only considered equal to
+// themselves by |DisplayList::Equals|.
+class ImageDetector : public IgnoreAttributeDispatchHelper,
+                      public IgnoreClipDispatchHelper,
+                      public IgnoreTransformDispatchHelper,
+                      public IgnoreDrawDispatchHelper {
+ public:
+  void setColorSource(const DlColorSource* source) override {
+    has_images |= source && source->asImage();
+  }
+  void drawImage(const sk_sp<DlImage> image,
+                 const SkPoint point,
+                 DlImageSampling sampling,
+                 bool render_with_attributes) override {
+    has_images = true;
+  }
+  void drawImageRect(const sk_sp<DlImage> image,
+                     const SkRect& src,
+                     const SkRect& dst,
+                     DlImageSampling sampling,
+                     bool render_with_attributes,
+                     SrcRectConstraint constraint) override {
+    has_images = true;
+  }
+  void drawImageNine(const sk_sp<DlImage> image,
+                     const SkIRect& center,
+                     const SkRect& dst,
+                     DlFilterMode filter,
+                     bool render_with_attributes) override {
+    has_images = true;
+  }
+  void drawAtlas(const sk_sp<DlImage> atlas,
+                 const SkRSXform xform[],
+                 const SkRect tex[],
+                 const DlColor colors[],
+                 int count,
+                 DlBlendMode mode,
+                 DlImageSampling sampling,
+                 const SkRect* cull_rect,
+                 bool render_with_attributes) override {
+    has_images = true;
+  }
+
+  bool has_images = false;
+};
+
+bool HasImages(const DisplayList& display_list) {
+  ImageDetector detector;
+  display_list.Dispatch(detector);
+  return detector.has_images;
+}
+
+bool MappingsEqual(const fml::Mapping& a, const fml::Mapping& b) {
+  return a.GetSize() == b.GetSize() &&
+         memcmp(a.GetMapping(), b.GetMapping(), a.GetSize()) == 0;
+}
+
+}  // namespace
+
+TEST(DlSerialization, SingleOpDisplayListsRoundTrip) {
+  for (auto& group : CreateAllGroups()) {
+    for (size_t i = 0; i < group.variants.size(); i++) {
+      DisplayListBuilder builder;
+      group.variants[i].Invoke(DisplayListBuilderTestingAccessor(builder));
+      sk_sp<DisplayList> dl = builder.Build();
+      auto desc = group.op_name + "(variant " + std::to_string(i + 1) + ")";
+
+      std::shared_ptr<const fml::Mapping> data =
+          DlSerialization::Serialize(*dl);
+      if (group.op_name == "DrawTextBlob") {
+        ASSERT_EQ(data, nullptr) << desc;
+        continue;
+      }
+      ASSERT_NE(data, nullptr) << desc;
+
+      sk_sp<DisplayList> copy = DlSerialization::Deserialize(data);
+      ASSERT_NE(copy, nullptr) << desc;
+      ASSERT_EQ(copy->op_count(true), dl->op_count(true)) << desc;
+      ASSERT_EQ(copy->bytes(true), dl->bytes(true)) << desc;
+      ASSERT_EQ(copy->bounds(), dl->bounds()) << desc;
+      if (!HasImages(*dl)) {
+        ASSERT_TRUE(copy->Equals(*dl)) << desc;
+      }
+      // The loaded images are new objects, but must have the same pixels.
+      auto copy_data = DlSerialization::Serialize(*copy);
+      ASSERT_NE(copy_data, nullptr) << desc;
+      ASSERT_TRUE(MappingsEqual(*copy_data, *data)) << desc;
+    }
+  }
+}
+
+TEST(DlSerialization, SharedPathIsStoredOnce) {
+  SkPath path = SkPath::Circle(50, 50, 40);
+  path.addRect(SkRect::MakeLTRB(20, 20, 80, 80));
+  DlPaint paint;
+
+  DisplayListBuilder builder1;
+  builder1.DrawPath(path, paint);
+  auto data1 = DlSerialization::Serialize(*builder1.Build());
+
+  DisplayListBuilder builder2;
+  builder2.DrawPath(path, paint);
+  builder2.DrawPath(path, paint);
+  auto data2 = DlSerialization::Serialize(*builder2.Build());
+
+  ASSERT_NE(data1, nullptr);
+  ASSERT_NE(data2, nullptr);
+  // The op and the index of the path.
+  ASSERT_EQ(data2->GetSize() - data1->GetSize(), 1u + 4u);
+}
+
+TEST(DlSerialization, EqualAttributesAreStoredOnce) {
+  const DlColor colors[] = {DlColor::kRed(), DlColor::kBlue()};
+  const float stops[] = {0, 1};
+  auto gradient1 = DlColorSource::MakeLinear({0, 0}, {100, 100}, 2, colors,
+                                             stops, DlTileMode::kClamp);
+  auto gradient2 = DlColorSource::MakeLinear({0, 0}, {100, 100}, 2, colors,
+                                             stops, DlTileMode::kClamp);
+
+  DisplayListBuilder builder1;
+  builder1.DrawRect({0, 0, 10, 10}, DlPaint().setColorSource(gradient1));
+  builder1.DrawRect({0, 0, 10, 10}, DlPaint());
+  auto data1 = DlSerialization::Serialize(*builder1.Build());
+
+  DisplayListBuilder builder2;
+  builder2.DrawRect({0, 0, 10, 10}, DlPaint().setColorSource(gradient1));
+  builder2.DrawRect({0, 0, 10, 10}, DlPaint());
+  builder2.DrawRect({0, 0, 10, 10}, DlPaint().setColorSource(gradient2));
+  auto data2 = DlSerialization::Serialize(*builder2.Build());
+
+  ASSERT_NE(data1, nullptr);
+  ASSERT_NE(data2, nullptr);
+  // The ops to set and clear the color source and draw the rect, of which
+  // only the clearing one could be omitted by the builder.
+  ASSERT_EQ(data2->GetSize() - data1->GetSize(),
+            (1u + 4u) + (1u + sizeof(SkRect)));
+}
+
+TEST(DlSerialization, RejectsInvalidData) {
+  DisplayListBuilder builder;
+  builder.DrawRect({10, 10, 20, 20}, DlPaint(DlColor::kRed()));
+  builder.DrawCircle({50, 50}, 10, DlPaint(DlColor::kBlue()));
+  auto data = DlSerialization::Serialize(*builder.Build());
+  ASSERT_NE(data, nullptr);
+  const uint8_t* bytes = data->GetMapping();
+  const size_t size = data->GetSize();
+
+  auto deserialize = [](std::vector<uint8_t> bytes) {
+    return DlSerialization::Deserialize(
+        std::make_shared<fml::DataMapping>(std::move(bytes)));
+  };
+
+  std::vector<uint8_t> valid(bytes, bytes + size);
+  ASSERT_NE(deserialize(valid), nullptr);
+
+  for (size_t truncated_size = 0; truncated_size < size; truncated_size++) {
+    ASSERT_EQ(deserialize(std::vector<uint8_t>(bytes, bytes + truncated_size)),
+              nullptr)
+        << truncated_size;
+  }
+
+  std::vector<uint8_t> trailing_data = valid;
+  trailing_data.push_back(0);
+  ASSERT_EQ(deserialize(trailing_data), nullptr);
+
+  std::vector<uint8_t> bad_magic = valid;
+  bad_magic[0] ^= 0xFF;
+  ASSERT_EQ(deserialize(bad_magic), nullptr);
+
+  std::vector<uint8_t> bad_version = valid;
+  bad_version[sizeof(uint32_t)]++;
+  ASSERT_EQ(deserialize(bad_version), nullptr);
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -7,7 +7,9 @@
 #include <optional>
 #include <utility>
 #include "flutter/flow/layers/layer_tree.h"
+#include "flutter/fml/time/time_point.h"
 #include "third_party/skia/include/core/SkCanvas.h"
+#include "third_party/skia/include/core/SkPath.h"
 
 namespace flutter {
 
@@ -23,6 +25,7 @@ std::optional<SkRect> FrameDamage::ComputeClipRect(
                         has_raster_cache, impeller_enabled);
     context.PushCullRect(SkRect::MakeIWH(layer_tree.frame_size().width(),
                                          layer_tree.frame_size().height()));
+    const fml::TimePoint diff_start = fml::TimePoint::Now();
     {
       DiffContext::AutoSubtreeRestore subtree(&context);
       const Layer* prev_root_layer = nullptr;
@@ -37,10 +40,12 @@ std::optional<SkRect> FrameDamage::ComputeClipRect(
       }
       layer_tree.root_layer()->Diff(&context, prev_root_layer);
     }
+    context.statistics().SetDiffDuration(fml::TimePoint::Now() - diff_start);
+    context.statistics().LogStatistics();
 
     damage_ =
         context.ComputeDamage(additional_damage_, horizontal_clip_alignment_,
-                              vertical_clip_alignment_);
+                              vertical_clip_alignment_, max_damage_rects_);
     return SkRect::Make(damage_->buffer_damage);
   }
   return std::nullopt;
@@ -121,6 +126,7 @@ RasterStatus CompositorContext::ScopedFrame::Raster(
   TRACE_EVENT0("flutter", "CompositorContext::ScopedFrame::Raster");
 
   std::optional<SkRect> clip_rect;
+  std::optional<DlRegion> clip_region;
   if (frame_damage) {
     clip_rect = frame_damage->ComputeClipRect(layer_tree, !ignore_raster_cache,
                                               !gr_context_);
@@ -130,6 +136,9 @@ RasterStatus CompositorContext::ScopedFrame::Raster(
       clip_rect = std::nullopt;
       frame_damage->Reset();
     }
+    if (clip_rect) {
+      clip_region = frame_damage->GetBufferDamageRegion();
+    }
   }
 
   bool root_needs_readback = layer_tree.Preroll(
@@ -151,8 +160,9 @@ RasterStatus CompositorContext::ScopedFrame::Raster(
   if (aiks_context_) {
     PaintLayerTreeImpeller(layer_tree, clip_rect, ignore_raster_cache);
   } else {
-    PaintLayerTreeSkia(layer_tree, clip_rect, needs_save_layer,
-                       ignore_raster_cache);
+    PaintLayerTreeSkia(layer_tree, clip_rect,
+                       clip_region ? &clip_region.value() : nullptr,
+                       needs_save_layer, ignore_raster_cache);
   }
   return RasterStatus::kSuccess;
 }
@@ -160,12 +170,21 @@ RasterStatus CompositorContext::ScopedFrame::Raster(
 void CompositorContext::ScopedFrame::PaintLayerTreeSkia(
     flutter::LayerTree& layer_tree,
     std::optional<SkRect> clip_rect,
+    const DlRegion* clip_region,
     bool needs_save_layer,
     bool ignore_raster_cache) {
   DlAutoCanvasRestore restore(canvas(), clip_rect.has_value());
 
   if (canvas()) {
-    if (clip_rect) {
+    if (clip_region && clip_region->isComplex()) {
+      // Only the pixels in the damage region are rasterized. The region lies
+      // within clip_rect, which was used to cull the layer tree.
+      SkPath path;
+      for (const SkIRect& rect : clip_region->getRects()) {
+        path.addRect(SkRect::Make(rect));
+      }
+      canvas()->ClipPath(path);
+    } else if (clip_rect) {
       canvas()->ClipRect(*clip_rect);
     }
 
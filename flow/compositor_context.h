@@ -67,6 +67,12 @@ class FrameDamage {
     vertical_clip_alignment_ = vertical;
   }
 
+  // Specifies the maximum number of rects in the damage regions. With the
+  // default of 1, the damage regions are the same as the damage rects.
+  void SetMaxDamageRects(size_t max_damage_rects) {
+    max_damage_rects_ = max_damage_rects;
+  }
+
   // Calculates clip rect for current rasterization. This is diff of layer tree
   // and previous layer tree + any additional provided damage.
   // If previous layer tree is not specified, clip rect will be nullopt,
@@ -88,6 +94,19 @@ class FrameDamage {
                : std::nullopt;
   }
 
+  // See Damage::frame_damage_region.
+  std::optional<DlRegion> GetFrameDamageRegion() const {
+    return damage_ ? std::make_optional(damage_->frame_damage_region)
+                   : std::nullopt;
+  }
+
+  // See Damage::buffer_damage_region.
+  std::optional<DlRegion> GetBufferDamageRegion() const {
+    return (damage_ && !ignore_damage_)
+               ? std::make_optional(damage_->buffer_damage_region)
+               : std::nullopt;
+  }
+
   // Remove reported buffer_damage to inform clients that a partial repaint
   // should not be performed on this frame.
   // frame_damage is required to correctly track accumulated damage for
@@ -100,6 +119,7 @@ class FrameDamage {
   const LayerTree* prev_layer_tree_ = nullptr;
   int vertical_clip_alignment_ = 1;
   int horizontal_clip_alignment_ = 1;
+  size_t max_damage_rects_ = 1;
   bool ignore_damage_ = false;
 };
 
@@ -142,6 +162,7 @@ class CompositorContext {
    private:
     void PaintLayerTreeSkia(flutter::LayerTree& layer_tree,
                             std::optional<SkRect> clip_rect,
+                            const DlRegion* clip_region,
                             bool needs_save_layer,
                             bool ignore_raster_cache);
 
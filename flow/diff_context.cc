@@ -3,6 +3,9 @@
 // found in the LICENSE file.
 
 #include "flutter/flow/diff_context.h"
+
+#include <limits>
+
 #include "flutter/flow/layers/layer.h"
 
 namespace flutter {
@@ -117,7 +120,8 @@ void DiffContext::AlignRect(SkIRect& rect,
 
 Damage DiffContext::ComputeDamage(const SkIRect& accumulated_buffer_damage,
                                   int horizontal_clip_alignment,
-                                  int vertical_clip_alignment) const {
+                                  int vertical_clip_alignment,
+                                  size_t max_damage_rects) const {
   SkRect buffer_damage = SkRect::Make(accumulated_buffer_damage);
   buffer_damage.join(damage_);
   SkRect frame_damage(damage_);
@@ -150,9 +154,140 @@ Damage DiffContext::ComputeDamage(const SkIRect& accumulated_buffer_damage,
     AlignRect(res.frame_damage, horizontal_clip_alignment,
               vertical_clip_alignment);
   }
+
+  if (max_damage_rects <= 1) {
+    res.frame_damage_region = MakeDamageRegion(
+        {res.frame_damage}, horizontal_clip_alignment, vertical_clip_alignment,
+        max_damage_rects);
+    res.buffer_damage_region = MakeDamageRegion(
+        {res.buffer_damage}, horizontal_clip_alignment,
+        vertical_clip_alignment, max_damage_rects);
+    return res;
+  }
+
+  std::vector<SkIRect> frame_rects;
+  frame_rects.reserve(damage_rects_.size() + 2 * readbacks_.size());
+  for (const SkRect& rect : damage_rects_) {
+    frame_rects.push_back(rect.roundOut());
+  }
+  if (!readbacks_.empty()) {
+    // Same as above, but checking the readbacks against the region instead of
+    // its bounds.
+    DlRegion frame_region(frame_rects);
+    for (const auto& r : readbacks_) {
+      if (frame_region.intersects(r.paint_rect) ||
+          frame_region.intersects(r.readback_rect)) {
+        for (const SkIRect& rect : {r.paint_rect, r.readback_rect}) {
+          if (!rect.isEmpty()) {
+            frame_rects.push_back(rect);
+          }
+        }
+        frame_region = DlRegion(frame_rects);
+      }
+    }
+  }
+
+  std::vector<SkIRect> buffer_rects = frame_rects;
+  buffer_rects.push_back(accumulated_buffer_damage);
+
+  res.frame_damage_region =
+      MakeDamageRegion(std::move(frame_rects), horizontal_clip_alignment,
+                       vertical_clip_alignment, max_damage_rects);
+  res.buffer_damage_region =
+      MakeDamageRegion(std::move(buffer_rects), horizontal_clip_alignment,
+                       vertical_clip_alignment, max_damage_rects);
   return res;
 }
 
+namespace {
+
+// Merging is quadratic in the number of rects. Damage made of more rects
+// than this is rare, and is reduced to its bounds instead.
+constexpr size_t kMaxDamageRectsToMerge = 64;
+constexpr int kMaxDamageMergePasses = 4;
+
+int64_t Area(const SkIRect& rect) {
+  return static_cast<int64_t>(rect.width()) * rect.height();
+}
+
+// Merges the pair of rects whose bounds add the least area to them.
+void MergeCheapestPair(std::vector<SkIRect>& rects) {
+  FML_DCHECK(rects.size() >= 2);
+  size_t best_i = 0;
+  size_t best_j = 1;
+  int64_t best_cost = std::numeric_limits<int64_t>::max();
+  for (size_t i = 0; i < rects.size(); i++) {
+    for (size_t j = i + 1; j < rects.size(); j++) {
+      SkIRect merged = rects[i];
+      merged.join(rects[j]);
+      const int64_t cost = Area(merged) - Area(rects[i]) - Area(rects[j]);
+      if (cost < best_cost) {
+        best_cost = cost;
+        best_i = i;
+        best_j = j;
+      }
+    }
+  }
+  rects[best_i].join(rects[best_j]);
+  rects.erase(rects.begin() + best_j);
+}
+
+}  // namespace
+
+DlRegion DiffContext::MakeDamageRegion(std::vector<SkIRect> rects,
+                                       int horizontal_clip_alignment,
+                                       int vertical_clip_alignment,
+                                       size_t max_rects) const {
+  const SkIRect frame_clip = SkIRect::MakeSize(frame_size_);
+  const bool align =
+      horizontal_clip_alignment > 1 || vertical_clip_alignment > 1;
+  // DlRegion expects no empty rects.
+  size_t count = 0;
+  for (SkIRect rect : rects) {
+    if (!rect.intersect(frame_clip)) {
+      continue;
+    }
+    if (align) {
+      AlignRect(rect, horizontal_clip_alignment, vertical_clip_alignment);
+    }
+    if (!rect.isEmpty()) {
+      rects[count++] = rect;
+    }
+  }
+  rects.resize(count);
+  if (rects.empty()) {
+    return DlRegion();
+  }
+  if (max_rects <= 1 || rects.size() == 1) {
+    SkIRect bounds = SkIRect::MakeEmpty();
+    for (const SkIRect& rect : rects) {
+      bounds.join(rect);
+    }
+    return DlRegion(bounds);
+  }
+
+  DlRegion region(rects);
+  // The merged rects may overlap, and their region may again need more rects
+  // than the cap, so merge a few times before giving up on the bounds.
+  for (int pass = 0; pass < kMaxDamageMergePasses; pass++) {
+    rects = region.getRects();
+    if (rects.size() <= max_rects) {
+      return region;
+    }
+    if (rects.size() > kMaxDamageRectsToMerge) {
+      break;
+    }
+    while (rects.size() > max_rects) {
+      MergeCheapestPair(rects);
+    }
+    region = DlRegion(rects);
+  }
+  if (region.getRects().size() <= max_rects) {
+    return region;
+  }
+  return DlRegion(region.bounds());
+}
+
 SkRect DiffContext::MapRect(const SkRect& rect) {
   SkRect mapped_rect(rect);
   clip_tracker_.mapRect(&mapped_rect);
@@ -246,12 +381,16 @@ PaintRegion DiffContext::CurrentSubtreeRegion() const {
 void DiffContext::AddDamage(const PaintRegion& damage) {
   FML_DCHECK(damage.is_valid());
   for (const auto& r : damage) {
-    damage_.join(r);
+    AddDamage(r);
   }
 }
 
 void DiffContext::AddDamage(const SkRect& rect) {
+  if (rect.isEmpty()) {
+    return;
+  }
   damage_.join(rect);
+  damage_rects_.push_back(rect);
 }
 
 void DiffContext::SetLayerPaintRegion(const Layer* layer,
@@ -278,7 +417,9 @@ void DiffContext::Statistics::LogStatistics() {
                     deep_compare_pictures_, "SameInstancePictures",
                     same_instance_pictures_,
                     "DifferentInstanceButEqualPictures",
-                    different_instance_but_equal_pictures_);
+                    different_instance_but_equal_pictures_,
+                    "FingerprintMatchedSubtrees", fingerprint_matched_subtrees_,
+                    "DiffMicros", diff_duration_.ToMicroseconds());
 #endif  // !FLUTTER_RELEASE
 }
 
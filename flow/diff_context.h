@@ -9,9 +9,11 @@
 #include <map>
 #include <optional>
 #include <vector>
+#include "display_list/geometry/dl_region.h"
 #include "display_list/utils/dl_matrix_clip_tracker.h"
 #include "flutter/flow/paint_region.h"
 #include "flutter/fml/macros.h"
+#include "flutter/fml/time/time_delta.h"
 #include "third_party/skia/include/core/SkM44.h"
 #include "third_party/skia/include/core/SkMatrix.h"
 #include "third_party/skia/include/core/SkRect.h"
@@ -35,6 +37,13 @@ struct Damage {
   // upfront may be useful for tile based GPUs.
   // Corresponds to "buffer damage" from EGL_KHR_partial_update.
   SkIRect buffer_damage;
+
+  // The same areas as frame_damage and buffer_damage, as regions of at most
+  // the number of rectangles requested in DiffContext::ComputeDamage. Changes
+  // that are far apart are kept in separate rectangles, so the regions may be
+  // much smaller than their bounds. Each is covered by the respective rect.
+  DlRegion frame_damage_region;
+  DlRegion buffer_damage_region;
 };
 
 // Layer Unique Id to PaintRegion
@@ -143,9 +152,14 @@ class DiffContext {
   //
   // clip_alignment controls the alignment of resulting frame and surface
   // damage.
+  //
+  // max_damage_rects caps the number of rectangles in the resulting damage
+  // regions. Rectangles are merged with the ones that grow the least in area
+  // until the cap is met.
   Damage ComputeDamage(const SkIRect& additional_damage,
                        int horizontal_clip_alignment = 0,
-                       int vertical_clip_alignment = 0) const;
+                       int vertical_clip_alignment = 0,
+                       size_t max_damage_rects = 1) const;
 
   // Adds the region to current damage. Used for removed layers, where instead
   // of diffing the layer its paint region is direcly added to damage.
@@ -189,6 +203,13 @@ class DiffContext {
       ++different_instance_but_equal_pictures_;
     };
 
+    // Subtree that replaced a different instance with the same content, which
+    // was confirmed instead of diffing it
+    void AddFingerprintMatchedSubtree() { ++fingerprint_matched_subtrees_; }
+
+    // Time spent diffing the layer tree
+    void SetDiffDuration(fml::TimeDelta duration) { diff_duration_ = duration; }
+
     // Logs the statistics to trace counter
     void LogStatistics();
 
@@ -198,6 +219,8 @@ class DiffContext {
     int same_instance_pictures_ = 0;
     int deep_compare_pictures_ = 0;
     int different_instance_but_equal_pictures_ = 0;
+    int fingerprint_matched_subtrees_ = 0;
+    fml::TimeDelta diff_duration_;
   };
 
   Statistics& statistics() { return statistics_; }
@@ -248,6 +271,8 @@ class DiffContext {
   SkRect ApplyFilterBoundsAdjustment(SkRect rect) const;
 
   SkRect damage_ = SkRect::MakeEmpty();
+  // The individual rects joined into damage_.
+  std::vector<SkRect> damage_rects_;
 
   PaintRegionMap& this_frame_paint_region_map_;
   const PaintRegionMap& last_frame_paint_region_map_;
@@ -260,6 +285,13 @@ class DiffContext {
                  int horizontal_alignment,
                  int vertical_clip_alignment) const;
 
+  // Builds a region of at most max_rects rectangles covering rects, clipped
+  // to the frame and aligned.
+  DlRegion MakeDamageRegion(std::vector<SkIRect> rects,
+                            int horizontal_clip_alignment,
+                            int vertical_clip_alignment,
+                            size_t max_rects) const;
+
   struct Readback {
     // Index of rects_ entry that this readback belongs to. Used to
     // determine if subtree has any readback
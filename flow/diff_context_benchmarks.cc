@@ -0,0 +1,105 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/benchmarking/benchmarking.h"
+
+#include "flutter/display_list/dl_builder.h"
+#include "flutter/flow/diff_context.h"
+#include "flutter/flow/layers/container_layer.h"
+#include "flutter/flow/layers/display_list_layer.h"
+
+namespace flutter {
+
+namespace {
+
+constexpr SkISize kFrameSize = SkISize::Make(1080, 1920);
+
+sk_sp<DisplayList> MakeDisplayList(const SkRect& bounds, DlColor color) {
+  DisplayListBuilder builder;
+  builder.DrawRect(bounds, DlPaint().setColor(color));
+  return builder.Build();
+}
+
+std::shared_ptr<DisplayListLayer> MakeLayer(const SkRect& bounds,
+                                            DlColor color) {
+  return std::make_shared<DisplayListLayer>(
+      SkPoint::Make(0, 0), MakeDisplayList(bounds, color), false, false);
+}
+
+struct Scene {
+  std::shared_ptr<ContainerLayer> root = std::make_shared<ContainerLayer>();
+  PaintRegionMap paint_region_map;
+};
+
+// A static background with a clock in the top left corner and a spinner in
+// the bottom right corner, both of which change in every frame.
+std::unique_ptr<Scene> MakeScene(
+    const std::shared_ptr<DisplayListLayer>& background,
+    int frame) {
+  auto scene = std::make_unique<Scene>();
+  DlColor color = frame % 2 ? DlColor::kRed() : DlColor::kBlue();
+  scene->root->Add(background);
+  scene->root->Add(MakeLayer(SkRect::MakeXYWH(16, 48, 160, 40), color));
+  scene->root->Add(MakeLayer(SkRect::MakeXYWH(968, 1808, 64, 64), color));
+  return scene;
+}
+
+Damage DiffScene(Scene& scene, Scene* old_scene, size_t max_damage_rects) {
+  PaintRegionMap empty_paint_region_map;
+  DiffContext context(
+      kFrameSize, scene.paint_region_map,
+      old_scene ? old_scene->paint_region_map : empty_paint_region_map, true,
+      false);
+  context.PushCullRect(SkRect::Make(kFrameSize));
+  {
+    DiffContext::AutoSubtreeRestore subtree(&context);
+    if (!old_scene) {
+      context.MarkSubtreeDirty(SkRect::Make(kFrameSize));
+    }
+    scene.root->Diff(&context, old_scene ? old_scene->root.get() : nullptr);
+  }
+  return context.ComputeDamage(SkIRect::MakeEmpty(), 0, 0, max_damage_rects);
+}
+
+int64_t Area(const DlRegion& region) {
+  int64_t area = 0;
+  for (const SkIRect& rect : region.getRects()) {
+    area += static_cast<int64_t>(rect.width()) * rect.height();
+  }
+  return area;
+}
+
+}  // namespace
+
+// Diffs consecutive frames of a scene with two small changes far apart and
+// reports the number of pixels the resulting damage makes the rasterizer
+// repaint. With a cap of 1 rect, the bounds of both changes are repainted.
+static void BM_DiffContextPartialRepaint(benchmark::State& state) {
+  const size_t max_damage_rects = state.range(0);
+  auto background = MakeLayer(SkRect::Make(kFrameSize), DlColor::kLightGrey());
+  auto old_scene = MakeScene(background, 0);
+  DiffScene(*old_scene, nullptr, max_damage_rects);
+
+  int frame = 1;
+  int64_t pixels = 0;
+  for (auto _ : state) {
+    state.PauseTiming();
+    auto scene = MakeScene(background, frame++);
+    state.ResumeTiming();
+
+    Damage damage = DiffScene(*scene, old_scene.get(), max_damage_rects);
+    pixels = Area(damage.buffer_damage_region);
+    old_scene = std::move(scene);
+  }
+  state.counters["PixelsRasterized"] = pixels;
+  state.counters["FramePixels"] = kFrameSize.area();
+}
+
+BENCHMARK(BM_DiffContextPartialRepaint)
+    ->ArgName("MaxDamageRects")
+    ->Arg(1)
+    ->Arg(4)
+    ->Unit(benchmark::kMicrosecond);
+
+}  // namespace flutter
@@ -32,5 +32,73 @@ TEST_F(DiffContextTest, ClipAlignment) {
   EXPECT_EQ(damage.buffer_damage, SkIRect::MakeLTRB(16, 16, 64, 64));
 }
 
+TEST_F(DiffContextTest, DamageRegionKeepsDistantChangesApart) {
+  MockLayerTree t1;
+  t1.root()->Add(CreateDisplayListLayer(
+      CreateDisplayList(SkRect::MakeLTRB(10, 10, 50, 50))));
+  t1.root()->Add(CreateDisplayListLayer(
+      CreateDisplayList(SkRect::MakeLTRB(900, 900, 950, 950))));
+
+  auto damage = DiffLayerTree(t1, MockLayerTree(), SkIRect::MakeEmpty(), 0, 0,
+                              true, false, 1);
+  EXPECT_EQ(damage.frame_damage, SkIRect::MakeLTRB(10, 10, 950, 950));
+  EXPECT_EQ(damage.frame_damage_region.getRects(),
+            std::vector<SkIRect>{SkIRect::MakeLTRB(10, 10, 950, 950)});
+
+  damage = DiffLayerTree(t1, MockLayerTree(), SkIRect::MakeEmpty(), 0, 0, true,
+                         false, 4);
+  EXPECT_EQ(damage.frame_damage, SkIRect::MakeLTRB(10, 10, 950, 950));
+  EXPECT_EQ(damage.frame_damage_region.getRects(),
+            (std::vector<SkIRect>{SkIRect::MakeLTRB(10, 10, 50, 50),
+                                  SkIRect::MakeLTRB(900, 900, 950, 950)}));
+  EXPECT_EQ(damage.buffer_damage_region.getRects(),
+            damage.frame_damage_region.getRects());
+}
+
+TEST_F(DiffContextTest, DamageRegionIncludesAdditionalDamage) {
+  MockLayerTree t1;
+  t1.root()->Add(CreateDisplayListLayer(
+      CreateDisplayList(SkRect::MakeLTRB(10, 10, 50, 50))));
+
+  auto damage =
+      DiffLayerTree(t1, MockLayerTree(), SkIRect::MakeLTRB(500, 10, 600, 50),
+                    0, 0, true, false, 4);
+  EXPECT_EQ(damage.frame_damage_region.getRects(),
+            std::vector<SkIRect>{SkIRect::MakeLTRB(10, 10, 50, 50)});
+  EXPECT_EQ(damage.buffer_damage_region.getRects(),
+            (std::vector<SkIRect>{SkIRect::MakeLTRB(10, 10, 50, 50),
+                                  SkIRect::MakeLTRB(500, 10, 600, 50)}));
+}
+
+TEST_F(DiffContextTest, DamageRegionMergesClosestRectsOverCap) {
+  MockLayerTree t1;
+  t1.root()->Add(CreateDisplayListLayer(
+      CreateDisplayList(SkRect::MakeLTRB(10, 10, 50, 50))));
+  t1.root()->Add(CreateDisplayListLayer(
+      CreateDisplayList(SkRect::MakeLTRB(60, 10, 100, 50))));
+  t1.root()->Add(CreateDisplayListLayer(
+      CreateDisplayList(SkRect::MakeLTRB(900, 900, 950, 950))));
+
+  auto damage = DiffLayerTree(t1, MockLayerTree(), SkIRect::MakeEmpty(), 0, 0,
+                              true, false, 2);
+  EXPECT_EQ(damage.frame_damage_region.getRects(),
+            (std::vector<SkIRect>{SkIRect::MakeLTRB(10, 10, 100, 50),
+                                  SkIRect::MakeLTRB(900, 900, 950, 950)}));
+}
+
+TEST_F(DiffContextTest, DamageRegionIsAligned) {
+  MockLayerTree t1;
+  t1.root()->Add(CreateDisplayListLayer(
+      CreateDisplayList(SkRect::MakeLTRB(30, 30, 50, 50))));
+  t1.root()->Add(CreateDisplayListLayer(
+      CreateDisplayList(SkRect::MakeLTRB(900, 900, 950, 950))));
+
+  auto damage = DiffLayerTree(t1, MockLayerTree(), SkIRect::MakeEmpty(), 16,
+                              16, true, false, 4);
+  EXPECT_EQ(damage.frame_damage_region.getRects(),
+            (std::vector<SkIRect>{SkIRect::MakeLTRB(16, 16, 64, 64),
+                                  SkIRect::MakeLTRB(896, 896, 960, 960)}));
+}
+
 }  // namespace testing
 }  // namespace flutter
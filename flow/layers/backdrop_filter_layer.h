@@ -21,6 +21,13 @@ class BackdropFilterLayer : public ContainerLayer {
 
   void Paint(PaintContext& context) const override;
 
+ protected:
+  // Backdrop filters read back what is painted below them, so they are
+  // always diffed.
+  std::optional<size_t> ComputeFingerprint() const override {
+    return std::nullopt;
+  }
+
  private:
   std::shared_ptr<const DlImageFilter> filter_;
   DlBlendMode blend_mode_;
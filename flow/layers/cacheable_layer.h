@@ -41,6 +41,11 @@ class CacheableContainerLayer : public ContainerLayer {
   }
 
  protected:
+  // Filters and shaders can't be fingerprinted, so subclasses must opt in.
+  std::optional<size_t> ComputeFingerprint() const override {
+    return std::nullopt;
+  }
+
   std::unique_ptr<LayerRasterCacheItem> layer_raster_cache_item_;
 };
 
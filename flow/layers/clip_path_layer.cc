@@ -4,11 +4,20 @@
 
 #include "flutter/flow/layers/clip_path_layer.h"
 
+#include <string_view>
+
 namespace flutter {
 
 ClipPathLayer::ClipPathLayer(const SkPath& clip_path, Clip clip_behavior)
     : ClipShapeLayer(clip_path, clip_behavior) {}
 
+std::optional<size_t> ClipPathLayer::ComputeClipShapeFingerprint() const {
+  // Copies of a path share its generation ID until one of them is modified.
+  // Equal paths built separately don't, and are diffed as usual.
+  return fml::HashCombine(std::string_view("ClipPath"),
+                          clip_shape().getGenerationID());
+}
+
 const SkRect& ClipPathLayer::clip_shape_bounds() const {
   return clip_shape().getBounds();
 }
@@ -15,6 +15,8 @@ class ClipPathLayer : public ClipShapeLayer<SkPath> {
                          Clip clip_behavior = Clip::kAntiAlias);
 
  protected:
+  std::optional<size_t> ComputeClipShapeFingerprint() const override;
+
   const SkRect& clip_shape_bounds() const override;
 
   void ApplyClip(LayerStateStack::MutatorContext& mutator) const override;
@@ -4,11 +4,19 @@
 
 #include "flutter/flow/layers/clip_rect_layer.h"
 
+#include <string_view>
+
 namespace flutter {
 
 ClipRectLayer::ClipRectLayer(const SkRect& clip_rect, Clip clip_behavior)
     : ClipShapeLayer(clip_rect, clip_behavior) {}
 
+std::optional<size_t> ClipRectLayer::ComputeClipShapeFingerprint() const {
+  const SkRect& rect = clip_shape();
+  return fml::HashCombine(std::string_view("ClipRect"), rect.fLeft, rect.fTop,
+                          rect.fRight, rect.fBottom);
+}
+
 const SkRect& ClipRectLayer::clip_shape_bounds() const {
   return clip_shape();
 }
@@ -14,6 +14,8 @@ class ClipRectLayer : public ClipShapeLayer<SkRect> {
   ClipRectLayer(const SkRect& clip_rect, Clip clip_behavior);
 
  protected:
+  std::optional<size_t> ComputeClipShapeFingerprint() const override;
+
   const SkRect& clip_shape_bounds() const override;
 
   void ApplyClip(LayerStateStack::MutatorContext& mutator) const override;
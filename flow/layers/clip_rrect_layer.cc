@@ -4,11 +4,27 @@
 
 #include "flutter/flow/layers/clip_rrect_layer.h"
 
+#include <string_view>
+
 namespace flutter {
 
 ClipRRectLayer::ClipRRectLayer(const SkRRect& clip_rrect, Clip clip_behavior)
     : ClipShapeLayer(clip_rrect, clip_behavior) {}
 
+std::optional<size_t> ClipRRectLayer::ComputeClipShapeFingerprint() const {
+  const SkRRect& rrect = clip_shape();
+  const SkRect& rect = rrect.rect();
+  size_t seed = fml::HashCombine(std::string_view("ClipRRect"), rect.fLeft,
+                                 rect.fTop, rect.fRight, rect.fBottom);
+  for (auto corner :
+       {SkRRect::kUpperLeft_Corner, SkRRect::kUpperRight_Corner,
+        SkRRect::kLowerRight_Corner, SkRRect::kLowerLeft_Corner}) {
+    SkVector radii = rrect.radii(corner);
+    fml::HashCombineSeed(seed, radii.fX, radii.fY);
+  }
+  return seed;
+}
+
 const SkRect& ClipRRectLayer::clip_shape_bounds() const {
   return clip_shape().getBounds();
 }
@@ -14,6 +14,8 @@ class ClipRRectLayer : public ClipShapeLayer<SkRRect> {
   ClipRRectLayer(const SkRRect& clip_rrect, Clip clip_behavior);
 
  protected:
+  std::optional<size_t> ComputeClipShapeFingerprint() const override;
+
   const SkRect& clip_shape_bounds() const override;
 
   void ApplyClip(LayerStateStack::MutatorContext& mutator) const override;
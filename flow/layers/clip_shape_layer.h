@@ -8,6 +8,7 @@
 #include "flutter/flow/layers/cacheable_layer.h"
 #include "flutter/flow/layers/container_layer.h"
 #include "flutter/flow/paint_utils.h"
+#include "flutter/fml/hash_combine.h"
 
 namespace flutter {
 
@@ -104,6 +105,24 @@ class ClipShapeLayer : public CacheableContainerLayer {
   }
 
  protected:
+  std::optional<size_t> ComputeFingerprint() const override {
+    std::optional<size_t> shape_fingerprint = ComputeClipShapeFingerprint();
+    if (!shape_fingerprint.has_value()) {
+      return std::nullopt;
+    }
+    return FingerprintChildren(fml::HashCombine(
+        static_cast<int>(clip_behavior_), shape_fingerprint.value()));
+  }
+
+  bool HasSameProperties(const ContainerLayer* old_layer) const override {
+    auto* prev = static_cast<const ClipShapeLayer<ClipShape>*>(old_layer);
+    return clip_behavior_ == prev->clip_behavior_ &&
+           clip_shape_ == prev->clip_shape_;
+  }
+
+  // A hash of the clip shape that also identifies the shape type, or
+  // std::nullopt if the shape can't be hashed.
+  virtual std::optional<size_t> ComputeClipShapeFingerprint() const = 0;
   virtual const SkRect& clip_shape_bounds() const = 0;
   virtual void ApplyClip(LayerStateStack::MutatorContext& mutator) const = 0;
   virtual ~ClipShapeLayer() = default;
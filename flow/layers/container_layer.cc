@@ -5,6 +5,11 @@
 #include "flutter/flow/layers/container_layer.h"
 
 #include <optional>
+#include <string_view>
+
+#include "flutter/flow/layers/display_list_layer.h"
+#include "flutter/flow/raster_cache_atlas.h"
+#include "flutter/fml/hash_combine.h"
 
 namespace flutter {
 
@@ -24,6 +29,67 @@ void ContainerLayer::PreservePaintRegion(DiffContext* context) {
   }
 }
 
+void ContainerLayer::AdoptPaintRegion(DiffContext* context,
+                                      const Layer* old_layer) {
+  Layer::AdoptPaintRegion(context, old_layer);
+  // Only called once MatchesFingerprintedSubtree has confirmed the subtrees
+  // have the same shape.
+  const auto& old_layers = old_layer->as_container_layer()->layers_;
+  FML_DCHECK(old_layers.size() == layers_.size());
+  for (size_t i = 0; i < layers_.size(); i++) {
+    layers_[i]->AdoptPaintRegion(context, old_layers[i].get());
+  }
+}
+
+bool ContainerLayer::MatchesFingerprintedSubtree(const Layer* layer,
+                                                 const Layer* old_layer) {
+  if (const DisplayListLayer* display_list_layer =
+          layer->as_display_list_layer()) {
+    const DisplayListLayer* old_display_list_layer =
+        old_layer->as_display_list_layer();
+    return old_display_list_layer &&
+           display_list_layer->offset() == old_display_list_layer->offset() &&
+           display_list_layer->display_list()->Equals(
+               old_display_list_layer->display_list());
+  }
+  if (const ContainerLayer* container = layer->as_container_layer()) {
+    const ContainerLayer* old_container = old_layer->as_container_layer();
+    // Like Diff, this relies on a layer replacing an old layer of the same
+    // type when they share an original layer id.
+    if (!old_container ||
+        container->original_layer_id() != old_container->original_layer_id() ||
+        !container->HasSameProperties(old_container) ||
+        old_container->layers_.size() != container->layers_.size()) {
+      return false;
+    }
+    for (size_t i = 0; i < container->layers_.size(); i++) {
+      if (!MatchesFingerprintedSubtree(container->layers_[i].get(),
+                                       old_container->layers_[i].get())) {
+        return false;
+      }
+    }
+    return true;
+  }
+  // No other layers have a fingerprint.
+  return false;
+}
+
+std::optional<size_t> ContainerLayer::ComputeFingerprint() const {
+  return FingerprintChildren(fml::HashCombine(std::string_view("Container")));
+}
+
+std::optional<size_t> ContainerLayer::FingerprintChildren(size_t seed) const {
+  fml::HashCombineSeed(seed, layers_.size());
+  for (const auto& layer : layers_) {
+    std::optional<size_t> fingerprint = layer->fingerprint();
+    if (!fingerprint.has_value()) {
+      return std::nullopt;
+    }
+    fml::HashCombineSeed(seed, fingerprint.value());
+  }
+  return seed;
+}
+
 void ContainerLayer::DiffChildren(DiffContext* context,
                                   const ContainerLayer* old_layer) {
   if (context->IsSubtreeDirty()) {
@@ -77,8 +143,9 @@ void ContainerLayer::DiffChildren(DiffContext* context,
       auto layer = layers_[i];
       auto prev_layer = prev_layers[i_prev];
       auto paint_region = context->GetOldLayerPaintRegion(prev_layer.get());
-      if (layer == prev_layer && !paint_region.has_readback() &&
-          !paint_region.has_texture()) {
+      bool can_skip_diff =
+          !paint_region.has_readback() && !paint_region.has_texture();
+      if (layer == prev_layer && can_skip_diff) {
         // for retained layers, stop processing the subtree and add existing
         // region; We know current subtree is not dirty (every ancestor up to
         // here matches) so the retained subtree will render identically to
@@ -91,6 +158,15 @@ void ContainerLayer::DiffChildren(DiffContext* context,
         // associate their paint region with current layer tree so that we can
         // retrieve it in next frame diff
         layer->PreservePaintRegion(context);
+      } else if (can_skip_diff && layer->as_container_layer() &&
+                 layer->fingerprint().has_value() &&
+                 layer->fingerprint() == prev_layer->fingerprint() &&
+                 MatchesFingerprintedSubtree(layer.get(), prev_layer.get())) {
+        // A different instance with the same content, such as a subtree that
+        // was rebuilt without changes, is treated like a retained layer.
+        context->AddExistingPaintRegion(paint_region);
+        layer->AdoptPaintRegion(context, prev_layer.get());
+        context->statistics().AddFingerprintMatchedSubtree();
       } else {
         layer->Diff(context, prev_layer.get());
       }
@@ -187,8 +263,22 @@ void ContainerLayer::PaintChildren(PaintContext& context) const {
 
   // Intentionally not tracing here as there should be no self-time
   // and the trace event on this common function has a small overhead.
+  if (!context.raster_cache || !context.raster_cache->uses_atlas()) {
+    for (auto& layer : layers_) {
+      if (layer->needs_painting(context)) {
+        layer->Paint(context);
+      }
+    }
+    return;
+  }
+
+  // Children that only draw atlas entries are collected into the batch, which
+  // must be flushed before any other child draws.
+  RasterCacheAtlasBatch batch;
   for (auto& layer : layers_) {
-    if (layer->needs_painting(context)) {
+    if (layer->needs_painting(context) &&
+        !layer->AddToAtlasBatch(context, batch)) {
+      batch.Flush();
       layer->Paint(context);
     }
   }
@@ -17,6 +17,7 @@ class ContainerLayer : public Layer {
 
   void Diff(DiffContext* context, const Layer* old_layer) override;
   void PreservePaintRegion(DiffContext* context) override;
+  void AdoptPaintRegion(DiffContext* context, const Layer* old_layer) override;
 
   virtual void Add(std::shared_ptr<Layer> layer);
 
@@ -47,7 +48,31 @@ class ContainerLayer : public Layer {
  protected:
   void PrerollChildren(PrerollContext* context, SkRect* child_paint_bounds);
 
+  std::optional<size_t> ComputeFingerprint() const override;
+
+  // Combines the fingerprints of the children into seed, which should
+  // identify the layer type and its own properties. Returns std::nullopt if
+  // any child can't be fingerprinted.
+  std::optional<size_t> FingerprintChildren(size_t seed) const;
+
+  // Whether the properties this layer adds to its fingerprint, not counting
+  // its children, equal those of old_layer, which this layer replaces and so
+  // has the same type. Subclasses that fingerprint properties compare them
+  // here.
+  virtual bool HasSameProperties(const ContainerLayer* old_layer) const {
+    return true;
+  }
+
  private:
+  // Whether layer, whose fingerprint matches old_layer's, has the same
+  // content as old_layer: the same layer types, properties and display lists
+  // throughout the subtree. Fingerprints can collide, so a match is confirmed
+  // before the old paint regions are reused. This walks both subtrees and
+  // compares their display lists, so it is only cheaper than a diff in that
+  // no paint regions or damage are computed.
+  static bool MatchesFingerprintedSubtree(const Layer* layer,
+                                          const Layer* old_layer);
+
   std::vector<std::shared_ptr<Layer>> layers_;
   SkRect child_paint_bounds_;
   int children_renderable_state_flags_ = 0;
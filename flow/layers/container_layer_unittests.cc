@@ -6,6 +6,7 @@
 
 #include "flutter/flow/layers/layer.h"
 #include "flutter/flow/layers/layer_tree.h"
+#include "flutter/flow/layers/transform_layer.h"
 #include "flutter/flow/testing/diff_context_test.h"
 #include "flutter/flow/testing/layer_test.h"
 #include "flutter/flow/testing/mock_layer.h"
@@ -763,6 +764,65 @@ TEST_F(ContainerLayerDiffTest, ReplaceLayer) {
   EXPECT_EQ(damage.frame_damage, SkIRect::MakeLTRB(200, 0, 250, 150));
 }
 
+TEST_F(ContainerLayerDiffTest, RebuiltSubtreeWithSameFingerprint) {
+  auto pic1 = CreateDisplayList(SkRect::MakeLTRB(0, 0, 50, 50));
+  auto pic2 = CreateDisplayList(SkRect::MakeLTRB(100, 0, 150, 50));
+  auto transform = SkMatrix::Translate(10, 10);
+
+  // Like the framework, the container layers of a rebuilt subtree replace
+  // the old ones, while its display list layers are new.
+  auto build_subtree = [&](const sk_sp<DisplayList>& picture,
+                           const SkMatrix& matrix,
+                           const std::shared_ptr<TransformLayer>& old_layer) {
+    auto layer = std::make_shared<TransformLayer>(matrix);
+    auto container = CreateContainerLayer(CreateDisplayListLayer(picture));
+    if (old_layer) {
+      layer->AssignOldLayer(old_layer.get());
+      container->AssignOldLayer(old_layer->layers()[0].get());
+    }
+    layer->Add(container);
+    return layer;
+  };
+
+  MockLayerTree t1;
+  auto t1_subtree = build_subtree(pic1, transform, nullptr);
+  t1.root()->Add(t1_subtree);
+  auto damage = DiffLayerTree(t1, MockLayerTree());
+  EXPECT_EQ(damage.frame_damage, SkIRect::MakeLTRB(10, 10, 60, 60));
+
+  // Rebuilt with the same picture and transform.
+  MockLayerTree t2;
+  auto t2_subtree = build_subtree(pic1, transform, t1_subtree);
+  t2.root()->Add(t2_subtree);
+  EXPECT_EQ(t2_subtree->fingerprint(), t1_subtree->fingerprint());
+  damage = DiffLayerTree(t2, t1);
+  EXPECT_TRUE(damage.frame_damage.isEmpty());
+
+  // The paint regions of the skipped subtree are carried over, so the next
+  // change is diffed against them.
+  MockLayerTree t3;
+  auto t3_subtree = build_subtree(pic2, transform, t2_subtree);
+  t3.root()->Add(t3_subtree);
+  EXPECT_NE(t3_subtree->fingerprint(), t2_subtree->fingerprint());
+  damage = DiffLayerTree(t3, t2);
+  EXPECT_EQ(damage.frame_damage, SkIRect::MakeLTRB(10, 10, 160, 60));
+
+  // A different transform changes the fingerprint.
+  MockLayerTree t4;
+  auto t4_subtree =
+      build_subtree(pic2, SkMatrix::Translate(20, 10), t3_subtree);
+  t4.root()->Add(t4_subtree);
+  EXPECT_NE(t4_subtree->fingerprint(), t3_subtree->fingerprint());
+  damage = DiffLayerTree(t4, t3);
+  EXPECT_EQ(damage.frame_damage, SkIRect::MakeLTRB(110, 10, 170, 60));
+}
+
+TEST_F(ContainerLayerDiffTest, SubtreeWithMockLayerHasNoFingerprint) {
+  auto path = SkPath().addRect(SkRect::MakeLTRB(0, 0, 50, 50));
+  auto layer = CreateContainerLayer(std::make_shared<MockLayer>(path));
+  EXPECT_FALSE(layer->fingerprint().has_value());
+}
+
 }  // namespace testing
 }  // namespace flutter
 
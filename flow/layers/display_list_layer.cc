@@ -4,6 +4,7 @@
 
 #include "flutter/flow/layers/display_list_layer.h"
 
+#include <string_view>
 #include <utility>
 
 #include "flutter/display_list/dl_builder.h"
@@ -12,6 +13,7 @@
 #include "flutter/flow/layers/offscreen_surface.h"
 #include "flutter/flow/raster_cache.h"
 #include "flutter/flow/raster_cache_util.h"
+#include "flutter/fml/hash_combine.h"
 
 namespace flutter {
 
@@ -57,6 +59,14 @@ void DisplayListLayer::Diff(DiffContext* context, const Layer* old_layer) {
   context->SetLayerPaintRegion(this, context->CurrentSubtreeRegion());
 }
 
+std::optional<size_t> DisplayListLayer::ComputeFingerprint() const {
+  if (!display_list_) {
+    return std::nullopt;
+  }
+  return fml::HashCombine(std::string_view("DisplayList"), offset_.fX,
+                          offset_.fY, display_list_->content_hash());
+}
+
 bool DisplayListLayer::Compare(DiffContext::Statistics& statistics,
                                const DisplayListLayer* l1,
                                const DisplayListLayer* l2) {
@@ -103,6 +113,27 @@ void DisplayListLayer::Preroll(PrerollContext* context) {
   set_paint_bounds(bounds_);
 }
 
+bool DisplayListLayer::AddToAtlasBatch(PaintContext& context,
+                                       RasterCacheAtlasBatch& batch) const {
+  if (!context.raster_cache || !display_list_raster_cache_item_) {
+    return false;
+  }
+
+  auto mutator = context.state_stack.save();
+  mutator.translate(offset_.x(), offset_.y());
+  mutator.integralTransform();
+
+  // The batch draws with the default paint, so the layer must not have any
+  // outstanding attributes to apply.
+  DlPaint paint;
+  if (context.state_stack.fill(paint) ||
+      !display_list_raster_cache_item_->AddToAtlasBatch(context, batch)) {
+    return false;
+  }
+  TRACE_EVENT_INSTANT0("flutter", "raster cache hit");
+  return true;
+}
+
 void DisplayListLayer::Paint(PaintContext& context) const {
   FML_DCHECK(display_list_);
   FML_DCHECK(needs_painting(context));
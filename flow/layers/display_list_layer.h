@@ -25,6 +25,8 @@ class DisplayListLayer : public Layer {
 
   DisplayList* display_list() const { return display_list_.get(); }
 
+  const SkPoint& offset() const { return offset_; }
+
   bool IsReplacing(DiffContext* context, const Layer* layer) const override;
 
   void Diff(DiffContext* context, const Layer* old_layer) override;
@@ -37,6 +39,9 @@ class DisplayListLayer : public Layer {
 
   void Paint(PaintContext& context) const override;
 
+  bool AddToAtlasBatch(PaintContext& context,
+                       RasterCacheAtlasBatch& batch) const override;
+
   const DisplayListRasterCacheItem* raster_cache_item() const {
     return display_list_raster_cache_item_.get();
   }
@@ -46,6 +51,9 @@ class DisplayListLayer : public Layer {
                             RasterCacheKeyType::kDisplayList);
   }
 
+ protected:
+  std::optional<size_t> ComputeFingerprint() const override;
+
  private:
   std::unique_ptr<DisplayListRasterCacheItem> display_list_raster_cache_item_;
 
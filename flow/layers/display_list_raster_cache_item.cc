@@ -4,6 +4,7 @@
 
 #include "flutter/flow/layers/display_list_raster_cache_item.h"
 
+#include <algorithm>
 #include <optional>
 #include <utility>
 
@@ -68,13 +69,18 @@ std::unique_ptr<DisplayListRasterCacheItem> DisplayListRasterCacheItem::Make(
                                                       is_complex, will_change);
 }
 
+static DisplayListComplexityCalculator* GetComplexityCalculator(
+    GrDirectContext* gr_context) {
+  return gr_context ? DisplayListComplexityCalculator::GetForBackend(
+                          gr_context->backend())
+                    : DisplayListComplexityCalculator::GetForSoftware();
+}
+
 void DisplayListRasterCacheItem::PrerollSetup(PrerollContext* context,
                                               const SkMatrix& matrix) {
   cache_state_ = CacheState::kNone;
   DisplayListComplexityCalculator* complexity_calculator =
-      context->gr_context ? DisplayListComplexityCalculator::GetForBackend(
-                                context->gr_context->backend())
-                          : DisplayListComplexityCalculator::GetForSoftware();
+      GetComplexityCalculator(context->gr_context);
 
   if (!IsDisplayListWorthRasterizing(display_list(), will_change_, is_complex_,
                                      complexity_calculator)) {
@@ -139,6 +145,20 @@ bool DisplayListRasterCacheItem::Draw(const PaintContext& context,
   return false;
 }
 
+bool DisplayListRasterCacheItem::AddToAtlasBatch(
+    const PaintContext& context,
+    RasterCacheAtlasBatch& batch) const {
+  // Drawing above a platform view has to preserve the rtree, which the batch
+  // can't.
+  if (!context.raster_cache || !context.canvas ||
+      context.rendering_above_platform_view ||
+      cache_state_ != CacheState::kCurrent) {
+    return false;
+  }
+  return context.raster_cache->AddToAtlasBatch(key_id_, *context.canvas,
+                                               batch);
+}
+
 static const auto* flow_type = "RasterCacheFlow::DisplayList";
 
 bool DisplayListRasterCacheItem::TryToPrepareRasterCache(
@@ -156,6 +176,13 @@ bool DisplayListRasterCacheItem::TryToPrepareRasterCache(
       !context.raster_cache->GenerateNewCacheInThisFrame() || !id.has_value()) {
     return false;
   }
+  if (context.raster_cache->max_bytes() != 0 && raster_cost_ == 0) {
+    // The cache weighs the cost of rasterizing against the size of the image
+    // when it has to evict entries to stay within its budget.
+    raster_cost_ = std::max(
+        GetComplexityCalculator(context.gr_context)->Compute(display_list()),
+        1u);
+  }
   SkRect bounds = display_list_->bounds().makeOffset(offset_.x(), offset_.y());
   RasterCache::Context r_context = {
       // clang-format off
@@ -164,6 +191,7 @@ bool DisplayListRasterCacheItem::TryToPrepareRasterCache(
       .matrix             = transformation_matrix_,
       .logical_rect       = bounds,
       .flow_type          = flow_type,
+      .raster_cost        = raster_cost_,
       // clang-format on
   };
   return context.raster_cache->UpdateCacheEntry(
@@ -40,6 +40,11 @@ class DisplayListRasterCacheItem : public RasterCacheItem {
             DlCanvas* canvas,
             const DlPaint* paint) const override;
 
+  // Adds the cached image to |batch| if it is packed into an atlas page. See
+  // |RasterCache::AddToAtlasBatch|.
+  bool AddToAtlasBatch(const PaintContext& context,
+                       RasterCacheAtlasBatch& batch) const;
+
   bool TryToPrepareRasterCache(const PaintContext& context,
                                bool parent_cached = false) const override;
 
@@ -55,6 +60,9 @@ class DisplayListRasterCacheItem : public RasterCacheItem {
   SkPoint offset_;
   bool is_complex_;
   bool will_change_;
+  // The complexity score of the display list, computed once the raster cache
+  // has a byte budget.
+  mutable unsigned int raster_cost_ = 0;
 };
 
 }  // namespace flutter
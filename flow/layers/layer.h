@@ -7,6 +7,7 @@
 
 #include <algorithm>
 #include <memory>
+#include <optional>
 #include <unordered_set>
 #include <vector>
 
@@ -165,6 +166,28 @@ class Layer {
     context->SetLayerPaintRegion(this, context->GetOldLayerPaintRegion(this));
   }
 
+  // Used when diffing a layer whose fingerprint matches the old layer it
+  // replaces. Like PreservePaintRegion, but the paint region is taken from
+  // old_layer.
+  virtual void AdoptPaintRegion(DiffContext* context, const Layer* old_layer) {
+    context->SetLayerPaintRegion(this,
+                                 context->GetOldLayerPaintRegion(old_layer));
+  }
+
+  // A hash of everything that affects how this layer and its subtree diff,
+  // or std::nullopt if the layer can't be fingerprinted. Layers with
+  // different fingerprints have different content. Equal fingerprints are
+  // only a hint, which is confirmed by comparing the subtrees before a layer
+  // replacing an old layer is treated as unchanged. Computed on first use,
+  // which must be after the subtree has been built.
+  std::optional<size_t> fingerprint() const {
+    if (!fingerprint_computed_) {
+      fingerprint_ = ComputeFingerprint();
+      fingerprint_computed_ = true;
+    }
+    return fingerprint_;
+  }
+
   virtual void Preroll(PrerollContext* context) = 0;
 
   // Used during Preroll by layers that employ a saveLayer to manage the
@@ -195,6 +218,15 @@ class Layer {
 
   virtual void Paint(PaintContext& context) const = 0;
 
+  // Used instead of Paint when the layer would only draw an entry of the
+  // raster cache that is packed into an atlas page, so that consecutive
+  // siblings drawn from the same page share a single DrawAtlas call. Returns
+  // false if the layer has to be painted normally.
+  virtual bool AddToAtlasBatch(PaintContext& context,
+                               RasterCacheAtlasBatch& batch) const {
+    return false;
+  }
+
   virtual void PaintChildren(PaintContext& context) const { FML_DCHECK(false); }
 
   bool subtree_has_platform_view() const { return subtree_has_platform_view_; }
@@ -262,11 +294,18 @@ class Layer {
   }
   virtual const testing::MockLayer* as_mock_layer() const { return nullptr; }
 
+ protected:
+  virtual std::optional<size_t> ComputeFingerprint() const {
+    return std::nullopt;
+  }
+
  private:
   SkRect paint_bounds_;
   uint64_t unique_id_;
   uint64_t original_layer_id_;
   bool subtree_has_platform_view_ = false;
+  mutable bool fingerprint_computed_ = false;
+  mutable std::optional<size_t> fingerprint_;
 
   static uint64_t NextUniqueID();
 
@@ -4,8 +4,11 @@
 
 #include "flutter/flow/layers/opacity_layer.h"
 
+#include <string_view>
+
 #include "flutter/flow/layers/cacheable_layer.h"
 #include "flutter/flow/raster_cache_util.h"
+#include "flutter/fml/hash_combine.h"
 #include "third_party/skia/include/core/SkPaint.h"
 
 namespace flutter {
@@ -34,6 +37,16 @@ void OpacityLayer::Diff(DiffContext* context, const Layer* old_layer) {
   context->SetLayerPaintRegion(this, context->CurrentSubtreeRegion());
 }
 
+std::optional<size_t> OpacityLayer::ComputeFingerprint() const {
+  return FingerprintChildren(fml::HashCombine(
+      std::string_view("Opacity"), alpha_, offset_.fX, offset_.fY));
+}
+
+bool OpacityLayer::HasSameProperties(const ContainerLayer* old_layer) const {
+  auto* prev = static_cast<const OpacityLayer*>(old_layer);
+  return alpha_ == prev->alpha_ && offset_ == prev->offset_;
+}
+
 void OpacityLayer::Preroll(PrerollContext* context) {
   auto mutator = context->state_stack.save();
   mutator.translate(offset_);
@@ -47,6 +47,11 @@ class OpacityLayer : public CacheableContainerLayer {
 
   SkScalar opacity() const { return alpha_ * 1.0f / SK_AlphaOPAQUE; }
 
+ protected:
+  std::optional<size_t> ComputeFingerprint() const override;
+
+  bool HasSameProperties(const ContainerLayer* old_layer) const override;
+
  private:
   SkAlpha alpha_;
   SkPoint offset_;
@@ -5,6 +5,9 @@
 #include "flutter/flow/layers/transform_layer.h"
 
 #include <optional>
+#include <string_view>
+
+#include "flutter/fml/hash_combine.h"
 
 namespace flutter {
 
@@ -39,6 +42,21 @@ void TransformLayer::Diff(DiffContext* context, const Layer* old_layer) {
   context->SetLayerPaintRegion(this, context->CurrentSubtreeRegion());
 }
 
+std::optional<size_t> TransformLayer::ComputeFingerprint() const {
+  float matrix[16];
+  transform_.getColMajor(matrix);
+  size_t seed = fml::HashCombine(std::string_view("Transform"));
+  for (float value : matrix) {
+    fml::HashCombineSeed(seed, value);
+  }
+  return FingerprintChildren(seed);
+}
+
+bool TransformLayer::HasSameProperties(const ContainerLayer* old_layer) const {
+  auto* prev = static_cast<const TransformLayer*>(old_layer);
+  return transform_ == prev->transform_;
+}
+
 void TransformLayer::Preroll(PrerollContext* context) {
   auto mutator = context->state_stack.save();
   mutator.transform(transform_);
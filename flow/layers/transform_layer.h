@@ -23,6 +23,11 @@ class TransformLayer : public ContainerLayer {
 
   void Paint(PaintContext& context) const override;
 
+ protected:
+  std::optional<size_t> ComputeFingerprint() const override;
+
+  bool HasSameProperties(const ContainerLayer* old_layer) const override;
+
  private:
   SkM44 transform_;
 
@@ -4,7 +4,9 @@
 
 #include "flutter/flow/raster_cache.h"
 
+#include <algorithm>
 #include <cstddef>
+#include <limits>
 #include <vector>
 
 #include "flutter/common/constants.h"
@@ -12,6 +14,7 @@
 #include "flutter/flow/layers/container_layer.h"
 #include "flutter/flow/layers/layer.h"
 #include "flutter/flow/paint_utils.h"
+#include "flutter/flow/raster_cache_atlas.h"
 #include "flutter/flow/raster_cache_util.h"
 #include "flutter/fml/logging.h"
 #include "flutter/fml/trace_event.h"
@@ -24,6 +27,15 @@
 
 namespace flutter {
 
+// The raster cost assumed for entries that don't provide one, such as layers.
+// This is the complexity score above which display lists are worth caching
+// on the GPU backends, or roughly a millisecond of rasterization.
+static constexpr unsigned int kDefaultRasterCost = 200000;
+
+static size_t EstimateImageBytes(SkISize dimensions) {
+  return static_cast<size_t>(dimensions.width()) * dimensions.height() * 4;
+}
+
 RasterCacheResult::RasterCacheResult(sk_sp<DlImage> image,
                                      const SkRect& logical_rect,
                                      const char* type,
@@ -73,6 +85,8 @@ RasterCache::RasterCache(size_t access_threshold,
     : access_threshold_(access_threshold),
       display_list_cache_limit_per_frame_(display_list_cache_limit_per_frame) {}
 
+RasterCache::~RasterCache() = default;
+
 /// @note Procedure doesn't copy all closures.
 std::unique_ptr<RasterCacheResult> RasterCache::Rasterize(
     const RasterCache::Context& context,
@@ -120,23 +134,139 @@ bool RasterCache::UpdateCacheEntry(
     sk_sp<const DlRTree> rtree) const {
   RasterCacheKey key = RasterCacheKey(id, raster_cache_context.matrix);
   Entry& entry = cache_[key];
-  if (!entry.image) {
-    void (*func)(DlCanvas*, const SkRect& rect) = DrawCheckerboard;
+  if (entry.image) {
+    return true;
+  }
+  if (defer_entry_rasterization_ &&
+      id.type() == RasterCacheKeyType::kDisplayList) {
+    if (!entry.deferred) {
+      entry.deferred = std::make_unique<Entry::Deferred>(Entry::Deferred{
+          .gr_context = raster_cache_context.gr_context,
+          .dst_color_space = raster_cache_context.dst_color_space,
+          .matrix = raster_cache_context.matrix,
+          .logical_rect = raster_cache_context.logical_rect,
+          .flow_type = raster_cache_context.flow_type,
+          .raster_cost = raster_cache_context.raster_cost,
+          .render_function = render_function,
+          .rtree = std::move(rtree),
+      });
+      deferred_keys_.push_back(key);
+      // Deferred entries count against the per frame limit so that the
+      // queue can't grow faster than the synchronous path would cache.
+      display_list_cached_this_frame_++;
+    }
+    return false;
+  }
+  return RasterizeEntry(entry, id.type(), raster_cache_context,
+                        render_function, std::move(rtree));
+}
+
+bool RasterCache::RasterizeEntry(
+    Entry& entry,
+    RasterCacheKeyType type,
+    const Context& raster_cache_context,
+    const std::function<void(DlCanvas*)>& render_function,
+    sk_sp<const DlRTree> rtree) const {
+  FML_DCHECK(!entry.image);
+  entry.raster_cost = raster_cache_context.raster_cost;
+  if (max_bytes_ != 0) {
+    auto matrix =
+        RasterCacheUtil::GetIntegralTransCTM(raster_cache_context.matrix);
+    SkRect dest_rect = RasterCacheUtil::GetRoundedOutDeviceBounds(
+        raster_cache_context.logical_rect, matrix);
+    size_t bytes = EstimateImageBytes(
+        SkISize::Make(dest_rect.width(), dest_rect.height()));
+    if (!EvictToFit(bytes, GetRetentionRank(entry.raster_cost, bytes, 0))) {
+      return false;
+    }
+  }
+  void (*func)(DlCanvas*, const SkRect& rect) = DrawCheckerboard;
+  if (atlas_) {
+    entry.image = atlas_->Rasterize(raster_cache_context, rtree,
+                                    render_function, func,
+                                    checkerboard_images_);
+  }
+  if (entry.image == nullptr) {
     entry.image = Rasterize(raster_cache_context, std::move(rtree),
                             render_function, func);
-    if (entry.image != nullptr) {
-      switch (id.type()) {
-        case RasterCacheKeyType::kDisplayList: {
-          display_list_cached_this_frame_++;
-          break;
-        }
-        default:
-          break;
-      }
-      return true;
+  }
+  if (entry.image == nullptr) {
+    return false;
+  }
+  switch (type) {
+    case RasterCacheKeyType::kDisplayList: {
+      display_list_cached_this_frame_++;
+      break;
+    }
+    default:
+      break;
+  }
+  return true;
+}
+
+void RasterCache::SetDeferEntryRasterization(bool defer) {
+  defer_entry_rasterization_ = defer;
+}
+
+size_t RasterCache::RasterizeDeferredEntries(fml::TimePoint deadline) {
+  if (deferred_keys_.empty()) {
+    return 0;
+  }
+  TRACE_EVENT0("flutter", "RasterCache::RasterizeDeferredEntries");
+
+  size_t rasterized_count = 0;
+  fml::TimeDelta rasterized_duration;
+  std::deque<RasterCacheKey> still_deferred;
+  while (!deferred_keys_.empty()) {
+    RasterCacheKey key = deferred_keys_.front();
+    deferred_keys_.pop_front();
+    auto it = cache_.find(key);
+    if (it == cache_.end() || !it->second.deferred) {
+      continue;
+    }
+    Entry& entry = it->second;
+    if (entry.image || entry.frames_since_encountered != 0) {
+      entry.deferred.reset();
+      continue;
+    }
+    Entry::Deferred& deferred = *entry.deferred;
+    const fml::TimePoint start = fml::TimePoint::Now();
+    if (start >= deadline && deferred.frames_waited < kMaxFramesToDefer) {
+      deferred.frames_waited++;
+      still_deferred.push_back(key);
+      continue;
+    }
+    Context context = {
+        // clang-format off
+        .gr_context         = deferred.gr_context,
+        .dst_color_space    = deferred.dst_color_space,
+        .matrix             = deferred.matrix,
+        .logical_rect       = deferred.logical_rect,
+        .flow_type          = deferred.flow_type,
+        .raster_cost        = deferred.raster_cost,
+        // clang-format on
+    };
+    if (RasterizeEntry(entry, key.id().type(), context,
+                       deferred.render_function, deferred.rtree)) {
+      rasterized_count++;
+      rasterized_duration =
+          rasterized_duration + (fml::TimePoint::Now() - start);
     }
+    entry.deferred.reset();
   }
-  return entry.image != nullptr;
+  deferred_keys_ = std::move(still_deferred);
+
+#if !FLUTTER_RELEASE
+  // The rasterization time is what these entries would have added to the
+  // frames that decided to cache them.
+  FML_TRACE_COUNTER(
+      "flutter",                                                   //
+      "RasterCacheDeferred", reinterpret_cast<int64_t>(this),      //
+      "Rasterized", rasterized_count,                              //
+      "Pending", deferred_keys_.size(),                            //
+      "SavedFrameMicros", rasterized_duration.ToMicroseconds());
+#endif  // !FLUTTER_RELEASE
+  return rasterized_count;
 }
 
 RasterCache::CacheInfo RasterCache::MarkSeen(const RasterCacheKeyID& id,
@@ -190,31 +320,134 @@ bool RasterCache::Draw(const RasterCacheKeyID& id,
   return false;
 }
 
+void RasterCache::SetUseAtlas(bool use_atlas) {
+  if (!use_atlas || !RasterCacheAtlas::IsSupported()) {
+    // Entries that are already packed keep their pages alive.
+    atlas_ = nullptr;
+  } else if (!atlas_) {
+    atlas_ = std::make_unique<RasterCacheAtlas>();
+  }
+}
+
+size_t RasterCache::GetAtlasPageCount() const {
+  return atlas_ ? atlas_->page_count() : 0;
+}
+
+bool RasterCache::AddToAtlasBatch(const RasterCacheKeyID& id,
+                                  DlCanvas& canvas,
+                                  RasterCacheAtlasBatch& batch) const {
+  auto it = cache_.find(RasterCacheKey(id, canvas.GetTransform()));
+  if (it == cache_.end() || !it->second.image) {
+    return false;
+  }
+  const RasterCacheAtlasResult* result = it->second.image->as_atlas_result();
+  if (!result) {
+    return false;
+  }
+  batch.Add(canvas, *result);
+  return true;
+}
+
 void RasterCache::BeginFrame() {
   display_list_cached_this_frame_ = 0;
   picture_metrics_ = {};
   layer_metrics_ = {};
 }
 
+void RasterCache::SetMaxBytes(size_t max_bytes) {
+  max_bytes_ = max_bytes;
+}
+
 void RasterCache::UpdateMetrics() {
   for (auto it = cache_.begin(); it != cache_.end(); ++it) {
     Entry& entry = it->second;
-    FML_DCHECK(entry.encountered_this_frame);
+    FML_DCHECK(entry.encountered_this_frame || max_bytes_ != 0);
     if (entry.image) {
       RasterCacheMetrics& metrics = GetMetricsForKind(it->first.kind());
-      metrics.in_use_count++;
-      metrics.in_use_bytes += entry.image->image_bytes();
+      if (entry.encountered_this_frame) {
+        metrics.in_use_count++;
+        metrics.in_use_bytes += entry.image->image_bytes();
+      } else {
+        metrics.retained_count++;
+        metrics.retained_bytes += entry.image->image_bytes();
+      }
     }
+    entry.frames_since_encountered =
+        entry.encountered_this_frame ? 0 : entry.frames_since_encountered + 1;
     entry.encountered_this_frame = false;
   }
 }
 
+double RasterCache::GetRetentionRank(unsigned int raster_cost,
+                                     size_t bytes,
+                                     size_t frames_offscreen) {
+  // The raster cost saved per byte, discounted for entries that haven't been
+  // needed for a while.
+  return static_cast<double>(raster_cost ? raster_cost : kDefaultRasterCost) /
+         (std::max<size_t>(bytes, 1) * (1.0 + frames_offscreen));
+}
+
+double RasterCache::GetRetentionRank(const Entry& entry) const {
+  FML_DCHECK(entry.image);
+  size_t frames_offscreen =
+      entry.encountered_this_frame ? 0 : entry.frames_since_encountered + 1;
+  // Rank by the same estimate that is used for new entries, so that equal
+  // content never evicts itself.
+  return GetRetentionRank(entry.raster_cost,
+                          EstimateImageBytes(entry.image->image_dimensions()),
+                          frames_offscreen);
+}
+
+bool RasterCache::EvictToFit(size_t bytes, double rank) const {
+  size_t cached_bytes =
+      EstimateLayerCacheByteSize() + EstimatePictureCacheByteSize();
+  if (cached_bytes + bytes <= max_bytes_) {
+    return true;
+  }
+  size_t bytes_to_evict = cached_bytes + bytes - max_bytes_;
+
+  std::vector<std::pair<double, RasterCacheKey::Map<Entry>::iterator>>
+      candidates;
+  size_t evictable_bytes = 0;
+  for (auto it = cache_.begin(); it != cache_.end(); ++it) {
+    if (!it->second.image) {
+      continue;
+    }
+    double entry_rank = GetRetentionRank(it->second);
+    if (entry_rank < rank) {
+      candidates.emplace_back(entry_rank, it);
+      evictable_bytes += it->second.image->image_bytes();
+    }
+  }
+  if (evictable_bytes < bytes_to_evict) {
+    return false;
+  }
+
+  std::sort(candidates.begin(), candidates.end(),
+            [](const auto& a, const auto& b) { return a.first < b.first; });
+  size_t evicted_bytes = 0;
+  for (auto& [entry_rank, it] : candidates) {
+    if (evicted_bytes >= bytes_to_evict) {
+      break;
+    }
+    size_t image_bytes = it->second.image->image_bytes();
+    RasterCacheMetrics& metrics = GetMetricsForKind(it->first.kind());
+    metrics.eviction_count++;
+    metrics.eviction_bytes += image_bytes;
+    evicted_bytes += image_bytes;
+    it->second.image.reset();
+  }
+  return true;
+}
+
 void RasterCache::EvictUnusedCacheEntries() {
   std::vector<RasterCacheKey::Map<Entry>::iterator> dead;
 
   for (auto it = cache_.begin(); it != cache_.end(); ++it) {
     Entry& entry = it->second;
-    if (!entry.encountered_this_frame) {
+    if (!entry.encountered_this_frame &&
+        (max_bytes_ == 0 ||
+         entry.frames_since_encountered >= kOffscreenFramesToKeep)) {
       dead.push_back(it);
     }
   }
@@ -227,15 +460,27 @@ void RasterCache::EvictUnusedCacheEntries() {
     }
     cache_.erase(it);
   }
+
+  if (max_bytes_ != 0) {
+    // The budget may have been lowered since the last frame.
+    EvictToFit(0, std::numeric_limits<double>::infinity());
+  }
 }
 
 void RasterCache::EndFrame() {
   UpdateMetrics();
+  if (atlas_) {
+    atlas_->ReleaseEmptyPages();
+  }
   TraceStatsToTimeline();
 }
 
 void RasterCache::Clear() {
   cache_.clear();
+  deferred_keys_.clear();
+  if (atlas_) {
+    atlas_->Clear();
+  }
   picture_metrics_ = {};
   layer_metrics_ = {};
 }
@@ -311,7 +556,8 @@ size_t RasterCache::EstimatePictureCacheByteSize() const {
   return picture_cache_bytes;
 }
 
-RasterCacheMetrics& RasterCache::GetMetricsForKind(RasterCacheKeyKind kind) {
+RasterCacheMetrics& RasterCache::GetMetricsForKind(
+    RasterCacheKeyKind kind) const {
   switch (kind) {
     case RasterCacheKeyKind::kDisplayListMetrics:
       return picture_metrics_;
@@ -5,6 +5,7 @@
 #ifndef FLUTTER_FLOW_RASTER_CACHE_H_
 #define FLUTTER_FLOW_RASTER_CACHE_H_
 
+#include <deque>
 #include <memory>
 #include <unordered_map>
 
@@ -13,6 +14,7 @@
 #include "flutter/flow/raster_cache_util.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/memory/weak_ptr.h"
+#include "flutter/fml/time/time_point.h"
 #include "flutter/fml/trace_event.h"
 #include "third_party/skia/include/core/SkMatrix.h"
 #include "third_party/skia/include/core/SkRect.h"
@@ -24,6 +26,10 @@ namespace flutter {
 
 enum class RasterCacheLayerStrategy { kLayer, kLayerChildren };
 
+class RasterCacheAtlas;
+class RasterCacheAtlasBatch;
+class RasterCacheAtlasResult;
+
 class RasterCacheResult {
  public:
   RasterCacheResult(sk_sp<DlImage> image,
@@ -45,7 +51,12 @@ class RasterCacheResult {
     return image_ ? image_->GetApproximateByteSize() : 0;
   };
 
- private:
+  // Returns this result if it is packed into a |RasterCacheAtlas| page.
+  virtual const RasterCacheAtlasResult* as_atlas_result() const {
+    return nullptr;
+  }
+
+ protected:
   sk_sp<DlImage> image_;
   SkRect logical_rect_;
   fml::tracing::TraceFlow flow_;
@@ -78,15 +89,27 @@ struct RasterCacheMetrics {
    */
   size_t in_use_bytes = 0;
 
+  /**
+   * The number of cache entries with images that were not used in this frame
+   * but are kept because the cache has a byte budget.
+   */
+  size_t retained_count = 0;
+
+  /**
+   * The size of all of the images that were not used in this frame but are
+   * kept because the cache has a byte budget.
+   */
+  size_t retained_bytes = 0;
+
   /**
    * The total cache entries that had images during this frame.
    */
-  size_t total_count() const { return in_use_count; }
+  size_t total_count() const { return in_use_count + retained_count; }
 
   /**
    * The size of all of the cached images during this frame.
    */
-  size_t total_bytes() const { return in_use_bytes; }
+  size_t total_bytes() const { return in_use_bytes + retained_bytes; }
 };
 
 /**
@@ -121,6 +144,9 @@ class RasterCache {
     const SkMatrix& matrix;
     const SkRect& logical_rect;
     const char* flow_type;
+    // The estimated cost of rasterizing the content without the cache, as a
+    // DisplayListComplexityCalculator score, or 0 if unknown.
+    const unsigned int raster_cost = 0;
   };
   struct CacheInfo {
     const size_t accesses_since_visible;
@@ -139,7 +165,7 @@ class RasterCache {
       size_t picture_and_display_list_cache_limit_per_frame =
           RasterCacheUtil::kDefaultPictureAndDisplayListCacheLimitPerFrame);
 
-  virtual ~RasterCache() = default;
+  virtual ~RasterCache();
 
   // Draws this item if it should be rendered from the cache and returns
   // true iff it was successfully drawn. Typically this should only fail
@@ -158,12 +184,88 @@ class RasterCache {
 
   bool HasEntry(const RasterCacheKeyID& id, const SkMatrix&) const;
 
+  /**
+   * @brief Packs new entries that are small enough into shared atlas pages
+   * instead of giving each its own image, if |RasterCacheAtlas::IsSupported|.
+   * Defaults to false.
+   */
+  void SetUseAtlas(bool use_atlas);
+
+  bool uses_atlas() const { return atlas_ != nullptr; }
+
+  size_t GetAtlasPageCount() const;
+
+  /**
+   * @brief Adds the entry to |batch| instead of drawing it, if it is packed
+   * into an atlas page. Entries in the same batch are drawn with a single
+   * |DlCanvas::DrawAtlas| call when it is flushed.
+   * @return false if the entry doesn't exist or isn't in an atlas page, in
+   * which case it has to be drawn with |Draw|.
+   */
+  bool AddToAtlasBatch(const RasterCacheKeyID& id,
+                       DlCanvas& canvas,
+                       RasterCacheAtlasBatch& batch) const;
+
   void BeginFrame();
 
+  /**
+   * @brief The number of frames that entries which are no longer encountered
+   * are kept for when the cache has a byte budget. Content that scrolls
+   * offscreen and back within this time isn't rasterized again.
+   */
+  static constexpr size_t kOffscreenFramesToKeep = 30;
+
+  /**
+   * @brief Limits the total size of the cached images to |max_bytes|, or
+   * removes the limit if it is 0, which is the default.
+   *
+   * Without a limit, entries are evicted as soon as a frame doesn't encounter
+   * them. With a limit, they are kept for |kOffscreenFramesToKeep| frames.
+   * Entries are ranked by the raster cost they save per byte, discounted for
+   * every frame they have been offscreen. When the cache is over the limit,
+   * or a new image doesn't fit it, the lowest ranked images are evicted
+   * first. A new image is only created if it ranks higher than the images
+   * that have to be evicted to make room for it.
+   */
+  void SetMaxBytes(size_t max_bytes);
+
+  size_t max_bytes() const { return max_bytes_; }
+
   void EvictUnusedCacheEntries();
 
   void EndFrame();
 
+  /**
+   * @brief The number of frames a deferred entry waits for idle time before
+   * it is rasterized regardless, so that caching doesn't starve while every
+   * frame uses its whole budget.
+   */
+  static constexpr size_t kMaxFramesToDefer = 3;
+
+  /**
+   * @brief Whether new display list entries are rasterized by
+   * |RasterizeDeferredEntries| after the frame that decides to cache them is
+   * submitted, instead of synchronously within that frame. Until their image
+   * is ready, display lists are drawn directly. Defaults to false.
+   */
+  void SetDeferEntryRasterization(bool defer);
+
+  bool defers_entry_rasterization() const {
+    return defer_entry_rasterization_;
+  }
+
+  /**
+   * @brief Rasterizes the entries deferred by the previous frames, in the
+   * order they were deferred, until |deadline|. Entries that the last frame
+   * didn't encounter are dropped. Entries that have waited for
+   * |kMaxFramesToDefer| frames are rasterized even after the deadline.
+   *
+   * Must be called after |EndFrame| with the context that the cached images
+   * are created in current.
+   * @return the number of entries that were rasterized.
+   */
+  size_t RasterizeDeferredEntries(fml::TimePoint deadline);
+
   void Clear();
 
   void SetCheckboardCacheImages(bool checkerboard);
@@ -251,18 +353,57 @@ class RasterCache {
     bool encountered_this_frame = false;
     bool visible_this_frame = false;
     size_t accesses_since_visible = 0;
+    // The number of frames before this one that didn't encounter the entry.
+    size_t frames_since_encountered = 0;
+    unsigned int raster_cost = 0;
     std::unique_ptr<RasterCacheResult> image;
+    // Everything needed to rasterize the entry after the frame, while its
+    // rasterization is deferred.
+    struct Deferred {
+      GrDirectContext* gr_context;
+      sk_sp<SkColorSpace> dst_color_space;
+      SkMatrix matrix;
+      SkRect logical_rect;
+      const char* flow_type;
+      unsigned int raster_cost;
+      std::function<void(DlCanvas*)> render_function;
+      sk_sp<const DlRTree> rtree;
+      size_t frames_waited = 0;
+    };
+    std::unique_ptr<Deferred> deferred;
   };
 
+  bool RasterizeEntry(Entry& entry,
+                      RasterCacheKeyType type,
+                      const Context& raster_cache_context,
+                      const std::function<void(DlCanvas*)>& render_function,
+                      sk_sp<const DlRTree> rtree) const;
+
   void UpdateMetrics();
 
-  RasterCacheMetrics& GetMetricsForKind(RasterCacheKeyKind kind);
+  RasterCacheMetrics& GetMetricsForKind(RasterCacheKeyKind kind) const;
+
+  // The rank of an entry of |bytes| size for eviction. Entries with lower
+  // ranks are evicted first.
+  static double GetRetentionRank(unsigned int raster_cost,
+                                 size_t bytes,
+                                 size_t frames_offscreen);
+  double GetRetentionRank(const Entry& entry) const;
+
+  // Evicts images ranked lower than |rank|, lowest first, until |bytes| more
+  // fit the byte budget. Evicts nothing and returns false if that isn't
+  // possible.
+  bool EvictToFit(size_t bytes, double rank) const;
 
   const size_t access_threshold_;
   const size_t display_list_cache_limit_per_frame_;
   mutable size_t display_list_cached_this_frame_ = 0;
-  RasterCacheMetrics layer_metrics_;
-  RasterCacheMetrics picture_metrics_;
+  size_t max_bytes_ = 0;
+  bool defer_entry_rasterization_ = false;
+  mutable std::deque<RasterCacheKey> deferred_keys_;
+  std::unique_ptr<RasterCacheAtlas> atlas_;
+  mutable RasterCacheMetrics layer_metrics_;
+  mutable RasterCacheMetrics picture_metrics_;
   mutable RasterCacheKey::Map<Entry> cache_;
   bool checkerboard_images_ = false;
 
@@ -0,0 +1,285 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/flow/raster_cache_atlas.h"
+
+#include <algorithm>
+
+#include "flutter/display_list/skia/dl_sk_canvas.h"
+#include "flutter/flow/raster_cache_util.h"
+#include "flutter/fml/logging.h"
+#include "flutter/fml/trace_event.h"
+#include "third_party/skia/include/core/SkColorSpace.h"
+#include "third_party/skia/include/core/SkImage.h"
+#include "third_party/skia/include/core/SkSurface.h"
+#include "third_party/skia/include/gpu/GrDirectContext.h"
+#include "third_party/skia/include/gpu/ganesh/SkSurfaceGanesh.h"
+
+#if IMPELLER_SUPPORTS_RENDERING
+#include "impeller/typographer/rectangle_packer.h"  // nogncheck
+#endif  // IMPELLER_SUPPORTS_RENDERING
+
+namespace flutter {
+
+RasterCacheAtlasResult::RasterCacheAtlasResult(
+    std::shared_ptr<RasterCacheAtlasPage> page,
+    const SkIRect& page_rect,
+    const SkRect& logical_rect,
+    const char* type,
+    sk_sp<const DlRTree> rtree)
+    : RasterCacheResult(nullptr, logical_rect, type, std::move(rtree)),
+      page_(std::move(page)),
+      page_rect_(page_rect) {}
+
+RasterCacheAtlasResult::~RasterCacheAtlasResult() {
+  page_->Release();
+}
+
+SkRect RasterCacheAtlasResult::GetDeviceRect(const SkMatrix& ctm) const {
+  auto matrix = RasterCacheUtil::GetIntegralTransCTM(ctm);
+  SkRect bounds =
+      RasterCacheUtil::GetRoundedOutDeviceBounds(logical_rect_, matrix);
+  FML_DCHECK(std::abs(bounds.width() - page_rect_.width()) <= 1 &&
+             std::abs(bounds.height() - page_rect_.height()) <= 1);
+  return SkRect::MakeXYWH(bounds.fLeft, bounds.fTop, page_rect_.width(),
+                          page_rect_.height());
+}
+
+void RasterCacheAtlasResult::draw(DlCanvas& canvas,
+                                  const DlPaint* paint,
+                                  bool preserve_rtree) const {
+  DlAutoCanvasRestore auto_restore(&canvas, true);
+
+  auto matrix = RasterCacheUtil::GetIntegralTransCTM(canvas.GetTransform());
+  SkRect device_rect = GetDeviceRect(matrix);
+  canvas.TransformReset();
+  flow_.Step();
+  const sk_sp<DlImage>& image = page_->GetImage();
+  if (!preserve_rtree || !rtree_) {
+    canvas.DrawImageRect(image, SkRect::Make(page_rect_), device_rect,
+                         DlImageSampling::kNearestNeighbor, paint);
+    return;
+  }
+  // Same as |RasterCacheResult::draw|, with the rects offset into the page.
+  canvas.Translate(device_rect.fLeft, device_rect.fTop);
+  SkRect rtree_bounds =
+      RasterCacheUtil::GetRoundedOutDeviceBounds(rtree_->bounds(), matrix);
+  for (auto rect : rtree_->region().getRects(true)) {
+    SkRect rect_in_entry = RasterCacheUtil::GetRoundedOutDeviceBounds(
+        SkRect::Make(rect), matrix);
+    rect_in_entry.offset(-rtree_bounds.fLeft, -rtree_bounds.fTop);
+    canvas.DrawImageRect(
+        image, rect_in_entry.makeOffset(page_rect_.fLeft, page_rect_.fTop),
+        rect_in_entry, DlImageSampling::kNearestNeighbor, paint);
+  }
+}
+
+RasterCacheAtlasPage::RasterCacheAtlasPage(sk_sp<SkSurface> surface,
+                                           GrDirectContext* gr_context,
+                                           sk_sp<SkColorSpace> color_space)
+    : surface_(std::move(surface)),
+      gr_context_(gr_context),
+      color_space_(std::move(color_space)),
+      canvas_(std::make_unique<DlSkCanvasAdapter>(surface_->getCanvas())) {
+#if IMPELLER_SUPPORTS_RENDERING
+  packer_ = impeller::RectanglePacker::Factory(surface_->width(),
+                                               surface_->height());
+#endif  // IMPELLER_SUPPORTS_RENDERING
+}
+
+RasterCacheAtlasPage::~RasterCacheAtlasPage() {
+  FML_DCHECK(is_empty());
+}
+
+bool RasterCacheAtlasPage::IsCompatible(
+    GrDirectContext* gr_context,
+    const SkColorSpace* color_space) const {
+  return gr_context_ == gr_context &&
+         SkColorSpace::Equals(color_space_.get(), color_space);
+}
+
+bool RasterCacheAtlasPage::Allocate(int width, int height, SkIRect* page_rect) {
+#if IMPELLER_SUPPORTS_RENDERING
+  impeller::IPoint16 location;
+  if (!packer_->addRect(width, height, &location)) {
+    return false;
+  }
+  *page_rect = SkIRect::MakeXYWH(location.x(), location.y(), width, height);
+  live_allocations_++;
+  return true;
+#else
+  return false;
+#endif  // IMPELLER_SUPPORTS_RENDERING
+}
+
+void RasterCacheAtlasPage::Release() {
+  FML_DCHECK(live_allocations_ > 0);
+  if (--live_allocations_ == 0) {
+#if IMPELLER_SUPPORTS_RENDERING
+    // The packer can't free individual regions, but once nothing refers to
+    // the page any more, all of it can be reused.
+    packer_->reset();
+#endif  // IMPELLER_SUPPORTS_RENDERING
+  }
+}
+
+DlCanvas* RasterCacheAtlasPage::BeginDrawing(const SkIRect& page_rect) {
+  // Dropping the snapshot first lets the surface draw in place instead of
+  // copying the page if nothing else refers to the snapshot.
+  image_ = nullptr;
+  canvas_->Save();
+  canvas_->ClipRect(SkRect::Make(page_rect), DlCanvas::ClipOp::kIntersect,
+                    false);
+  canvas_->Clear(DlColor::kTransparent());
+  canvas_->Translate(page_rect.fLeft, page_rect.fTop);
+  return canvas_.get();
+}
+
+void RasterCacheAtlasPage::EndDrawing() {
+  canvas_->Restore();
+}
+
+const sk_sp<DlImage>& RasterCacheAtlasPage::GetImage() {
+  if (!image_) {
+    image_ = DlImage::Make(surface_->makeImageSnapshot());
+  }
+  return image_;
+}
+
+bool RasterCacheAtlas::IsSupported() {
+#if IMPELLER_SUPPORTS_RENDERING
+  return true;
+#else
+  return false;
+#endif  // IMPELLER_SUPPORTS_RENDERING
+}
+
+RasterCacheAtlas::RasterCacheAtlas() = default;
+
+RasterCacheAtlas::~RasterCacheAtlas() = default;
+
+std::unique_ptr<RasterCacheResult> RasterCacheAtlas::Rasterize(
+    const RasterCache::Context& context,
+    sk_sp<const DlRTree> rtree,
+    const std::function<void(DlCanvas*)>& draw_function,
+    const std::function<void(DlCanvas*, const SkRect& rect)>&
+        draw_checkerboard,
+    bool checkerboard) {
+  if (!IsSupported()) {
+    return nullptr;
+  }
+  auto matrix = RasterCacheUtil::GetIntegralTransCTM(context.matrix);
+  SkRect dest_rect =
+      RasterCacheUtil::GetRoundedOutDeviceBounds(context.logical_rect, matrix);
+  const int width = dest_rect.width();
+  const int height = dest_rect.height();
+  if (width <= 0 || height <= 0 || width > kMaxEntrySize ||
+      height > kMaxEntrySize) {
+    return nullptr;
+  }
+
+  std::shared_ptr<RasterCacheAtlasPage> page;
+  SkIRect page_rect;
+  for (const auto& candidate : pages_) {
+    if (candidate->IsCompatible(context.gr_context,
+                                context.dst_color_space.get()) &&
+        candidate->Allocate(width, height, &page_rect)) {
+      page = candidate;
+      break;
+    }
+  }
+  if (!page) {
+    if (pages_.size() >= kMaxPages) {
+      return nullptr;
+    }
+    TRACE_EVENT0("flutter", "RasterCacheAtlas::AddPage");
+    const SkImageInfo image_info = SkImageInfo::MakeN32Premul(
+        kPageSize, kPageSize, context.dst_color_space);
+    sk_sp<SkSurface> surface =
+        context.gr_context
+            ? SkSurfaces::RenderTarget(context.gr_context,
+                                       skgpu::Budgeted::kYes, image_info)
+            : SkSurfaces::Raster(image_info);
+    if (!surface) {
+      return nullptr;
+    }
+    page = std::make_shared<RasterCacheAtlasPage>(
+        std::move(surface), context.gr_context, context.dst_color_space);
+    if (!page->Allocate(width, height, &page_rect)) {
+      return nullptr;
+    }
+    pages_.push_back(page);
+  }
+
+  DlCanvas* canvas = page->BeginDrawing(page_rect);
+  canvas->Translate(-dest_rect.left(), -dest_rect.top());
+  canvas->Transform(matrix);
+  draw_function(canvas);
+  if (checkerboard) {
+    draw_checkerboard(canvas, context.logical_rect);
+  }
+  page->EndDrawing();
+
+  return std::make_unique<RasterCacheAtlasResult>(
+      std::move(page), page_rect, context.logical_rect, context.flow_type,
+      std::move(rtree));
+}
+
+void RasterCacheAtlas::ReleaseEmptyPages() {
+  bool kept_empty_page = false;
+  pages_.erase(std::remove_if(pages_.begin(), pages_.end(),
+                              [&kept_empty_page](const auto& page) {
+                                if (!page->is_empty()) {
+                                  return false;
+                                }
+                                if (!kept_empty_page) {
+                                  kept_empty_page = true;
+                                  return false;
+                                }
+                                return true;
+                              }),
+               pages_.end());
+}
+
+void RasterCacheAtlas::Clear() {
+  // Results that are still alive keep their pages until they are released.
+  pages_.clear();
+}
+
+RasterCacheAtlasBatch::RasterCacheAtlasBatch() = default;
+
+RasterCacheAtlasBatch::~RasterCacheAtlasBatch() {
+  Flush();
+}
+
+void RasterCacheAtlasBatch::Add(DlCanvas& canvas,
+                                const RasterCacheAtlasResult& result) {
+  if (canvas_ != &canvas || page_ != result.page().get()) {
+    Flush();
+    canvas_ = &canvas;
+    page_ = result.page().get();
+    image_ = result.page()->GetImage();
+  }
+  SkRect device_rect = result.GetDeviceRect(canvas.GetTransform());
+  xforms_.push_back(
+      SkRSXform::Make(1, 0, device_rect.fLeft, device_rect.fTop));
+  tex_rects_.push_back(SkRect::Make(result.page_rect()));
+}
+
+void RasterCacheAtlasBatch::Flush() {
+  if (!xforms_.empty()) {
+    DlAutoCanvasRestore auto_restore(canvas_, true);
+    canvas_->TransformReset();
+    canvas_->DrawAtlas(image_, xforms_.data(), tex_rects_.data(), nullptr,
+                       xforms_.size(), DlBlendMode::kSrcOver,
+                       DlImageSampling::kNearestNeighbor, nullptr);
+    xforms_.clear();
+    tex_rects_.clear();
+  }
+  canvas_ = nullptr;
+  page_ = nullptr;
+  image_ = nullptr;
+}
+
+}  // namespace flutter
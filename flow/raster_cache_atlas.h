@@ -0,0 +1,194 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FLOW_RASTER_CACHE_ATLAS_H_
+#define FLUTTER_FLOW_RASTER_CACHE_ATLAS_H_
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "flutter/display_list/dl_canvas.h"
+#include "flutter/flow/raster_cache.h"
+#include "flutter/fml/macros.h"
+#include "third_party/skia/include/core/SkRSXform.h"
+#include "third_party/skia/include/core/SkRect.h"
+
+class SkSurface;
+
+namespace impeller {
+class RectanglePacker;
+}  // namespace impeller
+
+namespace flutter {
+
+class RasterCacheAtlasPage;
+
+//------------------------------------------------------------------------------
+/// A raster cache entry that is a region of a shared atlas page rather than an
+/// image of its own.
+///
+class RasterCacheAtlasResult : public RasterCacheResult {
+ public:
+  RasterCacheAtlasResult(std::shared_ptr<RasterCacheAtlasPage> page,
+                         const SkIRect& page_rect,
+                         const SkRect& logical_rect,
+                         const char* type,
+                         sk_sp<const DlRTree> rtree = nullptr);
+
+  ~RasterCacheAtlasResult() override;
+
+  void draw(DlCanvas& canvas,
+            const DlPaint* paint,
+            bool preserve_rtree) const override;
+
+  SkISize image_dimensions() const override { return page_rect_.size(); }
+
+  int64_t image_bytes() const override {
+    return static_cast<int64_t>(page_rect_.width()) * page_rect_.height() * 4;
+  }
+
+  const RasterCacheAtlasResult* as_atlas_result() const override {
+    return this;
+  }
+
+  const std::shared_ptr<RasterCacheAtlasPage>& page() const { return page_; }
+
+  const SkIRect& page_rect() const { return page_rect_; }
+
+  // The rect the entry covers in device space when drawn with |ctm|.
+  SkRect GetDeviceRect(const SkMatrix& ctm) const;
+
+ private:
+  std::shared_ptr<RasterCacheAtlasPage> page_;
+  SkIRect page_rect_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(RasterCacheAtlasResult);
+};
+
+//------------------------------------------------------------------------------
+/// A surface that small raster cache entries are packed into. Packed regions
+/// can't be reused individually, so the page is only reset once all of its
+/// entries have been released.
+///
+class RasterCacheAtlasPage {
+ public:
+  RasterCacheAtlasPage(sk_sp<SkSurface> surface,
+                       GrDirectContext* gr_context,
+                       sk_sp<SkColorSpace> color_space);
+
+  ~RasterCacheAtlasPage();
+
+  bool IsCompatible(GrDirectContext* gr_context,
+                    const SkColorSpace* color_space) const;
+
+  // Reserves a |width| x |height| region of the page, or returns false if
+  // it doesn't fit.
+  bool Allocate(int width, int height, SkIRect* page_rect);
+
+  void Release();
+
+  bool is_empty() const { return live_allocations_ == 0; }
+
+  // Returns a canvas that draws into |page_rect|, clipped to it and cleared.
+  // The image of the page is stale until |GetImage| is called again.
+  DlCanvas* BeginDrawing(const SkIRect& page_rect);
+
+  void EndDrawing();
+
+  // A snapshot of the page that includes everything drawn into it so far.
+  const sk_sp<DlImage>& GetImage();
+
+ private:
+  sk_sp<SkSurface> surface_;
+  GrDirectContext* gr_context_;
+  sk_sp<SkColorSpace> color_space_;
+  std::unique_ptr<impeller::RectanglePacker> packer_;
+  std::unique_ptr<DlCanvas> canvas_;
+  sk_sp<DlImage> image_;
+  size_t live_allocations_ = 0;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(RasterCacheAtlasPage);
+};
+
+//------------------------------------------------------------------------------
+/// Sub-allocates small raster cache entries from shared atlas pages, so that
+/// they don't each need a texture of their own and entries on the same page
+/// can be drawn with a single |DlCanvas::DrawAtlas| call. See
+/// |RasterCacheAtlasBatch|.
+///
+class RasterCacheAtlas {
+ public:
+  static constexpr int kPageSize = 1024;
+
+  // Entries larger than this in either dimension get an image of their own.
+  static constexpr int kMaxEntrySize = 256;
+
+  static constexpr size_t kMaxPages = 4;
+
+  // Whether the atlas can pack entries in this build.
+  static bool IsSupported();
+
+  RasterCacheAtlas();
+
+  ~RasterCacheAtlas();
+
+  // Rasterizes the entry into a page, or returns nullptr if it is too large
+  // or doesn't fit any page.
+  std::unique_ptr<RasterCacheResult> Rasterize(
+      const RasterCache::Context& context,
+      sk_sp<const DlRTree> rtree,
+      const std::function<void(DlCanvas*)>& draw_function,
+      const std::function<void(DlCanvas*, const SkRect& rect)>&
+          draw_checkerboard,
+      bool checkerboard);
+
+  // Frees the pages that no longer hold entries, except for one that is kept
+  // for new entries.
+  void ReleaseEmptyPages();
+
+  void Clear();
+
+  size_t page_count() const { return pages_.size(); }
+
+ private:
+  std::vector<std::shared_ptr<RasterCacheAtlasPage>> pages_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(RasterCacheAtlas);
+};
+
+//------------------------------------------------------------------------------
+/// Collects consecutive draws of atlas entries and draws the entries that are
+/// on the same page with a single |DlCanvas::DrawAtlas| call.
+///
+/// Entries are drawn by |Flush|, which must be called before anything else is
+/// drawn to the canvas, and is called on destruction.
+///
+class RasterCacheAtlasBatch {
+ public:
+  RasterCacheAtlasBatch();
+
+  ~RasterCacheAtlasBatch();
+
+  // Adds |result| drawn with the current transform of |canvas|. Flushes the
+  // entries collected so far if they are on another canvas or page.
+  void Add(DlCanvas& canvas, const RasterCacheAtlasResult& result);
+
+  void Flush();
+
+  size_t size() const { return xforms_.size(); }
+
+ private:
+  DlCanvas* canvas_ = nullptr;
+  const RasterCacheAtlasPage* page_ = nullptr;
+  sk_sp<DlImage> image_;
+  std::vector<SkRSXform> xforms_;
+  std::vector<SkRect> tex_rects_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(RasterCacheAtlasBatch);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_FLOW_RASTER_CACHE_ATLAS_H_
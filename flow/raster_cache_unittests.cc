@@ -6,12 +6,14 @@
 #include "flutter/display_list/display_list.h"
 #include "flutter/display_list/dl_builder.h"
 #include "flutter/display_list/testing/dl_test_snippets.h"
+#include "flutter/display_list/utils/dl_receiver_utils.h"
 #include "flutter/flow/layers/container_layer.h"
 #include "flutter/flow/layers/display_list_layer.h"
 #include "flutter/flow/layers/image_filter_layer.h"
 #include "flutter/flow/layers/layer_tree.h"
 #include "flutter/flow/layers/transform_layer.h"
 #include "flutter/flow/raster_cache.h"
+#include "flutter/flow/raster_cache_atlas.h"
 #include "flutter/flow/raster_cache_item.h"
 #include "flutter/flow/testing/layer_test.h"
 #include "flutter/flow/testing/mock_raster_cache.h"
@@ -359,6 +361,365 @@ TEST(RasterCache, EvictUnusedCacheEntries) {
   cache.EndFrame();
 }
 
+TEST(RasterCache, DeferredRasterizationDrawsDirectlyUntilReady) {
+  size_t threshold = 1;
+  flutter::RasterCache cache(threshold);
+  cache.SetDeferEntryRasterization(true);
+
+  SkMatrix matrix = SkMatrix::I();
+
+  auto display_list = GetSampleDisplayList();
+
+  MockCanvas dummy_canvas(1000, 1000);
+  DlPaint paint;
+
+  LayerStateStack preroll_state_stack;
+  preroll_state_stack.set_preroll_delegate(kGiantRect, matrix);
+  LayerStateStack paint_state_stack;
+  preroll_state_stack.set_delegate(&dummy_canvas);
+
+  FixedRefreshRateStopwatch raster_time;
+  FixedRefreshRateStopwatch ui_time;
+  PrerollContextHolder preroll_context_holder = GetSamplePrerollContextHolder(
+      preroll_state_stack, &cache, &raster_time, &ui_time);
+  PaintContextHolder paint_context_holder = GetSamplePaintContextHolder(
+      paint_state_stack, &cache, &raster_time, &ui_time);
+  auto& preroll_context = preroll_context_holder.preroll_context;
+  auto& paint_context = paint_context_holder.paint_context;
+
+  DisplayListRasterCacheItem display_list_item(display_list, SkPoint(), true,
+                                               false);
+
+  cache.BeginFrame();
+  ASSERT_FALSE(RasterCacheItemPrerollAndTryToRasterCache(
+      display_list_item, preroll_context, paint_context, matrix));
+  cache.EndFrame();
+  ASSERT_EQ(cache.RasterizeDeferredEntries(fml::TimePoint::Max()), 0u);
+
+  // The frame that decides to cache the display list draws it directly.
+  cache.BeginFrame();
+  ASSERT_FALSE(RasterCacheItemPrerollAndTryToRasterCache(
+      display_list_item, preroll_context, paint_context, matrix));
+  ASSERT_FALSE(display_list_item.Draw(paint_context, &dummy_canvas, &paint));
+  ASSERT_EQ(cache.EstimatePictureCacheByteSize(), 0u);
+  cache.EndFrame();
+  ASSERT_EQ(cache.RasterizeDeferredEntries(fml::TimePoint::Max()), 1u);
+  ASSERT_EQ(cache.EstimatePictureCacheByteSize(), 25624u);
+
+  cache.BeginFrame();
+  ASSERT_TRUE(RasterCacheItemPrerollAndTryToRasterCache(
+      display_list_item, preroll_context, paint_context, matrix));
+  ASSERT_TRUE(display_list_item.Draw(paint_context, &dummy_canvas, &paint));
+  cache.EndFrame();
+  ASSERT_EQ(cache.RasterizeDeferredEntries(fml::TimePoint::Max()), 0u);
+}
+
+TEST(RasterCache, DeferredRasterizationWaitsForIdleTime) {
+  size_t threshold = 1;
+  flutter::RasterCache cache(threshold);
+  cache.SetDeferEntryRasterization(true);
+
+  SkMatrix matrix = SkMatrix::I();
+
+  auto display_list = GetSampleDisplayList();
+
+  MockCanvas dummy_canvas(1000, 1000);
+  DlPaint paint;
+
+  LayerStateStack preroll_state_stack;
+  preroll_state_stack.set_preroll_delegate(kGiantRect, matrix);
+  LayerStateStack paint_state_stack;
+  preroll_state_stack.set_delegate(&dummy_canvas);
+
+  FixedRefreshRateStopwatch raster_time;
+  FixedRefreshRateStopwatch ui_time;
+  PrerollContextHolder preroll_context_holder = GetSamplePrerollContextHolder(
+      preroll_state_stack, &cache, &raster_time, &ui_time);
+  PaintContextHolder paint_context_holder = GetSamplePaintContextHolder(
+      paint_state_stack, &cache, &raster_time, &ui_time);
+  auto& preroll_context = preroll_context_holder.preroll_context;
+  auto& paint_context = paint_context_holder.paint_context;
+
+  DisplayListRasterCacheItem display_list_item(display_list, SkPoint(), true,
+                                               false);
+
+  cache.BeginFrame();
+  RasterCacheItemPrerollAndTryToRasterCache(display_list_item, preroll_context,
+                                            paint_context, matrix);
+  cache.EndFrame();
+
+  // Frames without idle time leave the entry deferred, up to a limit.
+  for (size_t i = 0; i <= RasterCache::kMaxFramesToDefer; i++) {
+    cache.BeginFrame();
+    ASSERT_FALSE(RasterCacheItemPrerollAndTryToRasterCache(
+        display_list_item, preroll_context, paint_context, matrix));
+    cache.EndFrame();
+    size_t expected = i == RasterCache::kMaxFramesToDefer ? 1u : 0u;
+    ASSERT_EQ(cache.RasterizeDeferredEntries(fml::TimePoint::Min()), expected);
+  }
+  ASSERT_EQ(cache.EstimatePictureCacheByteSize(), 25624u);
+}
+
+namespace {
+
+class DrawAtlasCounter : public IgnoreAttributeDispatchHelper,
+                         public IgnoreClipDispatchHelper,
+                         public IgnoreTransformDispatchHelper,
+                         public IgnoreDrawDispatchHelper {
+ public:
+  void drawAtlas(const sk_sp<DlImage> atlas,
+                 const SkRSXform xform[],
+                 const SkRect tex[],
+                 const DlColor colors[],
+                 int count,
+                 DlBlendMode mode,
+                 DlImageSampling sampling,
+                 const SkRect* cull_rect,
+                 bool render_with_attributes) override {
+    atlas_count++;
+    sprite_count += count;
+  }
+
+  int atlas_count = 0;
+  int sprite_count = 0;
+};
+
+}  // namespace
+
+TEST(RasterCache, AtlasPacksSmallEntriesIntoOnePage) {
+  if (!RasterCacheAtlas::IsSupported()) {
+    GTEST_SKIP() << "The raster cache atlas is not supported in this build.";
+  }
+  size_t threshold = 1;
+  flutter::RasterCache cache(threshold);
+  cache.SetUseAtlas(true);
+
+  SkMatrix matrix = SkMatrix::I();
+
+  auto display_list_1 = GetSampleDisplayList();
+  auto display_list_2 = GetSampleDisplayList();
+
+  MockCanvas dummy_canvas(1000, 1000);
+
+  LayerStateStack preroll_state_stack;
+  preroll_state_stack.set_preroll_delegate(kGiantRect, matrix);
+  LayerStateStack paint_state_stack;
+  preroll_state_stack.set_delegate(&dummy_canvas);
+
+  FixedRefreshRateStopwatch raster_time;
+  FixedRefreshRateStopwatch ui_time;
+  PrerollContextHolder preroll_context_holder = GetSamplePrerollContextHolder(
+      preroll_state_stack, &cache, &raster_time, &ui_time);
+  PaintContextHolder paint_context_holder = GetSamplePaintContextHolder(
+      paint_state_stack, &cache, &raster_time, &ui_time);
+  auto& preroll_context = preroll_context_holder.preroll_context;
+  auto& paint_context = paint_context_holder.paint_context;
+
+  DisplayListRasterCacheItem display_list_item_1(display_list_1, SkPoint(),
+                                                 true, false);
+  DisplayListRasterCacheItem display_list_item_2(display_list_2, SkPoint(),
+                                                 true, false);
+
+  cache.BeginFrame();
+  RasterCacheItemPreroll(display_list_item_1, preroll_context, matrix);
+  RasterCacheItemPreroll(display_list_item_2, preroll_context, matrix);
+  cache.EvictUnusedCacheEntries();
+  cache.EndFrame();
+
+  cache.BeginFrame();
+  RasterCacheItemPreroll(display_list_item_1, preroll_context, matrix);
+  RasterCacheItemPreroll(display_list_item_2, preroll_context, matrix);
+  cache.EvictUnusedCacheEntries();
+  ASSERT_TRUE(
+      RasterCacheItemTryToRasterCache(display_list_item_1, paint_context));
+  ASSERT_TRUE(
+      RasterCacheItemTryToRasterCache(display_list_item_2, paint_context));
+  ASSERT_EQ(cache.GetAtlasPageCount(), 1u);
+  ASSERT_EQ(cache.EstimatePictureCacheByteSize(), 51200u);
+
+  DisplayListBuilder builder;
+  {
+    RasterCacheAtlasBatch batch;
+    ASSERT_TRUE(cache.AddToAtlasBatch(display_list_item_1.GetId().value(),
+                                      builder, batch));
+    builder.Translate(100, 0);
+    ASSERT_TRUE(cache.AddToAtlasBatch(display_list_item_2.GetId().value(),
+                                      builder, batch));
+    ASSERT_EQ(batch.size(), 2u);
+  }
+  DrawAtlasCounter counter;
+  builder.Build()->Dispatch(counter);
+  ASSERT_EQ(counter.atlas_count, 1);
+  ASSERT_EQ(counter.sprite_count, 2);
+  cache.EndFrame();
+
+  // Once its entries are evicted, the page is kept for new entries.
+  cache.BeginFrame();
+  cache.EvictUnusedCacheEntries();
+  cache.EndFrame();
+  ASSERT_EQ(cache.EstimatePictureCacheByteSize(), 0u);
+  ASSERT_EQ(cache.GetAtlasPageCount(), 1u);
+}
+
+TEST(RasterCache, ByteBudgetKeepsOffscreenEntries) {
+  size_t threshold = 1;
+  flutter::RasterCache cache(threshold);
+  cache.SetMaxBytes(1000000);
+
+  SkMatrix matrix = SkMatrix::I();
+
+  auto display_list_1 = GetSampleDisplayList();
+  auto display_list_2 = GetSampleDisplayList();
+
+  MockCanvas dummy_canvas(1000, 1000);
+  DlPaint paint;
+
+  LayerStateStack preroll_state_stack;
+  preroll_state_stack.set_preroll_delegate(kGiantRect, matrix);
+  LayerStateStack paint_state_stack;
+  preroll_state_stack.set_delegate(&dummy_canvas);
+
+  FixedRefreshRateStopwatch raster_time;
+  FixedRefreshRateStopwatch ui_time;
+  PrerollContextHolder preroll_context_holder = GetSamplePrerollContextHolder(
+      preroll_state_stack, &cache, &raster_time, &ui_time);
+  PaintContextHolder paint_context_holder = GetSamplePaintContextHolder(
+      paint_state_stack, &cache, &raster_time, &ui_time);
+  auto& preroll_context = preroll_context_holder.preroll_context;
+  auto& paint_context = paint_context_holder.paint_context;
+
+  DisplayListRasterCacheItem display_list_item_1(display_list_1, SkPoint(),
+                                                 true, false);
+  DisplayListRasterCacheItem display_list_item_2(display_list_2, SkPoint(),
+                                                 true, false);
+
+  cache.BeginFrame();
+  RasterCacheItemPreroll(display_list_item_1, preroll_context, matrix);
+  RasterCacheItemPreroll(display_list_item_2, preroll_context, matrix);
+  cache.EvictUnusedCacheEntries();
+  ASSERT_FALSE(
+      RasterCacheItemTryToRasterCache(display_list_item_1, paint_context));
+  ASSERT_FALSE(
+      RasterCacheItemTryToRasterCache(display_list_item_2, paint_context));
+  cache.EndFrame();
+
+  cache.BeginFrame();
+  RasterCacheItemPreroll(display_list_item_1, preroll_context, matrix);
+  RasterCacheItemPreroll(display_list_item_2, preroll_context, matrix);
+  cache.EvictUnusedCacheEntries();
+  ASSERT_TRUE(
+      RasterCacheItemTryToRasterCache(display_list_item_1, paint_context));
+  ASSERT_TRUE(
+      RasterCacheItemTryToRasterCache(display_list_item_2, paint_context));
+  cache.EndFrame();
+  ASSERT_EQ(cache.EstimatePictureCacheByteSize(), 51248u);
+
+  // The second display list scrolls offscreen but stays cached.
+  cache.BeginFrame();
+  RasterCacheItemPreroll(display_list_item_1, preroll_context, matrix);
+  cache.EvictUnusedCacheEntries();
+  ASSERT_EQ(cache.EstimatePictureCacheByteSize(), 51248u);
+  cache.EndFrame();
+  ASSERT_EQ(cache.picture_metrics().in_use_count, 1u);
+  ASSERT_EQ(cache.picture_metrics().retained_count, 1u);
+  ASSERT_EQ(cache.picture_metrics().total_bytes(), 51248u);
+
+  // It comes back and is drawn from the cache, while the first display list
+  // goes offscreen for good.
+  for (size_t i = 0; i < RasterCache::kOffscreenFramesToKeep; i++) {
+    cache.BeginFrame();
+    RasterCacheItemPreroll(display_list_item_2, preroll_context, matrix);
+    cache.EvictUnusedCacheEntries();
+    ASSERT_TRUE(
+        display_list_item_2.Draw(paint_context, &dummy_canvas, &paint));
+    cache.EndFrame();
+  }
+  ASSERT_EQ(cache.EstimatePictureCacheByteSize(), 51248u);
+
+  cache.BeginFrame();
+  RasterCacheItemPreroll(display_list_item_2, preroll_context, matrix);
+  cache.EvictUnusedCacheEntries();
+  ASSERT_EQ(cache.EstimatePictureCacheByteSize(), 25624u);
+  ASSERT_FALSE(
+      cache.Draw(display_list_item_1.GetId().value(), dummy_canvas, &paint));
+  cache.EndFrame();
+  ASSERT_EQ(cache.picture_metrics().eviction_count, 1u);
+}
+
+TEST(RasterCache, ByteBudgetEvictsOffscreenEntriesFirst) {
+  size_t threshold = 1;
+  flutter::RasterCache cache(threshold);
+  // Only fits one of the display lists.
+  cache.SetMaxBytes(30000);
+
+  SkMatrix matrix = SkMatrix::I();
+
+  auto display_list_1 = GetSampleDisplayList();
+  auto display_list_2 = GetSampleDisplayList();
+
+  MockCanvas dummy_canvas(1000, 1000);
+  DlPaint paint;
+
+  LayerStateStack preroll_state_stack;
+  preroll_state_stack.set_preroll_delegate(kGiantRect, matrix);
+  LayerStateStack paint_state_stack;
+  preroll_state_stack.set_delegate(&dummy_canvas);
+
+  FixedRefreshRateStopwatch raster_time;
+  FixedRefreshRateStopwatch ui_time;
+  PrerollContextHolder preroll_context_holder = GetSamplePrerollContextHolder(
+      preroll_state_stack, &cache, &raster_time, &ui_time);
+  PaintContextHolder paint_context_holder = GetSamplePaintContextHolder(
+      paint_state_stack, &cache, &raster_time, &ui_time);
+  auto& preroll_context = preroll_context_holder.preroll_context;
+  auto& paint_context = paint_context_holder.paint_context;
+
+  DisplayListRasterCacheItem display_list_item_1(display_list_1, SkPoint(),
+                                                 true, false);
+  DisplayListRasterCacheItem display_list_item_2(display_list_2, SkPoint(),
+                                                 true, false);
+
+  cache.BeginFrame();
+  RasterCacheItemPreroll(display_list_item_1, preroll_context, matrix);
+  RasterCacheItemPreroll(display_list_item_2, preroll_context, matrix);
+  cache.EvictUnusedCacheEntries();
+  ASSERT_FALSE(
+      RasterCacheItemTryToRasterCache(display_list_item_1, paint_context));
+  ASSERT_FALSE(
+      RasterCacheItemTryToRasterCache(display_list_item_2, paint_context));
+  cache.EndFrame();
+
+  cache.BeginFrame();
+  RasterCacheItemPreroll(display_list_item_1, preroll_context, matrix);
+  RasterCacheItemPreroll(display_list_item_2, preroll_context, matrix);
+  cache.EvictUnusedCacheEntries();
+  ASSERT_TRUE(
+      RasterCacheItemTryToRasterCache(display_list_item_1, paint_context));
+  // Evicting an equally valuable entry to make room would only thrash.
+  ASSERT_FALSE(
+      RasterCacheItemTryToRasterCache(display_list_item_2, paint_context));
+  ASSERT_EQ(cache.EstimatePictureCacheByteSize(), 25624u);
+  ASSERT_TRUE(display_list_item_1.Draw(paint_context, &dummy_canvas, &paint));
+  ASSERT_FALSE(display_list_item_2.Draw(paint_context, &dummy_canvas, &paint));
+  cache.EndFrame();
+
+  // Once the first display list is offscreen, it is worth less than the
+  // second one and makes room for it.
+  cache.BeginFrame();
+  RasterCacheItemPreroll(display_list_item_2, preroll_context, matrix);
+  cache.EvictUnusedCacheEntries();
+  ASSERT_EQ(cache.EstimatePictureCacheByteSize(), 25624u);
+  ASSERT_TRUE(
+      RasterCacheItemTryToRasterCache(display_list_item_2, paint_context));
+  ASSERT_EQ(cache.EstimatePictureCacheByteSize(), 25624u);
+  ASSERT_FALSE(
+      cache.Draw(display_list_item_1.GetId().value(), dummy_canvas, &paint));
+  ASSERT_TRUE(display_list_item_2.Draw(paint_context, &dummy_canvas, &paint));
+  cache.EndFrame();
+  ASSERT_EQ(cache.picture_metrics().eviction_count, 1u);
+  ASSERT_EQ(cache.picture_metrics().total_bytes(), 25624u);
+}
+
 TEST(RasterCache, ComputeDeviceRectBasedOnFractionalTranslation) {
   SkRect logical_rect = SkRect::MakeLTRB(0, 0, 300.2, 300.3);
   SkMatrix ctm = SkMatrix::MakeAll(2.0, 0, 0, 0, 2.0, 0, 0, 0, 1);
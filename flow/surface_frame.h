@@ -10,6 +10,7 @@
 
 #include "flutter/common/graphics/gl_context_switch.h"
 #include "flutter/display_list/dl_builder.h"
+#include "flutter/display_list/geometry/dl_region.h"
 #include "flutter/display_list/skia/dl_sk_canvas.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/time/time_point.h"
@@ -77,6 +78,13 @@ class SurfaceFrame {
     // Corresponds to EGL_KHR_partial_update
     std::optional<SkIRect> buffer_damage;
 
+    // The same areas as frame_damage and buffer_damage, split into up to
+    // Settings::max_damage_rects rectangles. Each is covered by the respective
+    // rect above, so platforms that can only present a single damage rect may
+    // ignore them.
+    std::optional<DlRegion> frame_damage_region;
+    std::optional<DlRegion> buffer_damage_region;
+
     // Time at which this frame is scheduled to be presented. This is a hint
     // that can be passed to the platform to drop queued frames.
     std::optional<fml::TimePoint> presentation_time;
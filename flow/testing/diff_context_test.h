@@ -44,7 +44,8 @@ class DiffContextTest : public LayerTest {
                        int horizontal_clip_alignment = 0,
                        int vertical_alignment = 0,
                        bool use_raster_cache = true,
-                       bool impeller_enabled = false);
+                       bool impeller_enabled = false,
+                       size_t max_damage_rects = 1);
 
   // Create display list consisting of filled rect with given color; Being able
   // to specify different color is useful to test deep comparison of pictures
@@ -5,7 +5,11 @@
 #ifndef FLUTTER_FML_CLOSURE_H_
 #define FLUTTER_FML_CLOSURE_H_
 
+#include <cstddef>
 #include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
 
 #include "flutter/fml/macros.h"
 
@@ -69,6 +73,131 @@ class ScopedCleanupClosure final {
   FML_DISALLOW_COPY_AND_ASSIGN(ScopedCleanupClosure);
 };
 
+//------------------------------------------------------------------------------
+/// @brief      A move-only, type-erased `void()` callable.
+///
+///             Unlike `fml::closure`, this accepts move-only callables (so
+///             there is no need for `fml::MakeCopyable`) and stores callables
+///             of up to `kInlineStorageSize` bytes, including any
+///             `fml::closure`, in place without allocating. Moving a
+///             `UniqueClosure` never allocates either.
+///
+class UniqueClosure final {
+ public:
+  static constexpr size_t kInlineStorageSize = 64;
+
+  UniqueClosure() = default;
+
+  // NOLINTNEXTLINE(google-explicit-constructor)
+  UniqueClosure(std::nullptr_t) {}
+
+  template <typename Callable,
+            typename Stored = std::decay_t<Callable>,
+            typename = std::enable_if_t<
+                !std::is_same_v<Stored, UniqueClosure> &&
+                std::is_invocable_r_v<void, Stored&>>>
+  // NOLINTNEXTLINE(google-explicit-constructor)
+  UniqueClosure(Callable&& callable) {
+    if constexpr (std::is_same_v<Stored, fml::closure> ||
+                  std::is_pointer_v<Stored>) {
+      if (!callable) {
+        return;
+      }
+    }
+    if constexpr (sizeof(Stored) <= kInlineStorageSize &&
+                  alignof(Stored) <= alignof(std::max_align_t) &&
+                  std::is_nothrow_move_constructible_v<Stored>) {
+      new (storage_) Stored(std::forward<Callable>(callable));
+      ops_ = InlineOps<Stored>();
+    } else {
+      new (storage_) Stored*(new Stored(std::forward<Callable>(callable)));
+      ops_ = HeapOps<Stored>();
+    }
+  }
+
+  UniqueClosure(UniqueClosure&& other) noexcept { MoveFrom(other); }
+
+  UniqueClosure& operator=(UniqueClosure&& other) noexcept {
+    if (this != &other) {
+      Reset();
+      MoveFrom(other);
+    }
+    return *this;
+  }
+
+  UniqueClosure& operator=(std::nullptr_t) {
+    Reset();
+    return *this;
+  }
+
+  ~UniqueClosure() { Reset(); }
+
+  explicit operator bool() const { return ops_ != nullptr; }
+
+  bool operator==(std::nullptr_t) const { return ops_ == nullptr; }
+
+  bool operator!=(std::nullptr_t) const { return ops_ != nullptr; }
+
+  void operator()() const {
+    // Like std::function, invoking is a const operation even though the
+    // callable itself may be mutable.
+    ops_->invoke(const_cast<unsigned char*>(storage_));
+  }
+
+  /// Destroys the callable and anything it captured.
+  void Reset() {
+    if (ops_) {
+      ops_->destroy(storage_);
+      ops_ = nullptr;
+    }
+  }
+
+ private:
+  struct Ops {
+    void (*invoke)(void* storage);
+    void (*move)(void* from, void* to);
+    void (*destroy)(void* storage);
+  };
+
+  template <typename T>
+  static const Ops* InlineOps() {
+    static constexpr Ops kOps = {
+        [](void* storage) { (*static_cast<T*>(storage))(); },
+        [](void* from, void* to) {
+          new (to) T(std::move(*static_cast<T*>(from)));
+          static_cast<T*>(from)->~T();
+        },
+        [](void* storage) { static_cast<T*>(storage)->~T(); },
+    };
+    return &kOps;
+  }
+
+  template <typename T>
+  static const Ops* HeapOps() {
+    static constexpr Ops kOps = {
+        [](void* storage) { (**static_cast<T**>(storage))(); },
+        [](void* from, void* to) {
+          new (to) T*(*static_cast<T**>(from));
+        },
+        [](void* storage) { delete *static_cast<T**>(storage); },
+    };
+    return &kOps;
+  }
+
+  void MoveFrom(UniqueClosure& other) {
+    if (other.ops_) {
+      other.ops_->move(other.storage_, storage_);
+      ops_ = other.ops_;
+      other.ops_ = nullptr;
+    }
+  }
+
+  alignas(std::max_align_t) unsigned char storage_[kInlineStorageSize];
+  const Ops* ops_ = nullptr;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(UniqueClosure);
+};
+
 }  // namespace fml
 
 #endif  // FLUTTER_FML_CLOSURE_H_
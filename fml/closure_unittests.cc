@@ -3,6 +3,10 @@
 // found in the LICENSE file.
 
 #include "fml/closure.h"
+
+#include <array>
+#include <memory>
+
 #include "gtest/gtest.h"
 
 TEST(ScopedCleanupClosureTest, DestructorDoesNothingWhenNoClosureSet) {
@@ -69,3 +73,66 @@ TEST(ScopedCleanupClosureTest, ClosureNotInvokedWhenMovedViaAssignment) {
 
   EXPECT_EQ(1, invoked);
 }
+
+TEST(UniqueClosureTest, DefaultConstructedIsEmpty) {
+  fml::UniqueClosure closure;
+
+  EXPECT_FALSE(closure);
+  EXPECT_TRUE(closure == nullptr);
+}
+
+TEST(UniqueClosureTest, EmptyClosureConvertsToEmpty) {
+  fml::closure empty;
+  fml::UniqueClosure closure(empty);
+
+  EXPECT_FALSE(closure);
+}
+
+TEST(UniqueClosureTest, InvokesSmallCallable) {
+  auto invoked = 0;
+  fml::UniqueClosure closure([&invoked]() { invoked++; });
+
+  ASSERT_TRUE(closure);
+  closure();
+  closure();
+
+  EXPECT_EQ(2, invoked);
+}
+
+TEST(UniqueClosureTest, InvokesLargeCallable) {
+  std::array<int, 64> values = {};
+  values[63] = 42;
+  auto result = 0;
+  fml::UniqueClosure closure([values, &result]() { result = values[63]; });
+  static_assert(sizeof(values) > fml::UniqueClosure::kInlineStorageSize);
+
+  fml::UniqueClosure moved(std::move(closure));
+  EXPECT_FALSE(closure);
+  moved();
+
+  EXPECT_EQ(42, result);
+}
+
+TEST(UniqueClosureTest, AcceptsMoveOnlyCallable) {
+  auto value = std::make_unique<int>(7);
+  auto result = 0;
+  fml::UniqueClosure closure(
+      [value = std::move(value), &result]() { result = *value; });
+
+  fml::UniqueClosure moved;
+  moved = std::move(closure);
+  moved();
+
+  EXPECT_EQ(7, result);
+}
+
+TEST(UniqueClosureTest, ResetDestroysCaptures) {
+  auto captured = std::make_shared<int>(0);
+  std::weak_ptr<int> weak = captured;
+
+  fml::UniqueClosure closure([captured = std::move(captured)]() {});
+  EXPECT_FALSE(weak.expired());
+
+  closure = nullptr;
+  EXPECT_TRUE(weak.expired());
+}
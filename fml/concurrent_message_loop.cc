@@ -11,13 +11,33 @@
 
 namespace fml {
 
-ConcurrentMessageLoop::ConcurrentMessageLoop(size_t worker_count)
-    : worker_count_(std::max<size_t>(worker_count, 1ul)) {
+namespace {
+
+// The work stealing loop the current thread is a worker of, if any, and the
+// index of that worker.
+thread_local const ConcurrentMessageLoop* tls_worker_loop = nullptr;
+thread_local size_t tls_worker_index = 0;
+
+}  // namespace
+
+ConcurrentMessageLoop::ConcurrentMessageLoop(size_t worker_count,
+                                             SchedulingPolicy policy)
+    : policy_(policy), worker_count_(std::max<size_t>(worker_count, 1ul)) {
+  if (policy_ == SchedulingPolicy::kWorkStealing) {
+    for (size_t i = 0; i < worker_count_; ++i) {
+      worker_queues_.emplace_back(std::make_unique<WorkerQueue>());
+    }
+  }
+
   for (size_t i = 0; i < worker_count_; ++i) {
     workers_.emplace_back([i, this]() {
       fml::Thread::SetCurrentThreadName(fml::Thread::ThreadConfig(
           std::string{"io.worker." + std::to_string(i + 1)}));
-      WorkerMain();
+      if (policy_ == SchedulingPolicy::kWorkStealing) {
+        WorkStealingWorkerMain(i);
+      } else {
+        WorkerMain();
+      }
     });
   }
 
@@ -47,6 +67,11 @@ void ConcurrentMessageLoop::PostTask(const fml::closure& task) {
     return;
   }
 
+  if (policy_ == SchedulingPolicy::kWorkStealing) {
+    PostWorkStealingTask(task);
+    return;
+  }
+
   std::unique_lock lock(tasks_mutex_);
 
   // Don't just drop tasks on the floor in case of shutdown.
@@ -112,14 +137,195 @@ void ConcurrentMessageLoop::WorkerMain() {
   }
 }
 
+void ConcurrentMessageLoop::PostWorkStealingTask(const fml::closure& task) {
+  // The pending count is bumped before the task is pushed so that a worker
+  // that is about to sleep never misses it. At worst an idle worker spins
+  // once more while the push completes.
+  if (tls_worker_loop == this && !shutdown_) {
+    WorkerQueue& queue = *worker_queues_[tls_worker_index];
+    ++pending_task_count_;
+    {
+      std::scoped_lock lock(queue.tasks_mutex);
+      queue.tasks.push_back(task);
+    }
+    WakeSearchingWorkerIfNeeded();
+    return;
+  }
+
+  {
+    // |Terminate| sets |shutdown_| with |injection_mutex_| held, so a task
+    // is either pushed before the loop shuts down or run right here.
+    std::unique_lock lock(injection_mutex_);
+
+    // Don't just drop tasks on the floor in case of shutdown.
+    if (shutdown_) {
+      FML_DLOG(WARNING)
+          << "Tried to post a task to shutdown concurrent message "
+             "loop. The task will be executed on the callers thread.";
+      lock.unlock();
+      ExecuteTask(task);
+      return;
+    }
+
+    ++pending_task_count_;
+    ++injected_task_count_;
+    injected_tasks_.push_back(task);
+  }
+  WakeSearchingWorkerIfNeeded();
+}
+
+void ConcurrentMessageLoop::WakeSearchingWorkerIfNeeded() {
+  // A worker that is already searching will find the task, and a worker that
+  // is about to sleep re-checks |pending_task_count_| after publishing itself
+  // in |sleeping_worker_count_|.
+  if (searching_workers_ > 0 || sleeping_worker_count_ == 0) {
+    return;
+  }
+  std::unique_lock lock(tasks_mutex_);
+  WorkerQueue* worker = WakeSearchingWorkerLocked();
+  lock.unlock();
+  if (worker) {
+    worker->wake_condition.notify_one();
+  }
+}
+
+ConcurrentMessageLoop::WorkerQueue*
+ConcurrentMessageLoop::WakeSearchingWorkerLocked() {
+  if (searching_workers_ > 0 || sleeping_workers_.empty()) {
+    return nullptr;
+  }
+  const size_t index = sleeping_workers_.back();
+  sleeping_workers_.pop_back();
+  --sleeping_worker_count_;
+  ++searching_workers_;
+  WorkerQueue* worker = worker_queues_[index].get();
+  worker->notified = true;
+  worker->woken_to_search = true;
+  return worker;
+}
+
+fml::closure ConcurrentMessageLoop::PopWorkStealingTask(size_t index) {
+  if (pending_task_count_ == 0) {
+    return nullptr;
+  }
+
+  fml::closure task;
+
+  // Most recently pushed local task first, it is most likely to be hot.
+  {
+    WorkerQueue& queue = *worker_queues_[index];
+    std::scoped_lock lock(queue.tasks_mutex);
+    if (!queue.tasks.empty()) {
+      task = std::move(queue.tasks.back());
+      queue.tasks.pop_back();
+    }
+  }
+
+  if (!task && injected_task_count_ > 0) {
+    std::scoped_lock lock(injection_mutex_);
+    if (!injected_tasks_.empty()) {
+      task = std::move(injected_tasks_.front());
+      injected_tasks_.pop_front();
+      --injected_task_count_;
+    }
+  }
+
+  for (size_t i = 1; !task && i < worker_count_; ++i) {
+    WorkerQueue& victim = *worker_queues_[(index + i) % worker_count_];
+    std::scoped_lock lock(victim.tasks_mutex);
+    if (!victim.tasks.empty()) {
+      task = std::move(victim.tasks.front());
+      victim.tasks.pop_front();
+    }
+  }
+
+  if (task) {
+    --pending_task_count_;
+  }
+  return task;
+}
+
+void ConcurrentMessageLoop::WorkStealingWorkerMain(size_t index) {
+  tls_worker_loop = this;
+  tls_worker_index = index;
+
+  WorkerQueue& worker = *worker_queues_[index];
+  bool searching = false;
+
+  while (true) {
+    if (worker.has_thread_tasks) {
+      std::vector<fml::closure> thread_tasks;
+      {
+        std::scoped_lock lock(tasks_mutex_);
+        worker.has_thread_tasks = false;
+        if (HasThreadTasksLocked()) {
+          thread_tasks = GetThreadTasksLocked();
+        }
+      }
+      for (const auto& thread_task : thread_tasks) {
+        ExecuteTask(thread_task);
+      }
+    }
+
+    if (shutdown_) {
+      break;
+    }
+
+    fml::closure task = PopWorkStealingTask(index);
+    if (task) {
+      if (searching) {
+        searching = false;
+        // Hand the search over to another sleeping worker if there is more
+        // work than this worker is about to take care of.
+        if (--searching_workers_ == 0 && pending_task_count_ > 0) {
+          WakeSearchingWorkerIfNeeded();
+        }
+      }
+      ExecuteTask(task);
+      continue;
+    }
+
+    std::unique_lock lock(tasks_mutex_);
+    if (searching) {
+      searching = false;
+      --searching_workers_;
+    }
+    sleeping_workers_.push_back(index);
+    ++sleeping_worker_count_;
+
+    // Pairs with the check in |WakeSearchingWorkerIfNeeded|.
+    if (pending_task_count_ > 0 || shutdown_ || worker.has_thread_tasks) {
+      sleeping_workers_.pop_back();
+      --sleeping_worker_count_;
+      searching = true;
+      ++searching_workers_;
+      continue;
+    }
+
+    worker.wake_condition.wait(lock, [&worker]() { return worker.notified; });
+    worker.notified = false;
+    searching = worker.woken_to_search;
+    worker.woken_to_search = false;
+    lock.unlock();
+
+    TRACE_EVENT0("flutter", "ConcurrentWorkerWake");
+  }
+}
+
 void ConcurrentMessageLoop::ExecuteTask(const fml::closure& task) {
   task();
 }
 
 void ConcurrentMessageLoop::Terminate() {
-  std::scoped_lock lock(tasks_mutex_);
+  std::scoped_lock lock(tasks_mutex_, injection_mutex_);
   shutdown_ = true;
   tasks_condition_.notify_all();
+  for (size_t index : sleeping_workers_) {
+    worker_queues_[index]->notified = true;
+    worker_queues_[index]->wake_condition.notify_one();
+  }
+  sleeping_workers_.clear();
+  sleeping_worker_count_ = 0;
 }
 
 void ConcurrentMessageLoop::PostTaskToAllWorkers(const fml::closure& task) {
@@ -132,6 +338,15 @@ void ConcurrentMessageLoop::PostTaskToAllWorkers(const fml::closure& task) {
     thread_tasks_[worker_thread_id].emplace_back(task);
   }
   tasks_condition_.notify_all();
+  for (const auto& worker_queue : worker_queues_) {
+    worker_queue->has_thread_tasks = true;
+  }
+  for (size_t index : sleeping_workers_) {
+    worker_queues_[index]->notified = true;
+    worker_queues_[index]->wake_condition.notify_one();
+  }
+  sleeping_workers_.clear();
+  sleeping_worker_count_ = 0;
 }
 
 bool ConcurrentMessageLoop::HasThreadTasksLocked() const {
@@ -5,8 +5,11 @@
 #ifndef FLUTTER_FML_CONCURRENT_MESSAGE_LOOP_H_
 #define FLUTTER_FML_CONCURRENT_MESSAGE_LOOP_H_
 
+#include <atomic>
 #include <condition_variable>
+#include <deque>
 #include <map>
+#include <memory>
 #include <queue>
 #include <thread>
 
@@ -21,8 +24,21 @@ class ConcurrentTaskRunner;
 class ConcurrentMessageLoop
     : public std::enable_shared_from_this<ConcurrentMessageLoop> {
  public:
+  /// How tasks posted to the loop are distributed to its workers.
+  enum class SchedulingPolicy {
+    /// All workers pull from one queue guarded by one mutex.
+    kSharedQueue,
+    /// Each worker owns a deque that tasks posted from that worker go to and
+    /// that idle workers steal from. Tasks posted from other threads go to a
+    /// global injection queue with a lock of its own. Only one idle worker
+    /// is woken per burst of posted tasks; it wakes the next one once it has
+    /// found work.
+    kWorkStealing,
+  };
+
   static std::shared_ptr<ConcurrentMessageLoop> Create(
-      size_t worker_count = std::thread::hardware_concurrency());
+      size_t worker_count = std::thread::hardware_concurrency(),
+      SchedulingPolicy policy = SchedulingPolicy::kSharedQueue);
 
   virtual ~ConcurrentMessageLoop();
 
@@ -37,12 +53,33 @@ class ConcurrentMessageLoop
   bool RunsTasksOnCurrentThread();
 
  protected:
-  explicit ConcurrentMessageLoop(size_t worker_count);
+  explicit ConcurrentMessageLoop(
+      size_t worker_count,
+      SchedulingPolicy policy = SchedulingPolicy::kSharedQueue);
   virtual void ExecuteTask(const fml::closure& task);
 
  private:
   friend ConcurrentTaskRunner;
 
+  // Per-worker state used by |SchedulingPolicy::kWorkStealing|.
+  struct WorkerQueue {
+    // Guards |tasks|. The owning worker pushes and pops at the back, other
+    // workers steal from the front.
+    std::mutex tasks_mutex;
+    std::deque<fml::closure> tasks;
+    // Waited on with |tasks_mutex_| held.
+    std::condition_variable wake_condition;
+    // Guarded by |tasks_mutex_|.
+    bool notified = false;
+    // Guarded by |tasks_mutex_|. Set when the worker was woken to look for
+    // work and has already been counted in |searching_workers_|.
+    bool woken_to_search = false;
+    // Set with |tasks_mutex_| held when |thread_tasks_| has an entry for this
+    // worker, so that busy workers can poll it without taking the lock.
+    std::atomic_bool has_thread_tasks = false;
+  };
+
+  const SchedulingPolicy policy_;
   size_t worker_count_ = 0;
   std::vector<std::thread> workers_;
   std::mutex tasks_mutex_;
@@ -50,12 +87,42 @@ class ConcurrentMessageLoop
   std::queue<fml::closure> tasks_;
   std::vector<std::thread::id> worker_thread_ids_;
   std::map<std::thread::id, std::vector<fml::closure>> thread_tasks_;
-  bool shutdown_ = false;
+  std::atomic_bool shutdown_ = false;
+
+  // Work stealing state.
+  std::vector<std::unique_ptr<WorkerQueue>> worker_queues_;
+  // Guards |injected_tasks_|. Kept apart from |tasks_mutex_|, which the
+  // workers take to go to sleep and to be woken, so that threads posting to
+  // the loop only contend with each other and with the workers popping the
+  // tasks they posted.
+  std::mutex injection_mutex_;
+  // Tasks posted from threads that are not workers of this loop.
+  std::deque<fml::closure> injected_tasks_;
+  // Guarded by |tasks_mutex_|. Indices of the workers waiting for work.
+  std::vector<size_t> sleeping_workers_;
+  std::atomic_size_t sleeping_worker_count_ = 0;
+  std::atomic_size_t searching_workers_ = 0;
+  // Tasks in |injected_tasks_| and all worker queues, including tasks that
+  // are about to be pushed.
+  std::atomic_size_t pending_task_count_ = 0;
+  std::atomic_size_t injected_task_count_ = 0;
 
   void WorkerMain();
 
+  void WorkStealingWorkerMain(size_t index);
+
   void PostTask(const fml::closure& task);
 
+  void PostWorkStealingTask(const fml::closure& task);
+
+  fml::closure PopWorkStealingTask(size_t index);
+
+  void WakeSearchingWorkerIfNeeded();
+
+  // Returns the worker that has to be notified once |tasks_mutex_| is
+  // released, if any.
+  WorkerQueue* WakeSearchingWorkerLocked();
+
   bool HasThreadTasksLocked() const;
 
   std::vector<fml::closure> GetThreadTasksLocked();
@@ -0,0 +1,118 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/concurrent_message_loop.h"
+
+#include <thread>
+#include <vector>
+
+#include "flutter/benchmarking/benchmarking.h"
+#include "flutter/fml/synchronization/count_down_latch.h"
+
+namespace fml {
+namespace benchmarking {
+
+// Posts 100k empty closures split across |state.range(1)| producer threads
+// and waits for all of them to run.
+static void BM_ConcurrentMessageLoopPostSmallTasks(
+    benchmark::State& state) {  // NOLINT
+  const auto policy =
+      static_cast<ConcurrentMessageLoop::SchedulingPolicy>(state.range(0));
+  const size_t num_producers = state.range(1);
+  const size_t num_tasks = 100000;
+  const size_t num_tasks_per_producer = num_tasks / num_producers;
+
+  auto loop = ConcurrentMessageLoop::Create(4u, policy);
+  auto task_runner = loop->GetTaskRunner();
+
+  while (state.KeepRunning()) {
+    CountDownLatch tasks_done(num_tasks_per_producer * num_producers);
+    std::vector<std::thread> producers;
+    producers.reserve(num_producers);
+    for (size_t i = 0; i < num_producers; i++) {
+      producers.emplace_back([&task_runner, &tasks_done,
+                              num_tasks_per_producer]() {
+        for (size_t j = 0; j < num_tasks_per_producer; j++) {
+          task_runner->PostTask([&tasks_done]() { tasks_done.CountDown(); });
+        }
+      });
+    }
+    for (auto& producer : producers) {
+      producer.join();
+    }
+    tasks_done.Wait();
+  }
+
+  state.SetItemsProcessed(state.iterations() * num_tasks_per_producer *
+                          num_producers);
+}
+
+BENCHMARK(BM_ConcurrentMessageLoopPostSmallTasks)
+    ->ArgNames({"work_stealing", "producers"})
+    ->ArgsProduct({
+        {static_cast<int64_t>(
+             ConcurrentMessageLoop::SchedulingPolicy::kSharedQueue),
+         static_cast<int64_t>(
+             ConcurrentMessageLoop::SchedulingPolicy::kWorkStealing)},
+        {1, 4, 8},
+    })
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+// Starts |state.range(1)| threads that are not workers of the loop at the
+// same time and has each of them post 20k empty closures, so that the
+// posting threads contend with each other and with the workers for the
+// queue that tasks from outside the loop are injected into.
+static void BM_ConcurrentMessageLoopInjectionContention(
+    benchmark::State& state) {  // NOLINT
+  const auto policy =
+      static_cast<ConcurrentMessageLoop::SchedulingPolicy>(state.range(0));
+  const size_t num_producers = state.range(1);
+  const size_t num_tasks_per_producer = 20000;
+
+  auto loop = ConcurrentMessageLoop::Create(4u, policy);
+  auto task_runner = loop->GetTaskRunner();
+
+  while (state.KeepRunning()) {
+    CountDownLatch producers_ready(num_producers);
+    CountDownLatch start(1);
+    CountDownLatch tasks_done(num_tasks_per_producer * num_producers);
+    std::vector<std::thread> producers;
+    producers.reserve(num_producers);
+    for (size_t i = 0; i < num_producers; i++) {
+      producers.emplace_back([&task_runner, &producers_ready, &start,
+                              &tasks_done, num_tasks_per_producer]() {
+        producers_ready.CountDown();
+        start.Wait();
+        for (size_t j = 0; j < num_tasks_per_producer; j++) {
+          task_runner->PostTask([&tasks_done]() { tasks_done.CountDown(); });
+        }
+      });
+    }
+    producers_ready.Wait();
+    start.CountDown();
+    for (auto& producer : producers) {
+      producer.join();
+    }
+    tasks_done.Wait();
+  }
+
+  state.SetItemsProcessed(state.iterations() * num_tasks_per_producer *
+                          num_producers);
+}
+
+BENCHMARK(BM_ConcurrentMessageLoopInjectionContention)
+    ->ArgNames({"work_stealing", "producers"})
+    ->ArgsProduct({
+        {static_cast<int64_t>(
+             ConcurrentMessageLoop::SchedulingPolicy::kSharedQueue),
+         static_cast<int64_t>(
+             ConcurrentMessageLoop::SchedulingPolicy::kWorkStealing)},
+        {8, 16, 32},
+    })
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+}  // namespace benchmarking
+}  // namespace fml
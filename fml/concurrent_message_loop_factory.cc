@@ -7,9 +7,10 @@
 namespace fml {
 
 std::shared_ptr<ConcurrentMessageLoop> ConcurrentMessageLoop::Create(
-    size_t worker_count) {
+    size_t worker_count,
+    SchedulingPolicy policy) {
   return std::shared_ptr<ConcurrentMessageLoop>{
-      new ConcurrentMessageLoop(worker_count)};
+      new ConcurrentMessageLoop(worker_count, policy)};
 }
 
 }  // namespace fml
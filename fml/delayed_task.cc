@@ -6,25 +6,43 @@
 
 #include "flutter/fml/delayed_task.h"
 
+#include <algorithm>
+
 namespace fml {
 
+DelayedTask::DelayedTask()
+    : order_(0),
+      task_source_grade_(fml::TaskSourceGrade::kUnspecified),
+      priority_(fml::TaskPriority::kNormal),
+      deadline_(fml::TimePoint::Max()) {}
+
 DelayedTask::DelayedTask(size_t order,
-                         const fml::closure& task,
+                         fml::UniqueClosure task,
                          fml::TimePoint target_time,
-                         fml::TaskSourceGrade task_source_grade)
+                         fml::TaskSourceGrade task_source_grade,
+                         fml::TaskPriority priority,
+                         fml::TimePoint deadline)
     : order_(order),
-      task_(task),
+      task_(std::move(task)),
       target_time_(target_time),
-      task_source_grade_(task_source_grade) {}
+      task_source_grade_(task_source_grade),
+      priority_(priority),
+      deadline_(deadline) {}
 
 DelayedTask::~DelayedTask() = default;
 
-DelayedTask::DelayedTask(const DelayedTask& other) = default;
+DelayedTask::DelayedTask(DelayedTask&& other) = default;
+
+DelayedTask& DelayedTask::operator=(DelayedTask&& other) = default;
 
-const fml::closure& DelayedTask::GetTask() const {
+const fml::UniqueClosure& DelayedTask::GetTask() const {
   return task_;
 }
 
+fml::UniqueClosure DelayedTask::TakeTask() {
+  return std::move(task_);
+}
+
 fml::TimePoint DelayedTask::GetTargetTime() const {
   return target_time_;
 }
@@ -33,6 +51,57 @@ fml::TaskSourceGrade DelayedTask::GetTaskSourceGrade() const {
   return task_source_grade_;
 }
 
+fml::TaskPriority DelayedTask::GetPriority() const {
+  return priority_;
+}
+
+fml::TimePoint DelayedTask::GetDeadline() const {
+  return deadline_;
+}
+
+bool DelayedTask::HasDeadline() const {
+  return deadline_ != fml::TimePoint::Max();
+}
+
+fml::TimePoint DelayedTask::GetEscalationTime() const {
+  // Tasks scheduled this far ahead can't be starved before the end of time.
+  if (target_time_ > fml::TimePoint::Max() - kStarvationThreshold) {
+    return deadline_;
+  }
+  return std::min(deadline_, target_time_ + kStarvationThreshold);
+}
+
+fml::TaskPriority DelayedTask::GetEffectivePriority(fml::TimePoint now) const {
+  if (GetEscalationTime() <= now) {
+    return fml::TaskPriority::kFrameCritical;
+  }
+  return priority_;
+}
+
+bool DelayedTask::RunsBefore(const DelayedTask& other,
+                             fml::TimePoint now) const {
+  const bool ready = target_time_ <= now;
+  const bool other_ready = other.target_time_ <= now;
+  if (ready != other_ready) {
+    return ready;
+  }
+  if (ready) {
+    const auto priority = GetEffectivePriority(now);
+    const auto other_priority = other.GetEffectivePriority(now);
+    if (priority != other_priority) {
+      return priority < other_priority;
+    }
+    // A deadline alone doesn't reorder a task ahead of the tasks that were
+    // posted before it, until the deadline has passed and the task was
+    // escalated.
+    if (priority == fml::TaskPriority::kFrameCritical &&
+        deadline_ != other.deadline_) {
+      return deadline_ < other.deadline_;
+    }
+  }
+  return other > *this;
+}
+
 bool DelayedTask::operator>(const DelayedTask& other) const {
   if (target_time_ == other.target_time_) {
     return order_ > other.order_;
@@ -40,4 +109,64 @@ bool DelayedTask::operator>(const DelayedTask& other) const {
   return target_time_ > other.target_time_;
 }
 
+namespace {
+
+// Orders the heap by escalation time, so that the task on top is the first
+// one of its heap to be escalated. Without a deadline, this is the same as
+// |DelayedTask::operator>|.
+bool RunsLater(const std::unique_ptr<DelayedTask>& a,
+               const std::unique_ptr<DelayedTask>& b) {
+  const auto escalation_time = a->GetEscalationTime();
+  const auto other_escalation_time = b->GetEscalationTime();
+  if (escalation_time != other_escalation_time) {
+    return escalation_time > other_escalation_time;
+  }
+  return *a > *b;
+}
+
+}  // namespace
+
+DelayedTaskQueue::DelayedTaskQueue() = default;
+
+DelayedTaskQueue::DelayedTaskQueue(DelayedTaskQueue&& other) = default;
+
+DelayedTaskQueue& DelayedTaskQueue::operator=(DelayedTaskQueue&& other) =
+    default;
+
+DelayedTaskQueue::~DelayedTaskQueue() = default;
+
+bool DelayedTaskQueue::empty() const {
+  return heap_.empty();
+}
+
+size_t DelayedTaskQueue::size() const {
+  return heap_.size();
+}
+
+const DelayedTask& DelayedTaskQueue::top() const {
+  return *heap_.front();
+}
+
+void DelayedTaskQueue::push(DelayedTask task) {
+  if (free_nodes_.empty()) {
+    heap_.push_back(std::make_unique<DelayedTask>(std::move(task)));
+  } else {
+    *free_nodes_.back() = std::move(task);
+    heap_.push_back(std::move(free_nodes_.back()));
+    free_nodes_.pop_back();
+  }
+  std::push_heap(heap_.begin(), heap_.end(), RunsLater);
+}
+
+fml::UniqueClosure DelayedTaskQueue::pop() {
+  std::pop_heap(heap_.begin(), heap_.end(), RunsLater);
+  std::unique_ptr<DelayedTask> node = std::move(heap_.back());
+  heap_.pop_back();
+  fml::UniqueClosure task = node->TakeTask();
+  if (free_nodes_.size() < kMaxPooledNodes) {
+    free_nodes_.push_back(std::move(node));
+  }
+  return task;
+}
+
 }  // namespace fml
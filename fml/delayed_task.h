@@ -5,43 +5,123 @@
 #ifndef FLUTTER_FML_DELAYED_TASK_H_
 #define FLUTTER_FML_DELAYED_TASK_H_
 
-#include <queue>
+#include <memory>
+#include <vector>
 
 #include "flutter/fml/closure.h"
+#include "flutter/fml/task_priority.h"
 #include "flutter/fml/task_source_grade.h"
+#include "flutter/fml/time/time_delta.h"
 #include "flutter/fml/time/time_point.h"
 
 namespace fml {
 
 class DelayedTask {
  public:
+  /// Tasks that have been ready to run for longer than this are treated as
+  /// frame-critical, so that lower priority classes cannot be starved.
+  static constexpr fml::TimeDelta kStarvationThreshold =
+      fml::TimeDelta::FromMilliseconds(100);
+
+  DelayedTask();
+
   DelayedTask(size_t order,
-              const fml::closure& task,
+              fml::UniqueClosure task,
               fml::TimePoint target_time,
-              fml::TaskSourceGrade task_source_grade);
+              fml::TaskSourceGrade task_source_grade,
+              fml::TaskPriority priority = fml::TaskPriority::kNormal,
+              fml::TimePoint deadline = fml::TimePoint::Max());
 
-  DelayedTask(const DelayedTask& other);
+  DelayedTask(DelayedTask&& other);
+
+  DelayedTask& operator=(DelayedTask&& other);
 
   ~DelayedTask();
 
-  const fml::closure& GetTask() const;
+  const fml::UniqueClosure& GetTask() const;
+
+  /// Moves the closure out of this task, leaving it empty.
+  fml::UniqueClosure TakeTask();
 
   fml::TimePoint GetTargetTime() const;
 
   fml::TaskSourceGrade GetTaskSourceGrade() const;
 
+  fml::TaskPriority GetPriority() const;
+
+  fml::TimePoint GetDeadline() const;
+
+  bool HasDeadline() const;
+
+  /// The time at which the task is escalated to
+  /// |TaskPriority::kFrameCritical|, which is its deadline or the time at
+  /// which it has waited for |kStarvationThreshold|, whichever comes first.
+  fml::TimePoint GetEscalationTime() const;
+
+  /// The priority class the task competes in at |now|. Tasks past their
+  /// deadline or starved for longer than |kStarvationThreshold| are escalated
+  /// to |TaskPriority::kFrameCritical|.
+  fml::TaskPriority GetEffectivePriority(fml::TimePoint now) const;
+
+  /// Whether this task should run before |other| at |now|. Ready tasks run
+  /// before tasks scheduled in the future, then by effective priority, and
+  /// finally in the order of |operator>|, so that tasks of the same class
+  /// run in the order they were posted in. Only frame-critical tasks are
+  /// ordered by deadline before that.
+  bool RunsBefore(const DelayedTask& other, fml::TimePoint now) const;
+
   bool operator>(const DelayedTask& other) const;
 
  private:
   size_t order_;
-  fml::closure task_;
+  fml::UniqueClosure task_;
   fml::TimePoint target_time_;
   fml::TaskSourceGrade task_source_grade_;
+  fml::TaskPriority priority_;
+  fml::TimePoint deadline_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(DelayedTask);
 };
 
-using DelayedTaskQueue = std::priority_queue<DelayedTask,
-                                             std::deque<DelayedTask>,
-                                             std::greater<DelayedTask>>;
+/// A min-heap of `DelayedTask`s ordered by their escalation time, and then
+/// by `DelayedTask::operator>`. For tasks without a deadline, this is the
+/// order in which they were scheduled. For tasks with a deadline, the task
+/// that is first escalated is on top, so it is never hidden behind a task
+/// with a later deadline.
+///
+/// Tasks live in pooled nodes and only node pointers move when the heap is
+/// reordered. Once the queue has reached its steady-state size, pushing and
+/// popping tasks does not allocate.
+class DelayedTaskQueue {
+ public:
+  /// The number of released nodes kept around for reuse.
+  static constexpr size_t kMaxPooledNodes = 64;
+
+  DelayedTaskQueue();
+
+  DelayedTaskQueue(DelayedTaskQueue&& other);
+
+  DelayedTaskQueue& operator=(DelayedTaskQueue&& other);
+
+  ~DelayedTaskQueue();
+
+  bool empty() const;
+
+  size_t size() const;
+
+  const DelayedTask& top() const;
+
+  void push(DelayedTask task);
+
+  /// Removes the top task and returns its closure.
+  fml::UniqueClosure pop();
+
+ private:
+  std::vector<std::unique_ptr<DelayedTask>> heap_;
+  std::vector<std::unique_ptr<DelayedTask>> free_nodes_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(DelayedTaskQueue);
+};
 
 }  // namespace fml
 
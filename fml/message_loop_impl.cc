@@ -57,15 +57,20 @@ MessageLoopImpl::~MessageLoopImpl() {
   task_queue_->Dispose(queue_id_);
 }
 
-void MessageLoopImpl::PostTask(const fml::closure& task,
-                               fml::TimePoint target_time) {
+void MessageLoopImpl::PostTask(fml::UniqueClosure&& task,
+                               fml::TimePoint target_time,
+                               fml::TaskPriority priority,
+                               fml::TimePoint deadline) {
   FML_DCHECK(task != nullptr);
   if (terminated_) {
     // If the message loop has already been terminated, PostTask should destruct
     // |task| synchronously within this function.
+    task.Reset();
     return;
   }
-  task_queue_->RegisterTask(queue_id_, task, target_time);
+  task_queue_->RegisterTask(queue_id_, std::move(task), target_time,
+                            fml::TaskSourceGrade::kUnspecified, priority,
+                            deadline);
 }
 
 void MessageLoopImpl::AddTaskObserver(intptr_t key,
@@ -121,15 +126,25 @@ void MessageLoopImpl::DoTerminate() {
 
 void MessageLoopImpl::FlushTasks(FlushType type) {
   const auto now = fml::TimePoint::Now();
-  fml::closure invocation;
+  const bool record_stats = task_queue_->IsStatsEnabled();
+  fml::UniqueClosure invocation;
+  // Take the reusable observer storage so that a nested flush started by a
+  // task or observer gets its own.
+  std::vector<fml::closure> observers = std::move(observers_to_notify_);
   do {
     invocation = task_queue_->GetNextTaskToRun(queue_id_, now);
     if (!invocation) {
       break;
     }
-    invocation();
-    std::vector<fml::closure> observers =
-        task_queue_->GetObserversToNotify(queue_id_);
+    if (record_stats) {
+      const auto start = fml::TimePoint::Now();
+      invocation();
+      task_queue_->RecordTaskRunTime(queue_id_,
+                                     fml::TimePoint::Now() - start);
+    } else {
+      invocation();
+    }
+    task_queue_->GetObserversToNotify(queue_id_, observers);
     for (const auto& observer : observers) {
       observer();
     }
@@ -137,6 +152,8 @@ void MessageLoopImpl::FlushTasks(FlushType type) {
       break;
     }
   } while (invocation);
+  observers.clear();
+  observers_to_notify_ = std::move(observers);
 }
 
 void MessageLoopImpl::RunExpiredTasksNow() {
@@ -11,6 +11,7 @@
 #include <mutex>
 #include <queue>
 #include <utility>
+#include <vector>
 
 #include "flutter/fml/closure.h"
 #include "flutter/fml/delayed_task.h"
@@ -39,7 +40,10 @@ class MessageLoopImpl : public Wakeable,
 
   virtual void Terminate() = 0;
 
-  void PostTask(const fml::closure& task, fml::TimePoint target_time);
+  void PostTask(fml::UniqueClosure&& task,
+                fml::TimePoint target_time,
+                fml::TaskPriority priority = fml::TaskPriority::kNormal,
+                fml::TimePoint deadline = fml::TimePoint::Max());
 
   void AddTaskObserver(intptr_t key, const fml::closure& callback);
 
@@ -69,6 +73,9 @@ class MessageLoopImpl : public Wakeable,
 
   std::atomic_bool terminated_;
 
+  // Reused across flushes so that notifying observers doesn't allocate.
+  std::vector<fml::closure> observers_to_notify_;
+
   void FlushTasks(FlushType type);
 
   FML_DISALLOW_COPY_AND_ASSIGN(MessageLoopImpl);
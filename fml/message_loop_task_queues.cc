@@ -7,6 +7,7 @@
 #include "flutter/fml/message_loop_task_queues.h"
 
 #include <algorithm>
+#include <climits>
 #include <iostream>
 #include <memory>
 #include <optional>
@@ -41,46 +42,181 @@ TaskQueueEntry::TaskQueueEntry(TaskQueueId created_for_arg)
   task_source = std::make_unique<TaskSource>(created_for);
 }
 
+// Locks every task queue reachable through the merge relationships of the
+// given seed queues, i.e. each seed plus its owner and that owner's subsumed
+// queues. Entry mutexes are acquired in ascending id order. Since the merge
+// state of an entry is only mutated while its mutex is held, the group is
+// re-validated after locking and the acquisition retried if a concurrent
+// |Merge| or |Unmerge| changed it in the meantime.
+//
+// Queues that are neither merged nor owners take a single mutex.
+class MessageLoopTaskQueues::QueueGroupLock {
+ public:
+  QueueGroupLock(const MessageLoopTaskQueues& queues,
+                 std::initializer_list<TaskQueueId> seeds)
+      : queues_(queues), table_lock_(queues.GetShardMutex(*seeds.begin())) {
+    if (seeds.size() == 1) {
+      TaskQueueEntry* entry = queues_.GetEntryUnlocked(*seeds.begin());
+      entry->mutex.lock();
+      if (entry->subsumed_by == kUnmerged && entry->owner_of.empty()) {
+        single_ = entry;
+        return;
+      }
+      entry->mutex.unlock();
+    }
+    for (;;) {
+      std::set<TaskQueueId> members;
+      for (TaskQueueId seed : seeds) {
+        CollectGroup(seed, members);
+      }
+      for (TaskQueueId member : members) {
+        TaskQueueEntry* entry = queues_.GetEntryUnlocked(member);
+        entry->mutex.lock();
+        group_.push_back(entry);
+      }
+      if (IsGroupClosed(seeds, members)) {
+        return;
+      }
+      Release();
+    }
+  }
+
+  ~QueueGroupLock() { Release(); }
+
+ private:
+  const MessageLoopTaskQueues& queues_;
+  SharedLock table_lock_;
+  TaskQueueEntry* single_ = nullptr;
+  std::vector<TaskQueueEntry*> group_;
+
+  void Release() {
+    if (single_) {
+      single_->mutex.unlock();
+      single_ = nullptr;
+    }
+    for (auto it = group_.rbegin(); it != group_.rend(); ++it) {
+      (*it)->mutex.unlock();
+    }
+    group_.clear();
+  }
+
+  // Takes the entry locks one at a time, so the result is only a guess that
+  // has to be confirmed by |IsGroupClosed| once the whole group is held.
+  void CollectGroup(TaskQueueId seed, std::set<TaskQueueId>& members) const {
+    TaskQueueId root = seed;
+    {
+      TaskQueueEntry* entry = queues_.GetEntryUnlocked(seed);
+      std::scoped_lock lock(entry->mutex);
+      if (entry->subsumed_by != kUnmerged) {
+        root = entry->subsumed_by;
+      }
+    }
+    members.insert(seed);
+    members.insert(root);
+    TaskQueueEntry* root_entry = queues_.GetEntryUnlocked(root);
+    std::scoped_lock lock(root_entry->mutex);
+    members.insert(root_entry->owner_of.begin(), root_entry->owner_of.end());
+  }
+
+  bool IsGroupClosed(std::initializer_list<TaskQueueId> seeds,
+                     const std::set<TaskQueueId>& members) const {
+    for (TaskQueueId seed : seeds) {
+      TaskQueueId root = seed;
+      TaskQueueEntry* entry = queues_.GetEntryUnlocked(seed);
+      if (entry->subsumed_by != kUnmerged) {
+        root = entry->subsumed_by;
+      }
+      if (members.find(root) == members.end()) {
+        return false;
+      }
+      for (TaskQueueId subsumed : queues_.GetEntryUnlocked(root)->owner_of) {
+        if (members.find(subsumed) == members.end()) {
+          return false;
+        }
+      }
+    }
+    return true;
+  }
+
+  FML_DISALLOW_COPY_AND_ASSIGN(QueueGroupLock);
+};
+
+// Exclusively locks every shard of the queue table. Only needed when the
+// table itself changes shape.
+class MessageLoopTaskQueues::TableWriteLock {
+ public:
+  explicit TableWriteLock(const MessageLoopTaskQueues& queues)
+      : queues_(queues) {
+    for (const auto& shard : queues_.table_shards_) {
+      shard->Lock();
+    }
+  }
+
+  ~TableWriteLock() {
+    for (auto it = std::rbegin(queues_.table_shards_);
+         it != std::rend(queues_.table_shards_); ++it) {
+      (*it)->Unlock();
+    }
+  }
+
+ private:
+  const MessageLoopTaskQueues& queues_;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(TableWriteLock);
+};
+
 MessageLoopTaskQueues* MessageLoopTaskQueues::GetInstance() {
   static MessageLoopTaskQueues* instance = new MessageLoopTaskQueues;
   return instance;
 }
 
 TaskQueueId MessageLoopTaskQueues::CreateTaskQueue() {
-  std::lock_guard guard(queue_mutex_);
-  TaskQueueId loop_id = TaskQueueId(task_queue_id_counter_);
-  ++task_queue_id_counter_;
-  queue_entries_[loop_id] = std::make_unique<TaskQueueEntry>(loop_id);
+  TableWriteLock table_lock(*this);
+  TaskQueueId loop_id = TaskQueueId(queue_entries_.size());
+  queue_entries_.push_back(std::make_unique<TaskQueueEntry>(loop_id));
   return loop_id;
 }
 
 MessageLoopTaskQueues::MessageLoopTaskQueues() : order_(0) {
   tls_task_source_grade.reset(
       new TaskSourceGradeHolder{TaskSourceGrade::kUnspecified});
+  for (auto& shard : table_shards_) {
+    shard.reset(SharedMutex::Create());
+  }
 }
 
 MessageLoopTaskQueues::~MessageLoopTaskQueues() = default;
 
+SharedMutex& MessageLoopTaskQueues::GetShardMutex(TaskQueueId queue_id) const {
+  return *table_shards_[queue_id % kQueueTableShardCount];
+}
+
+TaskQueueEntry* MessageLoopTaskQueues::GetEntryUnlocked(
+    TaskQueueId queue_id) const {
+  FML_CHECK(queue_id < queue_entries_.size() && queue_entries_[queue_id])
+      << "Unknown task queue: " << queue_id;
+  return queue_entries_[queue_id].get();
+}
+
 void MessageLoopTaskQueues::Dispose(TaskQueueId queue_id) {
-  std::lock_guard guard(queue_mutex_);
-  const auto& queue_entry = queue_entries_.at(queue_id);
+  TableWriteLock table_lock(*this);
+  TaskQueueEntry* queue_entry = GetEntryUnlocked(queue_id);
   FML_DCHECK(queue_entry->subsumed_by == kUnmerged);
-  auto& subsumed_set = queue_entry->owner_of;
-  for (auto& subsumed : subsumed_set) {
-    queue_entries_.erase(subsumed);
+  for (auto& subsumed : queue_entry->owner_of) {
+    queue_entries_[subsumed].reset();
   }
-  // Erase owner queue_id at last to avoid &subsumed_set from being invalid
-  queue_entries_.erase(queue_id);
+  // Reset owner queue_id at last to avoid owner_of from being invalid
+  queue_entries_[queue_id].reset();
 }
 
 void MessageLoopTaskQueues::DisposeTasks(TaskQueueId queue_id) {
-  std::lock_guard guard(queue_mutex_);
-  const auto& queue_entry = queue_entries_.at(queue_id);
+  QueueGroupLock lock(*this, {queue_id});
+  TaskQueueEntry* queue_entry = GetEntryUnlocked(queue_id);
   FML_DCHECK(queue_entry->subsumed_by == kUnmerged);
   auto& subsumed_set = queue_entry->owner_of;
   queue_entry->task_source->ShutDown();
   for (auto& subsumed : subsumed_set) {
-    queue_entries_.at(subsumed)->task_source->ShutDown();
+    GetEntryUnlocked(subsumed)->task_source->ShutDown();
   }
 }
 
@@ -90,14 +226,22 @@ TaskSourceGrade MessageLoopTaskQueues::GetCurrentTaskSourceGrade() {
 
 void MessageLoopTaskQueues::RegisterTask(
     TaskQueueId queue_id,
-    const fml::closure& task,
+    fml::UniqueClosure task,
     fml::TimePoint target_time,
-    fml::TaskSourceGrade task_source_grade) {
-  std::lock_guard guard(queue_mutex_);
+    fml::TaskSourceGrade task_source_grade,
+    fml::TaskPriority priority,
+    fml::TimePoint deadline) {
+  QueueGroupLock lock(*this, {queue_id});
   size_t order = order_++;
-  const auto& queue_entry = queue_entries_.at(queue_id);
+  TaskQueueEntry* queue_entry = GetEntryUnlocked(queue_id);
   queue_entry->task_source->RegisterTask(
-      {order, task, target_time, task_source_grade});
+      {order, std::move(task), target_time, task_source_grade, priority,
+       deadline});
+  if (stats_enabled_.load(std::memory_order_relaxed)) {
+    queue_entry->stats.max_pending_tasks =
+        std::max(queue_entry->stats.max_pending_tasks,
+                 queue_entry->task_source->GetNumPendingTasks());
+  }
   TaskQueueId loop_to_wake = queue_id;
   if (queue_entry->subsumed_by != kUnmerged) {
     loop_to_wake = queue_entry->subsumed_by;
@@ -110,17 +254,18 @@ void MessageLoopTaskQueues::RegisterTask(
 }
 
 bool MessageLoopTaskQueues::HasPendingTasks(TaskQueueId queue_id) const {
-  std::lock_guard guard(queue_mutex_);
+  QueueGroupLock lock(*this, {queue_id});
   return HasPendingTasksUnlocked(queue_id);
 }
 
-fml::closure MessageLoopTaskQueues::GetNextTaskToRun(TaskQueueId queue_id,
-                                                     fml::TimePoint from_time) {
-  std::lock_guard guard(queue_mutex_);
+fml::UniqueClosure MessageLoopTaskQueues::GetNextTaskToRun(
+    TaskQueueId queue_id,
+    fml::TimePoint from_time) {
+  QueueGroupLock lock(*this, {queue_id});
   if (!HasPendingTasksUnlocked(queue_id)) {
     return nullptr;
   }
-  TaskSource::TopTask top = PeekNextTaskUnlocked(queue_id);
+  TaskSource::TopTask top = PeekNextTaskUnlocked(queue_id, from_time);
 
   if (!HasPendingTasksUnlocked(queue_id)) {
     WakeUpUnlocked(queue_id, fml::TimePoint::Max());
@@ -131,24 +276,76 @@ fml::closure MessageLoopTaskQueues::GetNextTaskToRun(TaskQueueId queue_id,
   if (top.task.GetTargetTime() > from_time) {
     return nullptr;
   }
-  fml::closure invocation = top.task.GetTask();
-  queue_entries_.at(top.task_queue_id)
-      ->task_source->PopTask(top.task.GetTaskSourceGrade());
   const auto task_source_grade = top.task.GetTaskSourceGrade();
-  tls_task_source_grade.reset(new TaskSourceGradeHolder{task_source_grade});
+  const auto priority = top.task.GetPriority();
+  const bool has_deadline = top.task.HasDeadline();
+  TaskQueueEntry* top_entry = GetEntryUnlocked(top.task_queue_id);
+  if (stats_enabled_.load(std::memory_order_relaxed)) {
+    // Tasks that run late in a long flush waited past |from_time|.
+    const auto run_time = std::max(from_time, fml::TimePoint::Now());
+    top_entry->stats.queue_delay[static_cast<size_t>(priority)].Record(
+        run_time - top.task.GetTargetTime());
+    top_entry->stats.tasks_run++;
+  }
+  // |top| refers to the popped task and is invalid past this point.
+  fml::UniqueClosure invocation =
+      top_entry->task_source->PopTask(task_source_grade, priority,
+                                      has_deadline);
+  if (tls_task_source_grade) {
+    tls_task_source_grade->task_source_grade = task_source_grade;
+  } else {
+    tls_task_source_grade.reset(new TaskSourceGradeHolder{task_source_grade});
+  }
   return invocation;
 }
 
+void MessageLoopTaskQueues::SetStatsEnabled(bool enabled) {
+  stats_enabled_.store(enabled, std::memory_order_relaxed);
+}
+
+bool MessageLoopTaskQueues::IsStatsEnabled() const {
+  return stats_enabled_.load(std::memory_order_relaxed);
+}
+
+TaskQueueStats MessageLoopTaskQueues::GetStats(TaskQueueId queue_id) const {
+  SharedLock table_lock(GetShardMutex(queue_id));
+  TaskQueueEntry* queue_entry = GetEntryUnlocked(queue_id);
+  std::scoped_lock entry_lock(queue_entry->mutex);
+  return queue_entry->stats;
+}
+
+void MessageLoopTaskQueues::ResetStats(TaskQueueId queue_id) {
+  SharedLock table_lock(GetShardMutex(queue_id));
+  TaskQueueEntry* queue_entry = GetEntryUnlocked(queue_id);
+  std::scoped_lock entry_lock(queue_entry->mutex);
+  queue_entry->stats = TaskQueueStats();
+}
+
+void MessageLoopTaskQueues::RecordTaskRunTime(TaskQueueId queue_id,
+                                              fml::TimeDelta run_time) {
+  SharedLock table_lock(GetShardMutex(queue_id));
+  TaskQueueEntry* queue_entry = GetEntryUnlocked(queue_id);
+  std::scoped_lock entry_lock(queue_entry->mutex);
+  queue_entry->stats.run_time.Record(run_time);
+}
+
+TimeHistogram MessageLoopTaskQueues::GetQueueDelayHistogram(
+    TaskQueueId queue_id,
+    TaskPriority priority) const {
+  return GetStats(queue_id).queue_delay[static_cast<size_t>(priority)];
+}
+
 void MessageLoopTaskQueues::WakeUpUnlocked(TaskQueueId queue_id,
                                            fml::TimePoint time) const {
-  if (queue_entries_.at(queue_id)->wakeable) {
-    queue_entries_.at(queue_id)->wakeable->WakeUp(time);
+  TaskQueueEntry* queue_entry = GetEntryUnlocked(queue_id);
+  if (queue_entry->wakeable) {
+    queue_entry->wakeable->WakeUp(time);
   }
 }
 
 size_t MessageLoopTaskQueues::GetNumPendingTasks(TaskQueueId queue_id) const {
-  std::lock_guard guard(queue_mutex_);
-  const auto& queue_entry = queue_entries_.at(queue_id);
+  QueueGroupLock lock(*this, {queue_id});
+  TaskQueueEntry* queue_entry = GetEntryUnlocked(queue_id);
   if (queue_entry->subsumed_by != kUnmerged) {
     return 0;
   }
@@ -158,7 +355,7 @@ size_t MessageLoopTaskQueues::GetNumPendingTasks(TaskQueueId queue_id) const {
 
   auto& subsumed_set = queue_entry->owner_of;
   for (auto& subsumed : subsumed_set) {
-    const auto& subsumed_entry = queue_entries_.at(subsumed);
+    TaskQueueEntry* subsumed_entry = GetEntryUnlocked(subsumed);
     total_tasks += subsumed_entry->task_source->GetNumPendingTasks();
   }
   return total_tasks;
@@ -167,55 +364,67 @@ size_t MessageLoopTaskQueues::GetNumPendingTasks(TaskQueueId queue_id) const {
 void MessageLoopTaskQueues::AddTaskObserver(TaskQueueId queue_id,
                                             intptr_t key,
                                             const fml::closure& callback) {
-  std::lock_guard guard(queue_mutex_);
   FML_DCHECK(callback != nullptr) << "Observer callback must be non-null.";
-  queue_entries_.at(queue_id)->task_observers[key] = callback;
+  SharedLock table_lock(GetShardMutex(queue_id));
+  TaskQueueEntry* queue_entry = GetEntryUnlocked(queue_id);
+  std::scoped_lock entry_lock(queue_entry->mutex);
+  queue_entry->task_observers[key] = callback;
 }
 
 void MessageLoopTaskQueues::RemoveTaskObserver(TaskQueueId queue_id,
                                                intptr_t key) {
-  std::lock_guard guard(queue_mutex_);
-  queue_entries_.at(queue_id)->task_observers.erase(key);
+  SharedLock table_lock(GetShardMutex(queue_id));
+  TaskQueueEntry* queue_entry = GetEntryUnlocked(queue_id);
+  std::scoped_lock entry_lock(queue_entry->mutex);
+  queue_entry->task_observers.erase(key);
 }
 
 std::vector<fml::closure> MessageLoopTaskQueues::GetObserversToNotify(
     TaskQueueId queue_id) const {
-  std::lock_guard guard(queue_mutex_);
   std::vector<fml::closure> observers;
+  GetObserversToNotify(queue_id, observers);
+  return observers;
+}
 
-  if (queue_entries_.at(queue_id)->subsumed_by != kUnmerged) {
-    return observers;
+void MessageLoopTaskQueues::GetObserversToNotify(
+    TaskQueueId queue_id,
+    std::vector<fml::closure>& observers) const {
+  QueueGroupLock lock(*this, {queue_id});
+  observers.clear();
+  TaskQueueEntry* queue_entry = GetEntryUnlocked(queue_id);
+
+  if (queue_entry->subsumed_by != kUnmerged) {
+    return;
   }
 
-  for (const auto& observer : queue_entries_.at(queue_id)->task_observers) {
+  for (const auto& observer : queue_entry->task_observers) {
     observers.push_back(observer.second);
   }
 
-  auto& subsumed_set = queue_entries_.at(queue_id)->owner_of;
+  auto& subsumed_set = queue_entry->owner_of;
   for (auto& subsumed : subsumed_set) {
-    for (const auto& observer : queue_entries_.at(subsumed)->task_observers) {
+    for (const auto& observer : GetEntryUnlocked(subsumed)->task_observers) {
       observers.push_back(observer.second);
     }
   }
-
-  return observers;
 }
 
 void MessageLoopTaskQueues::SetWakeable(TaskQueueId queue_id,
                                         fml::Wakeable* wakeable) {
-  std::lock_guard guard(queue_mutex_);
-  FML_CHECK(!queue_entries_.at(queue_id)->wakeable)
-      << "Wakeable can only be set once.";
-  queue_entries_.at(queue_id)->wakeable = wakeable;
+  SharedLock table_lock(GetShardMutex(queue_id));
+  TaskQueueEntry* queue_entry = GetEntryUnlocked(queue_id);
+  std::scoped_lock entry_lock(queue_entry->mutex);
+  FML_CHECK(!queue_entry->wakeable) << "Wakeable can only be set once.";
+  queue_entry->wakeable = wakeable;
 }
 
 bool MessageLoopTaskQueues::Merge(TaskQueueId owner, TaskQueueId subsumed) {
   if (owner == subsumed) {
     return true;
   }
-  std::lock_guard guard(queue_mutex_);
-  auto& owner_entry = queue_entries_.at(owner);
-  auto& subsumed_entry = queue_entries_.at(subsumed);
+  QueueGroupLock lock(*this, {owner, subsumed});
+  TaskQueueEntry* owner_entry = GetEntryUnlocked(owner);
+  TaskQueueEntry* subsumed_entry = GetEntryUnlocked(subsumed);
   auto& subsumed_set = owner_entry->owner_of;
   if (subsumed_set.find(subsumed) != subsumed_set.end()) {
     return true;
@@ -261,8 +470,9 @@ bool MessageLoopTaskQueues::Merge(TaskQueueId owner, TaskQueueId subsumed) {
 }
 
 bool MessageLoopTaskQueues::Unmerge(TaskQueueId owner, TaskQueueId subsumed) {
-  std::lock_guard guard(queue_mutex_);
-  const auto& owner_entry = queue_entries_.at(owner);
+  QueueGroupLock lock(*this, {owner, subsumed});
+  TaskQueueEntry* owner_entry = GetEntryUnlocked(owner);
+  TaskQueueEntry* subsumed_entry = GetEntryUnlocked(subsumed);
   if (owner_entry->owner_of.empty()) {
     FML_LOG(WARNING)
         << "Thread unmerging failed: owner_entry doesn't own anyone, owner="
@@ -276,7 +486,7 @@ bool MessageLoopTaskQueues::Unmerge(TaskQueueId owner, TaskQueueId subsumed) {
         << ", owner_entry->subsumed_by=" << owner_entry->subsumed_by;
     return false;
   }
-  if (queue_entries_.at(subsumed)->subsumed_by == kUnmerged) {
+  if (subsumed_entry->subsumed_by == kUnmerged) {
     FML_LOG(WARNING) << "Thread unmerging failed: subsumed_entry wasn't "
                         "subsumed by others, owner="
                      << owner << ", subsumed=" << subsumed;
@@ -289,7 +499,7 @@ bool MessageLoopTaskQueues::Unmerge(TaskQueueId owner, TaskQueueId subsumed) {
     return false;
   }
 
-  queue_entries_.at(subsumed)->subsumed_by = kUnmerged;
+  subsumed_entry->subsumed_by = kUnmerged;
   owner_entry->owner_of.erase(subsumed);
 
   if (HasPendingTasksUnlocked(owner)) {
@@ -305,28 +515,34 @@ bool MessageLoopTaskQueues::Unmerge(TaskQueueId owner, TaskQueueId subsumed) {
 
 bool MessageLoopTaskQueues::Owns(TaskQueueId owner,
                                  TaskQueueId subsumed) const {
-  std::lock_guard guard(queue_mutex_);
   if (owner == kUnmerged || subsumed == kUnmerged) {
     return false;
   }
-  auto& subsumed_set = queue_entries_.at(owner)->owner_of;
+  SharedLock table_lock(GetShardMutex(owner));
+  TaskQueueEntry* owner_entry = GetEntryUnlocked(owner);
+  std::scoped_lock entry_lock(owner_entry->mutex);
+  auto& subsumed_set = owner_entry->owner_of;
   return subsumed_set.find(subsumed) != subsumed_set.end();
 }
 
 std::set<TaskQueueId> MessageLoopTaskQueues::GetSubsumedTaskQueueId(
     TaskQueueId owner) const {
-  std::lock_guard guard(queue_mutex_);
-  return queue_entries_.at(owner)->owner_of;
+  SharedLock table_lock(GetShardMutex(owner));
+  TaskQueueEntry* owner_entry = GetEntryUnlocked(owner);
+  std::scoped_lock entry_lock(owner_entry->mutex);
+  return owner_entry->owner_of;
 }
 
 void MessageLoopTaskQueues::PauseSecondarySource(TaskQueueId queue_id) {
-  std::lock_guard guard(queue_mutex_);
-  queue_entries_.at(queue_id)->task_source->PauseSecondary();
+  SharedLock table_lock(GetShardMutex(queue_id));
+  TaskQueueEntry* queue_entry = GetEntryUnlocked(queue_id);
+  std::scoped_lock entry_lock(queue_entry->mutex);
+  queue_entry->task_source->PauseSecondary();
 }
 
 void MessageLoopTaskQueues::ResumeSecondarySource(TaskQueueId queue_id) {
-  std::lock_guard guard(queue_mutex_);
-  queue_entries_.at(queue_id)->task_source->ResumeSecondary();
+  QueueGroupLock lock(*this, {queue_id});
+  GetEntryUnlocked(queue_id)->task_source->ResumeSecondary();
   // Schedule a wake as needed.
   if (HasPendingTasksUnlocked(queue_id)) {
     WakeUpUnlocked(queue_id, GetNextWakeTimeUnlocked(queue_id));
@@ -337,7 +553,7 @@ void MessageLoopTaskQueues::ResumeSecondarySource(TaskQueueId queue_id) {
 // Owning queues will consider both their and their subsumed tasks.
 bool MessageLoopTaskQueues::HasPendingTasksUnlocked(
     TaskQueueId queue_id) const {
-  const auto& entry = queue_entries_.at(queue_id);
+  const TaskQueueEntry* entry = GetEntryUnlocked(queue_id);
   bool is_subsumed = entry->subsumed_by != kUnmerged;
   if (is_subsumed) {
     return false;
@@ -350,7 +566,7 @@ bool MessageLoopTaskQueues::HasPendingTasksUnlocked(
   auto& subsumed_set = entry->owner_of;
   return std::any_of(
       subsumed_set.begin(), subsumed_set.end(), [&](const auto& subsumed) {
-        return !queue_entries_.at(subsumed)->task_source->IsEmpty();
+        return !GetEntryUnlocked(subsumed)->task_source->IsEmpty();
       });
 }
 
@@ -360,22 +576,24 @@ fml::TimePoint MessageLoopTaskQueues::GetNextWakeTimeUnlocked(
 }
 
 TaskSource::TopTask MessageLoopTaskQueues::PeekNextTaskUnlocked(
-    TaskQueueId owner) const {
+    TaskQueueId owner,
+    fml::TimePoint now) const {
   FML_DCHECK(HasPendingTasksUnlocked(owner));
-  const auto& entry = queue_entries_.at(owner);
+  const TaskQueueEntry* entry = GetEntryUnlocked(owner);
   if (entry->owner_of.empty()) {
     FML_CHECK(!entry->task_source->IsEmpty());
-    return entry->task_source->Top();
+    return entry->task_source->Top(now);
   }
 
   // Use optional for the memory of TopTask object.
   std::optional<TaskSource::TopTask> top_task;
 
   std::function<void(const TaskSource*)> top_task_updater =
-      [&top_task](const TaskSource* source) {
+      [&top_task, now](const TaskSource* source) {
         if (source && !source->IsEmpty()) {
-          TaskSource::TopTask other_task = source->Top();
-          if (!top_task.has_value() || top_task->task > other_task.task) {
+          TaskSource::TopTask other_task = source->Top(now);
+          if (!top_task.has_value() ||
+              other_task.task.RunsBefore(top_task->task, now)) {
             top_task.emplace(other_task);
           }
         }
@@ -385,7 +603,7 @@ TaskSource::TopTask MessageLoopTaskQueues::PeekNextTaskUnlocked(
   top_task_updater(owner_tasks);
 
   for (TaskQueueId subsumed : entry->owner_of) {
-    TaskSource* subsumed_tasks = queue_entries_.at(subsumed)->task_source.get();
+    TaskSource* subsumed_tasks = GetEntryUnlocked(subsumed)->task_source.get();
     top_task_updater(subsumed_tasks);
   }
   // At least one task at the top because PeekNextTaskUnlocked() is called after
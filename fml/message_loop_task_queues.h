@@ -5,6 +5,8 @@
 #ifndef FLUTTER_FML_MESSAGE_LOOP_TASK_QUEUES_H_
 #define FLUTTER_FML_MESSAGE_LOOP_TASK_QUEUES_H_
 
+#include <atomic>
+#include <initializer_list>
 #include <map>
 #include <memory>
 #include <mutex>
@@ -16,14 +18,33 @@
 #include "flutter/fml/macros.h"
 #include "flutter/fml/memory/ref_counted.h"
 #include "flutter/fml/synchronization/shared_mutex.h"
+#include "flutter/fml/task_priority.h"
 #include "flutter/fml/task_queue_id.h"
 #include "flutter/fml/task_source.h"
+#include "flutter/fml/time/time_histogram.h"
 #include "flutter/fml/wakeable.h"
 
 namespace fml {
 
 static const TaskQueueId kUnmerged = TaskQueueId(TaskQueueId::kUnmerged);
 
+/// How a task queue has been serviced. Only collected while
+/// \p MessageLoopTaskQueues::SetStatsEnabled is on.
+struct TaskQueueStats {
+  /// Time between a task becoming ready and it being handed out to run, per
+  /// `TaskPriority` the task was posted with.
+  TimeHistogram queue_delay[kTaskPriorityCount];
+
+  /// Time taken to run each task, as reported by the loop servicing the queue.
+  TimeHistogram run_time;
+
+  /// Number of tasks handed out to run.
+  size_t tasks_run = 0;
+
+  /// The largest number of tasks that were pending on the queue at once.
+  size_t max_pending_tasks = 0;
+};
+
 /// A collection of tasks and observers associated with one TaskQueue.
 ///
 /// Often a TaskQueue has a one-to-one relationship with a fml::MessageLoop,
@@ -46,6 +67,13 @@ class TaskQueueEntry {
 
   TaskQueueId created_for;
 
+  TaskQueueStats stats;
+
+  /// Guards every other field of this entry. Operations that span a merged
+  /// group of queues hold the mutexes of all members, acquired in ascending
+  /// \p TaskQueueId order.
+  std::mutex mutex;
+
   explicit TaskQueueEntry(TaskQueueId created_for);
 
  private:
@@ -61,6 +89,13 @@ enum class FlushType {
 /// fml::MessageLoops.
 ///
 /// This also wakes up the loop at the required times.
+///
+/// Queues are stored in a flat table indexed by \p TaskQueueId. The table is
+/// guarded by a set of sharded reader-writer locks: lookups take the shared
+/// side of the shard the queue id maps to, while creating and disposing queues
+/// takes every shard exclusively. Task and observer state is guarded by the
+/// per-queue \p TaskQueueEntry::mutex, so threads working on unrelated queues
+/// never contend with each other.
 /// \see fml::MessageLoop
 /// \see fml::Wakeable
 class MessageLoopTaskQueues {
@@ -77,20 +112,49 @@ class MessageLoopTaskQueues {
 
   // Tasks methods.
 
-  void RegisterTask(TaskQueueId queue_id,
-                    const fml::closure& task,
-                    fml::TimePoint target_time,
-                    fml::TaskSourceGrade task_source_grade =
-                        fml::TaskSourceGrade::kUnspecified);
+  /// Registers a task to run on |queue_id| once |target_time| has passed.
+  /// Among ready tasks, those with a more urgent |priority| run first. A task
+  /// that has not run by its |deadline| competes as frame-critical.
+  void RegisterTask(
+      TaskQueueId queue_id,
+      fml::UniqueClosure task,
+      fml::TimePoint target_time,
+      fml::TaskSourceGrade task_source_grade =
+          fml::TaskSourceGrade::kUnspecified,
+      fml::TaskPriority priority = fml::TaskPriority::kNormal,
+      fml::TimePoint deadline = fml::TimePoint::Max());
 
   bool HasPendingTasks(TaskQueueId queue_id) const;
 
-  fml::closure GetNextTaskToRun(TaskQueueId queue_id, fml::TimePoint from_time);
+  fml::UniqueClosure GetNextTaskToRun(TaskQueueId queue_id,
+                                      fml::TimePoint from_time);
 
   size_t GetNumPendingTasks(TaskQueueId queue_id) const;
 
   static TaskSourceGrade GetCurrentTaskSourceGrade();
 
+  // Stats methods.
+
+  /// Turns collection of |TaskQueueStats| for all queues on or off. Collection
+  /// is off by default, in which case the only cost is checking this flag.
+  void SetStatsEnabled(bool enabled);
+
+  bool IsStatsEnabled() const;
+
+  /// Returns a snapshot of the stats collected for |queue_id|.
+  TaskQueueStats GetStats(TaskQueueId queue_id) const;
+
+  void ResetStats(TaskQueueId queue_id);
+
+  /// Records that a task of |queue_id| took |run_time| to run. Called by the
+  /// loop servicing the queue while stats are enabled.
+  void RecordTaskRunTime(TaskQueueId queue_id, fml::TimeDelta run_time);
+
+  /// Returns how long the tasks of |queue_id| posted with |priority| waited
+  /// between becoming ready and being run.
+  TimeHistogram GetQueueDelayHistogram(TaskQueueId queue_id,
+                                       TaskPriority priority) const;
+
   // Observers methods.
 
   void AddTaskObserver(TaskQueueId queue_id,
@@ -101,6 +165,11 @@ class MessageLoopTaskQueues {
 
   std::vector<fml::closure> GetObserversToNotify(TaskQueueId queue_id) const;
 
+  /// Like |GetObserversToNotify| but reuses the storage of |observers|, which
+  /// is cleared first.
+  void GetObserversToNotify(TaskQueueId queue_id,
+                            std::vector<fml::closure>& observers) const;
+
   // Misc.
 
   void SetWakeable(TaskQueueId queue_id, fml::Wakeable* wakeable);
@@ -139,26 +208,44 @@ class MessageLoopTaskQueues {
 
  private:
   class MergedQueuesRunner;
+  class QueueGroupLock;
+  class TableWriteLock;
+
+  static constexpr size_t kQueueTableShardCount = 16;
 
   MessageLoopTaskQueues();
 
   ~MessageLoopTaskQueues();
 
+  SharedMutex& GetShardMutex(TaskQueueId queue_id) const;
+
+  // Requires a shard lock to be held.
+  TaskQueueEntry* GetEntryUnlocked(TaskQueueId queue_id) const;
+
+  // The methods below require the group of |queue_id| to be locked.
+
   void WakeUpUnlocked(TaskQueueId queue_id, fml::TimePoint time) const;
 
   bool HasPendingTasksUnlocked(TaskQueueId queue_id) const;
 
-  TaskSource::TopTask PeekNextTaskUnlocked(TaskQueueId owner) const;
+  // Returns the task that should run at |now|, or the earliest scheduled task
+  // if none is ready yet.
+  TaskSource::TopTask PeekNextTaskUnlocked(
+      TaskQueueId owner,
+      fml::TimePoint now = fml::TimePoint::Min()) const;
 
   fml::TimePoint GetNextWakeTimeUnlocked(TaskQueueId queue_id) const;
 
-  mutable std::mutex queue_mutex_;
-  std::map<TaskQueueId, std::unique_ptr<TaskQueueEntry>> queue_entries_;
+  std::unique_ptr<SharedMutex> table_shards_[kQueueTableShardCount];
 
-  size_t task_queue_id_counter_ = 0;
+  // Indexed by TaskQueueId. Disposed queues leave a null slot behind so that
+  // ids are never reused.
+  std::vector<std::unique_ptr<TaskQueueEntry>> queue_entries_;
 
   std::atomic_int order_;
 
+  std::atomic_bool stats_enabled_ = false;
+
   FML_DISALLOW_COPY_ASSIGN_AND_MOVE(MessageLoopTaskQueues);
 };
 
@@ -7,6 +7,7 @@
 #include "flutter/fml/message_loop_task_queues.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cstdlib>
 #include <thread>
 #include <utility>
@@ -103,7 +104,8 @@ TEST(MessageLoopTaskQueue, PreserveTaskOrdering) {
   const auto now = ChronoTicksSinceEpoch();
   int expected_value = 1;
   while (true) {
-    fml::closure invocation = task_queue->GetNextTaskToRun(queue_id, now);
+    fml::UniqueClosure invocation =
+        task_queue->GetNextTaskToRun(queue_id, now);
     if (!invocation) {
       break;
     }
@@ -143,7 +145,8 @@ TEST(MessageLoopTaskQueue, RegisterTasksOnMergedQueuesPreserveTaskOrdering) {
   // "test_val = 1" in platform_queue
   // "test_val = 2" in raster2_queue
   while (true) {
-    fml::closure invocation = task_queue->GetNextTaskToRun(platform_queue, now);
+    fml::UniqueClosure invocation =
+        task_queue->GetNextTaskToRun(platform_queue, now);
     if (!invocation) {
       break;
     }
@@ -186,7 +189,8 @@ TEST(MessageLoopTaskQueue, UnmergeRespectTheOriginalTaskOrderingInQueues) {
   // "test_val = 1" in platform_queue
   // "test_val = 2" in raster_queue (running on platform)
   for (int i = 0; i < 3; i++) {
-    fml::closure invocation = task_queue->GetNextTaskToRun(platform_queue, now);
+    fml::UniqueClosure invocation =
+        task_queue->GetNextTaskToRun(platform_queue, now);
     ASSERT_FALSE(!invocation);
     invocation();
     ASSERT_TRUE(test_val == i);
@@ -205,7 +209,8 @@ TEST(MessageLoopTaskQueue, UnmergeRespectTheOriginalTaskOrderingInQueues) {
   // platform_queue has 1 task left: "test_val = 4"
   {
     ASSERT_TRUE(task_queue->GetNumPendingTasks(platform_queue) == 1);
-    fml::closure invocation = task_queue->GetNextTaskToRun(platform_queue, now);
+    fml::UniqueClosure invocation =
+        task_queue->GetNextTaskToRun(platform_queue, now);
     ASSERT_FALSE(!invocation);
     invocation();
     ASSERT_TRUE(test_val == 4);
@@ -215,14 +220,16 @@ TEST(MessageLoopTaskQueue, UnmergeRespectTheOriginalTaskOrderingInQueues) {
   // raster_queue has 2 tasks left: "test_val = 3" and "test_val = 5"
   {
     ASSERT_TRUE(task_queue->GetNumPendingTasks(raster_queue) == 2);
-    fml::closure invocation = task_queue->GetNextTaskToRun(raster_queue, now);
+    fml::UniqueClosure invocation =
+        task_queue->GetNextTaskToRun(raster_queue, now);
     ASSERT_FALSE(!invocation);
     invocation();
     ASSERT_TRUE(test_val == 3);
   }
   {
     ASSERT_TRUE(task_queue->GetNumPendingTasks(raster_queue) == 1);
-    fml::closure invocation = task_queue->GetNextTaskToRun(raster_queue, now);
+    fml::UniqueClosure invocation =
+        task_queue->GetNextTaskToRun(raster_queue, now);
     ASSERT_FALSE(!invocation);
     invocation();
     ASSERT_TRUE(test_val == 5);
@@ -404,6 +411,121 @@ TEST(MessageLoopTaskQueue, ConcurrentQueueAndTaskCreatingCounts) {
   ASSERT_EQ(pending_tasks, kThreadCount * kThreadTaskCount);
 }
 
+//------------------------------------------------------------------------------
+/// Verifies that tasks registered on a queue while it is concurrently merged
+/// into and unmerged from another queue are never lost.
+///
+TEST(MessageLoopTaskQueue, ConcurrentRegisterTaskAndMergeUnmerge) {
+  auto task_queues = fml::MessageLoopTaskQueues::GetInstance();
+  auto platform_queue = task_queues->CreateTaskQueue();
+  auto raster_queue = task_queues->CreateTaskQueue();
+
+  constexpr size_t kThreadCount = 4;
+  constexpr size_t kThreadTaskCount = 500;
+
+  std::atomic_bool done = false;
+  std::thread merger([&]() {
+    while (!done) {
+      ASSERT_TRUE(task_queues->Merge(platform_queue, raster_queue));
+      ASSERT_GT(task_queues->GetNumPendingTasks(platform_queue), 0u);
+      ASSERT_TRUE(task_queues->Unmerge(platform_queue, raster_queue));
+    }
+  });
+
+  // Keep at least one task on the platform queue so that the merged count
+  // above is always non-zero.
+  task_queues->RegisterTask(platform_queue, [] {}, ChronoTicksSinceEpoch());
+
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < kThreadCount; i++) {
+    threads.emplace_back([&]() {
+      for (size_t j = 0; j < kThreadTaskCount; j++) {
+        task_queues->RegisterTask(raster_queue, [] {},
+                                  ChronoTicksSinceEpoch());
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  done = true;
+  merger.join();
+
+  ASSERT_FALSE(task_queues->Owns(platform_queue, raster_queue));
+  ASSERT_EQ(task_queues->GetNumPendingTasks(platform_queue), 1u);
+  ASSERT_EQ(task_queues->GetNumPendingTasks(raster_queue),
+            kThreadCount * kThreadTaskCount);
+}
+
+TEST(MessageLoopTaskQueue, FrameCriticalTasksRunBeforeBulkWork) {
+  auto task_queue = fml::MessageLoopTaskQueues::GetInstance();
+  auto queue_id = task_queue->CreateTaskQueue();
+  const auto posted = ChronoTicksSinceEpoch();
+  std::vector<int> run_order;
+  task_queue->SetStatsEnabled(true);
+
+  for (int i = 0; i < 10; i++) {
+    task_queue->RegisterTask(
+        queue_id, [&run_order]() { run_order.push_back(0); }, posted,
+        fml::TaskSourceGrade::kUnspecified, fml::TaskPriority::kLow);
+  }
+  task_queue->RegisterTask(
+      queue_id, [&run_order]() { run_order.push_back(1); }, posted,
+      fml::TaskSourceGrade::kUnspecified, fml::TaskPriority::kFrameCritical);
+
+  const auto now = posted + fml::TimeDelta::FromMilliseconds(1);
+  while (auto task = task_queue->GetNextTaskToRun(queue_id, now)) {
+    task();
+  }
+  ASSERT_EQ(run_order.size(), 11u);
+  ASSERT_EQ(run_order[0], 1);
+
+  auto frame_critical = task_queue->GetQueueDelayHistogram(
+      queue_id, fml::TaskPriority::kFrameCritical);
+  auto low = task_queue->GetQueueDelayHistogram(queue_id,
+                                                fml::TaskPriority::kLow);
+  task_queue->SetStatsEnabled(false);
+  ASSERT_EQ(frame_critical.GetCount(), 1u);
+  ASSERT_EQ(low.GetCount(), 10u);
+  ASSERT_GE(frame_critical.GetMax(), fml::TimeDelta::FromMilliseconds(1));
+}
+
+TEST(MessageLoopTaskQueue, StatsAreOnlyCollectedWhenEnabled) {
+  auto task_queue = fml::MessageLoopTaskQueues::GetInstance();
+  auto queue_id = task_queue->CreateTaskQueue();
+  const auto past = ChronoTicksSinceEpoch();
+
+  task_queue->RegisterTask(queue_id, [] {}, past);
+  task_queue->GetNextTaskToRun(queue_id, past)();
+  auto stats = task_queue->GetStats(queue_id);
+  ASSERT_EQ(stats.tasks_run, 0u);
+  ASSERT_EQ(stats.max_pending_tasks, 0u);
+
+  task_queue->SetStatsEnabled(true);
+  for (int i = 0; i < 3; i++) {
+    task_queue->RegisterTask(queue_id, [] {}, past);
+  }
+  while (auto task = task_queue->GetNextTaskToRun(queue_id, past)) {
+    task();
+    task_queue->RecordTaskRunTime(queue_id,
+                                  fml::TimeDelta::FromMicroseconds(10));
+  }
+  task_queue->SetStatsEnabled(false);
+
+  stats = task_queue->GetStats(queue_id);
+  ASSERT_EQ(stats.tasks_run, 3u);
+  ASSERT_EQ(stats.max_pending_tasks, 3u);
+  ASSERT_EQ(
+      stats.queue_delay[static_cast<size_t>(fml::TaskPriority::kNormal)]
+          .GetCount(),
+      3u);
+  ASSERT_EQ(stats.run_time.GetCount(), 3u);
+  ASSERT_EQ(stats.run_time.GetMax(), fml::TimeDelta::FromMicroseconds(10));
+
+  task_queue->ResetStats(queue_id);
+  ASSERT_EQ(task_queue->GetStats(queue_id).tasks_run, 0u);
+}
+
 TEST(MessageLoopTaskQueue, RegisterTaskWakesUpOwnerQueue) {
   auto task_queue = fml::MessageLoopTaskQueues::GetInstance();
   auto platform_queue = task_queue->CreateTaskQueue();
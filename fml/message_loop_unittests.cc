@@ -7,10 +7,12 @@
 #include "flutter/fml/message_loop.h"
 
 #include <iostream>
+#include <memory>
 #include <thread>
 
 #include "flutter/fml/build_config.h"
 #include "flutter/fml/concurrent_message_loop.h"
+#include "flutter/fml/message_loop_task_queues.h"
 #include "flutter/fml/synchronization/count_down_latch.h"
 #include "flutter/fml/synchronization/waitable_event.h"
 #include "flutter/fml/task_runner.h"
@@ -73,6 +75,30 @@ TEST(MessageLoop, CanRunAndTerminate) {
   ASSERT_TRUE(terminated);
 }
 
+TEST(MessageLoop, RecordsTaskRunTimeWhenStatsAreEnabled) {
+  auto task_queues = fml::MessageLoopTaskQueues::GetInstance();
+  task_queues->SetStatsEnabled(true);
+  fml::TaskQueueStats stats;
+  std::thread thread([&stats, task_queues]() {
+    fml::MessageLoop::EnsureInitializedForCurrentThread();
+    auto& loop = fml::MessageLoop::GetCurrent();
+    const auto queue_id = loop.GetTaskRunner()->GetTaskQueueId();
+    loop.GetTaskRunner()->PostTask([]() {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    });
+    loop.GetTaskRunner()->PostTask([&stats, task_queues, queue_id]() {
+      stats = task_queues->GetStats(queue_id);
+      fml::MessageLoop::GetCurrent().Terminate();
+    });
+    loop.Run();
+  });
+  thread.join();
+  task_queues->SetStatsEnabled(false);
+  ASSERT_EQ(stats.tasks_run, 2u);
+  ASSERT_EQ(stats.run_time.GetCount(), 1u);
+  ASSERT_GE(stats.run_time.GetMax(), fml::TimeDelta::FromMilliseconds(1));
+}
+
 TEST(MessageLoop, NonDelayedTasksAreRunInOrder) {
   const size_t count = 100;
   bool started = false;
@@ -147,6 +173,22 @@ TEST(MessageLoop, CheckRunsTaskOnCurrentThread) {
   thread.join();
 }
 
+TEST(MessageLoop, CanPostMoveOnlyTasks) {
+  std::thread thread([]() {
+    fml::MessageLoop::EnsureInitializedForCurrentThread();
+    auto& loop = fml::MessageLoop::GetCurrent();
+    int runs = 0;
+    auto increment = std::make_unique<int>(1);
+    loop.GetTaskRunner()->PostTask(
+        [increment = std::move(increment), &runs]() { runs += *increment; });
+    loop.GetTaskRunner()->PostTaskWithPriority(
+        [&loop]() { loop.Terminate(); }, fml::TaskPriority::kNormal);
+    loop.Run();
+    ASSERT_EQ(runs, 1);
+  });
+  thread.join();
+}
+
 TEST(MessageLoop, TaskObserverFire) {
   bool started = false;
   bool terminated = false;
@@ -191,6 +233,42 @@ TEST(MessageLoop, CanCreateAndShutdownConcurrentMessageLoopsOverAndOver) {
   }
 }
 
+TEST(MessageLoop, WorkStealingConcurrentMessageLoopRunsAllTasks) {
+  auto loop = fml::ConcurrentMessageLoop::Create(
+      4u, fml::ConcurrentMessageLoop::SchedulingPolicy::kWorkStealing);
+  auto task_runner = loop->GetTaskRunner();
+  constexpr size_t kCount = 1000;
+  // Each task posted from outside the loop posts one more task from the
+  // worker it runs on, exercising both the injection and the local queues.
+  fml::CountDownLatch latch(kCount * 2);
+  for (size_t i = 0; i < kCount; ++i) {
+    task_runner->PostTask([&latch, task_runner]() {
+      task_runner->PostTask([&latch]() { latch.CountDown(); });
+      latch.CountDown();
+    });
+  }
+  latch.Wait();
+}
+
+TEST(MessageLoop, WorkStealingConcurrentMessageLoopRunsTasksOnAllWorkers) {
+  constexpr size_t kWorkerCount = 4;
+  auto loop = fml::ConcurrentMessageLoop::Create(
+      kWorkerCount,
+      fml::ConcurrentMessageLoop::SchedulingPolicy::kWorkStealing);
+  fml::CountDownLatch latch(kWorkerCount);
+  std::mutex thread_ids_mutex;
+  std::set<std::thread::id> thread_ids;
+  loop->PostTaskToAllWorkers([&]() {
+    {
+      std::scoped_lock lock(thread_ids_mutex);
+      thread_ids.insert(std::this_thread::get_id());
+    }
+    latch.CountDown();
+  });
+  latch.Wait();
+  ASSERT_EQ(thread_ids.size(), kWorkerCount);
+}
+
 TEST(MessageLoop, CanCreateConcurrentMessageLoop) {
   auto loop = fml::ConcurrentMessageLoop::Create();
   auto task_runner = loop->GetTaskRunner();
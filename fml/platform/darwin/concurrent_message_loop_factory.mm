@@ -10,7 +10,8 @@ class ConcurrentMessageLoopDarwin : public ConcurrentMessageLoop {
   friend class ConcurrentMessageLoop;
 
  protected:
-  explicit ConcurrentMessageLoopDarwin(size_t worker_count) : ConcurrentMessageLoop(worker_count) {}
+  ConcurrentMessageLoopDarwin(size_t worker_count, SchedulingPolicy policy)
+      : ConcurrentMessageLoop(worker_count, policy) {}
 
   void ExecuteTask(const fml::closure& task) override {
     @autoreleasepool {
@@ -19,8 +20,10 @@ class ConcurrentMessageLoopDarwin : public ConcurrentMessageLoop {
   }
 };
 
-std::shared_ptr<ConcurrentMessageLoop> ConcurrentMessageLoop::Create(size_t worker_count) {
-  return std::shared_ptr<ConcurrentMessageLoop>{new ConcurrentMessageLoopDarwin(worker_count)};
+std::shared_ptr<ConcurrentMessageLoop> ConcurrentMessageLoop::Create(size_t worker_count,
+                                                                     SchedulingPolicy policy) {
+  return std::shared_ptr<ConcurrentMessageLoop>{
+      new ConcurrentMessageLoopDarwin(worker_count, policy)};
 }
 
 }  // namespace fml
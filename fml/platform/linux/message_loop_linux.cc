@@ -79,12 +79,20 @@ void MessageLoopLinux::Terminate() {
 
 // |fml::MessageLoopImpl|
 void MessageLoopLinux::WakeUp(fml::TimePoint time_point) {
-  bool result = TimerRearm(timer_fd_.get(), time_point);
+  // The task queues request wakeups while holding the lock of this loop's
+  // queue, so calls to the coalescer and re-arms of the timer don't interleave.
+  auto arm_time =
+      timer_coalescer_.RequestWakeUp(time_point, fml::TimePoint::Now());
+  if (!arm_time.has_value()) {
+    return;
+  }
+  bool result = TimerRearm(timer_fd_.get(), arm_time.value());
   (void)result;
   FML_DCHECK(result);
 }
 
 void MessageLoopLinux::OnEventFired() {
+  timer_coalescer_.OnTimerFired(fml::TimePoint::Now());
   if (TimerDrain(timer_fd_.get())) {
     RunExpiredTasksNow();
   }
@@ -19,6 +19,7 @@
 #include <uv.h>
 #include "flutter/fml/macros.h"
 #include "flutter/fml/message_loop_impl.h"
+#include "flutter/fml/time/timer_coalescer.h"
 #include "flutter/fml/unique_fd.h"
 #include <thread>
 #include <atomic>
@@ -32,6 +33,7 @@ class MessageLoopOhos : public MessageLoopImpl {
   uv_loop_t loop_;
 	fml::UniqueFD epoll_fd_;
   fml::UniqueFD timer_fd_;
+  fml::TimerCoalescer timer_coalescer_;
   std::atomic<bool> running_;
   std::thread timerhandle_thread_;
 	bool is_platform_loop_;
@@ -0,0 +1,36 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FML_TASK_PRIORITY_H_
+#define FLUTTER_FML_TASK_PRIORITY_H_
+
+#include <cstddef>
+
+namespace fml {
+
+/**
+ * Priority classes of tasks dispatched by `MessageLoopTaskQueues`. Among the
+ * tasks of a queue that are ready to run, tasks of a more urgent class run
+ * first. This is independent of `TaskSourceGrade`, which only determines
+ * whether a task can be paused.
+ */
+enum class TaskPriority {
+  /// Work that has to complete within the current frame. Tasks that are past
+  /// their deadline, such as a vsync callback whose frame is at risk of being
+  /// late, compete in this class.
+  kFrameCritical,
+  /// Work that responds to the user or the platform, e.g. pointer events and
+  /// platform messages.
+  kHigh,
+  /// The default priority.
+  kNormal,
+  /// Bulk work that may wait behind everything else.
+  kLow,
+};
+
+constexpr size_t kTaskPriorityCount = 4;
+
+}  // namespace fml
+
+#endif  // FLUTTER_FML_TASK_PRIORITY_H_
@@ -7,6 +7,7 @@
 #include "flutter/fml/task_runner.h"
 #include "flutter/fml/memory/task_runner_checker.h"
 
+#include <memory>
 #include <utility>
 
 #include "flutter/fml/logging.h"
@@ -16,6 +17,18 @@
 
 namespace fml {
 
+namespace {
+
+// Wraps a task for the task runners that aren't backed by a MessageLoopImpl,
+// which only take copyable closures.
+fml::closure ToClosure(fml::UniqueClosure task) {
+  return [task = std::make_shared<fml::UniqueClosure>(std::move(task))]() {
+    (*task)();
+  };
+}
+
+}  // namespace
+
 TaskRunner::TaskRunner(fml::RefPtr<MessageLoopImpl> loop)
     : loop_(std::move(loop)) {}
 
@@ -25,16 +38,62 @@ void TaskRunner::PostTask(const fml::closure& task) {
   loop_->PostTask(task, fml::TimePoint::Now());
 }
 
+void TaskRunner::PostTask(fml::UniqueClosure&& task) {
+  if (!loop_) {
+    PostTask(ToClosure(std::move(task)));
+    return;
+  }
+  loop_->PostTask(std::move(task), fml::TimePoint::Now());
+}
+
 void TaskRunner::PostTaskForTime(const fml::closure& task,
                                  fml::TimePoint target_time) {
   loop_->PostTask(task, target_time);
 }
 
+void TaskRunner::PostTaskForTime(fml::UniqueClosure&& task,
+                                 fml::TimePoint target_time) {
+  if (!loop_) {
+    PostTaskForTime(ToClosure(std::move(task)), target_time);
+    return;
+  }
+  loop_->PostTask(std::move(task), target_time);
+}
+
 void TaskRunner::PostDelayedTask(const fml::closure& task,
                                  fml::TimeDelta delay) {
   loop_->PostTask(task, fml::TimePoint::Now() + delay);
 }
 
+void TaskRunner::PostDelayedTask(fml::UniqueClosure&& task,
+                                 fml::TimeDelta delay) {
+  if (!loop_) {
+    PostDelayedTask(ToClosure(std::move(task)), delay);
+    return;
+  }
+  loop_->PostTask(std::move(task), fml::TimePoint::Now() + delay);
+}
+
+void TaskRunner::PostTaskWithPriority(const fml::closure& task,
+                                      fml::TaskPriority priority,
+                                      fml::TimePoint deadline) {
+  if (!loop_) {
+    PostTask(task);
+    return;
+  }
+  loop_->PostTask(task, fml::TimePoint::Now(), priority, deadline);
+}
+
+void TaskRunner::PostTaskWithPriority(fml::UniqueClosure&& task,
+                                      fml::TaskPriority priority,
+                                      fml::TimePoint deadline) {
+  if (!loop_) {
+    PostTask(ToClosure(std::move(task)));
+    return;
+  }
+  loop_->PostTask(std::move(task), fml::TimePoint::Now(), priority, deadline);
+}
+
 TaskQueueId TaskRunner::GetTaskQueueId() {
   FML_DCHECK(loop_);
   return loop_->GetTaskQueueId();
@@ -62,4 +121,14 @@ void TaskRunner::RunNowOrPostTask(const fml::RefPtr<fml::TaskRunner>& runner,
   }
 }
 
+void TaskRunner::RunNowOrPostTask(const fml::RefPtr<fml::TaskRunner>& runner,
+                                  fml::UniqueClosure&& task) {
+  FML_DCHECK(runner);
+  if (runner->RunsTasksOnCurrentThread()) {
+    task();
+  } else {
+    runner->PostTask(std::move(task));
+  }
+}
+
 }  // namespace fml
@@ -5,11 +5,15 @@
 #ifndef FLUTTER_FML_TASK_RUNNER_H_
 #define FLUTTER_FML_TASK_RUNNER_H_
 
+#include <type_traits>
+#include <utility>
+
 #include "flutter/fml/closure.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/memory/ref_counted.h"
 #include "flutter/fml/memory/ref_ptr.h"
 #include "flutter/fml/message_loop_task_queues.h"
+#include "flutter/fml/task_priority.h"
 #include "flutter/fml/time/time_point.h"
 
 namespace fml {
@@ -30,17 +34,48 @@ class BasicTaskRunner {
 /// wants to execute an operation on that thread they post a task to the
 /// TaskRunner.
 ///
+/// Each method that posts a task also takes a \p fml::UniqueClosure. Lambdas
+/// and other callables are moved into one directly rather than wrapped in a
+/// \p fml::closure, so posting them doesn't allocate when their captures fit
+/// in its inline storage. Task runners that aren't backed by a
+/// \p MessageLoopImpl, such as the ones provided by embedders, receive these
+/// tasks through their \p fml::closure overloads, wrapped in a closure.
+///
 /// \see fml::MessageLoop
 class TaskRunner : public fml::RefCountedThreadSafe<TaskRunner>,
                    public BasicTaskRunner {
+ private:
+  // Picks the overloads that move a callable into a fml::UniqueClosure for
+  // everything but the closure types, which have overloads of their own.
+  template <typename Callable, typename Stored = std::decay_t<Callable>>
+  using EnableIfCallable =
+      std::enable_if_t<!std::is_same_v<Stored, fml::closure> &&
+                       !std::is_same_v<Stored, fml::UniqueClosure> &&
+                       std::is_invocable_r_v<void, Stored&>>;
+
  public:
   virtual ~TaskRunner();
 
   virtual void PostTask(const fml::closure& task) override;
 
+  void PostTask(fml::UniqueClosure&& task);
+
+  template <typename Callable, typename = EnableIfCallable<Callable>>
+  void PostTask(Callable&& task) {
+    PostTask(fml::UniqueClosure(std::forward<Callable>(task)));
+  }
+
   virtual void PostTaskForTime(const fml::closure& task,
                                fml::TimePoint target_time);
 
+  void PostTaskForTime(fml::UniqueClosure&& task, fml::TimePoint target_time);
+
+  template <typename Callable, typename = EnableIfCallable<Callable>>
+  void PostTaskForTime(Callable&& task, fml::TimePoint target_time) {
+    PostTaskForTime(fml::UniqueClosure(std::forward<Callable>(task)),
+                    target_time);
+  }
+
   /// Schedules a task to be run on the MessageLoop after the time \p delay has
   /// passed.
   /// \note There is latency between when the task is schedule and actually
@@ -49,6 +84,35 @@ class TaskRunner : public fml::RefCountedThreadSafe<TaskRunner>,
   /// tens of milliseconds.
   virtual void PostDelayedTask(const fml::closure& task, fml::TimeDelta delay);
 
+  void PostDelayedTask(fml::UniqueClosure&& task, fml::TimeDelta delay);
+
+  template <typename Callable, typename = EnableIfCallable<Callable>>
+  void PostDelayedTask(Callable&& task, fml::TimeDelta delay) {
+    PostDelayedTask(fml::UniqueClosure(std::forward<Callable>(task)), delay);
+  }
+
+  /// Schedules \p task to run as soon as possible in the given \p priority
+  /// class. Ready tasks of more urgent classes run first. If the task has not
+  /// run by \p deadline, it competes as \p TaskPriority::kFrameCritical.
+  /// \note Task runners that aren't backed by a \p MessageLoopImpl, such as
+  /// the ones provided by embedders, ignore the priority and deadline.
+  virtual void PostTaskWithPriority(
+      const fml::closure& task,
+      fml::TaskPriority priority,
+      fml::TimePoint deadline = fml::TimePoint::Max());
+
+  void PostTaskWithPriority(fml::UniqueClosure&& task,
+                            fml::TaskPriority priority,
+                            fml::TimePoint deadline = fml::TimePoint::Max());
+
+  template <typename Callable, typename = EnableIfCallable<Callable>>
+  void PostTaskWithPriority(Callable&& task,
+                            fml::TaskPriority priority,
+                            fml::TimePoint deadline = fml::TimePoint::Max()) {
+    PostTaskWithPriority(fml::UniqueClosure(std::forward<Callable>(task)),
+                         priority, deadline);
+  }
+
   /// Returns \p true when the current executing thread's TaskRunner matches
   /// this instance.
   virtual bool RunsTasksOnCurrentThread();
@@ -62,6 +126,15 @@ class TaskRunner : public fml::RefCountedThreadSafe<TaskRunner>,
   static void RunNowOrPostTask(const fml::RefPtr<fml::TaskRunner>& runner,
                                const fml::closure& task);
 
+  static void RunNowOrPostTask(const fml::RefPtr<fml::TaskRunner>& runner,
+                               fml::UniqueClosure&& task);
+
+  template <typename Callable, typename = EnableIfCallable<Callable>>
+  static void RunNowOrPostTask(const fml::RefPtr<fml::TaskRunner>& runner,
+                               Callable&& task) {
+    RunNowOrPostTask(runner, fml::UniqueClosure(std::forward<Callable>(task)));
+  }
+
  protected:
   explicit TaskRunner(fml::RefPtr<MessageLoopImpl> loop);
 
@@ -0,0 +1,76 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/task_runner.h"
+
+#include <array>
+#include <cstdlib>
+#include <new>
+
+#include "flutter/benchmarking/benchmarking.h"
+#include "flutter/fml/message_loop.h"
+
+// This binary replaces the global allocator to count heap allocations, which
+// is why these benchmarks don't live in fml_benchmarks.
+namespace {
+// Heap allocations made by the current thread.
+thread_local size_t tls_allocation_count = 0;
+}  // namespace
+
+void* operator new(size_t size) {
+  tls_allocation_count++;
+  if (void* ptr = std::malloc(size == 0 ? 1 : size)) {
+    return ptr;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept {
+  std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept {
+  std::free(ptr);
+}
+
+namespace fml {
+namespace benchmarking {
+
+// Posts a task through the task runner of the current thread and runs it,
+// reporting the number of heap allocations per task. Captures that fit in the
+// inline storage of `fml::UniqueClosure` should cost none once the queue has
+// warmed up.
+template <size_t kCaptureSize>
+static void BM_PostAndRunTaskAllocations(benchmark::State& state) {  // NOLINT
+  fml::MessageLoop::EnsureInitializedForCurrentThread();
+  auto& loop = fml::MessageLoop::GetCurrent();
+  fml::RefPtr<fml::TaskRunner> task_runner = loop.GetTaskRunner();
+  std::array<char, kCaptureSize> capture = {};
+  size_t sink = 0;
+
+  auto post_and_run = [&]() {
+    task_runner->PostTask([capture, &sink]() { sink += capture[0]; });
+    loop.RunExpiredTasksNow();
+  };
+  // Warm up the node pool and the queue storage.
+  post_and_run();
+
+  const size_t allocations_before = tls_allocation_count;
+  for (auto _ : state) {
+    post_and_run();
+  }
+  const size_t allocations = tls_allocation_count - allocations_before;
+
+  benchmark::DoNotOptimize(sink);
+  state.counters["allocs_per_task"] = benchmark::Counter(
+      static_cast<double>(allocations) / state.iterations());
+  state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK_TEMPLATE(BM_PostAndRunTaskAllocations, 16);
+BENCHMARK_TEMPLATE(BM_PostAndRunTaskAllocations, 48);
+BENCHMARK_TEMPLATE(BM_PostAndRunTaskAllocations, 256);
+
+}  // namespace benchmarking
+}  // namespace fml
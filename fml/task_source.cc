@@ -16,42 +16,51 @@ TaskSource::~TaskSource() {
 }
 
 void TaskSource::ShutDown() {
-  primary_task_queue_ = {};
-  secondary_task_queue_ = {};
-}
-
-void TaskSource::RegisterTask(const DelayedTask& task) {
-  switch (task.GetTaskSourceGrade()) {
-    case TaskSourceGrade::kUserInteraction:
-      primary_task_queue_.push(task);
-      break;
-    case TaskSourceGrade::kUnspecified:
-      primary_task_queue_.push(task);
-      break;
-    case TaskSourceGrade::kDartEventLoop:
-      secondary_task_queue_.push(task);
-      break;
+  for (auto& queue : primary_task_queues_) {
+    queue = {};
+  }
+  for (auto& queue : secondary_task_queues_) {
+    queue = {};
   }
 }
 
-void TaskSource::PopTask(TaskSourceGrade grade) {
+fml::DelayedTaskQueue& TaskSource::GetTaskQueue(TaskSourceGrade grade,
+                                                TaskPriority priority,
+                                                bool has_deadline) {
+  const auto index =
+      2 * static_cast<size_t>(priority) + (has_deadline ? 1 : 0);
   switch (grade) {
     case TaskSourceGrade::kUserInteraction:
-      primary_task_queue_.pop();
-      break;
+      return primary_task_queues_[index];
     case TaskSourceGrade::kUnspecified:
-      primary_task_queue_.pop();
-      break;
+      return primary_task_queues_[index];
     case TaskSourceGrade::kDartEventLoop:
-      secondary_task_queue_.pop();
-      break;
+      return secondary_task_queues_[index];
   }
+  FML_UNREACHABLE();
+}
+
+void TaskSource::RegisterTask(DelayedTask task) {
+  auto& queue = GetTaskQueue(task.GetTaskSourceGrade(), task.GetPriority(),
+                             task.HasDeadline());
+  queue.push(std::move(task));
+}
+
+fml::UniqueClosure TaskSource::PopTask(TaskSourceGrade grade,
+                                       TaskPriority priority,
+                                       bool has_deadline) {
+  return GetTaskQueue(grade, priority, has_deadline).pop();
 }
 
 size_t TaskSource::GetNumPendingTasks() const {
-  size_t size = primary_task_queue_.size();
+  size_t size = 0;
+  for (const auto& queue : primary_task_queues_) {
+    size += queue.size();
+  }
   if (secondary_pause_requests_ == 0) {
-    size += secondary_task_queue_.size();
+    for (const auto& queue : secondary_task_queues_) {
+      size += queue.size();
+    }
   }
   return size;
 }
@@ -61,34 +70,33 @@ bool TaskSource::IsEmpty() const {
 }
 
 TaskSource::TopTask TaskSource::Top() const {
+  // Nothing is ready at the beginning of time, so this picks the earliest
+  // scheduled task.
+  return Top(fml::TimePoint::Min());
+}
+
+TaskSource::TopTask TaskSource::Top(fml::TimePoint now) const {
   FML_CHECK(!IsEmpty());
-  if (secondary_pause_requests_ > 0 || secondary_task_queue_.empty()) {
-    const auto& primary_top = primary_task_queue_.top();
-    return {
-        .task_queue_id = task_queue_id_,
-        .task = primary_top,
-    };
-  } else if (primary_task_queue_.empty()) {
-    const auto& secondary_top = secondary_task_queue_.top();
-    return {
-        .task_queue_id = task_queue_id_,
-        .task = secondary_top,
-    };
-  } else {
-    const auto& primary_top = primary_task_queue_.top();
-    const auto& secondary_top = secondary_task_queue_.top();
-    if (primary_top > secondary_top) {
-      return {
-          .task_queue_id = task_queue_id_,
-          .task = secondary_top,
-      };
-    } else {
-      return {
-          .task_queue_id = task_queue_id_,
-          .task = primary_top,
-      };
+  const DelayedTask* top = nullptr;
+  auto update_top = [&top, now](const fml::DelayedTaskQueue& queue) {
+    if (!queue.empty() && (!top || queue.top().RunsBefore(*top, now))) {
+      top = &queue.top();
+    }
+  };
+  for (const auto& queue : primary_task_queues_) {
+    update_top(queue);
+  }
+  if (secondary_pause_requests_ == 0) {
+    for (const auto& queue : secondary_task_queues_) {
+      update_top(queue);
     }
   }
+  // Covered by the IsEmpty check above.
+  FML_DCHECK(top);
+  return {
+      .task_queue_id = task_queue_id_,
+      .task = *top,
+  };
 }
 
 void TaskSource::PauseSecondary() {
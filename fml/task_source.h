@@ -6,8 +6,10 @@
 #define FLUTTER_FML_TASK_SOURCE_H_
 
 #include "flutter/fml/delayed_task.h"
+#include "flutter/fml/task_priority.h"
 #include "flutter/fml/task_queue_id.h"
 #include "flutter/fml/task_source_grade.h"
+#include "flutter/fml/time/time_point.h"
 
 namespace fml {
 
@@ -31,6 +33,16 @@ class MessageLoopTaskQueues;
  * Task dispatcher provides the event loop a way to acquire tasks to run via
  * `GetNextTaskToRun`. Task dispatcher asks the underlying `TaskSource` for the
  * next task.
+ *
+ * Priorities
+ * ----------
+ * Each task heap is further split by `TaskPriority`, and by whether the tasks
+ * have a deadline. Among the tasks that are ready to run, the one with the
+ * most urgent effective priority is picked, see `DelayedTask::RunsBefore`.
+ * Tasks with a deadline are kept apart so that a task that is escalated past
+ * its deadline isn't hidden behind the tasks of its class that were posted
+ * before it. Their heaps are ordered by escalation time, see
+ * `DelayedTaskQueue`, and are meant for tasks that are posted to run now.
  */
 class TaskSource {
  public:
@@ -49,10 +61,14 @@ class TaskSource {
 
   /// Adds a task to the corresponding task heap as dictated by the
   /// `TaskSourceGrade` of the `DelayedTask`.
-  void RegisterTask(const DelayedTask& task);
+  void RegisterTask(DelayedTask task);
 
-  /// Pops the task heap corresponding to the `TaskSourceGrade`.
-  void PopTask(TaskSourceGrade grade);
+  /// Pops the task heap corresponding to the `TaskSourceGrade`,
+  /// `TaskPriority` and whether the task has a deadline, and returns the
+  /// closure of the popped task.
+  fml::UniqueClosure PopTask(TaskSourceGrade grade,
+                             TaskPriority priority = TaskPriority::kNormal,
+                             bool has_deadline = false);
 
   /// Returns the number of pending tasks. Excludes the tasks from the secondary
   /// heap if it's paused.
@@ -65,6 +81,10 @@ class TaskSource {
   /// the secondary heap has been paused or not.
   TopTask Top() const;
 
+  /// Returns the task that should run at `now`. This is the most urgent task
+  /// that is ready to run, or the earliest scheduled task if none is ready.
+  TopTask Top(fml::TimePoint now) const;
+
   /// Pause providing tasks from secondary task heap.
   void PauseSecondary();
 
@@ -73,10 +93,16 @@ class TaskSource {
 
  private:
   const fml::TaskQueueId task_queue_id_;
-  fml::DelayedTaskQueue primary_task_queue_;
-  fml::DelayedTaskQueue secondary_task_queue_;
+  // Indexed by priority, with the tasks that have a deadline after the tasks
+  // of the same priority that don't.
+  fml::DelayedTaskQueue primary_task_queues_[2 * kTaskPriorityCount];
+  fml::DelayedTaskQueue secondary_task_queues_[2 * kTaskPriorityCount];
   int secondary_pause_requests_ = 0;
 
+  fml::DelayedTaskQueue& GetTaskQueue(TaskSourceGrade grade,
+                                      TaskPriority priority,
+                                      bool has_deadline);
+
   FML_DISALLOW_COPY_ASSIGN_AND_MOVE(TaskSource);
 };
 
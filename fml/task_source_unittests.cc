@@ -3,7 +3,9 @@
 // found in the LICENSE file.
 
 #include <atomic>
+#include <memory>
 #include <thread>
+#include <vector>
 
 #include "flutter/fml/macros.h"
 #include "flutter/fml/task_source.h"
@@ -97,5 +99,153 @@ TEST(TaskSourceTests, OrderingMultiTaskHeapsSecondaryPaused) {
   ASSERT_EQ(value, 1);
 }
 
+TEST(TaskSourceTests, ReadyTasksRunInPriorityOrder) {
+  TaskSource task_source = TaskSource(TaskQueueId(1));
+  auto time_stamp = ChronoTicksSinceEpoch();
+  task_source.RegisterTask({1, [] {}, time_stamp,
+                            TaskSourceGrade::kUnspecified, TaskPriority::kLow});
+  task_source.RegisterTask({2, [] {}, time_stamp,
+                            TaskSourceGrade::kUnspecified,
+                            TaskPriority::kNormal});
+  task_source.RegisterTask({3, [] {}, time_stamp,
+                            TaskSourceGrade::kDartEventLoop,
+                            TaskPriority::kFrameCritical});
+
+  // Without a current time, the earliest scheduled task is on top.
+  ASSERT_EQ(task_source.Top().task.GetPriority(), TaskPriority::kLow);
+
+  std::vector<TaskPriority> priorities;
+  while (!task_source.IsEmpty()) {
+    auto top = task_source.Top(time_stamp);
+    priorities.push_back(top.task.GetPriority());
+    task_source.PopTask(top.task.GetTaskSourceGrade(), top.task.GetPriority());
+  }
+  ASSERT_EQ(priorities,
+            std::vector<TaskPriority>({TaskPriority::kFrameCritical,
+                                       TaskPriority::kNormal,
+                                       TaskPriority::kLow}));
+}
+
+TEST(TaskSourceTests, FutureTasksDoNotPreemptReadyTasks) {
+  TaskSource task_source = TaskSource(TaskQueueId(1));
+  auto time_stamp = ChronoTicksSinceEpoch();
+  task_source.RegisterTask({1, [] {}, time_stamp,
+                            TaskSourceGrade::kUnspecified, TaskPriority::kLow});
+  task_source.RegisterTask({2, [] {},
+                            time_stamp + fml::TimeDelta::FromMilliseconds(1),
+                            TaskSourceGrade::kUnspecified,
+                            TaskPriority::kFrameCritical});
+  ASSERT_EQ(task_source.Top(time_stamp).task.GetPriority(),
+            TaskPriority::kLow);
+}
+
+TEST(TaskSourceTests, StarvedTasksAreEscalated) {
+  TaskSource task_source = TaskSource(TaskQueueId(1));
+  auto time_stamp = ChronoTicksSinceEpoch();
+  task_source.RegisterTask({1, [] {}, time_stamp,
+                            TaskSourceGrade::kUnspecified, TaskPriority::kLow});
+  auto later = time_stamp + DelayedTask::kStarvationThreshold;
+  task_source.RegisterTask({2, [] {}, later, TaskSourceGrade::kUnspecified,
+                            TaskPriority::kHigh});
+  // The low priority task has waited long enough to be treated as
+  // frame-critical and was ready first.
+  ASSERT_EQ(task_source.Top(later).task.GetPriority(), TaskPriority::kLow);
+}
+
+TEST(TaskSourceTests, TasksPastDeadlineAreEscalated) {
+  TaskSource task_source = TaskSource(TaskQueueId(1));
+  auto time_stamp = ChronoTicksSinceEpoch();
+  auto now = time_stamp + fml::TimeDelta::FromMilliseconds(2);
+  task_source.RegisterTask({1, [] {}, time_stamp,
+                            TaskSourceGrade::kUnspecified,
+                            TaskPriority::kHigh});
+  task_source.RegisterTask({2, [] {}, time_stamp,
+                            TaskSourceGrade::kUnspecified, TaskPriority::kLow,
+                            time_stamp + fml::TimeDelta::FromMilliseconds(1)});
+  ASSERT_EQ(task_source.Top(now).task.GetPriority(), TaskPriority::kLow);
+}
+
+TEST(TaskSourceTests, TasksWithDeadlineKeepPostingOrderUntilDeadline) {
+  TaskSource task_source = TaskSource(TaskQueueId(1));
+  auto time_stamp = ChronoTicksSinceEpoch();
+  auto deadline = time_stamp + fml::TimeDelta::FromMilliseconds(8);
+  task_source.RegisterTask({1, [] {}, time_stamp,
+                            TaskSourceGrade::kUnspecified,
+                            TaskPriority::kNormal});
+  task_source.RegisterTask({2, [] {}, time_stamp,
+                            TaskSourceGrade::kUnspecified,
+                            TaskPriority::kNormal, deadline});
+  // The task that was posted first runs first while the deadline of the
+  // other one is not at risk.
+  ASSERT_EQ(task_source.Top(deadline - fml::TimeDelta::FromMilliseconds(1))
+                .task.GetDeadline(),
+            fml::TimePoint::Max());
+  ASSERT_EQ(task_source.Top(deadline).task.GetDeadline(), deadline);
+}
+
+TEST(TaskSourceTests, LaterTaskPastDeadlineIsNotHidden) {
+  TaskSource task_source = TaskSource(TaskQueueId(1));
+  auto time_stamp = ChronoTicksSinceEpoch();
+  auto later = time_stamp + fml::TimeDelta::FromMilliseconds(1);
+  auto deadline = later + fml::TimeDelta::FromMilliseconds(1);
+  auto now = deadline + fml::TimeDelta::FromMilliseconds(1);
+  task_source.RegisterTask({1, [] {}, time_stamp,
+                            TaskSourceGrade::kUnspecified,
+                            TaskPriority::kNormal});
+  task_source.RegisterTask({2, [] {}, later, TaskSourceGrade::kUnspecified,
+                            TaskPriority::kNormal, deadline});
+  ASSERT_EQ(task_source.Top(now).task.GetDeadline(), deadline);
+}
+
+TEST(TaskSourceTests, LaterTaskPastDeadlineIsNotHiddenByEarlierDeadline) {
+  TaskSource task_source = TaskSource(TaskQueueId(1));
+  auto time_stamp = ChronoTicksSinceEpoch();
+  auto later = time_stamp + fml::TimeDelta::FromMilliseconds(1);
+  auto deadline = later + fml::TimeDelta::FromMilliseconds(1);
+  auto now = deadline + fml::TimeDelta::FromMilliseconds(1);
+  // Only the task that was posted later is past its deadline at |now|.
+  task_source.RegisterTask({1, [] {}, time_stamp,
+                            TaskSourceGrade::kUnspecified,
+                            TaskPriority::kNormal,
+                            time_stamp + fml::TimeDelta::FromSeconds(1)});
+  task_source.RegisterTask({2, [] {}, later, TaskSourceGrade::kUnspecified,
+                            TaskPriority::kNormal, deadline});
+
+  auto top = task_source.Top(now);
+  ASSERT_EQ(top.task.GetDeadline(), deadline);
+  ASSERT_EQ(top.task.GetEffectivePriority(now), TaskPriority::kFrameCritical);
+  task_source.PopTask(TaskSourceGrade::kUnspecified, TaskPriority::kNormal,
+                      true);
+  ASSERT_EQ(task_source.Top(now).task.GetDeadline(),
+            time_stamp + fml::TimeDelta::FromSeconds(1));
+}
+
+TEST(TaskSourceTests, PoppedTasksReleaseTheirCaptures) {
+  TaskSource task_source = TaskSource(TaskQueueId(1));
+  auto time_stamp = ChronoTicksSinceEpoch();
+  auto captured = std::make_shared<int>(0);
+  std::weak_ptr<int> weak = captured;
+  task_source.RegisterTask({1, [captured = std::move(captured)] {}, time_stamp,
+                            TaskSourceGrade::kUnspecified});
+  {
+    auto task = task_source.PopTask(TaskSourceGrade::kUnspecified);
+    ASSERT_FALSE(weak.expired());
+  }
+  // The node that held the task is pooled for reuse but must not keep the
+  // captures alive.
+  ASSERT_TRUE(weak.expired());
+
+  int value = 0;
+  task_source.RegisterTask({2, [&value] { value = 2; }, time_stamp,
+                            TaskSourceGrade::kUnspecified});
+  task_source.RegisterTask({3, [&value] { value = 3; }, time_stamp,
+                            TaskSourceGrade::kUnspecified});
+  task_source.PopTask(TaskSourceGrade::kUnspecified)();
+  ASSERT_EQ(value, 2);
+  task_source.PopTask(TaskSourceGrade::kUnspecified)();
+  ASSERT_EQ(value, 3);
+  ASSERT_TRUE(task_source.IsEmpty());
+}
+
 }  // namespace testing
 }  // namespace fml
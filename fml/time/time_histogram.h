@@ -0,0 +1,86 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FML_TIME_TIME_HISTOGRAM_H_
+#define FLUTTER_FML_TIME_TIME_HISTOGRAM_H_
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "flutter/fml/time/time_delta.h"
+
+namespace fml {
+
+/// A histogram of durations with power-of-two microsecond buckets. Bucket `i`
+/// holds samples shorter than `2^i` microseconds, the last bucket holds
+/// everything longer.
+///
+/// Not thread safe. Callers provide their own synchronization.
+class TimeHistogram {
+ public:
+  static constexpr size_t kBucketCount = 24;
+
+  void Record(TimeDelta sample) {
+    const int64_t micros = sample.ToMicroseconds();
+    size_t bucket = 0;
+    while (bucket + 1 < kBucketCount && micros >= (int64_t{1} << bucket)) {
+      bucket++;
+    }
+    buckets_[bucket]++;
+    count_++;
+    total_ = total_ + sample;
+    if (sample > max_) {
+      max_ = sample;
+    }
+  }
+
+  size_t GetCount() const { return count_; }
+
+  size_t GetBucketCount(size_t bucket) const { return buckets_[bucket]; }
+
+  /// The exclusive upper bound of the given bucket.
+  static TimeDelta GetBucketUpperBound(size_t bucket) {
+    if (bucket + 1 >= kBucketCount) {
+      return TimeDelta::Max();
+    }
+    return TimeDelta::FromMicroseconds(int64_t{1} << bucket);
+  }
+
+  TimeDelta GetMax() const { return max_; }
+
+  TimeDelta GetMean() const {
+    if (count_ == 0) {
+      return TimeDelta::Zero();
+    }
+    return TimeDelta::FromNanoseconds(total_.ToNanoseconds() / count_);
+  }
+
+  /// An upper bound for the given percentile in [0, 1], at the resolution of
+  /// the buckets and clamped to the longest recorded sample.
+  TimeDelta GetPercentile(double percentile) const {
+    const double target = percentile * count_;
+    size_t seen = 0;
+    for (size_t i = 0; i < kBucketCount; i++) {
+      seen += buckets_[i];
+      if (seen > 0 && seen >= target) {
+        const TimeDelta bound = GetBucketUpperBound(i);
+        return bound < max_ ? bound : max_;
+      }
+    }
+    return max_;
+  }
+
+  void Reset() { *this = TimeHistogram(); }
+
+ private:
+  std::array<size_t, kBucketCount> buckets_ = {};
+  size_t count_ = 0;
+  TimeDelta total_;
+  TimeDelta max_;
+};
+
+}  // namespace fml
+
+#endif  // FLUTTER_FML_TIME_TIME_HISTOGRAM_H_
@@ -0,0 +1,50 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/time/time_histogram.h"
+
+#include "gtest/gtest.h"
+
+namespace fml {
+namespace {
+
+TEST(TimeHistogram, StartsEmpty) {
+  TimeHistogram histogram;
+  EXPECT_EQ(histogram.GetCount(), 0u);
+  EXPECT_EQ(histogram.GetMean(), TimeDelta::Zero());
+  EXPECT_EQ(histogram.GetMax(), TimeDelta::Zero());
+}
+
+TEST(TimeHistogram, RecordsIntoPowerOfTwoBuckets) {
+  TimeHistogram histogram;
+  histogram.Record(TimeDelta::FromNanoseconds(500));
+  histogram.Record(TimeDelta::FromMicroseconds(3));
+  histogram.Record(TimeDelta::FromMicroseconds(1000));
+  EXPECT_EQ(histogram.GetCount(), 3u);
+  EXPECT_EQ(histogram.GetBucketCount(0), 1u);
+  EXPECT_EQ(histogram.GetBucketCount(2), 1u);
+  EXPECT_EQ(histogram.GetBucketCount(10), 1u);
+  EXPECT_EQ(histogram.GetMax(), TimeDelta::FromMicroseconds(1000));
+}
+
+TEST(TimeHistogram, PercentileIsClampedToMax) {
+  TimeHistogram histogram;
+  for (int i = 0; i < 99; i++) {
+    histogram.Record(TimeDelta::FromMicroseconds(10));
+  }
+  histogram.Record(TimeDelta::FromMicroseconds(1500));
+  EXPECT_EQ(histogram.GetPercentile(0.5), TimeDelta::FromMicroseconds(16));
+  EXPECT_EQ(histogram.GetPercentile(1.0), TimeDelta::FromMicroseconds(1500));
+}
+
+TEST(TimeHistogram, OverflowBucketHasNoUpperBound) {
+  TimeHistogram histogram;
+  histogram.Record(TimeDelta::FromSeconds(3600));
+  EXPECT_EQ(histogram.GetBucketCount(TimeHistogram::kBucketCount - 1), 1u);
+  EXPECT_EQ(TimeHistogram::GetBucketUpperBound(TimeHistogram::kBucketCount - 1),
+            TimeDelta::Max());
+}
+
+}  // namespace
+}  // namespace fml
@@ -0,0 +1,114 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/time/timer_coalescer.h"
+
+#include <algorithm>
+#include <atomic>
+
+#include "flutter/fml/trace_event.h"
+
+namespace fml {
+
+static std::atomic<int64_t> gTimerSlackNanos = 0;
+
+void TimerCoalescer::SetSlack(fml::TimeDelta slack) {
+  gTimerSlackNanos.store(std::max<int64_t>(slack.ToNanoseconds(), 0),
+                         std::memory_order_relaxed);
+}
+
+fml::TimeDelta TimerCoalescer::GetSlack() {
+  return fml::TimeDelta::FromNanoseconds(
+      gTimerSlackNanos.load(std::memory_order_relaxed));
+}
+
+TimerCoalescer::TimerCoalescer() = default;
+
+TimerCoalescer::~TimerCoalescer() = default;
+
+std::optional<fml::TimePoint> TimerCoalescer::RequestWakeUp(
+    fml::TimePoint time_point,
+    fml::TimePoint now) {
+  std::scoped_lock lock(mutex_);
+  stats_.wake_requests++;
+  const bool is_new_time = last_requested_time_ != time_point;
+  last_requested_time_ = time_point;
+
+  auto skip = [&]() -> std::optional<fml::TimePoint> {
+    stats_.skipped_rearms++;
+    if (is_new_time) {
+      stats_.coalesced_requests++;
+    }
+    return std::nullopt;
+  };
+
+  fml::TimePoint target = time_point;
+  if (time_point <= now) {
+    // A timer armed for the past has fired or is about to, and the loop will
+    // run every expired task once it wakes up.
+    if (armed_time_.has_value() && *armed_time_ <= now) {
+      return skip();
+    }
+  } else if (time_point != fml::TimePoint::Max()) {
+    const fml::TimeDelta slack = GetSlack();
+    if (slack > fml::TimeDelta::Zero()) {
+      if (armed_time_.has_value() && *armed_time_ >= time_point &&
+          *armed_time_ - time_point <= slack) {
+        return skip();
+      }
+      // Round up to the slack so that nearby deadlines share a wakeup.
+      const int64_t slack_nanos = slack.ToNanoseconds();
+      const int64_t nanos = time_point.ToEpochDelta().ToNanoseconds();
+      const int64_t aligned =
+          ((nanos + slack_nanos - 1) / slack_nanos) * slack_nanos;
+      target = fml::TimePoint::FromEpochDelta(
+          fml::TimeDelta::FromNanoseconds(aligned));
+    }
+  }
+
+  if (armed_time_ == target) {
+    return skip();
+  }
+  armed_time_ = target;
+  return target;
+}
+
+void TimerCoalescer::OnTimerFired(fml::TimePoint now) {
+  std::scoped_lock lock(mutex_);
+  armed_time_ = std::nullopt;
+  stats_.timer_fires++;
+  ReportToTimeline(now);
+}
+
+TimerCoalescer::Stats TimerCoalescer::GetStats() const {
+  std::scoped_lock lock(mutex_);
+  return stats_;
+}
+
+void TimerCoalescer::ReportToTimeline(fml::TimePoint now) {
+#if !FLUTTER_RELEASE
+  const fml::TimeDelta elapsed = now - reported_time_;
+  if (elapsed < fml::TimeDelta::FromSeconds(1)) {
+    return;
+  }
+  const double seconds = elapsed.ToSecondsF();
+  auto per_second = [seconds](uint64_t current, uint64_t reported) {
+    return static_cast<int64_t>((current - reported) / seconds);
+  };
+  FML_TRACE_COUNTER(
+      "flutter",                                                      //
+      "TimerCoalescer", reinterpret_cast<int64_t>(this),              //
+      "WakeupsPerSecond",                                             //
+      per_second(stats_.timer_fires, reported_stats_.timer_fires),    //
+      "SkippedRearmsPerSecond",                                       //
+      per_second(stats_.skipped_rearms, reported_stats_.skipped_rearms),
+      "CoalescedRequestsPerSecond",
+      per_second(stats_.coalesced_requests,
+                 reported_stats_.coalesced_requests));
+  reported_stats_ = stats_;
+  reported_time_ = now;
+#endif  // !FLUTTER_RELEASE
+}
+
+}  // namespace fml
@@ -0,0 +1,92 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_FML_TIME_TIMER_COALESCER_H_
+#define FLUTTER_FML_TIME_TIMER_COALESCER_H_
+
+#include <cstdint>
+#include <mutex>
+#include <optional>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/time/time_delta.h"
+#include "flutter/fml/time/time_point.h"
+
+namespace fml {
+
+//------------------------------------------------------------------------------
+/// @brief      Decides when a message loop's wakeup timer needs to be re-armed.
+///
+///             Message loops are asked to wake up at the earliest pending
+///             task's target time every time a task is posted or run. Most of
+///             these requests ask for a time the timer is already armed for,
+///             or for a time that is about to be served anyway. A loop asks
+///             the coalescer before re-arming its timer and skips the system
+///             call when it isn't needed.
+///
+///             With a non-zero slack (see `SetSlack`), future wake times are
+///             rounded up to a multiple of the slack so that nearby deadlines
+///             share one wakeup. Tasks may then run up to the slack later than
+///             their target time. Immediate wakeups are never delayed.
+///
+///             All methods are thread safe.
+///
+class TimerCoalescer {
+ public:
+  struct Stats {
+    /// The number of times the loop was asked to wake up.
+    uint64_t wake_requests = 0;
+
+    /// The number of requests for which the timer was not re-armed.
+    uint64_t skipped_rearms = 0;
+
+    /// The number of requests for a new time that were served by an already
+    /// armed wakeup. Without coalescing, each would have moved the timer.
+    uint64_t coalesced_requests = 0;
+
+    /// The number of times the timer fired.
+    uint64_t timer_fires = 0;
+  };
+
+  /// Sets how much later than requested a future wakeup may happen, for all
+  /// loops. A slack of zero, the default, disables coalescing of distinct
+  /// wake times.
+  static void SetSlack(fml::TimeDelta slack);
+
+  static fml::TimeDelta GetSlack();
+
+  TimerCoalescer();
+
+  ~TimerCoalescer();
+
+  /// Returns the time the timer must be armed for so that the loop wakes up
+  /// at or shortly after |time_point|, or `std::nullopt` if the currently
+  /// armed timer already does. The caller must arm the timer for the returned
+  /// time.
+  std::optional<fml::TimePoint> RequestWakeUp(fml::TimePoint time_point,
+                                              fml::TimePoint now);
+
+  /// Must be called when the timer fires, before running the expired tasks.
+  void OnTimerFired(fml::TimePoint now);
+
+  Stats GetStats() const;
+
+ private:
+  mutable std::mutex mutex_;
+  // The time the timer is armed for, or std::nullopt if it fired since.
+  std::optional<fml::TimePoint> armed_time_;
+  std::optional<fml::TimePoint> last_requested_time_;
+  Stats stats_;
+  // The stats when the rates were last reported to the timeline.
+  Stats reported_stats_;
+  fml::TimePoint reported_time_;
+
+  void ReportToTimeline(fml::TimePoint now);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(TimerCoalescer);
+};
+
+}  // namespace fml
+
+#endif  // FLUTTER_FML_TIME_TIMER_COALESCER_H_
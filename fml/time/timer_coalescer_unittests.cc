@@ -0,0 +1,96 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/fml/time/timer_coalescer.h"
+
+#include "gtest/gtest.h"
+
+namespace fml {
+namespace {
+
+TimePoint FromMillis(int64_t millis) {
+  return TimePoint::FromEpochDelta(TimeDelta::FromMilliseconds(millis));
+}
+
+class ScopedTimerSlack {
+ public:
+  explicit ScopedTimerSlack(TimeDelta slack)
+      : previous_(TimerCoalescer::GetSlack()) {
+    TimerCoalescer::SetSlack(slack);
+  }
+
+  ~ScopedTimerSlack() { TimerCoalescer::SetSlack(previous_); }
+
+ private:
+  TimeDelta previous_;
+};
+
+TEST(TimerCoalescer, SkipsRearmingForTheArmedTime) {
+  TimerCoalescer coalescer;
+  const auto now = FromMillis(100);
+  EXPECT_EQ(coalescer.RequestWakeUp(FromMillis(120), now), FromMillis(120));
+  EXPECT_EQ(coalescer.RequestWakeUp(FromMillis(120), now), std::nullopt);
+  EXPECT_EQ(coalescer.RequestWakeUp(FromMillis(110), now), FromMillis(110));
+
+  auto stats = coalescer.GetStats();
+  EXPECT_EQ(stats.wake_requests, 3u);
+  EXPECT_EQ(stats.skipped_rearms, 1u);
+  EXPECT_EQ(stats.coalesced_requests, 0u);
+}
+
+TEST(TimerCoalescer, SkipsRearmingWhileAnExpiredTimerIsPending) {
+  TimerCoalescer coalescer;
+  EXPECT_EQ(coalescer.RequestWakeUp(FromMillis(100), FromMillis(100)),
+            FromMillis(100));
+  EXPECT_EQ(coalescer.RequestWakeUp(FromMillis(101), FromMillis(101)),
+            std::nullopt);
+  EXPECT_EQ(coalescer.RequestWakeUp(FromMillis(102), FromMillis(102)),
+            std::nullopt);
+
+  coalescer.OnTimerFired(FromMillis(102));
+  EXPECT_EQ(coalescer.RequestWakeUp(FromMillis(103), FromMillis(103)),
+            FromMillis(103));
+  EXPECT_EQ(coalescer.GetStats().timer_fires, 1u);
+}
+
+TEST(TimerCoalescer, RearmsForTheSameTimeAfterFiring) {
+  TimerCoalescer coalescer;
+  const auto now = FromMillis(100);
+  EXPECT_EQ(coalescer.RequestWakeUp(FromMillis(120), now), FromMillis(120));
+  coalescer.OnTimerFired(FromMillis(120));
+  EXPECT_EQ(coalescer.RequestWakeUp(FromMillis(120), now), FromMillis(120));
+}
+
+TEST(TimerCoalescer, DoesNotDelayWakeupsWithoutSlack) {
+  TimerCoalescer coalescer;
+  const auto now = FromMillis(100);
+  EXPECT_EQ(coalescer.RequestWakeUp(FromMillis(121), now), FromMillis(121));
+  EXPECT_EQ(coalescer.RequestWakeUp(FromMillis(123), now), FromMillis(123));
+}
+
+TEST(TimerCoalescer, BatchesNearbyDeadlinesWithSlack) {
+  ScopedTimerSlack slack(TimeDelta::FromMilliseconds(8));
+  TimerCoalescer coalescer;
+  const auto now = FromMillis(100);
+  EXPECT_EQ(coalescer.RequestWakeUp(FromMillis(121), now), FromMillis(128));
+  EXPECT_EQ(coalescer.RequestWakeUp(FromMillis(123), now), std::nullopt);
+  EXPECT_EQ(coalescer.RequestWakeUp(FromMillis(127), now), std::nullopt);
+  // Too early to be served by the armed wakeup.
+  EXPECT_EQ(coalescer.RequestWakeUp(FromMillis(119), now), FromMillis(120));
+
+  auto stats = coalescer.GetStats();
+  EXPECT_EQ(stats.skipped_rearms, 2u);
+  EXPECT_EQ(stats.coalesced_requests, 2u);
+}
+
+TEST(TimerCoalescer, NeverDelaysImmediateWakeups) {
+  ScopedTimerSlack slack(TimeDelta::FromMilliseconds(8));
+  TimerCoalescer coalescer;
+  const auto now = FromMillis(101);
+  EXPECT_EQ(coalescer.RequestWakeUp(FromMillis(130), now), FromMillis(136));
+  EXPECT_EQ(coalescer.RequestWakeUp(now, now), now);
+}
+
+}  // namespace
+}  // namespace fml
@@ -4,7 +4,12 @@
 
 #include "flutter/benchmarking/benchmarking.h"
 
+#include "flutter/fml/concurrent_message_loop.h"
 #include "impeller/aiks/canvas.h"
+#include "impeller/entity/contents/color_source_contents.h"
+#include "impeller/entity/tessellation_prepass.h"
+#include "impeller/geometry/path_builder.h"
+#include "impeller/tessellator/tessellator.h"
 
 namespace impeller {
 
@@ -33,6 +38,30 @@ size_t DrawLine(Canvas& canvas) {
   }
   return 500;
 }
+
+// Draws a map like grid of outlined regions with curved borders.
+size_t DrawComplexPaths(Canvas& canvas) {
+  for (auto i = 0; i < 500; i++) {
+    Scalar x = (i % 25) * 40;
+    Scalar y = (i / 25) * 40;
+    PathBuilder builder;
+    builder.MoveTo({x, y});
+    for (auto j = 0; j < 8; j++) {
+      Scalar offset = (i + j) % 5;
+      builder.CubicCurveTo({x + 10 + offset, y - 5}, {x + 25, y + 5 + offset},
+                           {x + 30, y + j * 4});
+      builder.QuadraticCurveTo({x + 15, y + 40 - offset}, {x, y + j * 4});
+    }
+    builder.Close();
+    auto path = builder.TakePath();
+    canvas.DrawPath(path, {.color = Color::DarkKhaki()});
+    canvas.DrawPath(path, {.color = Color::Black(),
+                           .stroke_width = 2,
+                           .stroke_join = Join::kRound,
+                           .style = Paint::Style::kStroke});
+  }
+  return 1000;
+}
 }  // namespace
 
 // A set of benchmarks that measures the CPU cost of encoding canvas operations.
@@ -56,8 +85,62 @@ static void BM_CanvasRecord(benchmark::State& state, Args&&... args) {
   state.counters["TotalCanvasCount"] = canvas_count;
 }
 
+// Measures the tessellation of the paths in a recorded canvas, which is done
+// for each path as it is rendered or, with the tessellation prepass, spread
+// over worker threads before the pass is rendered.
+template <class... Args>
+static void BM_CanvasTessellate(benchmark::State& state, Args&&... args) {
+  auto args_tuple = std::make_tuple(std::move(args)...);
+  auto test_proc = std::get<CanvasCallback>(args_tuple);
+  bool use_prepass = std::get<bool>(args_tuple);
+
+  Canvas canvas;
+  size_t op_count = test_proc(canvas);
+  Picture picture = canvas.EndRecordingAsPicture();
+
+  auto loop = fml::ConcurrentMessageLoop::Create();
+  TessellationPrepass prepass;
+  prepass.SetWorkerTaskRunner(loop->GetTaskRunner());
+  Tessellator tessellator;
+
+  while (state.KeepRunning()) {
+    picture.pass->IterateAllEntities(
+        [&prepass, &tessellator, use_prepass](const Entity& entity) {
+          const auto& contents = entity.GetContents();
+          if (use_prepass) {
+            contents->PopulateTessellationPrepass(prepass,
+                                                  entity.GetTransform());
+          } else if (auto color_source_contents =
+                         std::dynamic_pointer_cast<ColorSourceContents>(
+                             contents)) {
+            color_source_contents->GetGeometry()->PrepareTessellation(
+                tessellator, entity.GetTransform());
+          }
+          return true;
+        });
+    if (use_prepass) {
+      prepass.Run(tessellator);
+    }
+  }
+  state.counters["OpCount"] = op_count;
+  state.counters["WorkerCount"] = loop->GetWorkerCount();
+}
+
 BENCHMARK_CAPTURE(BM_CanvasRecord, draw_rect, &DrawRect);
 BENCHMARK_CAPTURE(BM_CanvasRecord, draw_circle, &DrawCircle);
 BENCHMARK_CAPTURE(BM_CanvasRecord, draw_line, &DrawLine);
 
+BENCHMARK_CAPTURE(BM_CanvasTessellate,
+                  complex_paths,
+                  &DrawComplexPaths,
+                  false)
+    ->UseRealTime()
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_CanvasTessellate,
+                  complex_paths_prepass,
+                  &DrawComplexPaths,
+                  true)
+    ->UseRealTime()
+    ->Unit(benchmark::kMicrosecond);
+
 }  // namespace impeller
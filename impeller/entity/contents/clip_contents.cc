@@ -10,6 +10,7 @@
 #include "impeller/entity/contents/clip_contents.h"
 #include "impeller/entity/contents/content_context.h"
 #include "impeller/entity/entity.h"
+#include "impeller/entity/tessellation_prepass.h"
 #include "impeller/renderer/render_pass.h"
 #include "impeller/renderer/vertex_buffer_builder.h"
 
@@ -43,6 +44,11 @@ std::optional<Rect> ClipContents::GetCoverage(const Entity& entity) const {
   return std::nullopt;
 };
 
+void ClipContents::PopulateTessellationPrepass(TessellationPrepass& prepass,
+                                               const Matrix& transform) const {
+  prepass.AddGeometry(geometry_, transform);
+}
+
 Contents::ClipCoverage ClipContents::GetClipCoverage(
     const Entity& entity,
     const std::optional<Rect>& current_clip_coverage) const {
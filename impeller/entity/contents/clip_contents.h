@@ -29,6 +29,10 @@ class ClipContents final : public Contents {
   // |Contents|
   std::optional<Rect> GetCoverage(const Entity& entity) const override;
 
+  // |Contents|
+  void PopulateTessellationPrepass(TessellationPrepass& prepass,
+                                   const Matrix& transform) const override;
+
   // |Contents|
   ClipCoverage GetClipCoverage(
       const Entity& entity,
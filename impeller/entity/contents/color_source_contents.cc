@@ -5,6 +5,7 @@
 #include "impeller/entity/contents/color_source_contents.h"
 
 #include "impeller/entity/entity.h"
+#include "impeller/entity/tessellation_prepass.h"
 #include "impeller/geometry/matrix.h"
 
 namespace impeller {
@@ -46,6 +47,12 @@ std::optional<Rect> ColorSourceContents::GetCoverage(
   return geometry_->GetCoverage(entity.GetTransform());
 };
 
+void ColorSourceContents::PopulateTessellationPrepass(
+    TessellationPrepass& prepass,
+    const Matrix& transform) const {
+  prepass.AddGeometry(geometry_, transform);
+}
+
 bool ColorSourceContents::CanInheritOpacity(const Entity& entity) const {
   return true;
 }
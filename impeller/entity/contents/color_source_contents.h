@@ -98,6 +98,10 @@ class ColorSourceContents : public Contents {
   // |Contents|
   std::optional<Rect> GetCoverage(const Entity& entity) const override;
 
+  // |Contents|
+  void PopulateTessellationPrepass(TessellationPrepass& prepass,
+                                   const Matrix& transform) const override;
+
   // |Contents|
   bool CanInheritOpacity(const Entity& entity) const override;
 
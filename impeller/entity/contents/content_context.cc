@@ -14,6 +14,7 @@
 #include "impeller/entity/contents/framebuffer_blend_contents.h"
 #include "impeller/entity/entity.h"
 #include "impeller/entity/render_target_cache.h"
+#include "impeller/entity/tessellation_prepass.h"
 #include "impeller/renderer/command_buffer.h"
 #include "impeller/renderer/pipeline_descriptor.h"
 #include "impeller/renderer/pipeline_library.h"
@@ -250,6 +251,10 @@ static std::unique_ptr<PipelineT> CreateDefaultPipeline(
   return std::make_unique<PipelineT>(context, desc);
 }
 
+// The bytes of tessellated paths that are kept to draw the same paths again
+// in later frames.
+static constexpr size_t kTessellationCacheMaxBytes = 4 * 1024 * 1024;
+
 ContentContext::ContentContext(
     std::shared_ptr<Context> context,
     std::shared_ptr<TypographerContext> typographer_context,
@@ -258,6 +263,7 @@ ContentContext::ContentContext(
       lazy_glyph_atlas_(
           std::make_shared<LazyGlyphAtlas>(std::move(typographer_context))),
       tessellator_(std::make_shared<Tessellator>()),
+      tessellation_prepass_(std::make_unique<TessellationPrepass>()),
 #if IMPELLER_ENABLE_3D
       scene_context_(std::make_shared<scene::SceneContext>(context_)),
 #endif  // IMPELLER_ENABLE_3D
@@ -267,6 +273,7 @@ ContentContext::ContentContext(
                                : std::move(render_target_allocator)),
       host_buffer_(HostBuffer::Create(context_->GetResourceAllocator())),
       pending_command_buffers_(std::make_unique<PendingCommandBuffers>()) {
+  tessellator_->SetCacheMaxBytes(kTessellationCacheMaxBytes);
   if (!context_ || !context_->IsValid()) {
     return;
   }
@@ -578,6 +585,10 @@ std::shared_ptr<Tessellator> ContentContext::GetTessellator() const {
   return tessellator_;
 }
 
+TessellationPrepass& ContentContext::GetTessellationPrepass() const {
+  return *tessellation_prepass_;
+}
+
 std::shared_ptr<Context> ContentContext::GetContext() const {
   return context_;
 }
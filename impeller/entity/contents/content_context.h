@@ -387,6 +387,7 @@ struct ContentContextOptions {
 };
 
 class Tessellator;
+class TessellationPrepass;
 class RenderTargetCache;
 
 class ContentContext {
@@ -416,6 +417,11 @@ class ContentContext {
 
   std::shared_ptr<Tessellator> GetTessellator() const;
 
+  /// @brief Retrieve the prepass that tessellates the geometry of a pass on
+  ///        worker threads, which is disabled until it is given a task
+  ///        runner with |TessellationPrepass::SetWorkerTaskRunner|.
+  TessellationPrepass& GetTessellationPrepass() const;
+
 #ifdef IMPELLER_DEBUG
   std::shared_ptr<Pipeline<PipelineDescriptor>> GetCheckerboardPipeline(
       ContentContextOptions opts) const {
@@ -1083,6 +1089,7 @@ class ContentContext {
 
   bool is_valid_ = false;
   std::shared_ptr<Tessellator> tessellator_;
+  std::unique_ptr<TessellationPrepass> tessellation_prepass_;
 #if IMPELLER_ENABLE_3D
   std::shared_ptr<scene::SceneContext> scene_context_;
 #endif  // IMPELLER_ENABLE_3D
@@ -25,6 +25,7 @@ class Entity;
 class Surface;
 class RenderPass;
 class FilterContents;
+class TessellationPrepass;
 
 ContentContextOptions OptionsFromPass(const RenderPass& pass);
 
@@ -62,6 +63,12 @@ class Contents {
       const std::shared_ptr<LazyGlyphAtlas>& lazy_glyph_atlas,
       Scalar scale) {}
 
+  /// @brief  Add any geometry that is tessellated on the CPU to the specified
+  ///         prepass. The transform must be the one that the entity is
+  ///         rendered with.
+  virtual void PopulateTessellationPrepass(TessellationPrepass& prepass,
+                                           const Matrix& transform) const {}
+
   virtual bool Render(const ContentContext& renderer,
                       const Entity& entity,
                       RenderPass& pass) const = 0;
@@ -23,6 +23,7 @@
 #include "impeller/entity/entity.h"
 #include "impeller/entity/entity_pass_clip_stack.h"
 #include "impeller/entity/inline_pass_context.h"
+#include "impeller/entity/tessellation_prepass.h"
 #include "impeller/geometry/color.h"
 #include "impeller/geometry/rect.h"
 #include "impeller/geometry/size.h"
@@ -403,12 +404,26 @@ bool EntityPass::Render(ContentContext& renderer,
                   {.readonly = true});
 
   const auto& lazy_glyph_atlas = renderer.GetLazyGlyphAtlas();
-  IterateAllEntities([&lazy_glyph_atlas](const Entity& entity) {
+  auto& tessellation_prepass = renderer.GetTessellationPrepass();
+  const bool prepare_tessellation = tessellation_prepass.IsEnabled();
+  // Geometry outside of the root pass is only drawn through filters that
+  // move it on screen, and is still tessellated when it is rendered.
+  tessellation_prepass.SetCullRect(
+      Rect::MakeSize(root_render_target.GetRenderTargetSize()));
+  IterateAllEntities([&lazy_glyph_atlas, &tessellation_prepass,
+                      prepare_tessellation](const Entity& entity) {
     if (const auto& contents = entity.GetContents()) {
       contents->PopulateGlyphAtlas(lazy_glyph_atlas, entity.DeriveTextScale());
+      if (prepare_tessellation) {
+        contents->PopulateTessellationPrepass(tessellation_prepass,
+                                              entity.GetTransform());
+      }
     }
     return true;
   });
+  if (prepare_tessellation) {
+    tessellation_prepass.Run(*renderer.GetTessellator());
+  }
 
   EntityPassClipStack clip_stack = EntityPassClipStack(
       Rect::MakeSize(root_render_target.GetRenderTargetSize()));
@@ -69,8 +69,8 @@ GeometryResult FillPathGeometry::GetPositionBuffer(
     }
   }
 
-  auto points = renderer.GetTessellator()->TessellateConvex(
-      path_, entity.GetTransform().GetMaxBasisLength());
+  auto points =
+      TakeConvexPoints(renderer, entity.GetTransform().GetMaxBasisLength());
 
   vertex_buffer.vertex_buffer = host_buffer.Emplace(
       points.data(), points.size() * sizeof(Point), alignof(Point));
@@ -146,8 +146,8 @@ GeometryResult FillPathGeometry::GetPositionUVBuffer(
     }
   }
 
-  auto points = renderer.GetTessellator()->TessellateConvex(
-      path_, entity.GetTransform().GetMaxBasisLength());
+  auto points =
+      TakeConvexPoints(renderer, entity.GetTransform().GetMaxBasisLength());
 
   VertexBufferBuilder<VS::PerVertexData> vertex_builder;
   vertex_builder.Reserve(points.size());
@@ -193,6 +193,65 @@ std::optional<Rect> FillPathGeometry::GetCoverage(
   return path_.GetTransformedBoundingBox(transform);
 }
 
+bool FillPathGeometry::CanPrepareTessellation() const {
+  const auto& bounding_box = path_.GetBoundingBox();
+  if (bounding_box.has_value() && bounding_box->IsEmpty()) {
+    return false;
+  }
+  return ContentContext::kEnableStencilThenCover || path_.IsConvex();
+}
+
+void FillPathGeometry::PrepareTessellation(Tessellator& tessellator,
+                                           const Matrix& transform) const {
+  if (!CanPrepareTessellation()) {
+    return;
+  }
+  Scalar scale = transform.GetMaxBasisLength();
+  prepared_points_ = {
+      .scale = scale,
+      .points = tessellator.TessellateConvex(path_, scale),
+  };
+}
+
+bool FillPathGeometry::PrepareCachedTessellation(
+    Tessellator& tessellator,
+    const Matrix& transform) const {
+  if (!CanPrepareTessellation()) {
+    return false;
+  }
+  Scalar scale = transform.GetMaxBasisLength();
+  auto points = tessellator.FindCachedConvex(path_, scale);
+  if (!points.has_value()) {
+    return false;
+  }
+  prepared_points_ = {
+      .scale = scale,
+      .points = std::move(points.value()),
+  };
+  return true;
+}
+
+void FillPathGeometry::CachePreparedTessellation(
+    Tessellator& tessellator) const {
+  if (prepared_points_.has_value()) {
+    tessellator.CacheConvex(path_, prepared_points_->scale,
+                            prepared_points_->points);
+  }
+}
+
+std::vector<Point> FillPathGeometry::TakeConvexPoints(
+    const ContentContext& renderer,
+    Scalar scale) const {
+  if (prepared_points_.has_value()) {
+    std::optional<PreparedPoints> prepared;
+    std::swap(prepared, prepared_points_);
+    if (prepared->scale == scale) {
+      return std::move(prepared->points);
+    }
+  }
+  return renderer.GetTessellator()->TessellateConvex(path_, scale);
+}
+
 bool FillPathGeometry::CoversArea(const Matrix& transform,
                                   const Rect& rect) const {
   if (!inner_rect_.has_value()) {
@@ -6,6 +6,7 @@
 #define FLUTTER_IMPELLER_ENTITY_GEOMETRY_FILL_PATH_GEOMETRY_H_
 
 #include <optional>
+#include <vector>
 
 #include "impeller/entity/geometry/geometry.h"
 #include "impeller/geometry/rect.h"
@@ -23,6 +24,20 @@ class FillPathGeometry final : public Geometry {
   // |Geometry|
   bool CoversArea(const Matrix& transform, const Rect& rect) const override;
 
+  // |Geometry|
+  bool CanPrepareTessellation() const override;
+
+  // |Geometry|
+  void PrepareTessellation(Tessellator& tessellator,
+                           const Matrix& transform) const override;
+
+  // |Geometry|
+  bool PrepareCachedTessellation(Tessellator& tessellator,
+                                 const Matrix& transform) const override;
+
+  // |Geometry|
+  void CachePreparedTessellation(Tessellator& tessellator) const override;
+
  private:
   // |Geometry|
   GeometryResult GetPositionBuffer(const ContentContext& renderer,
@@ -45,8 +60,19 @@ class FillPathGeometry final : public Geometry {
   // |Geometry|
   GeometryResult::Mode GetResultMode() const override;
 
+  // Returns the points that |PrepareTessellation| tessellated for the scale,
+  // or tessellates the path with the tessellator of the renderer.
+  std::vector<Point> TakeConvexPoints(const ContentContext& renderer,
+                                      Scalar scale) const;
+
+  struct PreparedPoints {
+    Scalar scale;
+    std::vector<Point> points;
+  };
+
   Path path_;
   std::optional<Rect> inner_rect_;
+  mutable std::optional<PreparedPoints> prepared_points_;
 
   FillPathGeometry(const FillPathGeometry&) = delete;
 
@@ -244,4 +244,18 @@ bool Geometry::CanApplyMaskFilter() const {
   return true;
 }
 
+bool Geometry::CanPrepareTessellation() const {
+  return false;
+}
+
+void Geometry::PrepareTessellation(Tessellator& tessellator,
+                                   const Matrix& transform) const {}
+
+bool Geometry::PrepareCachedTessellation(Tessellator& tessellator,
+                                         const Matrix& transform) const {
+  return false;
+}
+
+void Geometry::CachePreparedTessellation(Tessellator& tessellator) const {}
+
 }  // namespace impeller
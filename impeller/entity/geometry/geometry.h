@@ -150,6 +150,42 @@ class Geometry {
 
   virtual bool CanApplyMaskFilter() const;
 
+  //----------------------------------------------------------------------------
+  /// @brief    Whether |PrepareTessellation| does any work, which is the case
+  ///           for geometry that is tessellated on the CPU.
+  ///
+  virtual bool CanPrepareTessellation() const;
+
+  //----------------------------------------------------------------------------
+  /// @brief    Tessellates the geometry ahead of |GetPositionBuffer| for an
+  ///           entity with the given `transform`, so that the tessellation of
+  ///           many geometries can be spread over worker threads.
+  ///
+  ///           The result is used by the next call to |GetPositionBuffer| if
+  ///           the entity transform has the same scale, and released after.
+  ///
+  ///           This may be called on any thread, but not while the geometry
+  ///           is used on another thread.
+  ///
+  /// @see      |TessellationPrepass|
+  virtual void PrepareTessellation(Tessellator& tessellator,
+                                   const Matrix& transform) const;
+
+  //----------------------------------------------------------------------------
+  /// @brief    Prepares the tessellation like |PrepareTessellation| from the
+  ///           results that `tessellator` has cached, without tessellating.
+  ///
+  /// @return   Whether the results were cached.
+  ///
+  virtual bool PrepareCachedTessellation(Tessellator& tessellator,
+                                         const Matrix& transform) const;
+
+  //----------------------------------------------------------------------------
+  /// @brief    Adds the tessellation that another tessellator prepared for
+  ///           this geometry to the cache of `tessellator`.
+  ///
+  virtual void CachePreparedTessellation(Tessellator& tessellator) const;
+
  protected:
   static GeometryResult ComputePositionGeometry(
       const ContentContext& renderer,
@@ -76,6 +76,21 @@ class ImpellerEntityUnitTestAccessor {
         polyline, stroke_width, miter_limit, stroke_join, stroke_cap, scale,
         texture_origin, texture_size, effect_transform);
   }
+
+  static size_t ComputeButtBevelStrokeVertexCount(
+      const Path::Polyline& polyline) {
+    return StrokePathGeometry::ComputeButtBevelStrokeVertexCount(polyline);
+  }
+
+  static bool GenerateButtBevelStrokeVertices(
+      const Path::Polyline& polyline,
+      Scalar stroke_width,
+      Scalar scale,
+      SolidFillVertexShader::PerVertexData* vertices,
+      size_t vertex_count) {
+    return StrokePathGeometry::GenerateButtBevelStrokeVertices(
+        polyline, stroke_width, scale, vertices, vertex_count);
+  }
 };
 
 namespace testing {
@@ -231,6 +246,58 @@ TEST(EntityGeometryTest, StrokePathGeometryTransformOfLine) {
   }
 }
 
+TEST(EntityGeometryTest, StrokePathGeometryButtBevelVerticesInBuffer) {
+  PathBuilder chart;
+  chart.MoveTo({0, 0});
+  for (int i = 1; i < 100; i++) {
+    chart.LineTo({i * 2.0f, (i % 7) * 10.0f});
+  }
+  std::vector<Path> paths = {
+      PathBuilder{}.AddLine({100, 100}, {200, 100}).TakePath(),
+      PathBuilder{}
+          .MoveTo({10, 10})
+          .LineTo({50, 10})
+          .QuadraticCurveTo({80, 40}, {50, 70})
+          .CubicCurveTo({20, 100}, {0, 50}, {10, 120})
+          .TakePath(),
+      // Closed contours and a contour with a single point.
+      PathBuilder{}
+          .AddRoundedRect(Rect::MakeXYWH(0, 0, 100, 50), 10)
+          .MoveTo({200, 200})
+          .LineTo({200, 200})
+          .AddCircle({300, 300}, 40)
+          .TakePath(),
+      chart.TakePath(),
+      PathBuilder{}.TakePath(),
+  };
+
+  for (const Path& path : paths) {
+    for (Scalar scale : {0.5f, 1.0f, 4.0f}) {
+      auto polyline = path.CreatePolyline(scale);
+      auto expected =
+          ImpellerEntityUnitTestAccessor::GenerateSolidStrokeVertices(
+              polyline, 4.0f, 10.0f, Join::kBevel, Cap::kButt, scale);
+
+      size_t count =
+          ImpellerEntityUnitTestAccessor::ComputeButtBevelStrokeVertexCount(
+              polyline);
+      ASSERT_EQ(count, expected.size());
+      std::vector<SolidFillVertexShader::PerVertexData> vertices(count);
+      EXPECT_TRUE(
+          ImpellerEntityUnitTestAccessor::GenerateButtBevelStrokeVertices(
+              polyline, 4.0f, scale, vertices.data(), count));
+      EXPECT_SOLID_VERTICES_NEAR(vertices, expected);
+
+      // Too little room is reported instead of overrunning the buffer.
+      if (count > 0) {
+        EXPECT_FALSE(
+            ImpellerEntityUnitTestAccessor::GenerateButtBevelStrokeVertices(
+                polyline, 4.0f, scale, vertices.data(), count - 1));
+      }
+    }
+  }
+}
+
 TEST(EntityGeometryTest, GeometryResultHasReasonableDefaults) {
   GeometryResult result;
   EXPECT_EQ(result.type, PrimitiveType::kTriangleStrip);
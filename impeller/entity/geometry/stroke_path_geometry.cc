@@ -16,20 +16,22 @@ using VS = SolidFillVertexShader;
 
 namespace {
 
+// The cap and join procs are template arguments of |StrokeGenerator| so that
+// they are called directly, and usually inlined, for every cap and join.
 template <typename VertexWriter>
-using CapProc = std::function<void(VertexWriter& vtx_builder,
-                                   const Point& position,
-                                   const Point& offset,
-                                   Scalar scale,
-                                   bool reverse)>;
+using CapProc = void (*)(VertexWriter& vtx_builder,
+                         const Point& position,
+                         const Point& offset,
+                         Scalar scale,
+                         bool reverse);
 
 template <typename VertexWriter>
-using JoinProc = std::function<void(VertexWriter& vtx_builder,
-                                    const Point& position,
-                                    const Point& start_offset,
-                                    const Point& end_offset,
-                                    Scalar miter_limit,
-                                    Scalar scale)>;
+using JoinProc = void (*)(VertexWriter& vtx_builder,
+                          const Point& position,
+                          const Point& start_offset,
+                          const Point& end_offset,
+                          Scalar miter_limit,
+                          Scalar scale);
 
 class PositionWriter {
  public:
@@ -41,10 +43,39 @@ class PositionWriter {
     return data_;
   }
 
+  std::vector<SolidFillVertexShader::PerVertexData> TakeData() {
+    return std::move(data_);
+  }
+
  private:
   std::vector<SolidFillVertexShader::PerVertexData> data_ = {};
 };
 
+// Writes the positions straight into memory that was sized for them, such
+// as the memory of a |HostBuffer|, instead of into a vector.
+class PositionBufferWriter {
+ public:
+  PositionBufferWriter(SolidFillVertexShader::PerVertexData* data,
+                       size_t count)
+      : data_(data), end_(data + count) {}
+
+  void AppendVertex(const Point& point) {
+    if (data_ < end_) {
+      *data_++ = {.position = point};
+    } else {
+      overflowed_ = true;
+    }
+  }
+
+  // Whether exactly the vertices that there was room for were written.
+  bool IsFull() const { return data_ == end_ && !overflowed_; }
+
+ private:
+  SolidFillVertexShader::PerVertexData* data_;
+  SolidFillVertexShader::PerVertexData* const end_;
+  bool overflowed_ = false;
+};
+
 class PositionUVWriter {
  public:
   PositionUVWriter(const Point& texture_origin,
@@ -88,20 +119,18 @@ class PositionUVWriter {
   const Matrix effect_transform_;
 };
 
-template <typename VertexWriter>
+template <typename VertexWriter,
+          JoinProc<VertexWriter> join_proc,
+          CapProc<VertexWriter> cap_proc>
 class StrokeGenerator {
  public:
   StrokeGenerator(const Path::Polyline& p_polyline,
                   const Scalar p_stroke_width,
                   const Scalar p_scaled_miter_limit,
-                  const JoinProc<VertexWriter>& p_join_proc,
-                  const CapProc<VertexWriter>& p_cap_proc,
                   const Scalar p_scale)
       : polyline(p_polyline),
         stroke_width(p_stroke_width),
         scaled_miter_limit(p_scaled_miter_limit),
-        join_proc(p_join_proc),
-        cap_proc(p_cap_proc),
         scale(p_scale) {}
 
   void Generate(VertexWriter& vtx_builder) {
@@ -292,8 +321,6 @@ class StrokeGenerator {
   const Path::Polyline& polyline;
   const Scalar stroke_width;
   const Scalar scaled_miter_limit;
-  const JoinProc<VertexWriter>& join_proc;
-  const CapProc<VertexWriter>& cap_proc;
   const Scalar scale;
 
   Point previous_offset;
@@ -469,41 +496,59 @@ void CreateBevelJoin(VertexWriter& vtx_builder,
   CreateBevelAndGetDirection(vtx_builder, position, start_offset, end_offset);
 }
 
+template <typename VertexWriter, JoinProc<VertexWriter> join_proc>
+void CreateSolidStrokeVerticesWithJoin(VertexWriter& vtx_builder,
+                                       const Path::Polyline& polyline,
+                                       Scalar stroke_width,
+                                       Scalar scaled_miter_limit,
+                                       Cap stroke_cap,
+                                       Scalar scale) {
+  switch (stroke_cap) {
+    case Cap::kButt:
+      StrokeGenerator<VertexWriter, join_proc, &CreateButtCap<VertexWriter>>(
+          polyline, stroke_width, scaled_miter_limit, scale)
+          .Generate(vtx_builder);
+      return;
+    case Cap::kRound:
+      StrokeGenerator<VertexWriter, join_proc, &CreateRoundCap<VertexWriter>>(
+          polyline, stroke_width, scaled_miter_limit, scale)
+          .Generate(vtx_builder);
+      return;
+    case Cap::kSquare:
+      StrokeGenerator<VertexWriter, join_proc, &CreateSquareCap<VertexWriter>>(
+          polyline, stroke_width, scaled_miter_limit, scale)
+          .Generate(vtx_builder);
+      return;
+  }
+}
+
 template <typename VertexWriter>
 void CreateSolidStrokeVertices(VertexWriter& vtx_builder,
                                const Path::Polyline& polyline,
                                Scalar stroke_width,
                                Scalar scaled_miter_limit,
-                               const JoinProc<VertexWriter>& join_proc,
-                               const CapProc<VertexWriter>& cap_proc,
+                               Join stroke_join,
+                               Cap stroke_cap,
                                Scalar scale) {
-  StrokeGenerator stroke_generator(polyline, stroke_width, scaled_miter_limit,
-                                   join_proc, cap_proc, scale);
-  stroke_generator.Generate(vtx_builder);
-}
-
-// static
-template <typename VertexWriter>
-JoinProc<VertexWriter> GetJoinProc(Join stroke_join) {
   switch (stroke_join) {
     case Join::kBevel:
-      return &CreateBevelJoin<VertexWriter>;
+      CreateSolidStrokeVerticesWithJoin<VertexWriter,
+                                        &CreateBevelJoin<VertexWriter>>(
+          vtx_builder, polyline, stroke_width, scaled_miter_limit, stroke_cap,
+          scale);
+      return;
     case Join::kMiter:
-      return &CreateMiterJoin<VertexWriter>;
+      CreateSolidStrokeVerticesWithJoin<VertexWriter,
+                                        &CreateMiterJoin<VertexWriter>>(
+          vtx_builder, polyline, stroke_width, scaled_miter_limit, stroke_cap,
+          scale);
+      return;
     case Join::kRound:
-      return &CreateRoundJoin<VertexWriter>;
-  }
-}
-
-template <typename VertexWriter>
-CapProc<VertexWriter> GetCapProc(Cap stroke_cap) {
-  switch (stroke_cap) {
-    case Cap::kButt:
-      return &CreateButtCap<VertexWriter>;
-    case Cap::kRound:
-      return &CreateRoundCap<VertexWriter>;
-    case Cap::kSquare:
-      return &CreateSquareCap<VertexWriter>;
+      CreateSolidStrokeVerticesWithJoin<VertexWriter,
+                                        &CreateRoundJoin<VertexWriter>>(
+          vtx_builder, polyline, stroke_width, scaled_miter_limit, stroke_cap,
+          scale);
+      return;
   }
 }
 }  // namespace
@@ -516,13 +561,10 @@ StrokePathGeometry::GenerateSolidStrokeVertices(const Path::Polyline& polyline,
                                                 Cap stroke_cap,
                                                 Scalar scale) {
   auto scaled_miter_limit = stroke_width * miter_limit * 0.5f;
-  auto join_proc = GetJoinProc<PositionWriter>(stroke_join);
-  auto cap_proc = GetCapProc<PositionWriter>(stroke_cap);
-  StrokeGenerator stroke_generator(polyline, stroke_width, scaled_miter_limit,
-                                   join_proc, cap_proc, scale);
   PositionWriter vtx_builder;
-  stroke_generator.Generate(vtx_builder);
-  return vtx_builder.GetData();
+  CreateSolidStrokeVertices(vtx_builder, polyline, stroke_width,
+                            scaled_miter_limit, stroke_join, stroke_cap, scale);
+  return vtx_builder.TakeData();
 }
 
 std::vector<TextureFillVertexShader::PerVertexData>
@@ -537,15 +579,83 @@ StrokePathGeometry::GenerateSolidStrokeVerticesUV(
     Size texture_size,
     const Matrix& effect_transform) {
   auto scaled_miter_limit = stroke_width * miter_limit * 0.5f;
-  auto join_proc = GetJoinProc<PositionUVWriter>(stroke_join);
-  auto cap_proc = GetCapProc<PositionUVWriter>(stroke_cap);
-  StrokeGenerator stroke_generator(polyline, stroke_width, scaled_miter_limit,
-                                   join_proc, cap_proc, scale);
   PositionUVWriter vtx_builder(texture_origin, texture_size, effect_transform);
-  stroke_generator.Generate(vtx_builder);
+  CreateSolidStrokeVertices(vtx_builder, polyline, stroke_width,
+                            scaled_miter_limit, stroke_join, stroke_cap, scale);
   return vtx_builder.GetData();
 }
 
+size_t StrokePathGeometry::ComputeButtBevelStrokeVertexCount(
+    const Path::Polyline& polyline) {
+  // This follows |StrokeGenerator::Generate|, for which a butt cap always
+  // appends 2 vertices and a bevel join always appends 3.
+  constexpr size_t kCapVertexCount = 2;
+  constexpr size_t kJoinVertexCount = 3;
+
+  size_t count = 0;
+  for (size_t contour_i = 0; contour_i < polyline.contours.size();
+       contour_i++) {
+    const Path::PolylineContour& contour = polyline.contours[contour_i];
+    auto [contour_start_point_i, contour_end_point_i] =
+        polyline.GetContourPointBounds(contour_i);
+    auto contour_delta = contour_end_point_i - contour_start_point_i;
+    if (contour_delta == 1) {
+      count += 2 * kCapVertexCount;
+      continue;
+    } else if (contour_delta == 0) {
+      continue;
+    }
+
+    if (contour_i > 0) {
+      // The vertices that pick up the pen.
+      count += 4;
+    }
+    if (!contour.is_closed) {
+      count += kCapVertexCount;
+    }
+
+    for (size_t contour_component_i = 0;
+         contour_component_i < contour.components.size();
+         contour_component_i++) {
+      const Path::PolylineContour::Component& component =
+          contour.components[contour_component_i];
+      size_t component_start_index = component.component_start_index;
+      size_t component_end_index =
+          contour_component_i == contour.components.size() - 1
+              ? contour_end_point_i - 1
+              : contour.components[contour_component_i + 1]
+                    .component_start_index;
+      if (component_end_index <= component_start_index) {
+        continue;
+      }
+      size_t point_count = component_end_index - component_start_index;
+      count += component.is_curve ? 2 * point_count + 2 : 4 * point_count;
+      if (component_start_index !=
+          contour.components.back().component_start_index) {
+        count += kJoinVertexCount;
+      }
+    }
+
+    count += contour.is_closed ? kJoinVertexCount : kCapVertexCount;
+  }
+  return count;
+}
+
+bool StrokePathGeometry::GenerateButtBevelStrokeVertices(
+    const Path::Polyline& polyline,
+    Scalar stroke_width,
+    Scalar scale,
+    SolidFillVertexShader::PerVertexData* vertices,
+    size_t vertex_count) {
+  PositionBufferWriter vtx_builder(vertices, vertex_count);
+  // Bevel joins don't use the miter limit.
+  StrokeGenerator<PositionBufferWriter, &CreateBevelJoin<PositionBufferWriter>,
+                  &CreateButtCap<PositionBufferWriter>>(polyline, stroke_width,
+                                                        0.0f, scale)
+      .Generate(vtx_builder);
+  return vtx_builder.IsFull();
+}
+
 StrokePathGeometry::StrokePathGeometry(const Path& path,
                                        Scalar stroke_width,
                                        Scalar miter_limit,
@@ -575,43 +685,107 @@ Join StrokePathGeometry::GetStrokeJoin() const {
   return stroke_join_;
 }
 
-GeometryResult StrokePathGeometry::GetPositionBuffer(
-    const ContentContext& renderer,
-    const Entity& entity,
-    RenderPass& pass) const {
+std::optional<Scalar> StrokePathGeometry::GetTransformedStrokeWidth(
+    const Matrix& transform) const {
   if (stroke_width_ < 0.0) {
-    return {};
+    return std::nullopt;
   }
-  auto determinant = entity.GetTransform().GetDeterminant();
+  auto determinant = transform.GetDeterminant();
   if (determinant == 0) {
-    return {};
+    return std::nullopt;
   }
 
   Scalar min_size = 1.0f / sqrt(std::abs(determinant));
-  Scalar stroke_width = std::max(stroke_width_, min_size);
-
-  auto& host_buffer = renderer.GetTransientsBuffer();
-  auto scale = entity.GetTransform().GetMaxBasisLength();
+  return std::max(stroke_width_, min_size);
+}
 
+std::vector<SolidFillVertexShader::PerVertexData>
+StrokePathGeometry::CreateStrokeVertices(Tessellator& tessellator,
+                                         Scalar stroke_width,
+                                         Scalar scale) const {
   PositionWriter position_writer;
-  auto polyline = renderer.GetTessellator()->CreateTempPolyline(path_, scale);
+  auto polyline = tessellator.CreateTempPolyline(path_, scale);
   CreateSolidStrokeVertices(position_writer, polyline, stroke_width,
-                            miter_limit_ * stroke_width_ * 0.5f,
-                            GetJoinProc<PositionWriter>(stroke_join_),
-                            GetCapProc<PositionWriter>(stroke_cap_), scale);
+                            miter_limit_ * stroke_width_ * 0.5f, stroke_join_,
+                            stroke_cap_, scale);
+  return position_writer.TakeData();
+}
+
+bool StrokePathGeometry::CanPrepareTessellation() const {
+  return stroke_width_ >= 0.0;
+}
+
+void StrokePathGeometry::PrepareTessellation(Tessellator& tessellator,
+                                             const Matrix& transform) const {
+  auto stroke_width = GetTransformedStrokeWidth(transform);
+  if (!stroke_width.has_value()) {
+    return;
+  }
+  Scalar scale = transform.GetMaxBasisLength();
+  prepared_vertices_ = {
+      .stroke_width = stroke_width.value(),
+      .scale = scale,
+      .vertices =
+          CreateStrokeVertices(tessellator, stroke_width.value(), scale),
+  };
+}
+
+GeometryResult StrokePathGeometry::GetPositionBuffer(
+    const ContentContext& renderer,
+    const Entity& entity,
+    RenderPass& pass) const {
+  std::optional<PreparedVertices> prepared;
+  std::swap(prepared, prepared_vertices_);
+  auto stroke_width = GetTransformedStrokeWidth(entity.GetTransform());
+  if (!stroke_width.has_value()) {
+    return {};
+  }
 
-  BufferView buffer_view =
-      host_buffer.Emplace(position_writer.GetData().data(),
-                          position_writer.GetData().size() *
-                              sizeof(SolidFillVertexShader::PerVertexData),
-                          alignof(SolidFillVertexShader::PerVertexData));
+  auto& host_buffer = renderer.GetTransientsBuffer();
+  auto scale = entity.GetTransform().GetMaxBasisLength();
+
+  BufferView buffer_view;
+  size_t vertex_count;
+  if (prepared.has_value() && prepared->stroke_width == stroke_width.value() &&
+      prepared->scale == scale) {
+    const auto& vertices = prepared->vertices;
+    buffer_view = host_buffer.Emplace(
+        vertices.data(),
+        vertices.size() * sizeof(SolidFillVertexShader::PerVertexData),
+        alignof(SolidFillVertexShader::PerVertexData));
+    vertex_count = vertices.size();
+  } else if (stroke_join_ == Join::kBevel && stroke_cap_ == Cap::kButt) {
+    // The vertices of butt caps and bevel joins can be counted up front, so
+    // they are written straight into the host buffer. This is the common
+    // case for charts and other thin lines.
+    auto polyline = renderer.GetTessellator()->CreateTempPolyline(path_, scale);
+    vertex_count = ComputeButtBevelStrokeVertexCount(polyline);
+    buffer_view = host_buffer.Emplace(
+        vertex_count * sizeof(SolidFillVertexShader::PerVertexData),
+        alignof(SolidFillVertexShader::PerVertexData),
+        [&polyline, &stroke_width, scale, vertex_count](uint8_t* buffer) {
+          [[maybe_unused]] bool filled = GenerateButtBevelStrokeVertices(
+              polyline, stroke_width.value(), scale,
+              reinterpret_cast<SolidFillVertexShader::PerVertexData*>(buffer),
+              vertex_count);
+          FML_DCHECK(filled);
+        });
+  } else {
+    auto vertices = CreateStrokeVertices(*renderer.GetTessellator(),
+                                         stroke_width.value(), scale);
+    buffer_view = host_buffer.Emplace(
+        vertices.data(),
+        vertices.size() * sizeof(SolidFillVertexShader::PerVertexData),
+        alignof(SolidFillVertexShader::PerVertexData));
+    vertex_count = vertices.size();
+  }
 
   return GeometryResult{
       .type = PrimitiveType::kTriangleStrip,
       .vertex_buffer =
           {
               .vertex_buffer = buffer_view,
-              .vertex_count = position_writer.GetData().size(),
+              .vertex_count = vertex_count,
               .index_type = IndexType::kNone,
           },
       .transform = entity.GetShaderTransform(pass),
@@ -625,6 +799,8 @@ GeometryResult StrokePathGeometry::GetPositionUVBuffer(
     const ContentContext& renderer,
     const Entity& entity,
     RenderPass& pass) const {
+  // Vertices with texture coordinates aren't prepared.
+  prepared_vertices_.reset();
   if (stroke_width_ < 0.0) {
     return {};
   }
@@ -643,9 +819,8 @@ GeometryResult StrokePathGeometry::GetPositionUVBuffer(
   PositionUVWriter writer(Point{0, 0}, texture_coverage.GetSize(),
                           effect_transform);
   CreateSolidStrokeVertices(writer, polyline, stroke_width,
-                            miter_limit_ * stroke_width_ * 0.5f,
-                            GetJoinProc<PositionUVWriter>(stroke_join_),
-                            GetCapProc<PositionUVWriter>(stroke_cap_), scale);
+                            miter_limit_ * stroke_width_ * 0.5f, stroke_join_,
+                            stroke_cap_, scale);
 
   BufferView buffer_view = host_buffer.Emplace(
       writer.GetData().data(),
@@ -5,6 +5,9 @@
 #ifndef FLUTTER_IMPELLER_ENTITY_GEOMETRY_STROKE_PATH_GEOMETRY_H_
 #define FLUTTER_IMPELLER_ENTITY_GEOMETRY_STROKE_PATH_GEOMETRY_H_
 
+#include <optional>
+#include <vector>
+
 #include "impeller/entity/geometry/geometry.h"
 
 namespace impeller {
@@ -28,6 +31,13 @@ class StrokePathGeometry final : public Geometry {
 
   Join GetStrokeJoin() const;
 
+  // |Geometry|
+  bool CanPrepareTessellation() const override;
+
+  // |Geometry|
+  void PrepareTessellation(Tessellator& tessellator,
+                           const Matrix& transform) const override;
+
  private:
   // |Geometry|
   GeometryResult GetPositionBuffer(const ContentContext& renderer,
@@ -70,16 +80,49 @@ class StrokePathGeometry final : public Geometry {
                                 Size texture_size,
                                 const Matrix& effect_transform);
 
+  // Returns the number of vertices that |GenerateButtBevelStrokeVertices|
+  // writes for the polyline.
+  static size_t ComputeButtBevelStrokeVertexCount(
+      const Path::Polyline& polyline);
+
+  // Writes the same vertices as |GenerateSolidStrokeVertices| does for butt
+  // caps and bevel joins into `vertices`, which has room for the number of
+  // vertices from |ComputeButtBevelStrokeVertexCount|, and returns whether
+  // exactly that many were written.
+  static bool GenerateButtBevelStrokeVertices(
+      const Path::Polyline& polyline,
+      Scalar stroke_width,
+      Scalar scale,
+      SolidFillVertexShader::PerVertexData* vertices,
+      size_t vertex_count);
+
   friend class ImpellerBenchmarkAccessor;
   friend class ImpellerEntityUnitTestAccessor;
 
   bool SkipRendering() const;
 
+  // Returns the width that the stroke is drawn with for an entity with the
+  // transform, or nothing if the stroke isn't drawn.
+  std::optional<Scalar> GetTransformedStrokeWidth(
+      const Matrix& transform) const;
+
+  std::vector<SolidFillVertexShader::PerVertexData> CreateStrokeVertices(
+      Tessellator& tessellator,
+      Scalar stroke_width,
+      Scalar scale) const;
+
+  struct PreparedVertices {
+    Scalar stroke_width;
+    Scalar scale;
+    std::vector<SolidFillVertexShader::PerVertexData> vertices;
+  };
+
   Path path_;
   Scalar stroke_width_;
   Scalar miter_limit_;
   Cap stroke_cap_;
   Join stroke_join_;
+  mutable std::optional<PreparedVertices> prepared_vertices_;
 
   StrokePathGeometry(const StrokePathGeometry&) = delete;
 
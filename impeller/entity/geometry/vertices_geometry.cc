@@ -6,6 +6,7 @@
 
 #include <cstdint>
 #include <utility>
+#include <vector>
 
 #include "impeller/core/buffer_view.h"
 
@@ -200,6 +201,12 @@ GeometryResult VerticesGeometry::GetPositionUVBuffer(
       texture_coverage.GetNormalizingTransform() * effect_transform;
   auto has_texture_coordinates = HasTextureCoordinates();
 
+  std::vector<Point> uvs(vertex_count);
+  uv_transform.TransformPoints(
+      uvs.data(),
+      has_texture_coordinates ? texture_coordinates_.data() : vertices_.data(),
+      vertex_count);
+
   size_t total_vtx_bytes = vertices_.size() * sizeof(VS::PerVertexData);
   size_t total_idx_bytes = index_count * sizeof(uint16_t);
   auto vertex_buffer = renderer.GetTransientsBuffer().Emplace(
@@ -208,9 +215,7 @@ GeometryResult VerticesGeometry::GetPositionUVBuffer(
             reinterpret_cast<VS::PerVertexData*>(data);
         for (auto i = 0u; i < vertices_.size(); i++) {
           auto vertex = vertices_[i];
-          auto texture_coord =
-              has_texture_coordinates ? texture_coordinates_[i] : vertices_[i];
-          auto uv = uv_transform * texture_coord;
+          auto uv = uvs[i];
           // From experimentation we need to clamp these values to < 1.0 or else
           // there can be flickering.
           VS::PerVertexData vertex_data = {
@@ -0,0 +1,129 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/entity/tessellation_prepass.h"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+#include "flutter/fml/synchronization/count_down_latch.h"
+#include "flutter/fml/trace_event.h"
+#include "impeller/entity/geometry/geometry.h"
+#include "impeller/tessellator/tessellator.h"
+
+namespace impeller {
+
+// The least geometry that is worth posting tasks to the workers for.
+static constexpr size_t kMinConcurrentGeometryCount = 16;
+
+// The geometry to add for every worker that helps the raster thread.
+static constexpr size_t kGeometryPerWorker = 8;
+
+TessellationPrepass::TessellationPrepass() = default;
+
+TessellationPrepass::~TessellationPrepass() = default;
+
+void TessellationPrepass::SetWorkerTaskRunner(
+    std::shared_ptr<fml::ConcurrentTaskRunner> task_runner) {
+  task_runner_ = std::move(task_runner);
+}
+
+void TessellationPrepass::AddGeometry(const std::shared_ptr<Geometry>& geometry,
+                                      const Matrix& transform) {
+  if (!geometry || !geometry->CanPrepareTessellation()) {
+    return;
+  }
+  if (cull_rect_.has_value()) {
+    auto coverage = geometry->GetCoverage(transform);
+    if (coverage.has_value() && !coverage->IntersectsWithRect(*cull_rect_)) {
+      return;
+    }
+  }
+  // Geometry that is drawn more than once is prepared for its first entity.
+  if (!added_geometry_.insert(geometry.get()).second) {
+    return;
+  }
+  items_.push_back({geometry, transform});
+}
+
+void TessellationPrepass::Run(Tessellator& tessellator) {
+  if (!task_runner_ || items_.size() < kMinConcurrentGeometryCount) {
+    Clear();
+    return;
+  }
+  TRACE_EVENT0("impeller", "TessellationPrepass::Run");
+
+  // The cache isn't thread safe, so it is only used on this thread. Only the
+  // geometry that it has no results for is left in the items.
+  size_t miss_count = 0;
+  for (size_t i = 0; i < items_.size(); i++) {
+    const Item& item = items_[i];
+    if (item.geometry->PrepareCachedTessellation(tessellator, item.transform)) {
+      continue;
+    }
+    if (miss_count != i) {
+      items_[miss_count] = std::move(items_[i]);
+    }
+    miss_count++;
+  }
+  items_.resize(miss_count);
+  if (items_.size() < kMinConcurrentGeometryCount) {
+    Clear();
+    return;
+  }
+
+  size_t worker_count =
+      std::min<size_t>(items_.size() / kGeometryPerWorker,
+                       std::max(1u, std::thread::hardware_concurrency()));
+  while (worker_tessellators_.size() < worker_count + 1) {
+    worker_tessellators_.push_back(std::make_unique<Tessellator>());
+  }
+  // Round tolerances like the cache does, so that the results can be added
+  // to it.
+  for (const auto& worker_tessellator : worker_tessellators_) {
+    worker_tessellator->SetQuantizeTolerance(tessellator.IsCacheEnabled());
+  }
+
+  struct State {
+    explicit State(size_t count) : count(count), done(count) {}
+
+    const size_t count;
+    std::atomic_size_t next = 0;
+    fml::CountDownLatch done;
+  };
+  // Each thread claims the next geometry that no other thread has claimed,
+  // so the raster thread never waits for a worker that hasn't started. The
+  // workers that start after all geometry was claimed only touch |state|,
+  // which they keep alive, and not the items or their tessellator.
+  auto state = std::make_shared<State>(items_.size());
+  auto run = [state, items = items_.data()](Tessellator* tessellator) {
+    size_t index;
+    while ((index = state->next.fetch_add(1)) < state->count) {
+      const Item& item = items[index];
+      item.geometry->PrepareTessellation(*tessellator, item.transform);
+      state->done.CountDown();
+    }
+  };
+  for (size_t i = 0; i < worker_count; i++) {
+    task_runner_->PostTask(
+        [run, tessellator = worker_tessellators_[i].get()]() {
+          run(tessellator);
+        });
+  }
+  run(worker_tessellators_[worker_count].get());
+  state->done.Wait();
+
+  for (const Item& item : items_) {
+    item.geometry->CachePreparedTessellation(tessellator);
+  }
+  Clear();
+}
+
+void TessellationPrepass::Clear() {
+  items_.clear();
+  added_geometry_.clear();
+}
+
+}  // namespace impeller
@@ -0,0 +1,100 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_IMPELLER_ENTITY_TESSELLATION_PREPASS_H_
+#define FLUTTER_IMPELLER_ENTITY_TESSELLATION_PREPASS_H_
+
+#include <memory>
+#include <optional>
+#include <unordered_set>
+#include <vector>
+
+#include "flutter/fml/concurrent_message_loop.h"
+#include "impeller/geometry/matrix.h"
+#include "impeller/geometry/rect.h"
+
+namespace impeller {
+
+class Geometry;
+class Tessellator;
+
+//------------------------------------------------------------------------------
+/// @brief      Tessellates the geometry of the entities in a pass on worker
+///             threads before the pass is rendered, so that scenes with many
+///             complex paths, such as maps and grids of icons, aren't limited
+///             by the speed of the raster thread.
+///
+///             Each worker uses its own |Tessellator|. Results that the
+///             renderer's tessellator has cached are used instead, and the
+///             results of the workers are added to its cache. The vertices
+///             are still written to the host buffer in the order that the
+///             entities are rendered in, by |Geometry::GetPositionBuffer|.
+///
+class TessellationPrepass {
+ public:
+  TessellationPrepass();
+
+  ~TessellationPrepass();
+
+  //----------------------------------------------------------------------------
+  /// @brief      Sets the task runner whose workers tessellate the geometry.
+  ///             The prepass is disabled without one.
+  ///
+  void SetWorkerTaskRunner(
+      std::shared_ptr<fml::ConcurrentTaskRunner> task_runner);
+
+  bool IsEnabled() const { return task_runner_ != nullptr; }
+
+  //----------------------------------------------------------------------------
+  /// @brief      Sets the bounds of the pass. Geometry that is known to fall
+  ///             outside of them isn't added.
+  ///
+  void SetCullRect(std::optional<Rect> cull_rect) { cull_rect_ = cull_rect; }
+
+  //----------------------------------------------------------------------------
+  /// @brief      Adds geometry to tessellate for an entity with the given
+  ///             transform. Geometry that was already added, that isn't
+  ///             tessellated on the CPU or that is culled is ignored.
+  ///
+  void AddGeometry(const std::shared_ptr<Geometry>& geometry,
+                   const Matrix& transform);
+
+  size_t GetGeometryCount() const { return items_.size(); }
+
+  //----------------------------------------------------------------------------
+  /// @brief      Prepares the added geometry from the results that
+  ///             `tessellator` has cached, tessellates the rest on the
+  ///             workers and on the calling thread, and returns once all of
+  ///             it is done. The new results are added to the cache of
+  ///             `tessellator` and the added geometry is then cleared.
+  ///
+  ///             Too little uncached geometry to be worth spreading over the
+  ///             workers is left for the entities to tessellate when
+  ///             rendered.
+  ///
+  void Run(Tessellator& tessellator);
+
+ private:
+  struct Item {
+    std::shared_ptr<Geometry> geometry;
+    Matrix transform;
+  };
+
+  void Clear();
+
+  std::shared_ptr<fml::ConcurrentTaskRunner> task_runner_;
+  // One for each worker, plus one for the calling thread.
+  std::vector<std::unique_ptr<Tessellator>> worker_tessellators_;
+  std::optional<Rect> cull_rect_;
+  std::vector<Item> items_;
+  std::unordered_set<const Geometry*> added_geometry_;
+
+  TessellationPrepass(const TessellationPrepass&) = delete;
+
+  TessellationPrepass& operator=(const TessellationPrepass&) = delete;
+};
+
+}  // namespace impeller
+
+#endif  // FLUTTER_IMPELLER_ENTITY_TESSELLATION_PREPASS_H_
@@ -0,0 +1,225 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include <atomic>
+#include <memory>
+
+#include "flutter/fml/concurrent_message_loop.h"
+#include "flutter/testing/testing.h"
+#include "impeller/entity/geometry/geometry.h"
+#include "impeller/entity/tessellation_prepass.h"
+#include "impeller/geometry/path_builder.h"
+#include "impeller/tessellator/tessellator.h"
+
+namespace impeller {
+namespace testing {
+
+namespace {
+
+class TestGeometry final : public Geometry {
+ public:
+  explicit TestGeometry(bool can_prepare = true,
+                        std::optional<Rect> coverage = std::nullopt)
+      : can_prepare_(can_prepare), coverage_(coverage) {}
+
+  // |Geometry|
+  GeometryResult GetPositionBuffer(const ContentContext& renderer,
+                                   const Entity& entity,
+                                   RenderPass& pass) const override {
+    return {};
+  }
+
+  // |Geometry|
+  GeometryResult GetPositionUVBuffer(Rect texture_coverage,
+                                     Matrix effect_transform,
+                                     const ContentContext& renderer,
+                                     const Entity& entity,
+                                     RenderPass& pass) const override {
+    return {};
+  }
+
+  // |Geometry|
+  GeometryVertexType GetVertexType() const override {
+    return GeometryVertexType::kPosition;
+  }
+
+  // |Geometry|
+  std::optional<Rect> GetCoverage(const Matrix& transform) const override {
+    return coverage_;
+  }
+
+  // |Geometry|
+  bool CanPrepareTessellation() const override { return can_prepare_; }
+
+  // |Geometry|
+  void PrepareTessellation(Tessellator& tessellator,
+                           const Matrix& transform) const override {
+    prepare_count++;
+    prepared_transform = transform;
+  }
+
+  // |Geometry|
+  bool PrepareCachedTessellation(Tessellator& tessellator,
+                                 const Matrix& transform) const override {
+    return is_cached;
+  }
+
+  // |Geometry|
+  void CachePreparedTessellation(Tessellator& tessellator) const override {
+    cache_count++;
+  }
+
+  bool is_cached = false;
+  mutable std::atomic_int prepare_count = 0;
+  mutable int cache_count = 0;
+  mutable Matrix prepared_transform;
+
+ private:
+  bool can_prepare_;
+  std::optional<Rect> coverage_;
+};
+
+}  // namespace
+
+TEST(TessellationPrepassTest, IsDisabledWithoutTaskRunner) {
+  TessellationPrepass prepass;
+  Tessellator tessellator;
+  EXPECT_FALSE(prepass.IsEnabled());
+
+  std::vector<std::shared_ptr<TestGeometry>> geometries;
+  for (int i = 0; i < 64; i++) {
+    geometries.push_back(std::make_shared<TestGeometry>());
+    prepass.AddGeometry(geometries.back(), {});
+  }
+  prepass.Run(tessellator);
+
+  EXPECT_EQ(prepass.GetGeometryCount(), 0u);
+  for (const auto& geometry : geometries) {
+    EXPECT_EQ(geometry->prepare_count, 0);
+  }
+}
+
+TEST(TessellationPrepassTest, PreparesEachGeometryOnce) {
+  auto loop = fml::ConcurrentMessageLoop::Create(4);
+  TessellationPrepass prepass;
+  prepass.SetWorkerTaskRunner(loop->GetTaskRunner());
+  Tessellator tessellator;
+  ASSERT_TRUE(prepass.IsEnabled());
+
+  // Run more than once to use the worker tessellators again.
+  for (int frame = 0; frame < 3; frame++) {
+    std::vector<std::shared_ptr<TestGeometry>> geometries;
+    for (int i = 0; i < 200; i++) {
+      geometries.push_back(std::make_shared<TestGeometry>());
+      prepass.AddGeometry(geometries.back(), Matrix::MakeScale({2, 2, 1}));
+    }
+    // Geometry is prepared for the first entity that draws it.
+    prepass.AddGeometry(geometries.front(), Matrix::MakeScale({3, 3, 1}));
+    auto unprepared = std::make_shared<TestGeometry>(false);
+    prepass.AddGeometry(unprepared, {});
+    EXPECT_EQ(prepass.GetGeometryCount(), 200u);
+
+    prepass.Run(tessellator);
+
+    EXPECT_EQ(prepass.GetGeometryCount(), 0u);
+    for (const auto& geometry : geometries) {
+      EXPECT_EQ(geometry->prepare_count, 1);
+      EXPECT_EQ(geometry->prepared_transform, Matrix::MakeScale({2, 2, 1}));
+    }
+    EXPECT_EQ(unprepared->prepare_count, 0);
+  }
+}
+
+TEST(TessellationPrepassTest, LeavesLittleGeometryForRendering) {
+  auto loop = fml::ConcurrentMessageLoop::Create(4);
+  TessellationPrepass prepass;
+  prepass.SetWorkerTaskRunner(loop->GetTaskRunner());
+  Tessellator tessellator;
+
+  auto geometry = std::make_shared<TestGeometry>();
+  prepass.AddGeometry(geometry, {});
+  prepass.Run(tessellator);
+
+  EXPECT_EQ(prepass.GetGeometryCount(), 0u);
+  EXPECT_EQ(geometry->prepare_count, 0);
+}
+
+TEST(TessellationPrepassTest, SkipsGeometryOutsideCullRect) {
+  TessellationPrepass prepass;
+  prepass.SetCullRect(Rect::MakeLTRB(0, 0, 100, 100));
+
+  auto inside =
+      std::make_shared<TestGeometry>(true, Rect::MakeLTRB(50, 50, 150, 150));
+  auto outside =
+      std::make_shared<TestGeometry>(true, Rect::MakeLTRB(200, 0, 300, 100));
+  // Geometry without known coverage isn't culled.
+  auto unknown = std::make_shared<TestGeometry>();
+  prepass.AddGeometry(inside, {});
+  prepass.AddGeometry(outside, {});
+  prepass.AddGeometry(unknown, {});
+
+  EXPECT_EQ(prepass.GetGeometryCount(), 2u);
+}
+
+TEST(TessellationPrepassTest, TessellatesOnlyUncachedGeometry) {
+  auto loop = fml::ConcurrentMessageLoop::Create(4);
+  TessellationPrepass prepass;
+  prepass.SetWorkerTaskRunner(loop->GetTaskRunner());
+  Tessellator tessellator;
+
+  std::vector<std::shared_ptr<TestGeometry>> geometries;
+  for (int i = 0; i < 200; i++) {
+    geometries.push_back(std::make_shared<TestGeometry>());
+    geometries.back()->is_cached = i % 2 == 0;
+    prepass.AddGeometry(geometries.back(), {});
+  }
+  prepass.Run(tessellator);
+
+  for (int i = 0; i < 200; i++) {
+    bool is_cached = i % 2 == 0;
+    EXPECT_EQ(geometries[i]->prepare_count, is_cached ? 0 : 1);
+    EXPECT_EQ(geometries[i]->cache_count, is_cached ? 0 : 1);
+  }
+}
+
+TEST(TessellationPrepassTest, AddsResultsToTessellatorCache) {
+  auto loop = fml::ConcurrentMessageLoop::Create(4);
+  TessellationPrepass prepass;
+  prepass.SetWorkerTaskRunner(loop->GetTaskRunner());
+  Tessellator tessellator;
+  tessellator.SetCacheMaxBytes(1024 * 1024);
+
+  // The paths are rebuilt for every frame, like the paths of a DisplayList.
+  auto add_paths = [&prepass]() {
+    std::vector<std::shared_ptr<Geometry>> geometries;
+    for (int i = 0; i < 32; i++) {
+      auto path = PathBuilder{}.AddCircle(Point(i * 10, 0), 5 + i).TakePath();
+      geometries.push_back(Geometry::MakeFillPath(path));
+      prepass.AddGeometry(geometries.back(), Matrix::MakeScale({1.1, 1.1, 1}));
+    }
+    return geometries;
+  };
+
+  auto first_frame = add_paths();
+  prepass.Run(tessellator);
+  EXPECT_EQ(tessellator.GetCacheStats().entry_count, 32u);
+  EXPECT_EQ(tessellator.GetCacheStats().hits, 0u);
+
+  auto second_frame = add_paths();
+  prepass.Run(tessellator);
+  EXPECT_EQ(tessellator.GetCacheStats().entry_count, 32u);
+  EXPECT_EQ(tessellator.GetCacheStats().hits, 32u);
+
+  // The results of the workers match the ones of the cached tessellator.
+  Tessellator uncached;
+  auto path = PathBuilder{}.AddCircle(Point(0, 0), 5).TakePath();
+  auto cached = tessellator.FindCachedConvex(path, 1.1);
+  ASSERT_TRUE(cached.has_value());
+  EXPECT_EQ(cached.value(),
+            uncached.TessellateConvex(
+                path, TessellationCache::QuantizeTolerance(1.1)));
+}
+
+}  // namespace testing
+}  // namespace impeller
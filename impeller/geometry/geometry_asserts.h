@@ -5,7 +5,10 @@
 #ifndef FLUTTER_IMPELLER_GEOMETRY_GEOMETRY_ASSERTS_H_
 #define FLUTTER_IMPELLER_GEOMETRY_GEOMETRY_ASSERTS_H_
 
+#include <algorithm>
 #include <array>
+#include <cmath>
+#include <cstring>
 #include <iostream>
 
 #include "gtest/gtest.h"
@@ -153,6 +156,36 @@ inline ::testing::AssertionResult ColorsNear(std::vector<impeller::Color> a,
   return ::testing::AssertionSuccess();
 }
 
+/// Whether the scalars of two points, rects or matrices have the same bits,
+/// which unlike `==` also tells NaNs and the signs of zeros apart. Compilers
+/// may fuse the multiplies and adds of scalar code for targets with FMA
+/// instructions, so for those the scalars only have to be close.
+template <class T>
+inline ::testing::AssertionResult ScalarsIdentical(const T& a, const T& b) {
+  constexpr size_t kCount = sizeof(T) / sizeof(impeller::Scalar);
+  static_assert(sizeof(T) == kCount * sizeof(impeller::Scalar));
+  impeller::Scalar a_scalars[kCount];
+  impeller::Scalar b_scalars[kCount];
+  std::memcpy(a_scalars, &a, sizeof(T));
+  std::memcpy(b_scalars, &b, sizeof(T));
+  for (size_t i = 0; i < kCount; i++) {
+    auto x = a_scalars[i];
+    auto y = b_scalars[i];
+#if defined(__FMA__) || defined(__ARM_FEATURE_FMA)
+    auto same = (std::isnan(x) && std::isnan(y)) || x == y ||
+                std::abs(x - y) <= 1e-4f * std::max(1.0f, std::abs(x));
+#else
+    auto same = std::memcmp(&x, &y, sizeof(x)) == 0;
+#endif
+    if (!same) {
+      return ::testing::AssertionFailure() << "Scalar " << i
+                                           << " is not identical (" << x
+                                           << " " << y << ").";
+    }
+  }
+  return ::testing::AssertionSuccess();
+}
+
 #define ASSERT_MATRIX_NEAR(a, b) ASSERT_PRED2(&::MatrixNear, a, b)
 #define ASSERT_QUATERNION_NEAR(a, b) ASSERT_PRED2(&::QuaternionNear, a, b)
 #define ASSERT_RECT_NEAR(a, b) ASSERT_PRED2(&::RectNear, a, b)
@@ -2,6 +2,8 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <cmath>
+
 #include "flutter/benchmarking/benchmarking.h"
 
 #include "flutter/impeller/entity/solid_fill.vert.h"
@@ -41,6 +43,31 @@ class ImpellerBenchmarkAccessor {
         polyline, stroke_width, miter_limit, stroke_join, stroke_cap, scale,
         texture_origin, texture_size, effect_transform);
   }
+
+  static size_t ComputeButtBevelStrokeVertexCount(
+      const Path::Polyline& polyline) {
+    return StrokePathGeometry::ComputeButtBevelStrokeVertexCount(polyline);
+  }
+
+  static bool GenerateButtBevelStrokeVertices(
+      const Path::Polyline& polyline,
+      Scalar stroke_width,
+      Scalar scale,
+      SolidFillVertexShader::PerVertexData* vertices,
+      size_t vertex_count) {
+    return StrokePathGeometry::GenerateButtBevelStrokeVertices(
+        polyline, stroke_width, scale, vertices, vertex_count);
+  }
+
+  static Path::Polyline CreateUncachedPolyline(
+      const Path& path,
+      Scalar scale,
+      Path::Polyline::PointBufferPtr point_buffer,
+      Path::Polyline::ReclaimPointBufferCallback reclaim) {
+    Path::Polyline polyline(std::move(point_buffer), std::move(reclaim));
+    path.AppendPolyline(scale, polyline);
+    return polyline;
+  }
 };
 
 namespace {
@@ -51,6 +78,8 @@ Path CreateCubic(bool closed);
 Path CreateQuadratic(bool closed);
 /// Create a rounded rect.
 Path CreateRRect();
+/// A line chart with thousands of short line segments.
+Path CreateChart();
 }  // namespace
 
 static Tessellator tess;
@@ -97,6 +126,33 @@ static void BM_Polyline(benchmark::State& state, Args&&... args) {
   state.counters["TotalPointCount"] = point_count;
 }
 
+// Flattens a path at the slowly growing scales of a pinch zoom, with or
+// without the polylines that the path caches for power of two scales.
+static void BM_PolylineZoom(benchmark::State& state, bool cached) {
+  auto path = CreateCubic(true);
+  auto points = std::make_unique<std::vector<Point>>();
+  points->reserve(2048);
+  auto reclaim = [&points](Path::Polyline::PointBufferPtr reclaimed) {
+    points = std::move(reclaimed);
+  };
+
+  size_t frame = 0u;
+  size_t point_count = 0u;
+  for (auto _ : state) {
+    // Zooms from 1x to 4x over 300 frames.
+    Scalar scale = 1.0f + (frame++ % 300) / 100.0f;
+    // Clang-tidy doesn't know that the points get moved back before
+    // getting moved again in this loop.
+    // NOLINTNEXTLINE(clang-analyzer-cplusplus.Move)
+    auto polyline = cached ? path.CreatePolyline(scale, std::move(points),
+                                                 reclaim)
+                           : ImpellerBenchmarkAccessor::CreateUncachedPolyline(
+                                 path, scale, std::move(points), reclaim);
+    point_count += polyline.points->size();
+  }
+  state.counters["TotalPointCount"] = point_count;
+}
+
 enum class UVMode {
   kNoUV,
   kUVRect,
@@ -147,6 +203,39 @@ static void BM_StrokePolyline(benchmark::State& state, Args&&... args) {
   state.counters["TotalPointCount"] = point_count;
 }
 
+// Strokes a polyline with butt caps and bevel joins straight into memory
+// that is reused across iterations, as |StrokePathGeometry| does with the
+// memory of the host buffer.
+static void BM_StrokePolylineToBuffer(benchmark::State& state, Path path) {
+  const Scalar stroke_width = 5.0f;
+  const Scalar scale = 1.0f;
+
+  auto points = std::make_unique<std::vector<Point>>();
+  points->reserve(2048);
+  auto polyline =
+      path.CreatePolyline(1.0f, std::move(points),
+                          [&points](Path::Polyline::PointBufferPtr reclaimed) {
+                            points = std::move(reclaimed);
+                          });
+
+  std::vector<SolidFillVertexShader::PerVertexData> buffer;
+  size_t point_count = 0u;
+  size_t single_point_count = 0u;
+  for (auto _ : state) {
+    single_point_count =
+        ImpellerBenchmarkAccessor::ComputeButtBevelStrokeVertexCount(polyline);
+    if (buffer.size() < single_point_count) {
+      buffer.resize(single_point_count);
+    }
+    bool filled = ImpellerBenchmarkAccessor::GenerateButtBevelStrokeVertices(
+        polyline, stroke_width, scale, buffer.data(), single_point_count);
+    benchmark::DoNotOptimize(filled);
+    point_count += single_point_count;
+  }
+  state.counters["SinglePointCount"] = single_point_count;
+  state.counters["TotalPointCount"] = point_count;
+}
+
 template <class... Args>
 static void BM_Convex(benchmark::State& state, Args&&... args) {
   auto args_tuple = std::make_tuple(std::move(args)...);
@@ -165,6 +254,112 @@ static void BM_Convex(benchmark::State& state, Args&&... args) {
   state.counters["TotalPointCount"] = point_count;
 }
 
+// Fills the same set of rounded rects on every iteration, as a frame that
+// redraws the same icons and shapes does, with the tessellation cache of
+// the tessellator enabled or not.
+static void BM_ConvexFrame(benchmark::State& state, bool cached) {
+  std::vector<Path> paths;
+  for (int i = 0; i < state.range(0); i++) {
+    Scalar x = (i % 40) * 50;
+    Scalar y = (i / 40) * 50;
+    paths.push_back(
+        PathBuilder{}
+            .AddRoundedRect(Rect::MakeXYWH(x, y, 40, 40), 4 + i % 8)
+            .TakePath());
+  }
+
+  Tessellator tessellator;
+  tessellator.SetCacheMaxBytes(cached ? 16 * 1024 * 1024 : 0);
+  size_t point_count = 0u;
+  for (auto _ : state) {
+    for (const auto& path : paths) {
+      auto points = tessellator.TessellateConvex(path, 1.0f);
+      point_count += points.size();
+    }
+  }
+  state.counters["TotalPointCount"] = point_count;
+  state.counters["CacheHits"] = tessellator.GetCacheStats().hits;
+  state.counters["CacheMisses"] = tessellator.GetCacheStats().misses;
+}
+
+static Matrix CreateBenchmarkTransform(bool perspective) {
+  auto transform = Matrix::MakeTranslation({100, 200, 0}) *
+                   Matrix::MakeRotationZ(Degrees(30)) *
+                   Matrix::MakeScale({1.5, 2.5, 1});
+  if (perspective) {
+    transform = Matrix::MakePerspective(Degrees(60), 1.0f, 1, 100) *
+                Matrix::MakeTranslation({0, 0, 10}) *
+                Matrix::MakeRotationY(Degrees(20)) * transform;
+  }
+  return transform;
+}
+
+static void BM_TransformPoints(benchmark::State& state,
+                               bool batch,
+                               bool perspective) {
+  auto transform = CreateBenchmarkTransform(perspective);
+  std::vector<Point> points;
+  for (int i = 0; i < state.range(0); i++) {
+    points.emplace_back(i % 97 * 3.5f, i / 97 * 2.25f);
+  }
+  std::vector<Point> transformed(points.size());
+
+  for (auto _ : state) {
+    if (batch) {
+      transform.TransformPoints(transformed.data(), points.data(),
+                                points.size());
+    } else {
+      for (size_t i = 0; i < points.size(); i++) {
+        transformed[i] = transform * points[i];
+      }
+    }
+    benchmark::DoNotOptimize(transformed.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * points.size());
+}
+
+static void BM_TransformRects(benchmark::State& state,
+                              bool batch,
+                              bool perspective) {
+  auto transform = CreateBenchmarkTransform(perspective);
+  std::vector<Rect> rects;
+  for (int i = 0; i < state.range(0); i++) {
+    rects.push_back(Rect::MakeXYWH(i % 97 * 3.5f, i / 97 * 2.25f, 20, 10));
+  }
+  std::vector<Rect> transformed(rects.size());
+
+  for (auto _ : state) {
+    if (batch) {
+      transform.TransformRects(transformed.data(), rects.data(), rects.size());
+    } else {
+      for (size_t i = 0; i < rects.size(); i++) {
+        transformed[i] = rects[i].TransformBounds(transform);
+      }
+    }
+    benchmark::DoNotOptimize(transformed.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * rects.size());
+}
+
+// Concatenates a chain of transforms, as rendering a deeply nested display
+// list does.
+static void BM_MatrixMultiply(benchmark::State& state, bool simd) {
+  auto step = Matrix::MakeTranslation({1, 2, 0}) *
+              Matrix::MakeRotationZ(Degrees(1));
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(step);
+    Matrix result;
+    for (int i = 0; i < state.range(0); i++) {
+      result = simd ? result * step : result.Multiply(step);
+    }
+    benchmark::DoNotOptimize(result);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
 #define MAKE_STROKE_BENCHMARK_CAPTURE(path, cap, join, closed, uvname, uvtype) \
   BENCHMARK_CAPTURE(BM_StrokePolyline, stroke_##path##_##cap##_##join##uvname, \
                     Create##path(closed), Cap::k##cap, Join::k##join, uvtype)
@@ -192,6 +387,12 @@ BENCHMARK_CAPTURE(BM_Polyline,
                   CreateCubic(false),
                   true);
 MAKE_STROKE_BENCHMARK_CAPTURE_UVS(Cubic);
+BENCHMARK_CAPTURE(BM_StrokePolylineToBuffer,
+                  stroke_Cubic_Butt_Bevel,
+                  CreateCubic(false));
+
+BENCHMARK_CAPTURE(BM_PolylineZoom, cubic_uncached, false);
+BENCHMARK_CAPTURE(BM_PolylineZoom, cubic_cached, true);
 
 BENCHMARK_CAPTURE(BM_Polyline, quad_polyline, CreateQuadratic(true), false);
 BENCHMARK_CAPTURE(BM_Polyline, quad_polyline_tess, CreateQuadratic(true), true);
@@ -204,11 +405,44 @@ BENCHMARK_CAPTURE(BM_Polyline,
                   CreateQuadratic(false),
                   true);
 MAKE_STROKE_BENCHMARK_CAPTURE_UVS(Quadratic);
+BENCHMARK_CAPTURE(BM_StrokePolylineToBuffer,
+                  stroke_Quadratic_Butt_Bevel,
+                  CreateQuadratic(false));
 
 BENCHMARK_CAPTURE(BM_Convex, rrect_convex, CreateRRect(), true);
 MAKE_STROKE_BENCHMARK_CAPTURE(RRect, Butt, Bevel, , , UVMode::kNoUV);
 MAKE_STROKE_BENCHMARK_CAPTURE(RRect, Butt, Bevel, , _uv, UVMode::kUVRectTx);
 MAKE_STROKE_BENCHMARK_CAPTURE(RRect, Butt, Bevel, , _uvNoTx, UVMode::kUVRect);
+BENCHMARK_CAPTURE(BM_StrokePolylineToBuffer,
+                  stroke_RRect_Butt_Bevel,
+                  CreateRRect());
+
+MAKE_STROKE_BENCHMARK_CAPTURE(Chart, Butt, Bevel, , , UVMode::kNoUV);
+BENCHMARK_CAPTURE(BM_StrokePolylineToBuffer,
+                  stroke_Chart_Butt_Bevel,
+                  CreateChart());
+
+BENCHMARK_CAPTURE(BM_ConvexFrame, uncached, false)
+    ->Arg(1000)
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_CAPTURE(BM_ConvexFrame, cached, true)
+    ->Arg(1000)
+    ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_CAPTURE(BM_TransformPoints, scalar, false, false)->Arg(4096);
+BENCHMARK_CAPTURE(BM_TransformPoints, batch, true, false)->Arg(4096);
+BENCHMARK_CAPTURE(BM_TransformPoints, scalar_perspective, false, true)
+    ->Arg(4096);
+BENCHMARK_CAPTURE(BM_TransformPoints, batch_perspective, true, true)
+    ->Arg(4096);
+BENCHMARK_CAPTURE(BM_TransformRects, scalar, false, false)->Arg(4096);
+BENCHMARK_CAPTURE(BM_TransformRects, batch, true, false)->Arg(4096);
+BENCHMARK_CAPTURE(BM_TransformRects, scalar_perspective, false, true)
+    ->Arg(4096);
+BENCHMARK_CAPTURE(BM_TransformRects, batch_perspective, true, true)
+    ->Arg(4096);
+BENCHMARK_CAPTURE(BM_MatrixMultiply, scalar, false)->Arg(64);
+BENCHMARK_CAPTURE(BM_MatrixMultiply, simd, true)->Arg(64);
 
 namespace {
 
@@ -218,6 +452,17 @@ Path CreateRRect() {
       .TakePath();
 }
 
+Path CreateChart() {
+  PathBuilder builder;
+  builder.MoveTo({0, 200});
+  for (int i = 1; i < 4000; i++) {
+    // A noisy signal, like a plot of sampled data.
+    Scalar y = 200 + 100 * std::sin(i * 0.01f) + 20 * std::sin(i * 0.7f);
+    builder.LineTo({i * 0.25f, y});
+  }
+  return builder.TakePath();
+}
+
 Path CreateCubic(bool closed) {
   auto builder = PathBuilder{};
   builder  //
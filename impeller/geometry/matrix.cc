@@ -7,6 +7,12 @@
 #include <climits>
 #include <sstream>
 
+#include "impeller/geometry/rect.h"
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#endif
+
 namespace impeller {
 
 Matrix::Matrix(const MatrixDecomposition& d) : Matrix() {
@@ -398,4 +404,199 @@ uint64_t MatrixDecomposition::GetComponentsMask() const {
   return mask;
 }
 
+// The SIMD kernels below perform the same multiplies and adds in the same
+// order as `Matrix::operator*(const Point&)` so that the results are
+// identical, including the `if (w) { w = 1 / w; }` of the perspective divide.
+
+void Matrix::TransformPoints(Point* dst, const Point* src, size_t count) const {
+  static_assert(sizeof(Point) == 2 * sizeof(Scalar));
+  const Scalar* in = reinterpret_cast<const Scalar*>(src);
+  Scalar* out = reinterpret_cast<Scalar*>(dst);
+  size_t i = 0;
+
+#if defined(__AVX__)
+  {
+    // Four points per iteration, with the x and y of each point duplicated
+    // across the lanes of its result.
+    const __m256 x_col = _mm256_setr_ps(m[0], m[1], m[0], m[1],  //
+                                        m[0], m[1], m[0], m[1]);
+    const __m256 y_col = _mm256_setr_ps(m[4], m[5], m[4], m[5],  //
+                                        m[4], m[5], m[4], m[5]);
+    const __m256 t_col = _mm256_setr_ps(m[12], m[13], m[12], m[13],  //
+                                        m[12], m[13], m[12], m[13]);
+    const __m256 x_w = _mm256_set1_ps(m[3]);
+    const __m256 y_w = _mm256_set1_ps(m[7]);
+    const __m256 t_w = _mm256_set1_ps(m[15]);
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 one = _mm256_set1_ps(1.0f);
+    for (; i + 4 <= count; i += 4) {
+      __m256 xy = _mm256_loadu_ps(in + i * 2);
+      __m256 x = _mm256_shuffle_ps(xy, xy, _MM_SHUFFLE(2, 2, 0, 0));
+      __m256 y = _mm256_shuffle_ps(xy, xy, _MM_SHUFFLE(3, 3, 1, 1));
+      __m256 w = _mm256_add_ps(
+          _mm256_add_ps(_mm256_mul_ps(x, x_w), _mm256_mul_ps(y, y_w)), t_w);
+      __m256 result = _mm256_add_ps(
+          _mm256_add_ps(_mm256_mul_ps(x, x_col), _mm256_mul_ps(y, y_col)),
+          t_col);
+      // NaN compares as not equal to zero, as it is truthy in the scalar code.
+      __m256 nonzero = _mm256_cmp_ps(w, zero, _CMP_NEQ_UQ);
+      w = _mm256_blendv_ps(w, _mm256_div_ps(one, w), nonzero);
+      _mm256_storeu_ps(out + i * 2, _mm256_mul_ps(result, w));
+    }
+  }
+#endif  // defined(__AVX__)
+
+#if defined(__SSE2__)
+  {
+    // Two points per iteration, laid out as in the AVX kernel.
+    const __m128 x_col = _mm_setr_ps(m[0], m[1], m[0], m[1]);
+    const __m128 y_col = _mm_setr_ps(m[4], m[5], m[4], m[5]);
+    const __m128 t_col = _mm_setr_ps(m[12], m[13], m[12], m[13]);
+    const __m128 x_w = _mm_set1_ps(m[3]);
+    const __m128 y_w = _mm_set1_ps(m[7]);
+    const __m128 t_w = _mm_set1_ps(m[15]);
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.0f);
+    for (; i + 2 <= count; i += 2) {
+      __m128 xy = _mm_loadu_ps(in + i * 2);
+      __m128 x = _mm_shuffle_ps(xy, xy, _MM_SHUFFLE(2, 2, 0, 0));
+      __m128 y = _mm_shuffle_ps(xy, xy, _MM_SHUFFLE(3, 3, 1, 1));
+      __m128 w =
+          _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x_w), _mm_mul_ps(y, y_w)), t_w);
+      __m128 result = _mm_add_ps(
+          _mm_add_ps(_mm_mul_ps(x, x_col), _mm_mul_ps(y, y_col)), t_col);
+      __m128 nonzero = _mm_cmpneq_ps(w, zero);
+      w = _mm_or_ps(_mm_and_ps(nonzero, _mm_div_ps(one, w)),
+                    _mm_andnot_ps(nonzero, w));
+      _mm_storeu_ps(out + i * 2, _mm_mul_ps(result, w));
+    }
+  }
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+  {
+    const float32x4_t one = vdupq_n_f32(1.0f);
+    for (; i + 4 <= count; i += 4) {
+      float32x4x2_t xy = vld2q_f32(in + i * 2);
+      float32x4_t x = xy.val[0];
+      float32x4_t y = xy.val[1];
+      float32x4_t w = vaddq_f32(
+          vaddq_f32(vmulq_n_f32(x, m[3]), vmulq_n_f32(y, m[7])),
+          vdupq_n_f32(m[15]));
+      w = vbslq_f32(vceqzq_f32(w), w, vdivq_f32(one, w));
+      xy.val[0] = vmulq_f32(
+          vaddq_f32(vaddq_f32(vmulq_n_f32(x, m[0]), vmulq_n_f32(y, m[4])),
+                    vdupq_n_f32(m[12])),
+          w);
+      xy.val[1] = vmulq_f32(
+          vaddq_f32(vaddq_f32(vmulq_n_f32(x, m[1]), vmulq_n_f32(y, m[5])),
+                    vdupq_n_f32(m[13])),
+          w);
+      vst2q_f32(out + i * 2, xy);
+    }
+  }
+#endif
+
+  for (; i < count; i++) {
+    dst[i] = *this * src[i];
+  }
+}
+
+void Matrix::TransformRects(Rect* dst, const Rect* src, size_t count) const {
+#if defined(__SSE2__)
+  const __m128 x_x = _mm_set1_ps(m[0]);
+  const __m128 x_y = _mm_set1_ps(m[1]);
+  const __m128 x_w = _mm_set1_ps(m[3]);
+  const __m128 y_x = _mm_set1_ps(m[4]);
+  const __m128 y_y = _mm_set1_ps(m[5]);
+  const __m128 y_w = _mm_set1_ps(m[7]);
+  const __m128 t_x = _mm_set1_ps(m[12]);
+  const __m128 t_y = _mm_set1_ps(m[13]);
+  const __m128 t_w = _mm_set1_ps(m[15]);
+  const __m128 zero = _mm_setzero_ps();
+  const __m128 one = _mm_set1_ps(1.0f);
+  for (size_t i = 0; i < count; i++) {
+    const Rect& rect = src[i];
+    if (rect.IsEmpty()) {
+      dst[i] = {};
+      continue;
+    }
+    // The corners in the order of |Rect::GetPoints|.
+    __m128 x = _mm_setr_ps(rect.GetLeft(), rect.GetRight(),  //
+                           rect.GetLeft(), rect.GetRight());
+    __m128 y = _mm_setr_ps(rect.GetTop(), rect.GetTop(),  //
+                           rect.GetBottom(), rect.GetBottom());
+    __m128 w =
+        _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x_w), _mm_mul_ps(y, y_w)), t_w);
+    __m128 nonzero = _mm_cmpneq_ps(w, zero);
+    w = _mm_or_ps(_mm_and_ps(nonzero, _mm_div_ps(one, w)),
+                  _mm_andnot_ps(nonzero, w));
+    __m128 tx = _mm_mul_ps(
+        _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x_x), _mm_mul_ps(y, y_x)), t_x),
+        w);
+    __m128 ty = _mm_mul_ps(
+        _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x_y), _mm_mul_ps(y, y_y)), t_y),
+        w);
+
+    // Reduce the corners one at a time, as |Rect::MakePointBounds| does.
+    // |_mm_min_ps(a, b)| is `a < b ? a : b`, which matches
+    // `std::min(b, a)` for NaN and signed zeros too.
+    __m128 lo = _mm_unpacklo_ps(tx, ty);
+    __m128 hi = _mm_unpackhi_ps(tx, ty);
+    __m128 p1 = _mm_movehl_ps(lo, lo);
+    __m128 p2 = _mm_movelh_ps(hi, hi);
+    __m128 p3 = _mm_movehl_ps(hi, hi);
+    __m128 min = _mm_movelh_ps(lo, lo);
+    __m128 max = min;
+    min = _mm_min_ps(p1, min);
+    max = _mm_max_ps(p1, max);
+    min = _mm_min_ps(p2, min);
+    max = _mm_max_ps(p2, max);
+    min = _mm_min_ps(p3, min);
+    max = _mm_max_ps(p3, max);
+
+    Scalar ltrb[4];
+    _mm_storeu_ps(ltrb, _mm_movelh_ps(min, max));
+    dst[i] = Rect::MakeLTRB(ltrb[0], ltrb[1], ltrb[2], ltrb[3]);
+  }
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+  const float32x4_t one = vdupq_n_f32(1.0f);
+  for (size_t i = 0; i < count; i++) {
+    const Rect& rect = src[i];
+    if (rect.IsEmpty()) {
+      dst[i] = {};
+      continue;
+    }
+    // The corners in the order of |Rect::GetPoints|.
+    const Scalar xs[4] = {rect.GetLeft(), rect.GetRight(),  //
+                          rect.GetLeft(), rect.GetRight()};
+    const Scalar ys[4] = {rect.GetTop(), rect.GetTop(),  //
+                          rect.GetBottom(), rect.GetBottom()};
+    float32x4_t x = vld1q_f32(xs);
+    float32x4_t y = vld1q_f32(ys);
+    float32x4_t w =
+        vaddq_f32(vaddq_f32(vmulq_n_f32(x, m[3]), vmulq_n_f32(y, m[7])),
+                  vdupq_n_f32(m[15]));
+    w = vbslq_f32(vceqzq_f32(w), w, vdivq_f32(one, w));
+    float32x4x2_t corners;
+    corners.val[0] = vmulq_f32(
+        vaddq_f32(vaddq_f32(vmulq_n_f32(x, m[0]), vmulq_n_f32(y, m[4])),
+                  vdupq_n_f32(m[12])),
+        w);
+    corners.val[1] = vmulq_f32(
+        vaddq_f32(vaddq_f32(vmulq_n_f32(x, m[1]), vmulq_n_f32(y, m[5])),
+                  vdupq_n_f32(m[13])),
+        w);
+
+    // NEON's min and max don't treat NaN like |std::min| and |std::max|.
+    Point points[4];
+    vst2q_f32(reinterpret_cast<Scalar*>(points), corners);
+    dst[i] = Rect::MakePointBounds(std::begin(points), std::end(points))
+                 .value();
+  }
+#else
+  for (size_t i = 0; i < count; i++) {
+    dst[i] = src[i].TransformBounds(*this);
+  }
+#endif
+}
+
 }  // namespace impeller
@@ -20,8 +20,17 @@
 #include "impeller/geometry/size.h"
 #include "impeller/geometry/vector.h"
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
 namespace impeller {
 
+template <class T>
+struct TRect;
+
 //------------------------------------------------------------------------------
 /// @brief      A 4x4 matrix using column-major storage.
 ///
@@ -395,7 +404,41 @@ struct Matrix {
 
   Matrix operator-(const Vector3& t) const { return Translate(-t); }
 
-  Matrix operator*(const Matrix& m) const { return Multiply(m); }
+  /// The same as |Multiply|, with the same results, but uses SIMD
+  /// instructions where available.
+  Matrix operator*(const Matrix& o) const {
+#if defined(__SSE2__)
+    const __m128 c0 = _mm_loadu_ps(&m[0]);
+    const __m128 c1 = _mm_loadu_ps(&m[4]);
+    const __m128 c2 = _mm_loadu_ps(&m[8]);
+    const __m128 c3 = _mm_loadu_ps(&m[12]);
+    Matrix result;
+    for (int i = 0; i < 16; i += 4) {
+      __m128 column = _mm_mul_ps(c0, _mm_set1_ps(o.m[i]));
+      column = _mm_add_ps(column, _mm_mul_ps(c1, _mm_set1_ps(o.m[i + 1])));
+      column = _mm_add_ps(column, _mm_mul_ps(c2, _mm_set1_ps(o.m[i + 2])));
+      column = _mm_add_ps(column, _mm_mul_ps(c3, _mm_set1_ps(o.m[i + 3])));
+      _mm_storeu_ps(&result.m[i], column);
+    }
+    return result;
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+    const float32x4_t c0 = vld1q_f32(&m[0]);
+    const float32x4_t c1 = vld1q_f32(&m[4]);
+    const float32x4_t c2 = vld1q_f32(&m[8]);
+    const float32x4_t c3 = vld1q_f32(&m[12]);
+    Matrix result;
+    for (int i = 0; i < 16; i += 4) {
+      float32x4_t column = vmulq_n_f32(c0, o.m[i]);
+      column = vaddq_f32(column, vmulq_n_f32(c1, o.m[i + 1]));
+      column = vaddq_f32(column, vmulq_n_f32(c2, o.m[i + 2]));
+      column = vaddq_f32(column, vmulq_n_f32(c3, o.m[i + 3]));
+      vst1q_f32(&result.m[i], column);
+    }
+    return result;
+#else
+    return Multiply(o);
+#endif
+  }
 
   Matrix operator+(const Matrix& m) const;
 
@@ -458,6 +501,27 @@ struct Matrix {
     };
   }
 
+  //----------------------------------------------------------------------------
+  /// @brief      Transforms `count` points from `src` into `dst`, which may be
+  ///             the same array, using SIMD instructions where available.
+  ///
+  ///             The results are the same as transforming each point with
+  ///             `*this * point`.
+  ///
+  void TransformPoints(Point* dst, const Point* src, size_t count) const;
+
+  //----------------------------------------------------------------------------
+  /// @brief      Transforms the bounds of `count` rects from `src` into `dst`,
+  ///             which may be the same array, using SIMD instructions where
+  ///             available.
+  ///
+  ///             The results are the same as `rect.TransformBounds(*this)`
+  ///             for each rect.
+  ///
+  void TransformRects(TRect<Scalar>* dst,
+                      const TRect<Scalar>* src,
+                      size_t count) const;
+
   template <class T>
   static constexpr Matrix MakeOrthographic(TSize<T> size) {
     // Per assumptions about NDC documented above.
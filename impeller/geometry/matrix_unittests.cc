@@ -2,6 +2,9 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include <limits>
+#include <vector>
+
 #include "gtest/gtest.h"
 
 #include "flutter/impeller/geometry/matrix.h"
@@ -24,5 +27,100 @@ TEST(MatrixTest, Multiply) {
                                         11.0, 21.0, 0.0, 1.0)));
 }
 
+namespace {
+
+std::vector<Matrix> CreateTestMatrices() {
+  Matrix perspective = Matrix::MakePerspective(Degrees(60), 1.5f, 1, 100) *
+                       Matrix::MakeTranslation({0, 0, 10}) *
+                       Matrix::MakeRotationY(Degrees(20));
+  // Maps points with x == 0 to w == 0, which aren't divided by.
+  Matrix zero_w(2, 0, 0, 1,  //
+                0, 3, 0, 0,  //
+                0, 0, 1, 0,  //
+                5, 7, 0, 0);
+  return {
+      Matrix(),
+      Matrix::MakeTranslation({10.5, -20.25, 0}),
+      Matrix::MakeTranslation({100, 200, 0}) *
+          Matrix::MakeRotationZ(Degrees(33)) *
+          Matrix::MakeScale({1.7, -0.3, 1}),
+      Matrix::MakeSkew(0.3, -0.7) * Matrix::MakeScale({1e-3, 1e3, 1}),
+      perspective,
+      zero_w,
+  };
+}
+
+std::vector<Point> CreateTestPoints() {
+  Scalar inf = std::numeric_limits<Scalar>::infinity();
+  Scalar nan = std::numeric_limits<Scalar>::quiet_NaN();
+  std::vector<Point> points = {
+      {0, 0},   {-0.0f, 1}, {0, -0.0f},   {1e30, -1e30},
+      {inf, 1}, {2, -inf},  {nan, 3},     {4, nan},
+      {1, 1},   {-1, -1},   {0.1f, 0.7f}, {-123.456f, 789.012f},
+  };
+  for (int i = 0; i < 37; i++) {
+    points.emplace_back(i * 13.7f - 250.0f, i * -7.3f + 125.0f);
+  }
+  return points;
+}
+
+}  // namespace
+
+TEST(MatrixTest, MultiplyIsIdenticalToScalarMultiply) {
+  auto matrices = CreateTestMatrices();
+  for (const auto& a : matrices) {
+    for (const auto& b : matrices) {
+      EXPECT_TRUE(ScalarsIdentical(a * b, a.Multiply(b)));
+    }
+  }
+}
+
+TEST(MatrixTest, TransformPointsIsIdenticalToScalarTransform) {
+  auto points = CreateTestPoints();
+  for (const auto& matrix : CreateTestMatrices()) {
+    // Every count, to cover the tails of each SIMD kernel.
+    for (size_t count = 0; count <= points.size(); count++) {
+      std::vector<Point> transformed(count);
+      matrix.TransformPoints(transformed.data(), points.data(), count);
+      for (size_t i = 0; i < count; i++) {
+        EXPECT_TRUE(ScalarsIdentical(transformed[i], matrix * points[i]))
+            << "point " << i << " of " << count << " with " << matrix;
+      }
+    }
+  }
+}
+
+TEST(MatrixTest, TransformPointsInPlace) {
+  auto matrix = Matrix::MakeTranslation({10, 20, 0}) *
+                Matrix::MakeScale({2, 3, 1});
+  std::vector<Point> points = {{1, 1}, {2, 2}, {3, 3}, {4, 4}, {5, 5}};
+  matrix.TransformPoints(points.data(), points.data(), points.size());
+  EXPECT_POINT_NEAR(points[0], Point(12, 23));
+  EXPECT_POINT_NEAR(points[1], Point(14, 26));
+  EXPECT_POINT_NEAR(points[2], Point(16, 29));
+  EXPECT_POINT_NEAR(points[3], Point(18, 32));
+  EXPECT_POINT_NEAR(points[4], Point(20, 35));
+}
+
+TEST(MatrixTest, TransformRectsIsIdenticalToTransformBounds) {
+  Scalar nan = std::numeric_limits<Scalar>::quiet_NaN();
+  std::vector<Rect> rects = {
+      Rect::MakeLTRB(0, 0, 100, 100),    Rect::MakeLTRB(-0.0f, -0.0f, 1, 1),
+      Rect::MakeLTRB(-50, 20, 30, 40),   Rect::MakeLTRB(1e-20f, 0, 1e20f, 1),
+      Rect::MakeLTRB(10, 10, 10, 20),    Rect::MakeLTRB(30, 30, 20, 20),
+      Rect::MakeLTRB(nan, 0, 10, 10),    Rect::MakeLTRB(0, 0, 1e30f, 1e30f),
+      Rect::MakeXYWH(-3.5, 7.25, 12, 9),
+  };
+  for (const auto& matrix : CreateTestMatrices()) {
+    std::vector<Rect> transformed(rects.size());
+    matrix.TransformRects(transformed.data(), rects.data(), rects.size());
+    for (size_t i = 0; i < rects.size(); i++) {
+      EXPECT_TRUE(
+          ScalarsIdentical(transformed[i], rects[i].TransformBounds(matrix)))
+          << "rect " << i << " with " << matrix;
+    }
+  }
+}
+
 }  // namespace testing
 }  // namespace impeller
@@ -4,9 +4,13 @@
 
 #include "impeller/geometry/path.h"
 
+#include <algorithm>
+#include <cmath>
 #include <optional>
+#include <string_view>
 #include <variant>
 
+#include "flutter/fml/hash_combine.h"
 #include "flutter/fml/logging.h"
 #include "impeller/geometry/path_component.h"
 #include "impeller/geometry/point.h"
@@ -60,6 +64,40 @@ bool Path::IsEmpty() const {
   return data_->points.empty();
 }
 
+size_t Path::GetHash() const {
+  const Data& data = *data_;
+  size_t hash = fml::HashCombine(data.fill, data.components.size(),
+                                 data.contours.size());
+  for (const auto& component : data.components) {
+    fml::HashCombineSeed(hash, component.type, component.index);
+  }
+  for (const auto& contour : data.contours) {
+    fml::HashCombineSeed(hash, contour.destination.x, contour.destination.y,
+                         contour.is_closed);
+  }
+  // The points are most of the data, so hash their bytes all at once.
+  std::string_view points(reinterpret_cast<const char*>(data.points.data()),
+                          data.points.size() * sizeof(Point));
+  fml::HashCombineSeed(hash, points);
+  return hash;
+}
+
+bool Path::operator==(const Path& other) const {
+  if (data_ == other.data_) {
+    return true;
+  }
+  const Data& a = *data_;
+  const Data& b = *other.data_;
+  return a.fill == b.fill && a.convexity == b.convexity &&
+         a.points == b.points && a.contours == b.contours &&
+         std::equal(a.components.begin(), a.components.end(),
+                    b.components.begin(), b.components.end(),
+                    [](const ComponentIndexPair& a,
+                       const ComponentIndexPair& b) {
+                      return a.type == b.type && a.index == b.index;
+                    });
+}
+
 void Path::EnumerateComponents(
     const Applier<LinearPathComponent>& linear_applier,
     const Applier<QuadraticPathComponent>& quad_applier,
@@ -195,12 +233,111 @@ Path::Polyline::~Polyline() {
   }
 }
 
+// The most scales that the polylines of a path are cached for.
+static constexpr size_t kMaxPolylineCacheEntries = 3;
+
+// The scale exponents that are cached, which bound the number of points a
+// cached polyline can have.
+static constexpr int kMinPolylineCacheScaleExponent = -16;
+static constexpr int kMaxPolylineCacheScaleExponent = 16;
+
+Path::PolylineCache::PolylineCache() = default;
+
+Path::PolylineCache::PolylineCache(const PolylineCache& other) {}
+
+Path::PolylineCache::PolylineCache(PolylineCache&& other) {}
+
+Path::PolylineCache::~PolylineCache() = default;
+
+std::optional<int> Path::PolylineCache::GetScaleExponent(Scalar scale) {
+  if (!(scale > 0) || !std::isfinite(scale)) {
+    return std::nullopt;
+  }
+  // scale is fraction * 2^exponent, with the fraction in [0.5, 1).
+  int exponent;
+  Scalar fraction = std::frexp(scale, &exponent);
+  if (fraction == 0.5f) {
+    exponent--;
+  }
+  if (exponent < kMinPolylineCacheScaleExponent ||
+      exponent > kMaxPolylineCacheScaleExponent) {
+    return std::nullopt;
+  }
+  return exponent;
+}
+
+bool Path::PolylineCache::Find(int scale_exponent, Polyline& polyline) {
+  std::scoped_lock lock(mutex_);
+  auto best = entries_.end();
+  for (auto it = entries_.begin(); it != entries_.end(); ++it) {
+    if (it->scale_exponent >= scale_exponent &&
+        it->scale_exponent <= scale_exponent + 1 &&
+        (best == entries_.end() || it->scale_exponent < best->scale_exponent)) {
+      best = it;
+    }
+  }
+  if (best == entries_.end()) {
+    return false;
+  }
+  polyline.points->assign(best->points.begin(), best->points.end());
+  polyline.contours = best->contours;
+  std::rotate(entries_.begin(), best, best + 1);
+  return true;
+}
+
+void Path::PolylineCache::Insert(int scale_exponent, const Polyline& polyline) {
+  std::scoped_lock lock(mutex_);
+  auto it = std::find_if(entries_.begin(), entries_.end(),
+                         [scale_exponent](const Entry& entry) {
+                           return entry.scale_exponent == scale_exponent;
+                         });
+  if (it == entries_.end()) {
+    if (entries_.size() < kMaxPolylineCacheEntries) {
+      entries_.emplace_back();
+    }
+    // Reuses the storage of the least recently used entry when full.
+    it = entries_.end() - 1;
+  }
+  it->scale_exponent = scale_exponent;
+  it->points.assign(polyline.points->begin(), polyline.points->end());
+  it->contours = polyline.contours;
+  std::rotate(entries_.begin(), it, it + 1);
+}
+
 Path::Polyline Path::CreatePolyline(
     Scalar scale,
     Path::Polyline::PointBufferPtr point_buffer,
     Path::Polyline::ReclaimPointBufferCallback reclaim) const {
   Polyline polyline(std::move(point_buffer), std::move(reclaim));
 
+  // The polylines of paths without curves don't depend on the scale.
+  std::optional<int> scale_exponent;
+  if (HasCurves() && polyline.points->empty()) {
+    scale_exponent = PolylineCache::GetScaleExponent(scale);
+  }
+  if (!scale_exponent.has_value()) {
+    AppendPolyline(scale, polyline);
+    return polyline;
+  }
+
+  auto& cache = data_->polyline_cache;
+  if (cache.Find(scale_exponent.value(), polyline)) {
+    return polyline;
+  }
+  AppendPolyline(std::ldexp(1.0f, scale_exponent.value()), polyline);
+  cache.Insert(scale_exponent.value(), polyline);
+  return polyline;
+}
+
+bool Path::HasCurves() const {
+  return std::any_of(data_->components.begin(), data_->components.end(),
+                     [](const ComponentIndexPair& component) {
+                       return component.type == ComponentType::kQuadratic ||
+                              component.type == ComponentType::kCubic;
+                     });
+}
+
+void Path::AppendPolyline(Scalar scale, Polyline& polyline) const {
   auto& path_components = data_->components;
   auto& path_points = data_->points;
 
@@ -333,7 +470,6 @@ Path::Polyline Path::CreatePolyline(
     }
   }
   end_contour();
-  return polyline;
 }
 
 std::optional<Rect> Path::GetBoundingBox() const {
@@ -6,6 +6,7 @@
 #define FLUTTER_IMPELLER_GEOMETRY_PATH_H_
 
 #include <functional>
+#include <mutex>
 #include <optional>
 #include <tuple>
 #include <vector>
@@ -137,6 +138,15 @@ class Path {
 
   bool IsEmpty() const;
 
+  /// Returns a hash of the fill type, components and points of the path.
+  /// Equal paths have the same hash, except that points are hashed by their
+  /// bits and so 0 and -0 coordinates hash differently.
+  size_t GetHash() const;
+
+  /// Returns whether the paths have the same fill type, convexity,
+  /// components and points, even if they were built separately.
+  bool operator==(const Path& other) const;
+
   template <class T>
   using Applier = std::function<void(size_t index, const T& component)>;
   void EnumerateComponents(
@@ -162,6 +172,12 @@ class Path {
   /// It is suitable to use the max basis length of the matrix used to transform
   /// the path. If the provided scale is 0, curves will revert to straight
   /// lines.
+  ///
+  /// The curves are flattened for the next power of two scale at or above
+  /// the provided scale, and those flattenings are cached with the path. A
+  /// path drawn at slowly changing scales, such as while zooming, is then
+  /// only flattened again when the scale crosses a power of two. The cached
+  /// points are copied into `point_buffer`.
   Polyline CreatePolyline(
       Scalar scale,
       Polyline::PointBufferPtr point_buffer =
@@ -174,6 +190,7 @@ class Path {
 
  private:
   friend class PathBuilder;
+  friend class ImpellerBenchmarkAccessor;
 
   struct ComponentIndexPair {
     ComponentType type = ComponentType::kLinear;
@@ -185,6 +202,43 @@ class Path {
         : type(a_type), index(a_index) {}
   };
 
+  // The polylines of a path at power of two scales, most recently used
+  // first. The cache is shared by the copies of a path, which may be
+  // flattened on different threads, and is not copied with its |Data|.
+  class PolylineCache {
+   public:
+    PolylineCache();
+
+    PolylineCache(const PolylineCache& other);
+
+    PolylineCache(PolylineCache&& other);
+
+    ~PolylineCache();
+
+    // Returns the exponent of the power of two scale to flatten curves at
+    // for the given scale, or std::nullopt if the scale isn't cached.
+    static std::optional<int> GetScaleExponent(Scalar scale);
+
+    // Copies the cached polyline for the smallest scale that is at least
+    // 2^|scale_exponent|, if it isn't more than twice as large, into
+    // |polyline| and returns true.
+    bool Find(int scale_exponent, Polyline& polyline);
+
+    void Insert(int scale_exponent, const Polyline& polyline);
+
+   private:
+    struct Entry {
+      int scale_exponent;
+      std::vector<Point> points;
+      std::vector<PolylineContour> contours;
+    };
+
+    std::mutex mutex_;
+    std::vector<Entry> entries_;
+
+    PolylineCache& operator=(const PolylineCache&) = delete;
+  };
+
   // All of the data for the path is stored in this structure which is
   // held by a shared_ptr. Since they all share the structure, the
   // copy constructor for Path is very cheap and we don't need to deal
@@ -210,10 +264,16 @@ class Path {
     std::vector<ContourComponent> contours;
 
     std::optional<Rect> bounds;
+
+    mutable PolylineCache polyline_cache;
   };
 
   explicit Path(Data data);
 
+  bool HasCurves() const;
+
+  void AppendPolyline(Scalar scale, Polyline& polyline) const;
+
   std::shared_ptr<const Data> data_;
 };
 
@@ -229,6 +229,76 @@ TEST(PathTest, PolylineFailsWithNullptrBuffer) {
                             "");
 }
 
+namespace {
+
+Path CreateCurvedPath() {
+  return PathBuilder{}
+      .MoveTo({10, 10})
+      .CubicCurveTo({20, 100}, {100, 20}, {110, 110})
+      .QuadraticCurveTo({150, 0}, {200, 110})
+      .Close()
+      .TakePath();
+}
+
+std::vector<Point> CreatePolylinePoints(const Path& path, Scalar scale) {
+  return *path.CreatePolyline(scale).points;
+}
+
+}  // namespace
+
+TEST(PathTest, PolylineIsFlattenedForPowerOfTwoScales) {
+  // Separately built paths don't share their cached polylines.
+  EXPECT_EQ(CreatePolylinePoints(CreateCurvedPath(), 3.0f),
+            CreatePolylinePoints(CreateCurvedPath(), 4.0f));
+  EXPECT_EQ(CreatePolylinePoints(CreateCurvedPath(), 0.3f),
+            CreatePolylinePoints(CreateCurvedPath(), 0.5f));
+  EXPECT_LT(CreatePolylinePoints(CreateCurvedPath(), 1.0f).size(),
+            CreatePolylinePoints(CreateCurvedPath(), 16.0f).size());
+}
+
+TEST(PathTest, PolylineUsesNearestAdequateCachedScale) {
+  auto path = CreateCurvedPath();
+  auto points_4 = CreatePolylinePoints(path, 4.0f);
+  auto points_1 = CreatePolylinePoints(CreateCurvedPath(), 1.0f);
+  ASSERT_NE(points_4.size(), points_1.size());
+
+  // The polyline for up to twice the scale is used.
+  EXPECT_EQ(CreatePolylinePoints(path, 1.5f), points_4);
+  // But not one for more than twice the scale.
+  EXPECT_EQ(CreatePolylinePoints(path, 1.0f), points_1);
+  // Nor one for a smaller scale.
+  EXPECT_EQ(CreatePolylinePoints(path, 8.0f),
+            CreatePolylinePoints(CreateCurvedPath(), 8.0f));
+  // A scale of 0 isn't cached, and still turns the curves into lines.
+  EXPECT_EQ(CreatePolylinePoints(path, 0.0f),
+            CreatePolylinePoints(CreateCurvedPath(), 0.0f));
+}
+
+TEST(PathTest, CachedPolylineUsesProvidedPointBuffer) {
+  auto path = CreateCurvedPath();
+  // The first polyline is flattened, the second is copied from the cache.
+  for (int i = 0; i < 2; i++) {
+    auto point_buffer = std::make_unique<std::vector<Point>>();
+    auto point_buffer_address = point_buffer.get();
+    bool reclaimed = false;
+    {
+      auto polyline = path.CreatePolyline(
+          2.0f, std::move(point_buffer),
+          [&reclaimed, point_buffer_address](
+              Path::Polyline::PointBufferPtr point_buffer) {
+            EXPECT_EQ(point_buffer.get(), point_buffer_address);
+            EXPECT_TRUE(point_buffer->empty());
+            reclaimed = true;
+          });
+      EXPECT_EQ(polyline.points.get(), point_buffer_address);
+      EXPECT_FALSE(polyline.points->empty());
+      ASSERT_EQ(polyline.contours.size(), 1u);
+      EXPECT_EQ(polyline.contours[0].components.size(), 3u);
+    }
+    EXPECT_TRUE(reclaimed);
+  }
+}
+
 TEST(PathTest, PathShifting) {
   PathBuilder builder{};
   auto path =
@@ -0,0 +1,104 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "impeller/tessellator/tessellation_cache.h"
+
+#include <cmath>
+
+#include "flutter/fml/hash_combine.h"
+#include "flutter/fml/logging.h"
+
+namespace impeller {
+
+// Steps of the quantized tolerance per doubling.
+static constexpr Scalar kToleranceStepsPerOctave = 4;
+
+Scalar TessellationCache::QuantizeTolerance(Scalar tolerance) {
+  // Curves become straight lines for a tolerance of 0.
+  if (!(tolerance > 0) || !std::isfinite(tolerance)) {
+    return tolerance;
+  }
+  Scalar step = std::ceil(std::log2(tolerance) * kToleranceStepsPerOctave);
+  return std::exp2(step / kToleranceStepsPerOctave);
+}
+
+TessellationCache::Key::Key(const Path& path, Scalar tolerance, Type type)
+    : path(path),
+      path_hash(path.GetHash()),
+      tolerance(QuantizeTolerance(tolerance)),
+      type(type) {}
+
+bool TessellationCache::Key::operator==(const Key& other) const {
+  return path_hash == other.path_hash && tolerance == other.tolerance &&
+         type == other.type && path == other.path;
+}
+
+size_t TessellationCache::Key::Hash::operator()(const Key& key) const {
+  return fml::HashCombine(key.path_hash, key.tolerance, key.type);
+}
+
+size_t TessellationCache::Result::GetByteSize() const {
+  return vertices.size() * sizeof(Point) + indices.size() * sizeof(uint16_t);
+}
+
+TessellationCache::TessellationCache(size_t max_bytes)
+    : max_bytes_(max_bytes) {}
+
+TessellationCache::~TessellationCache() = default;
+
+void TessellationCache::SetMaxBytes(size_t max_bytes) {
+  max_bytes_ = max_bytes;
+  Trim(max_bytes);
+}
+
+const TessellationCache::Result* TessellationCache::Find(const Key& key) {
+  auto found = index_.find(key);
+  if (found == index_.end()) {
+    stats_.misses++;
+    return nullptr;
+  }
+  stats_.hits++;
+  entries_.splice(entries_.begin(), entries_, found->second);
+  return &found->second->result;
+}
+
+void TessellationCache::Insert(const Key& key, Result result) {
+  size_t byte_size = result.GetByteSize();
+  if (byte_size > max_bytes_) {
+    return;
+  }
+  auto found = index_.find(key);
+  if (found != index_.end()) {
+    Erase(found->second);
+  }
+  Trim(max_bytes_ - byte_size);
+  entries_.push_front({key, std::move(result)});
+  index_.emplace(key, entries_.begin());
+  stats_.entry_count++;
+  stats_.byte_size += byte_size;
+}
+
+void TessellationCache::Clear() {
+  index_.clear();
+  entries_.clear();
+  stats_.entry_count = 0;
+  stats_.byte_size = 0;
+}
+
+void TessellationCache::Trim(size_t max_bytes) {
+  while (stats_.byte_size > max_bytes) {
+    FML_DCHECK(!entries_.empty());
+    Erase(std::prev(entries_.end()));
+    stats_.evictions++;
+  }
+}
+
+void TessellationCache::Erase(EntryList::iterator entry) {
+  stats_.entry_count--;
+  stats_.byte_size -= entry->result.GetByteSize();
+  index_.erase(entry->key);
+  entries_.erase(entry);
+}
+
+}  // namespace impeller
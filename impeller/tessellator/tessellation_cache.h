@@ -0,0 +1,134 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_IMPELLER_TESSELLATOR_TESSELLATION_CACHE_H_
+#define FLUTTER_IMPELLER_TESSELLATOR_TESSELLATION_CACHE_H_
+
+#include <cstdint>
+#include <list>
+#include <unordered_map>
+#include <vector>
+
+#include "impeller/geometry/path.h"
+#include "impeller/geometry/point.h"
+#include "impeller/geometry/scalar.h"
+
+namespace impeller {
+
+//------------------------------------------------------------------------------
+/// @brief      A cache of the vertices and indices that the |Tessellator|
+///             generates for paths, so that paths which are drawn again,
+///             such as icons and the grid of a chart, aren't tessellated on
+///             every frame.
+///
+///             Results are looked up by the contents of the path rather
+///             than the path object, as paths are usually rebuilt from the
+///             DisplayList for every frame. The least recently used results
+///             are dropped to stay within a byte limit.
+///
+///             Like the |Tessellator|, this object is not thread safe.
+///
+class TessellationCache {
+ public:
+  /// The kind of tessellation the results come from.
+  enum class Type {
+    /// Triangles from |Tessellator::Tessellate|.
+    kTriangles,
+    /// A triangle strip from |Tessellator::TessellateConvex|.
+    kConvex,
+  };
+
+  struct Key {
+    /// Quantizes the tolerance with |QuantizeTolerance|.
+    Key(const Path& path, Scalar tolerance, Type type);
+
+    Path path;
+    size_t path_hash;
+    Scalar tolerance;
+    Type type;
+
+    bool operator==(const Key& other) const;
+
+    struct Hash {
+      size_t operator()(const Key& key) const;
+    };
+  };
+
+  struct Result {
+    /// The vertices, in the layout that the |Tessellator| returns them in.
+    std::vector<Point> vertices;
+    /// The indices of the vertices, which are empty if the vertices
+    /// aren't indexed.
+    std::vector<uint16_t> indices;
+
+    size_t GetByteSize() const;
+  };
+
+  struct Stats {
+    size_t hits = 0;
+    size_t misses = 0;
+    size_t evictions = 0;
+    size_t entry_count = 0;
+    size_t byte_size = 0;
+  };
+
+  //----------------------------------------------------------------------------
+  /// @brief      Rounds the tolerance up to one of 4 steps per doubling, so
+  ///             that a path drawn under slightly different scales shares
+  ///             one result. Generating that result for the larger
+  ///             tolerance only makes it finer.
+  ///
+  static Scalar QuantizeTolerance(Scalar tolerance);
+
+  /// Creates a cache that can hold up to |max_bytes| of results. A cache
+  /// with a limit of 0 is disabled.
+  explicit TessellationCache(size_t max_bytes = 0);
+
+  ~TessellationCache();
+
+  bool IsEnabled() const { return max_bytes_ > 0; }
+
+  size_t GetMaxBytes() const { return max_bytes_; }
+
+  /// Changes the byte limit, dropping results that no longer fit.
+  void SetMaxBytes(size_t max_bytes);
+
+  /// Returns the result for the key if there is one, which stays valid
+  /// until the cache is next changed.
+  const Result* Find(const Key& key);
+
+  /// Adds the result for the key, unless it is larger than the limit.
+  void Insert(const Key& key, Result result);
+
+  /// Drops all of the results.
+  void Clear();
+
+  const Stats& GetStats() const { return stats_; }
+
+ private:
+  struct Entry {
+    Key key;
+    Result result;
+  };
+
+  using EntryList = std::list<Entry>;
+
+  void Trim(size_t max_bytes);
+
+  void Erase(EntryList::iterator entry);
+
+  size_t max_bytes_;
+  Stats stats_;
+  // The most recently used entry first.
+  EntryList entries_;
+  std::unordered_map<Key, EntryList::iterator, Key::Hash> index_;
+
+  TessellationCache(const TessellationCache&) = delete;
+
+  TessellationCache& operator=(const TessellationCache&) = delete;
+};
+
+}  // namespace impeller
+
+#endif  // FLUTTER_IMPELLER_TESSELLATOR_TESSELLATION_CACHE_H_
@@ -0,0 +1,110 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/testing/testing.h"
+#include "gtest/gtest.h"
+
+#include "impeller/geometry/path_builder.h"
+#include "impeller/tessellator/tessellation_cache.h"
+
+namespace impeller {
+namespace testing {
+
+namespace {
+
+Path MakeRectPath(Scalar x) {
+  return PathBuilder{}.AddRect(Rect::MakeXYWH(x, 0, 10, 10)).TakePath();
+}
+
+TessellationCache::Result MakeResult(size_t vertex_count) {
+  TessellationCache::Result result;
+  result.vertices.resize(vertex_count);
+  return result;
+}
+
+}  // namespace
+
+TEST(TessellationCacheTest, QuantizeToleranceRoundsUp) {
+  EXPECT_EQ(TessellationCache::QuantizeTolerance(0), 0);
+  EXPECT_EQ(TessellationCache::QuantizeTolerance(1), 1);
+  EXPECT_EQ(TessellationCache::QuantizeTolerance(2), 2);
+  EXPECT_EQ(TessellationCache::QuantizeTolerance(0.5), 0.5);
+
+  Scalar quantized = TessellationCache::QuantizeTolerance(1.1);
+  EXPECT_GE(quantized, 1.1f);
+  EXPECT_LT(quantized, 1.1f * 1.2f);
+  EXPECT_EQ(TessellationCache::QuantizeTolerance(1.05), quantized);
+  EXPECT_EQ(TessellationCache::QuantizeTolerance(quantized), quantized);
+}
+
+TEST(TessellationCacheTest, FindsResultsByPathContents) {
+  TessellationCache cache(1024);
+  using Key = TessellationCache::Key;
+  auto type = TessellationCache::Type::kConvex;
+
+  cache.Insert(Key(MakeRectPath(0), 1, type), MakeResult(4));
+
+  // A path built separately with the same contents.
+  auto result = cache.Find(Key(MakeRectPath(0), 1, type));
+  ASSERT_NE(result, nullptr);
+  EXPECT_EQ(result->vertices.size(), 4u);
+  // A tolerance that quantizes to the same value.
+  EXPECT_NE(cache.Find(Key(MakeRectPath(0), 0.99, type)), nullptr);
+
+  EXPECT_EQ(cache.Find(Key(MakeRectPath(1), 1, type)), nullptr);
+  EXPECT_EQ(cache.Find(Key(MakeRectPath(0), 2, type)), nullptr);
+  EXPECT_EQ(cache.Find(
+                Key(MakeRectPath(0), 1, TessellationCache::Type::kTriangles)),
+            nullptr);
+  EXPECT_EQ(cache.Find(Key(PathBuilder{}
+                               .AddRect(Rect::MakeXYWH(0, 0, 10, 10))
+                               .TakePath(FillType::kOdd),
+                           1, type)),
+            nullptr);
+
+  EXPECT_EQ(cache.GetStats().hits, 2u);
+  EXPECT_EQ(cache.GetStats().misses, 4u);
+  EXPECT_EQ(cache.GetStats().entry_count, 1u);
+  EXPECT_EQ(cache.GetStats().byte_size, 4 * sizeof(Point));
+}
+
+TEST(TessellationCacheTest, EvictsLeastRecentlyUsedResults) {
+  const size_t result_size = 4 * sizeof(Point);
+  TessellationCache cache(3 * result_size);
+  using Key = TessellationCache::Key;
+  auto type = TessellationCache::Type::kConvex;
+
+  for (int i = 0; i < 3; i++) {
+    cache.Insert(Key(MakeRectPath(i), 1, type), MakeResult(4));
+  }
+  EXPECT_EQ(cache.GetStats().entry_count, 3u);
+
+  // Use the oldest result, which makes the second the least recently used.
+  EXPECT_NE(cache.Find(Key(MakeRectPath(0), 1, type)), nullptr);
+  cache.Insert(Key(MakeRectPath(3), 1, type), MakeResult(4));
+
+  EXPECT_EQ(cache.GetStats().evictions, 1u);
+  EXPECT_EQ(cache.GetStats().entry_count, 3u);
+  EXPECT_EQ(cache.GetStats().byte_size, 3 * result_size);
+  EXPECT_NE(cache.Find(Key(MakeRectPath(0), 1, type)), nullptr);
+  EXPECT_EQ(cache.Find(Key(MakeRectPath(1), 1, type)), nullptr);
+  EXPECT_NE(cache.Find(Key(MakeRectPath(2), 1, type)), nullptr);
+  EXPECT_NE(cache.Find(Key(MakeRectPath(3), 1, type)), nullptr);
+
+  // Results larger than the cache aren't kept.
+  cache.Insert(Key(MakeRectPath(4), 1, type), MakeResult(16));
+  EXPECT_EQ(cache.Find(Key(MakeRectPath(4), 1, type)), nullptr);
+  EXPECT_EQ(cache.GetStats().entry_count, 3u);
+
+  cache.SetMaxBytes(result_size);
+  EXPECT_EQ(cache.GetStats().entry_count, 1u);
+  EXPECT_NE(cache.Find(Key(MakeRectPath(3), 1, type)), nullptr);
+
+  cache.Clear();
+  EXPECT_EQ(cache.GetStats().entry_count, 0u);
+  EXPECT_EQ(cache.GetStats().byte_size, 0u);
+}
+
+}  // namespace testing
+}  // namespace impeller
@@ -4,6 +4,8 @@
 
 #include "impeller/tessellator/tessellator.h"
 
+#include <optional>
+
 #include "third_party/libtess2/Include/tesselator.h"
 
 namespace impeller {
@@ -45,6 +47,34 @@ Tessellator::Tessellator()
 
 Tessellator::~Tessellator() = default;
 
+void Tessellator::SetCacheMaxBytes(size_t max_bytes) {
+  cache_.SetMaxBytes(max_bytes);
+}
+
+std::optional<std::vector<Point>> Tessellator::FindCachedConvex(
+    const Path& path,
+    Scalar tolerance) {
+  if (!cache_.IsEnabled()) {
+    return std::nullopt;
+  }
+  TessellationCache::Key key(path, tolerance, TessellationCache::Type::kConvex);
+  auto cached = cache_.Find(key);
+  if (!cached) {
+    return std::nullopt;
+  }
+  return cached->vertices;
+}
+
+void Tessellator::CacheConvex(const Path& path,
+                              Scalar tolerance,
+                              std::vector<Point> points) {
+  if (!cache_.IsEnabled()) {
+    return;
+  }
+  TessellationCache::Key key(path, tolerance, TessellationCache::Type::kConvex);
+  cache_.Insert(key, {.vertices = std::move(points)});
+}
+
 static int ToTessWindingRule(FillType fill_type) {
   switch (fill_type) {
     case FillType::kOdd:
@@ -62,6 +92,44 @@ Tessellator::Result Tessellator::Tessellate(const Path& path,
     return Result::kInputError;
   }
 
+  std::optional<TessellationCache::Key> cache_key;
+  if (cache_.IsEnabled()) {
+    cache_key.emplace(path, tolerance, TessellationCache::Type::kTriangles);
+    if (auto cached = cache_.Find(*cache_key)) {
+      static_assert(sizeof(Point) == 2 * sizeof(float));
+      bool delivered = callback(
+          reinterpret_cast<const float*>(cached->vertices.data()),
+          cached->vertices.size(),
+          cached->indices.empty() ? nullptr : cached->indices.data(),
+          cached->indices.size());
+      return delivered ? Result::kSuccess : Result::kInputError;
+    }
+    tolerance = cache_key->tolerance;
+  } else if (quantize_tolerance_) {
+    tolerance = TessellationCache::QuantizeTolerance(tolerance);
+  }
+
+  // Delivers the results to the callback, keeping a copy of them in the
+  // cache if it is enabled.
+  auto deliver = [this, &callback, &cache_key](const float* vertices,
+                                               size_t vertices_count,
+                                               const uint16_t* indices,
+                                               size_t indices_count) {
+    if (!callback(vertices, vertices_count, indices, indices_count)) {
+      return false;
+    }
+    if (cache_key.has_value()) {
+      TessellationCache::Result result;
+      auto points = reinterpret_cast<const Point*>(vertices);
+      result.vertices.assign(points, points + vertices_count);
+      if (indices != nullptr) {
+        result.indices.assign(indices, indices + indices_count);
+      }
+      cache_.Insert(*cache_key, std::move(result));
+    }
+    return true;
+  };
+
   point_buffer_->clear();
   auto polyline =
       path.CreatePolyline(tolerance, std::move(point_buffer_),
@@ -134,8 +202,8 @@ Tessellator::Result Tessellator::Tessellate(const Path& path,
     for (int i = 0; i < element_item_count; i++) {
       indices[i] = static_cast<uint16_t>(elements[i]);
     }
-    if (!callback(vertices, vertex_item_count, indices.data(),
-                  element_item_count)) {
+    if (!deliver(vertices, vertex_item_count, indices.data(),
+                 element_item_count)) {
       return Result::kInputError;
     }
   } else {
@@ -156,7 +224,7 @@ Tessellator::Result Tessellator::Tessellate(const Path& path,
       data.emplace_back(points[elements[i]].x);
       data.emplace_back(points[elements[i]].y);
     }
-    if (!callback(data.data(), element_item_count, nullptr, 0u)) {
+    if (!deliver(data.data(), element_item_count, nullptr, 0u)) {
       return Result::kInputError;
     }
   }
@@ -180,6 +248,17 @@ std::vector<Point> Tessellator::TessellateConvex(const Path& path,
                                                  Scalar tolerance) {
   FML_DCHECK(point_buffer_);
 
+  std::optional<TessellationCache::Key> cache_key;
+  if (cache_.IsEnabled()) {
+    cache_key.emplace(path, tolerance, TessellationCache::Type::kConvex);
+    if (auto cached = cache_.Find(*cache_key)) {
+      return cached->vertices;
+    }
+    tolerance = cache_key->tolerance;
+  } else if (quantize_tolerance_) {
+    tolerance = TessellationCache::QuantizeTolerance(tolerance);
+  }
+
   std::vector<Point> output;
   point_buffer_->clear();
   auto polyline =
@@ -236,6 +315,9 @@ std::vector<Point> Tessellator::TessellateConvex(const Path& path,
       previous_contour_odd_points = true;
     }
   }
+  if (cache_key.has_value()) {
+    cache_.Insert(*cache_key, {.vertices = output});
+  }
   return output;
 }
 
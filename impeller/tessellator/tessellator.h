@@ -7,12 +7,14 @@
 
 #include <functional>
 #include <memory>
+#include <optional>
 #include <vector>
 
 #include "impeller/core/formats.h"
 #include "impeller/geometry/path.h"
 #include "impeller/geometry/point.h"
 #include "impeller/geometry/trig.h"
+#include "impeller/tessellator/tessellation_cache.h"
 
 struct TESStesselator;
 
@@ -212,6 +214,50 @@ class Tessellator {
   ///
   std::vector<Point> TessellateConvex(const Path& path, Scalar tolerance);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Sets how many bytes of results |Tessellate| and
+  ///             |TessellateConvex| may keep to return again for paths with
+  ///             the same contents, fill type and tolerance. The cache is
+  ///             disabled by default.
+  ///
+  ///             While the cache is enabled, paths are tessellated for the
+  ///             tolerance rounded up by
+  ///             |TessellationCache::QuantizeTolerance|.
+  ///
+  void SetCacheMaxBytes(size_t max_bytes);
+
+  bool IsCacheEnabled() const { return cache_.IsEnabled(); }
+
+  //----------------------------------------------------------------------------
+  /// @brief      Rounds tolerances up by |TessellationCache::QuantizeTolerance|
+  ///             even while the cache is disabled, so that the results of
+  ///             |TessellateConvex| can be added to the cache of another
+  ///             tessellator with |CacheConvex|.
+  ///
+  void SetQuantizeTolerance(bool quantize) { quantize_tolerance_ = quantize; }
+
+  //----------------------------------------------------------------------------
+  /// @brief      Returns the cached result of |TessellateConvex| for the path
+  ///             and tolerance without tessellating the path on a miss.
+  ///
+  std::optional<std::vector<Point>> FindCachedConvex(const Path& path,
+                                                     Scalar tolerance);
+
+  //----------------------------------------------------------------------------
+  /// @brief      Adds the result of |TessellateConvex| that a tessellator
+  ///             which quantizes tolerances returned for the path and
+  ///             tolerance to the cache, if the cache is enabled.
+  ///
+  void CacheConvex(const Path& path,
+                   Scalar tolerance,
+                   std::vector<Point> points);
+
+  /// @brief  Returns the hit, miss and eviction counters and the size of the
+  ///         cache of results.
+  const TessellationCache::Stats& GetCacheStats() const {
+    return cache_.GetStats();
+  }
+
   //----------------------------------------------------------------------------
   /// @brief      Create a temporary polyline. Only one per-process can exist at
   ///             a time.
@@ -300,6 +346,8 @@ class Tessellator {
   /// Used for polyline generation.
   std::unique_ptr<std::vector<Point>> point_buffer_;
   CTessellator c_tessellator_;
+  TessellationCache cache_;
+  bool quantize_tolerance_ = false;
 
   // Data for variouos Circle/EllipseGenerator classes, cached per
   // Tessellator instance which is usually the foreground life of an app
@@ -130,6 +130,54 @@ TEST(TessellatorTest, TessellateConvex) {
   }
 }
 
+TEST(TessellatorTest, ReturnsCachedResultsForEqualPaths) {
+  Tessellator t;
+  t.SetCacheMaxBytes(1024 * 1024);
+  auto make_path = [] {
+    return PathBuilder{}
+        .AddRoundedRect(Rect::MakeLTRB(0, 0, 100, 100), 20)
+        .TakePath();
+  };
+
+  auto first = t.TessellateConvex(make_path(), 1.0);
+  auto second = t.TessellateConvex(make_path(), 1.0);
+  EXPECT_EQ(first, second);
+  EXPECT_EQ(t.GetCacheStats().misses, 1u);
+  EXPECT_EQ(t.GetCacheStats().hits, 1u);
+
+  std::vector<float> first_vertices;
+  std::vector<uint16_t> first_indices;
+  auto collect = [](std::vector<float>& vertices_out,
+                    std::vector<uint16_t>& indices_out) {
+    return [&vertices_out, &indices_out](
+               const float* vertices, size_t vertices_count,
+               const uint16_t* indices, size_t indices_count) {
+      vertices_out.assign(vertices, vertices + vertices_count * 2);
+      if (indices != nullptr) {
+        indices_out.assign(indices, indices + indices_count);
+      }
+      return true;
+    };
+  };
+  ASSERT_EQ(t.Tessellate(make_path(), 1.0,
+                         collect(first_vertices, first_indices)),
+            Tessellator::Result::kSuccess);
+
+  std::vector<float> second_vertices;
+  std::vector<uint16_t> second_indices;
+  ASSERT_EQ(t.Tessellate(make_path(), 1.0,
+                         collect(second_vertices, second_indices)),
+            Tessellator::Result::kSuccess);
+  EXPECT_EQ(first_vertices, second_vertices);
+  EXPECT_EQ(first_indices, second_indices);
+  EXPECT_FALSE(second_indices.empty());
+  EXPECT_EQ(t.GetCacheStats().misses, 2u);
+  EXPECT_EQ(t.GetCacheStats().hits, 2u);
+
+  // The convex and triangle results are cached separately.
+  EXPECT_EQ(t.GetCacheStats().entry_count, 2u);
+}
+
 TEST(TessellatorTest, CircleVertexCounts) {
   auto tessellator = std::make_shared<Tessellator>();
 
@@ -103,6 +103,7 @@ typedef CanvasPath Path;
   V(PlatformConfigurationNativeApi::Render)                        \
   V(PlatformConfigurationNativeApi::UpdateSemantics)               \
   V(PlatformConfigurationNativeApi::SetNeedsReportTimings)         \
+  V(PlatformConfigurationNativeApi::IsFrameMissPredicted)          \
   V(PlatformConfigurationNativeApi::SetIsolateDebugName)           \
   V(PlatformConfigurationNativeApi::RequestDartPerformanceMode)    \
   V(PlatformConfigurationNativeApi::GetPersistentIsolateData)      \
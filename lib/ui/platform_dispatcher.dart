@@ -781,6 +781,20 @@ class PlatformDispatcher {
   @Native<Int Function(Int)>(symbol: 'PlatformConfigurationNativeApi::RequestDartPerformanceMode')
   external static int _requestDartPerformanceMode(int mode);
 
+  /// Whether the engine predicts that building the current frame will miss
+  /// its deadline.
+  ///
+  /// The prediction is made from the build durations of recent frames and is
+  /// updated right before each [onBeginFrame]. Code that is about to start
+  /// expensive, deferrable work, such as precaching or starting a large
+  /// computation, can check it and postpone the work to a later frame.
+  ///
+  /// Always false on the web, and until a few frames have been built.
+  bool get frameMissPredicted => _isFrameMissPredicted();
+
+  @Native<Bool Function()>(symbol: 'PlatformConfigurationNativeApi::IsFrameMissPredicted')
+  external static bool _isFrameMissPredicted();
+
   /// The embedder can specify data that the isolate can request synchronously
   /// on launch. This accessor fetches that data.
   ///
@@ -11,6 +11,7 @@
 
 #include "flutter/common/settings.h"
 #include "flutter/common/task_runners.h"
+#include "flutter/display_list/display_list.h"
 #include "flutter/fml/build_config.h"
 #include "flutter/fml/memory/weak_ptr.h"
 #include "flutter/fml/synchronization/waitable_event.h"
@@ -147,6 +148,14 @@ class UIDartState : public tonic::DartState {
 
   std::shared_ptr<IsolateNameServer> GetIsolateNameServer() const;
 
+  /// The pool that the pictures recorded by this isolate take their storage
+  /// from, so that pictures recorded every frame reuse the storage of the
+  /// pictures of earlier frames.
+  const std::shared_ptr<DisplayListStoragePool>& GetDisplayListStoragePool()
+      const {
+    return display_list_storage_pool_;
+  }
+
   tonic::DartErrorHandleType GetLastError();
 
   // Logs `print` messages from the application via an embedder-specified
@@ -207,6 +216,8 @@ class UIDartState : public tonic::DartState {
   LogMessageCallback log_message_callback_;
   const std::shared_ptr<IsolateNameServer> isolate_name_server_;
   UIDartState::Context context_;
+  const std::shared_ptr<DisplayListStoragePool> display_list_storage_pool_ =
+      std::make_shared<DisplayListStoragePool>();
 
   void AddOrRemoveTaskObserver(bool add);
 };
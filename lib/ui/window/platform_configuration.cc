@@ -573,6 +573,13 @@ int PlatformConfigurationNativeApi::RequestDartPerformanceMode(int mode) {
   return Dart_SetPerformanceMode(current_performance_mode_);
 }
 
+bool PlatformConfigurationNativeApi::IsFrameMissPredicted() {
+  UIDartState::ThrowIfUIOperationsProhibited();
+  return UIDartState::Current()
+      ->platform_configuration()
+      ->IsFrameMissPredicted();
+}
+
 Dart_Handle PlatformConfigurationNativeApi::GetPersistentIsolateData() {
   UIDartState::ThrowIfUIOperationsProhibited();
 
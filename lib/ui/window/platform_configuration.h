@@ -453,6 +453,26 @@ class PlatformConfiguration final {
   ///
   void BeginFrame(fml::TimePoint frame_time, uint64_t frame_number);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Updates whether building the upcoming frame is predicted to
+  ///             miss its target time. The animator updates this right before
+  ///             every `BeginFrame` from the build durations of recent frames.
+  ///
+  ///             The framework reads it through
+  ///             `PlatformDispatcher.frameMissPredicted`.
+  ///
+  /// @param[in]  predicted_to_miss  Whether the frame is predicted to miss.
+  ///
+  void SetFrameMissPredicted(bool predicted_to_miss) {
+    frame_miss_predicted_ = predicted_to_miss;
+  }
+
+  //----------------------------------------------------------------------------
+  /// @brief      Whether building the current or upcoming frame is predicted
+  ///             to miss its target time.
+  ///
+  bool IsFrameMissPredicted() const { return frame_miss_predicted_; }
+
   //----------------------------------------------------------------------------
   /// @brief      Dart code cannot fully measure the time it takes for a
   ///             specific frame to be rendered. This is because Dart code only
@@ -537,6 +557,8 @@ class PlatformConfiguration final {
   // All current views' view metrics mapped from view IDs.
   std::unordered_map<int64_t, ViewportMetrics> metrics_;
 
+  bool frame_miss_predicted_ = false;
+
   // ID starts at 1 because an ID of 0 indicates that no response is expected.
   int next_response_id_ = 1;
   std::unordered_map<int, fml::RefPtr<PlatformMessageResponse>>
@@ -584,6 +606,8 @@ class PlatformConfigurationNativeApi {
 
   static void SetNeedsReportTimings(bool value);
 
+  static bool IsFrameMissPredicted();
+
   static Dart_Handle GetPersistentIsolateData();
 
   static Dart_Handle ComputePlatformResolvedLocale(
@@ -86,6 +86,8 @@ abstract class PlatformDispatcher {
 
   void requestDartPerformanceMode(DartPerformanceMode mode) {}
 
+  bool get frameMissPredicted => false;
+
   ByteData? getPersistentIsolateData() => null;
 
   void scheduleFrame();
@@ -287,7 +287,8 @@ DartVM::DartVM(const std::shared_ptr<const DartVMData>& vm_data,
     : settings_(vm_data->GetSettings()),
       concurrent_message_loop_(fml::ConcurrentMessageLoop::Create(
           fml::EfficiencyCoreCount().value_or(
-              std::thread::hardware_concurrency()))),
+              std::thread::hardware_concurrency()),
+          fml::ConcurrentMessageLoop::SchedulingPolicy::kWorkStealing)),
       skia_concurrent_executor_(
           [runner = concurrent_message_loop_->GetTaskRunner()](
               const fml::closure& work) { runner->PostTask(work); }),
@@ -239,6 +239,15 @@ bool RuntimeController::BeginFrame(fml::TimePoint frame_time,
   return false;
 }
 
+bool RuntimeController::SetFrameMissPredicted(bool predicted_to_miss) {
+  if (auto* platform_configuration = GetPlatformConfigurationIfAvailable()) {
+    platform_configuration->SetFrameMissPredicted(predicted_to_miss);
+    return true;
+  }
+
+  return false;
+}
+
 bool RuntimeController::ReportTimings(std::vector<int64_t> timings) {
   if (auto* platform_configuration = GetPlatformConfigurationIfAvailable()) {
     platform_configuration->ReportTimings(std::move(timings));
@@ -302,6 +302,18 @@ class RuntimeController : public PlatformConfigurationClient {
   ///
   bool BeginFrame(fml::TimePoint frame_time, uint64_t frame_number);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Updates whether building the upcoming frame is predicted to
+  ///             miss its target time.
+  ///
+  /// @see        `Engine::SetFrameMissPredicted` for more context.
+  ///
+  /// @param[in]  predicted_to_miss  Whether the frame is predicted to miss.
+  ///
+  /// @return     If the prediction was forwarded to the running isolate.
+  ///
+  bool SetFrameMissPredicted(bool predicted_to_miss);
+
   //----------------------------------------------------------------------------
   /// @brief      Dart code cannot fully measure the time it takes for a
   ///             specific frame to be rendered. This is because Dart code only
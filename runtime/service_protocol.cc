@@ -42,6 +42,8 @@ const std::string_view
         "_flutter.renderFrameWithRasterStats";
 const std::string_view ServiceProtocol::kReloadAssetFonts =
     "_flutter.reloadAssetFonts";
+const std::string_view ServiceProtocol::kGetTaskQueueStatsExtensionName =
+    "_flutter.getTaskQueueStats";
 
 static constexpr std::string_view kViewIdPrefx = "_flutterView/";
 static constexpr std::string_view kListViewsExtensionName =
@@ -63,6 +65,7 @@ ServiceProtocol::ServiceProtocol()
           kEstimateRasterCacheMemoryExtensionName,
           kRenderFrameWithRasterStatsExtensionName,
           kReloadAssetFonts,
+          kGetTaskQueueStatsExtensionName,
       }),
       handlers_mutex_(fml::SharedMutex::Create()) {}
 
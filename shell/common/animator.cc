@@ -4,6 +4,8 @@
 
 #include "flutter/shell/common/animator.h"
 
+#include <algorithm>
+
 #include "flutter/common/constants.h"
 #include "flutter/flow/frame_timings.h"
 #include "flutter/fml/logging.h"
@@ -21,6 +23,19 @@ namespace {
 constexpr fml::TimeDelta kNotifyIdleTaskWaitTime =
     fml::TimeDelta::FromMilliseconds(51);
 
+uint32_t GetMaxPipelineDepth(const TaskRunners& task_runners) {
+#if SHELL_ENABLE_METAL
+  return PipelineDepthController::kMaxDepth;
+#else   // SHELL_ENABLE_METAL
+  // TODO(dnfield): We should remove this logic and allow deeper pipelines in
+  // this case. See https://github.com/flutter/engine/pull/9132 for discussion.
+  return task_runners.GetPlatformTaskRunner() ==
+                 task_runners.GetRasterTaskRunner()
+             ? 1
+             : PipelineDepthController::kMaxDepth;
+#endif  // SHELL_ENABLE_METAL
+}
+
 }  // namespace
 
 Animator::Animator(Delegate& delegate,
@@ -29,24 +44,21 @@ Animator::Animator(Delegate& delegate,
     : delegate_(delegate),
       task_runners_(task_runners),
       waiter_(std::move(waiter)),
-#if SHELL_ENABLE_METAL
-      layer_tree_pipeline_(std::make_shared<FramePipeline>(2)),
-#else   // SHELL_ENABLE_METAL
-      // TODO(dnfield): We should remove this logic and set the pipeline depth
-      // back to 2 in this case. See
-      // https://github.com/flutter/engine/pull/9132 for discussion.
-      layer_tree_pipeline_(std::make_shared<FramePipeline>(
-          task_runners.GetPlatformTaskRunner() ==
-                  task_runners.GetRasterTaskRunner()
-              ? 1
-              : 2)),
-#endif  // SHELL_ENABLE_METAL
+      max_pipeline_depth_(GetMaxPipelineDepth(task_runners)),
+      layer_tree_pipeline_(
+          std::make_shared<FramePipeline>(std::min(max_pipeline_depth_, 2u),
+                                          max_pipeline_depth_)),
       pending_frame_semaphore_(1),
       weak_factory_(this) {
 }
 
 Animator::~Animator() = default;
 
+void Animator::SetPipelineDepthController(
+    std::shared_ptr<PipelineDepthController> controller) {
+  pipeline_depth_controller_ = std::move(controller);
+}
+
 void Animator::EnqueueTraceFlowId(uint64_t trace_flow_id) {
   fml::TaskRunner::RunNowOrPostTask(
       task_runners_.GetUITaskRunner(),
@@ -93,6 +105,11 @@ void Animator::BeginFrame(
   regenerate_layer_trees_ = false;
   pending_frame_semaphore_.Signal();
 
+  if (pipeline_depth_controller_) {
+    layer_tree_pipeline_->SetDepth(std::min(
+        pipeline_depth_controller_->GetDepth(), max_pipeline_depth_));
+  }
+
   if (!producer_continuation_) {
     // We may already have a valid pipeline continuation in case a previous
     // begin frame did not result in an Animator::Render. Simply reuse that
@@ -115,6 +132,18 @@ void Animator::BeginFrame(
   const fml::TimePoint frame_target_time =
       frame_timings_recorder_->GetVsyncTargetTime();
   dart_frame_deadline_ = frame_target_time.ToEpochDelta();
+  frame_interval_ =
+      frame_target_time - frame_timings_recorder_->GetVsyncStartTime();
+  const fml::TimeDelta predicted_build_duration =
+      frame_time_predictor_.PredictBuildDuration();
+  const bool predicted_to_miss = frame_time_predictor_.IsPredictedToMiss(
+      frame_target_time - fml::TimePoint::Now());
+  FML_TRACE_COUNTER("flutter", "FrameTimePredictor",
+                    reinterpret_cast<int64_t>(this),            //
+                    "PredictedBuildMicros",                     //
+                    predicted_build_duration.ToMicroseconds(),  //
+                    "PredictedToMiss", predicted_to_miss ? 1 : 0);
+  delegate_.OnAnimatorPredictFrameMiss(predicted_to_miss);
   uint64_t frame_number = frame_timings_recorder_->GetFrameNumber();
   delegate_.OnAnimatorBeginFrame(frame_target_time, frame_number);
 }
@@ -128,7 +157,10 @@ void Animator::EndFrame() {
   }
   if (!layer_trees_tasks_.empty()) {
     // The build is completed in OnAnimatorBeginFrame.
-    frame_timings_recorder_->RecordBuildEnd(fml::TimePoint::Now());
+    const fml::TimePoint build_end = fml::TimePoint::Now();
+    frame_timings_recorder_->RecordBuildEnd(build_end);
+    frame_time_predictor_.RecordBuildDuration(
+        build_end - frame_timings_recorder_->GetBuildStartTime());
 
     delegate_.OnAnimatorUpdateLatestFrameTargetTime(
         frame_timings_recorder_->GetVsyncTargetTime());
@@ -288,7 +320,18 @@ void Animator::AwaitVSync() {
         }
       });
   if (has_rendered_) {
-    delegate_.OnAnimatorNotifyIdle(dart_frame_deadline_);
+    // The next frame starts building at the next vsync, around the deadline of
+    // the last one, but only needs part of the frame interval to build. Give
+    // the rest of it to the VM as well if the prediction allows.
+    fml::TimeDelta idle_deadline = dart_frame_deadline_;
+    if (frame_time_predictor_.HasPrediction()) {
+      const fml::TimeDelta slack =
+          frame_interval_ - frame_time_predictor_.PredictBuildDuration();
+      if (slack > fml::TimeDelta::Zero()) {
+        idle_deadline = idle_deadline + slack;
+      }
+    }
+    delegate_.OnAnimatorNotifyIdle(idle_deadline);
   }
 }
 
@@ -13,7 +13,9 @@
 #include "flutter/fml/memory/weak_ptr.h"
 #include "flutter/fml/synchronization/semaphore.h"
 #include "flutter/fml/time/time_point.h"
+#include "flutter/shell/common/frame_time_predictor.h"
 #include "flutter/shell/common/pipeline.h"
+#include "flutter/shell/common/pipeline_depth_controller.h"
 #include "flutter/shell/common/rasterizer.h"
 #include "flutter/shell/common/vsync_waiter.h"
 
@@ -36,6 +38,10 @@ class Animator final {
 
     virtual void OnAnimatorNotifyIdle(fml::TimeDelta deadline) = 0;
 
+    // Called right before |OnAnimatorBeginFrame| with whether building the
+    // frame is predicted to miss its target time.
+    virtual void OnAnimatorPredictFrameMiss(bool predicted_to_miss) = 0;
+
     virtual void OnAnimatorUpdateLatestFrameTargetTime(
         fml::TimePoint frame_target_time) = 0;
 
@@ -107,6 +113,14 @@ class Animator final {
   void ScheduleSecondaryVsyncCallback(uintptr_t id,
                                       const fml::closure& callback);
 
+  //--------------------------------------------------------------------------
+  /// @brief    Lets |controller| pick the depth of the layer tree pipeline
+  ///           at the start of every frame. Without a controller, the depth
+  ///           stays at the one the pipeline was created with.
+  ///
+  void SetPipelineDepthController(
+      std::shared_ptr<PipelineDepthController> controller);
+
   // Enqueue |trace_flow_id| into |trace_flow_ids_|.  The flow event will be
   // ended at either the next frame, or the next vsync interval with no active
   // rendering.
@@ -140,7 +154,12 @@ class Animator final {
       layer_trees_tasks_;
   uint64_t frame_request_number_ = 1;
   fml::TimeDelta dart_frame_deadline_;
+  // The interval between vsyncs, as of the last frame.
+  fml::TimeDelta frame_interval_;
+  FrameTimePredictor frame_time_predictor_;
+  const uint32_t max_pipeline_depth_;
   std::shared_ptr<FramePipeline> layer_tree_pipeline_;
+  std::shared_ptr<PipelineDepthController> pipeline_depth_controller_;
   fml::Semaphore pending_frame_semaphore_;
   FramePipeline::ProducerContinuation producer_continuation_;
   bool regenerate_layer_trees_ = false;
@@ -6,9 +6,12 @@
 
 #include "flutter/shell/common/animator.h"
 
+#include <chrono>
 #include <functional>
 #include <future>
 #include <memory>
+#include <thread>
+#include <vector>
 
 #include "flutter/shell/common/shell_test.h"
 #include "flutter/shell/common/shell_test_platform_view.h"
@@ -34,6 +37,11 @@ class FakeAnimatorDelegate : public Animator::Delegate {
 
   void OnAnimatorNotifyIdle(fml::TimeDelta deadline) override {
     notify_idle_called_ = true;
+    notify_idle_deadlines_.push_back(deadline);
+  }
+
+  void OnAnimatorPredictFrameMiss(bool predicted_to_miss) override {
+    predicted_frame_misses_.push_back(predicted_to_miss);
   }
 
   MOCK_METHOD(void,
@@ -50,8 +58,80 @@ class FakeAnimatorDelegate : public Animator::Delegate {
       std::unique_ptr<FrameTimingsRecorder> frame_timings_recorder) override {}
 
   bool notify_idle_called_ = false;
+  std::vector<fml::TimeDelta> notify_idle_deadlines_;
+  std::vector<bool> predicted_frame_misses_;
+};
+
+// Fires vsyncs right away, each with a target time |interval| after its start.
+class FixedIntervalVsyncWaiter : public VsyncWaiter {
+ public:
+  FixedIntervalVsyncWaiter(const TaskRunners& task_runners,
+                           fml::TimeDelta interval)
+      : VsyncWaiter(task_runners), interval_(interval) {}
+
+ protected:
+  void AwaitVSync() override {
+    task_runners_.GetPlatformTaskRunner()->PostTask([this]() {
+      const fml::TimePoint now = fml::TimePoint::Now();
+      FireCallback(now, now + interval_);
+    });
+  }
+
+ private:
+  const fml::TimeDelta interval_;
 };
 
+// Builds and renders |frame_count| frames back to back, each taking at least
+// |build_duration|, and returns their target times.
+static std::vector<fml::TimePoint> BuildFrames(
+    FakeAnimatorDelegate& delegate,
+    const TaskRunners& task_runners,
+    fml::TimeDelta frame_interval,
+    fml::TimeDelta build_duration,
+    size_t frame_count) {
+  std::shared_ptr<Animator> animator;
+  PostTaskSync(task_runners.GetUITaskRunner(), [&] {
+    auto vsync_waiter = static_cast<std::unique_ptr<VsyncWaiter>>(
+        std::make_unique<FixedIntervalVsyncWaiter>(task_runners,
+                                                   frame_interval));
+    animator = std::make_unique<Animator>(delegate, task_runners,
+                                          std::move(vsync_waiter));
+  });
+
+  // Stand in for the rasterizer so that the pipeline never fills up.
+  EXPECT_CALL(delegate, OnAnimatorDraw)
+      .WillRepeatedly([](std::shared_ptr<FramePipeline> pipeline) {
+        PipelineConsumeResult result =
+            pipeline->Consume([](std::unique_ptr<FrameItem> item) {});
+        EXPECT_NE(result, PipelineConsumeResult::NoneAvailable);
+      });
+
+  std::vector<fml::TimePoint> frame_target_times;
+  fml::AutoResetWaitableEvent frames_latch;
+  EXPECT_CALL(delegate, OnAnimatorBeginFrame)
+      .Times(static_cast<int>(frame_count))
+      .WillRepeatedly([&](fml::TimePoint frame_target_time,
+                          uint64_t frame_number) {
+        frame_target_times.push_back(frame_target_time);
+        std::this_thread::sleep_for(
+            std::chrono::microseconds(build_duration.ToMicroseconds()));
+        auto layer_tree = std::make_unique<LayerTree>(LayerTree::Config(),
+                                                      SkISize::Make(600, 800));
+        animator->Render(kImplicitViewId, std::move(layer_tree), 1.0);
+        if (frame_target_times.size() < frame_count) {
+          animator->RequestFrame();
+        } else {
+          frames_latch.Signal();
+        }
+      });
+
+  task_runners.GetUITaskRunner()->PostTask([&] { animator->RequestFrame(); });
+  frames_latch.Wait();
+
+  PostTaskSync(task_runners.GetUITaskRunner(), [&] { animator.reset(); });
+  return frame_target_times;
+}
+
 TEST_F(ShellTest, VSyncTargetTime) {
   // Add native callbacks to listen for window.onBeginFrame
   int64_t target_time;
@@ -261,6 +341,79 @@ TEST_F(ShellTest, AnimatorDoesNotNotifyDelegateIfPipelineIsNotEmpty) {
   PostTaskSync(task_runners.GetUITaskRunner(), [&] { animator.reset(); });
 }
 
+TEST_F(ShellTest, AnimatorExtendsIdleDeadlineByPredictedSlack) {
+  FakeAnimatorDelegate delegate;
+  TaskRunners task_runners = {
+      "test",
+      CreateNewThread(),  // platform
+      CreateNewThread(),  // raster
+      CreateNewThread(),  // ui
+      CreateNewThread()   // io
+  };
+  const fml::TimeDelta frame_interval = fml::TimeDelta::FromMilliseconds(100);
+  const size_t frame_count = FrameTimePredictor::kMinSamples + 1;
+
+  std::vector<fml::TimePoint> frame_target_times =
+      BuildFrames(delegate, task_runners, frame_interval,
+                  fml::TimeDelta::Zero(), frame_count);
+
+  PostTaskSync(task_runners.GetUITaskRunner(), [&] {
+    // The animator notifies idle while it waits for the vsync of every frame
+    // after the first one.
+    ASSERT_GE(delegate.notify_idle_deadlines_.size(), frame_count - 1);
+    // Until there is a prediction, the idle period ends at the deadline of
+    // the last frame.
+    for (size_t i = 0; i + 1 < FrameTimePredictor::kMinSamples; i++) {
+      EXPECT_EQ(delegate.notify_idle_deadlines_[i],
+                frame_target_times[i].ToEpochDelta());
+    }
+    // Then it extends into the next frame interval by the part of it the
+    // next frame is not predicted to need.
+    const size_t predicted = FrameTimePredictor::kMinSamples - 1;
+    const fml::TimeDelta frame_deadline =
+        frame_target_times[predicted].ToEpochDelta();
+    EXPECT_GT(delegate.notify_idle_deadlines_[predicted],
+              frame_deadline + frame_interval / 2);
+    EXPECT_LE(delegate.notify_idle_deadlines_[predicted],
+              frame_deadline + frame_interval);
+
+    // Building a frame takes far less than the frame interval.
+    EXPECT_EQ(delegate.predicted_frame_misses_,
+              std::vector<bool>(frame_count, false));
+  });
+}
+
+TEST_F(ShellTest, AnimatorNotifiesDelegateOfPredictedFrameMiss) {
+  FakeAnimatorDelegate delegate;
+  TaskRunners task_runners = {
+      "test",
+      CreateNewThread(),  // platform
+      CreateNewThread(),  // raster
+      CreateNewThread(),  // ui
+      CreateNewThread()   // io
+  };
+  const size_t frame_count = FrameTimePredictor::kMinSamples + 1;
+
+  // Every frame takes longer to build than the frame interval.
+  std::vector<fml::TimePoint> frame_target_times = BuildFrames(
+      delegate, task_runners, fml::TimeDelta::FromMilliseconds(1),
+      fml::TimeDelta::FromMilliseconds(10), frame_count);
+
+  PostTaskSync(task_runners.GetUITaskRunner(), [&] {
+    // Misses are only predicted once enough frames have been built.
+    std::vector<bool> expected_misses(frame_count, false);
+    expected_misses.back() = true;
+    EXPECT_EQ(delegate.predicted_frame_misses_, expected_misses);
+
+    // There is no slack to give to the VM, so the idle period still ends at
+    // the deadline of the last frame.
+    ASSERT_GE(delegate.notify_idle_deadlines_.size(), frame_count - 1);
+    const size_t predicted = FrameTimePredictor::kMinSamples - 1;
+    EXPECT_EQ(delegate.notify_idle_deadlines_[predicted],
+              frame_target_times[predicted].ToEpochDelta());
+  });
+}
+
 }  // namespace testing
 }  // namespace flutter
 
@@ -264,6 +264,10 @@ void Engine::BeginFrame(fml::TimePoint frame_time, uint64_t frame_number) {
   runtime_controller_->BeginFrame(frame_time, frame_number);
 }
 
+void Engine::SetFrameMissPredicted(bool predicted_to_miss) {
+  runtime_controller_->SetFrameMissPredicted(predicted_to_miss);
+}
+
 void Engine::ReportTimings(std::vector<int64_t> timings) {
   runtime_controller_->ReportTimings(std::move(timings));
 }
@@ -553,6 +553,16 @@ class Engine final : public RuntimeDelegate, PointerDataDispatcher::Delegate {
   ///                          events.
   void BeginFrame(fml::TimePoint frame_time, uint64_t frame_number);
 
+  //----------------------------------------------------------------------------
+  /// @brief      Updates whether the animator predicts that building the
+  ///             upcoming frame will miss its target time. Applications can
+  ///             read this through `PlatformDispatcher.frameMissPredicted` and
+  ///             defer expensive work.
+  ///
+  /// @param[in]  predicted_to_miss  Whether the frame is predicted to miss.
+  ///
+  void SetFrameMissPredicted(bool predicted_to_miss);
+
   //----------------------------------------------------------------------------
   /// @brief      Notifies the engine that the UI task runner is not expected to
   ///             undertake a new frame workload till a specified timepoint. The
@@ -95,6 +95,10 @@ class MockAnimatorDelegate : public Animator::Delegate {
               OnAnimatorNotifyIdle,
               (fml::TimeDelta deadline),
               (override));
+  MOCK_METHOD(void,
+              OnAnimatorPredictFrameMiss,
+              (bool predicted_to_miss),
+              (override));
   MOCK_METHOD(void,
               OnAnimatorUpdateLatestFrameTargetTime,
               (fml::TimePoint frame_target_time),
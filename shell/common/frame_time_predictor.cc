@@ -0,0 +1,56 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/frame_time_predictor.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace flutter {
+
+namespace {
+
+// The gains of the moving average and deviation, and the multiple of the
+// deviation added to the prediction, as recommended for TCP in RFC 6298.
+constexpr double kAverageGain = 1.0 / 8;
+constexpr double kDeviationGain = 1.0 / 4;
+constexpr double kDeviationFactor = 4;
+
+}  // namespace
+
+FrameTimePredictor::FrameTimePredictor() = default;
+
+FrameTimePredictor::~FrameTimePredictor() = default;
+
+void FrameTimePredictor::RecordBuildDuration(fml::TimeDelta build_duration) {
+  const double micros =
+      std::max<double>(build_duration.ToMicrosecondsF(), 0.0);
+  if (sample_count_ == 0) {
+    average_micros_ = micros;
+    deviation_micros_ = micros / 2;
+  } else {
+    const double deviation = std::abs(micros - average_micros_);
+    deviation_micros_ += kDeviationGain * (deviation - deviation_micros_);
+    average_micros_ += kAverageGain * (micros - average_micros_);
+  }
+  sample_count_++;
+}
+
+bool FrameTimePredictor::HasPrediction() const {
+  return sample_count_ >= kMinSamples;
+}
+
+fml::TimeDelta FrameTimePredictor::PredictBuildDuration() const {
+  if (!HasPrediction()) {
+    return fml::TimeDelta::Zero();
+  }
+  return fml::TimeDelta::FromMicroseconds(static_cast<int64_t>(
+      std::ceil(average_micros_ + kDeviationFactor * deviation_micros_)));
+}
+
+bool FrameTimePredictor::IsPredictedToMiss(fml::TimeDelta available) const {
+  return HasPrediction() && PredictBuildDuration() > available;
+}
+
+}  // namespace flutter
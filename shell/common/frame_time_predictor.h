@@ -0,0 +1,59 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_COMMON_FRAME_TIME_PREDICTOR_H_
+#define FLUTTER_SHELL_COMMON_FRAME_TIME_PREDICTOR_H_
+
+#include <cstddef>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/time/time_delta.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief      Predicts how long the UI thread will take to build the next
+///             frame from the build durations of recent frames.
+///
+///             The prediction tracks a moving average of the build durations
+///             and of their deviation from it, the same way TCP estimates
+///             round trip times, and adds a multiple of the deviation to the
+///             average. Frames with a stable cost are predicted close to that
+///             cost, while erratic ones are predicted conservatively.
+///
+///             Not thread safe. The animator uses it on the UI thread.
+///
+class FrameTimePredictor {
+ public:
+  /// The number of frames that must be recorded before predictions are made.
+  static constexpr size_t kMinSamples = 4;
+
+  FrameTimePredictor();
+
+  ~FrameTimePredictor();
+
+  void RecordBuildDuration(fml::TimeDelta build_duration);
+
+  /// Whether enough frames have been recorded to make predictions.
+  bool HasPrediction() const;
+
+  /// The predicted build duration of the next frame, or zero if there is no
+  /// prediction yet.
+  fml::TimeDelta PredictBuildDuration() const;
+
+  /// Whether building the next frame is predicted to take longer than
+  /// |available|. Always false until there is a prediction.
+  bool IsPredictedToMiss(fml::TimeDelta available) const;
+
+ private:
+  size_t sample_count_ = 0;
+  double average_micros_ = 0;
+  double deviation_micros_ = 0;
+
+  FML_DISALLOW_COPY_AND_ASSIGN(FrameTimePredictor);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_COMMON_FRAME_TIME_PREDICTOR_H_
@@ -0,0 +1,66 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/frame_time_predictor.h"
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+TEST(FrameTimePredictorTest, NoPredictionBeforeEnoughSamples) {
+  FrameTimePredictor predictor;
+  for (size_t i = 0; i < FrameTimePredictor::kMinSamples - 1; i++) {
+    predictor.RecordBuildDuration(fml::TimeDelta::FromMilliseconds(50));
+  }
+  EXPECT_FALSE(predictor.HasPrediction());
+  EXPECT_EQ(predictor.PredictBuildDuration(), fml::TimeDelta::Zero());
+  EXPECT_FALSE(
+      predictor.IsPredictedToMiss(fml::TimeDelta::FromMilliseconds(16)));
+
+  predictor.RecordBuildDuration(fml::TimeDelta::FromMilliseconds(50));
+  EXPECT_TRUE(predictor.HasPrediction());
+  EXPECT_TRUE(
+      predictor.IsPredictedToMiss(fml::TimeDelta::FromMilliseconds(16)));
+}
+
+TEST(FrameTimePredictorTest, ConvergesOnStableBuildDurations) {
+  FrameTimePredictor predictor;
+  for (int i = 0; i < 100; i++) {
+    predictor.RecordBuildDuration(fml::TimeDelta::FromMilliseconds(8));
+  }
+  const fml::TimeDelta prediction = predictor.PredictBuildDuration();
+  EXPECT_GE(prediction, fml::TimeDelta::FromMilliseconds(8));
+  EXPECT_LE(prediction, fml::TimeDelta::FromMicroseconds(8100));
+  EXPECT_FALSE(
+      predictor.IsPredictedToMiss(fml::TimeDelta::FromMilliseconds(16)));
+}
+
+TEST(FrameTimePredictorTest, ErraticBuildDurationsArePredictedConservatively) {
+  FrameTimePredictor predictor;
+  for (int i = 0; i < 100; i++) {
+    predictor.RecordBuildDuration(
+        fml::TimeDelta::FromMilliseconds(i % 2 == 0 ? 2 : 14));
+  }
+  // The average alone would fit the budget, but the deviation doesn't.
+  EXPECT_TRUE(
+      predictor.IsPredictedToMiss(fml::TimeDelta::FromMilliseconds(16)));
+}
+
+TEST(FrameTimePredictorTest, AdaptsToCheaperFrames) {
+  FrameTimePredictor predictor;
+  for (int i = 0; i < 20; i++) {
+    predictor.RecordBuildDuration(fml::TimeDelta::FromMilliseconds(30));
+  }
+  EXPECT_TRUE(
+      predictor.IsPredictedToMiss(fml::TimeDelta::FromMilliseconds(16)));
+  for (int i = 0; i < 60; i++) {
+    predictor.RecordBuildDuration(fml::TimeDelta::FromMilliseconds(4));
+  }
+  EXPECT_FALSE(
+      predictor.IsPredictedToMiss(fml::TimeDelta::FromMilliseconds(16)));
+}
+
+}  // namespace testing
+}  // namespace flutter
@@ -2,6 +2,7 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file.
 
+#include "flutter/shell/common/pointer_data_dispatcher.h"
 #include "flutter/shell/common/shell_test.h"
 #include "flutter/testing/testing.h"
 
@@ -430,6 +431,175 @@ TEST_F(ShellTest, CanCorrectlySynthesizePointerPacket) {
   ASSERT_FALSE(DartVMRef::IsInstanceRunning());
 }
 
+class FakePointerDataDispatcherDelegate
+    : public PointerDataDispatcher::Delegate {
+ public:
+  void DoDispatchPacket(std::unique_ptr<PointerDataPacket> packet,
+                        uint64_t trace_flow_id) override {
+    packets.push_back(std::move(packet));
+    trace_flow_ids.push_back(trace_flow_id);
+  }
+
+  void ScheduleSecondaryVsyncCallback(uintptr_t id,
+                                      const fml::closure& callback) override {
+    vsync_callback = callback;
+  }
+
+  void SimulateVsync() {
+    fml::closure callback = std::move(vsync_callback);
+    vsync_callback = nullptr;
+    if (callback) {
+      callback();
+    }
+  }
+
+  std::vector<std::unique_ptr<PointerDataPacket>> packets;
+  std::vector<uint64_t> trace_flow_ids;
+  fml::closure vsync_callback;
+};
+
+static PointerData CreateBatchingTestPointerData(PointerData::Change change,
+                                                 int64_t device,
+                                                 int64_t time_stamp,
+                                                 double x,
+                                                 double delta_x) {
+  PointerData data;
+  data.Clear();
+  CreateSimulatedPointerData(data, change, x, 0.0);
+  data.device = device;
+  data.time_stamp = time_stamp;
+  data.physical_delta_x = delta_x;
+  return data;
+}
+
+static std::unique_ptr<PointerDataPacket> CreateBatchingTestPacket(
+    const std::vector<PointerData>& events) {
+  auto packet = std::make_unique<PointerDataPacket>(events.size());
+  for (size_t i = 0; i < events.size(); i++) {
+    packet->SetPointerData(i, events[i]);
+  }
+  return packet;
+}
+
+TEST(BatchingPointerDataDispatcherTest, CoalescesMovesWithinAFrame) {
+  FakePointerDataDispatcherDelegate delegate;
+  BatchingPointerDataDispatcher dispatcher(delegate);
+  using Change = PointerData::Change;
+
+  dispatcher.DispatchPacket(
+      CreateBatchingTestPacket(
+          {CreateBatchingTestPointerData(Change::kDown, 0, 0, 0.0, 0.0)}),
+      1);
+  for (int i = 1; i <= 3; i++) {
+    dispatcher.DispatchPacket(CreateBatchingTestPacket({
+                                  CreateBatchingTestPointerData(
+                                      Change::kMove, 0, i * 4, i * 2.0, 2.0),
+                              }),
+                              i + 1);
+  }
+  EXPECT_TRUE(delegate.packets.empty());
+
+  delegate.SimulateVsync();
+  ASSERT_EQ(delegate.packets.size(), 1u);
+  EXPECT_EQ(delegate.trace_flow_ids[0], 4u);
+  const PointerDataPacket& packet = *delegate.packets[0];
+  ASSERT_EQ(packet.GetLength(), 2u);
+  EXPECT_EQ(packet.GetPointerData(0).change, Change::kDown);
+  const PointerData move = packet.GetPointerData(1);
+  EXPECT_EQ(move.change, Change::kMove);
+  EXPECT_EQ(move.time_stamp, 12);
+  EXPECT_EQ(move.physical_x, 6.0);
+  EXPECT_EQ(move.physical_delta_x, 6.0);
+
+  // Nothing is dispatched for frames without events.
+  delegate.SimulateVsync();
+  EXPECT_EQ(delegate.packets.size(), 1u);
+}
+
+TEST(BatchingPointerDataDispatcherTest, KeepsTheOrderOfDownsAndUps) {
+  FakePointerDataDispatcherDelegate delegate;
+  BatchingPointerDataDispatcher dispatcher(delegate);
+  using Change = PointerData::Change;
+
+  dispatcher.DispatchPacket(
+      CreateBatchingTestPacket({
+          CreateBatchingTestPointerData(Change::kDown, 0, 0, 0.0, 0.0),
+          CreateBatchingTestPointerData(Change::kMove, 0, 1, 1.0, 1.0),
+          CreateBatchingTestPointerData(Change::kMove, 0, 2, 2.0, 1.0),
+          CreateBatchingTestPointerData(Change::kUp, 0, 3, 2.0, 0.0),
+          CreateBatchingTestPointerData(Change::kDown, 0, 4, 5.0, 0.0),
+          CreateBatchingTestPointerData(Change::kMove, 0, 5, 6.0, 1.0),
+          CreateBatchingTestPointerData(Change::kMove, 0, 6, 7.0, 1.0),
+      }),
+      1);
+  delegate.SimulateVsync();
+
+  ASSERT_EQ(delegate.packets.size(), 1u);
+  const PointerDataPacket& packet = *delegate.packets[0];
+  const std::vector<Change> expected_changes = {
+      Change::kDown, Change::kMove, Change::kUp, Change::kDown, Change::kMove};
+  ASSERT_EQ(packet.GetLength(), expected_changes.size());
+  for (size_t i = 0; i < expected_changes.size(); i++) {
+    EXPECT_EQ(packet.GetPointerData(i).change, expected_changes[i]);
+  }
+  EXPECT_EQ(packet.GetPointerData(1).physical_x, 2.0);
+  EXPECT_EQ(packet.GetPointerData(1).physical_delta_x, 2.0);
+  EXPECT_EQ(packet.GetPointerData(4).physical_x, 7.0);
+  EXPECT_EQ(packet.GetPointerData(4).physical_delta_x, 2.0);
+}
+
+TEST(BatchingPointerDataDispatcherTest, ResamplesMovesToTheLatestEventTime) {
+  FakePointerDataDispatcherDelegate delegate;
+  BatchingPointerDataDispatcher dispatcher(delegate);
+  using Change = PointerData::Change;
+
+  dispatcher.DispatchPacket(
+      CreateBatchingTestPacket({
+          CreateBatchingTestPointerData(Change::kDown, 0, 0, 0.0, 0.0),
+          CreateBatchingTestPointerData(Change::kDown, 1, 0, 0.0, 0.0),
+          CreateBatchingTestPointerData(Change::kMove, 0, 10, 10.0, 10.0),
+          CreateBatchingTestPointerData(Change::kMove, 0, 20, 20.0, 10.0),
+          CreateBatchingTestPointerData(Change::kMove, 1, 25, 5.0, 5.0),
+      }),
+      1);
+  delegate.SimulateVsync();
+
+  ASSERT_EQ(delegate.packets.size(), 1u);
+  const PointerDataPacket& packet = *delegate.packets[0];
+  ASSERT_EQ(packet.GetLength(), 4u);
+  const PointerData resampled = packet.GetPointerData(2);
+  EXPECT_EQ(resampled.device, 0);
+  EXPECT_EQ(resampled.time_stamp, 25);
+  EXPECT_EQ(resampled.physical_x, 25.0);
+  // Only the position is extrapolated, the deltas are the ones reported.
+  EXPECT_EQ(resampled.physical_delta_x, 20.0);
+  const PointerData latest = packet.GetPointerData(3);
+  EXPECT_EQ(latest.device, 1);
+  EXPECT_EQ(latest.time_stamp, 25);
+  EXPECT_EQ(latest.physical_x, 5.0);
+}
+
+TEST(BatchingPointerDataDispatcherTest, ExtrapolatesAtMostOneSampleInterval) {
+  FakePointerDataDispatcherDelegate delegate;
+  BatchingPointerDataDispatcher dispatcher(delegate);
+  using Change = PointerData::Change;
+
+  dispatcher.DispatchPacket(
+      CreateBatchingTestPacket({
+          CreateBatchingTestPointerData(Change::kMove, 0, 10, 10.0, 10.0),
+          CreateBatchingTestPointerData(Change::kMove, 0, 20, 20.0, 10.0),
+          CreateBatchingTestPointerData(Change::kHover, 1, 60, 0.0, 0.0),
+      }),
+      1);
+  delegate.SimulateVsync();
+
+  ASSERT_EQ(delegate.packets.size(), 1u);
+  const PointerData resampled = delegate.packets[0]->GetPointerData(0);
+  EXPECT_EQ(resampled.time_stamp, 30);
+  EXPECT_EQ(resampled.physical_x, 30.0);
+  EXPECT_EQ(resampled.physical_delta_x, 20.0);
+}
+
 }  // namespace testing
 }  // namespace flutter
 
@@ -5,15 +5,14 @@
 #ifndef FLUTTER_SHELL_COMMON_PIPELINE_H_
 #define FLUTTER_SHELL_COMMON_PIPELINE_H_
 
-#include <deque>
+#include <algorithm>
+#include <atomic>
 #include <memory>
-#include <mutex>
 
 #include "flutter/flow/frame_timings.h"
 #include "flutter/flow/layers/layer_tree.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/memory/ref_counted.h"
-#include "flutter/fml/synchronization/semaphore.h"
 #include "flutter/fml/trace_event.h"
 
 namespace flutter {
@@ -39,6 +38,10 @@ size_t GetNextPipelineTraceID();
 /// A thread-safe queue of resources for a single consumer and a single
 /// producer, with a maximum queue depth.
 ///
+/// Resources are kept in a lock-free bounded ring. Besides the producer, the
+/// consumer may push back a resource it could not consume with
+/// |ProduceIfEmpty|, so committing to the ring tolerates concurrent producers.
+///
 /// Pipelines support two key operations: produce and consume.
 ///
 /// The consumer calls |Consume| to wait for a resource to be produced and
@@ -128,12 +131,34 @@ class Pipeline {
     FML_DISALLOW_COPY_AND_ASSIGN(ProducerContinuation);
   };
 
-  explicit Pipeline(uint32_t depth)
-      : empty_(depth), available_(0), inflight_(0) {}
+  /// Creates a pipeline that allows |depth| resources in flight. The depth
+  /// may later be changed with |SetDepth|, up to the larger of |depth| and
+  /// |max_depth|.
+  explicit Pipeline(uint32_t depth, uint32_t max_depth = 0)
+      : capacity_(std::max(depth, max_depth)),
+        depth_(depth),
+        inflight_(0),
+        reserved_(0),
+        ring_(std::make_unique<Slot[]>(capacity_)) {
+    for (size_t i = 0; i < capacity_; i++) {
+      ring_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
 
   ~Pipeline() = default;
 
-  bool IsValid() const { return empty_.IsValid() && available_.IsValid(); }
+  bool IsValid() const { return ring_ != nullptr; }
+
+  /// Changes the number of resources allowed in flight. Lowering the depth
+  /// doesn't drop resources already in flight, producing just fails until
+  /// enough of them have been consumed.
+  void SetDepth(uint32_t depth) {
+    FML_DCHECK(depth <= capacity_);
+    depth_.store(std::min<uint32_t>(depth, capacity_),
+                 std::memory_order_relaxed);
+  }
+
+  uint32_t GetDepth() const { return depth_.load(std::memory_order_relaxed); }
 
   /// Creates a `ProducerContinuation` that a producer can use to add a
   /// resource to the queue.
@@ -141,7 +166,7 @@ class Pipeline {
   /// If the queue is already at its maximum depth, the `ProducerContinuation`
   /// is returned with success = false.
   ProducerContinuation Produce() {
-    if (!empty_.TryWait()) {
+    if (!TryReserve()) {
       return {};
     }
     ++inflight_;
@@ -162,7 +187,7 @@ class Pipeline {
   /// Prefer using |Produce|. ProducerContinuation returned by this method
   /// doesn't guarantee that the frame will be rendered.
   ProducerContinuation ProduceIfEmpty() {
-    if (!empty_.TryWait()) {
+    if (!TryReserve()) {
       return {};
     }
     ++inflight_;
@@ -185,24 +210,23 @@ class Pipeline {
       return PipelineConsumeResult::NoneAvailable;
     }
 
-    if (!available_.TryWait()) {
+    // Only the consumer advances the head.
+    const size_t head = head_.load(std::memory_order_relaxed);
+    Slot& slot = ring_[head % capacity_];
+    // Sequentially consistent, see |ProducerCommit|.
+    if (slot.sequence.load(std::memory_order_seq_cst) != head + 1) {
       return PipelineConsumeResult::NoneAvailable;
     }
 
-    ResourcePtr resource;
-    size_t trace_id = 0;
-    size_t items_count = 0;
-
-    {
-      std::scoped_lock lock(queue_mutex_);
-      std::tie(resource, trace_id) = std::move(queue_.front());
-      queue_.pop_front();
-      items_count = queue_.size();
-    }
+    ResourcePtr resource = std::move(slot.resource);
+    const size_t trace_id = slot.trace_id;
+    slot.sequence.store(head + capacity_, std::memory_order_release);
+    head_.store(head + 1, std::memory_order_seq_cst);
+    const size_t items_count = tail_.load(std::memory_order_seq_cst) - head - 1;
 
     consumer(std::move(resource));
 
-    empty_.Signal();
+    reserved_.fetch_sub(1, std::memory_order_release);
     --inflight_;
 
     TRACE_FLOW_END("flutter", "PipelineItem", trace_id);
@@ -213,42 +237,77 @@ class Pipeline {
   }
 
  private:
-  fml::Semaphore empty_;
-  fml::Semaphore available_;
+  /// A slot in the ring. Its |sequence| is the position the slot will be
+  /// written at next while it is free, and one past that position once the
+  /// resource has been committed and can be consumed.
+  struct Slot {
+    std::atomic<size_t> sequence;
+    ResourcePtr resource;
+    size_t trace_id = 0;
+  };
+
+  const uint32_t capacity_;
+  std::atomic<uint32_t> depth_;
   std::atomic<int> inflight_;
-  std::mutex queue_mutex_;
-  std::deque<std::pair<ResourcePtr, size_t>> queue_;
+  // Slots reserved by producers, including the one being consumed. Never
+  // exceeds |capacity_|, so committing always finds a free slot.
+  std::atomic<uint32_t> reserved_;
+  std::unique_ptr<Slot[]> ring_;
+  // Keep the positions on separate cache lines so that the producer and the
+  // consumer don't invalidate each other's.
+  alignas(64) std::atomic<size_t> head_ = 0;
+  alignas(64) std::atomic<size_t> tail_ = 0;
+
+  bool TryReserve() {
+    uint32_t reserved = reserved_.load(std::memory_order_relaxed);
+    do {
+      if (reserved >= depth_.load(std::memory_order_relaxed)) {
+        return false;
+      }
+    } while (!reserved_.compare_exchange_weak(reserved, reserved + 1,
+                                              std::memory_order_acquire,
+                                              std::memory_order_relaxed));
+    return true;
+  }
 
-  /// Commits a produced resource to the queue and signals the consumer that a
-  /// resource is available.
-  PipelineProduceResult ProducerCommit(ResourcePtr resource, size_t trace_id) {
-    bool is_first_item = false;
-    {
-      std::scoped_lock lock(queue_mutex_);
-      is_first_item = queue_.empty();
-      queue_.emplace_back(std::move(resource), trace_id);
-    }
+  void WriteSlot(size_t position, ResourcePtr resource, size_t trace_id) {
+    Slot& slot = ring_[position % capacity_];
+    FML_DCHECK(slot.sequence.load(std::memory_order_acquire) == position);
+    slot.resource = std::move(resource);
+    slot.trace_id = trace_id;
+    slot.sequence.store(position + 1, std::memory_order_seq_cst);
+  }
 
-    // Ensure the queue mutex is not held as that would be a pessimization.
-    available_.Signal();
+  /// Commits a produced resource to the queue, making it available to the
+  /// consumer.
+  ///
+  /// The producer publishes the tail and then reads the head, while the
+  /// consumer publishes the head and then reads the tail. Either the producer
+  /// sees the resource it committed as the first item and schedules the
+  /// consumer, or the consumer sees it and reports |MoreAvailable|. With
+  /// acquire/release ordering both sides could read the other's stale
+  /// position and no one would consume the resource, so these accesses, and
+  /// the slot sequence the consumer reads on its next attempt, are
+  /// sequentially consistent.
+  PipelineProduceResult ProducerCommit(ResourcePtr resource, size_t trace_id) {
+    const size_t position = tail_.fetch_add(1, std::memory_order_seq_cst);
+    WriteSlot(position, std::move(resource), trace_id);
+    const bool is_first_item =
+        head_.load(std::memory_order_seq_cst) == position;
     return {.success = true, .is_first_item = is_first_item};
   }
 
   PipelineProduceResult ProducerCommitIfEmpty(ResourcePtr resource,
                                               size_t trace_id) {
-    {
-      std::scoped_lock lock(queue_mutex_);
-      if (!queue_.empty()) {
-        // Bail if the queue is not empty, opens up spaces to produce other
-        // frames.
-        empty_.Signal();
-        return {.success = false, .is_first_item = false};
-      }
-      queue_.emplace_back(std::move(resource), trace_id);
+    size_t position = head_.load(std::memory_order_acquire);
+    if (!tail_.compare_exchange_strong(position, position + 1,
+                                       std::memory_order_acq_rel)) {
+      // Bail if the queue is not empty, opens up spaces to produce other
+      // frames.
+      reserved_.fetch_sub(1, std::memory_order_release);
+      return {.success = false, .is_first_item = false};
     }
-
-    // Ensure the queue mutex is not held as that would be a pessimization.
-    available_.Signal();
+    WriteSlot(position, std::move(resource), trace_id);
     return {.success = true, .is_first_item = true};
   }
 
@@ -0,0 +1,67 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/pipeline.h"
+
+#include <atomic>
+#include <memory>
+#include <thread>
+
+#include "flutter/benchmarking/benchmarking.h"
+#include "flutter/fml/time/time_point.h"
+
+namespace flutter {
+
+using TimePointPipeline = Pipeline<fml::TimePoint>;
+
+// Hands items from a producer to a consumer thread the way the animator hands
+// frames to the rasterizer, reporting the average time between completing an
+// item and the consumer receiving it.
+static void BM_PipelineProduceToConsumeLatency(
+    benchmark::State& state) {  // NOLINT
+  const uint32_t depth = state.range(0);
+  auto pipeline = std::make_shared<TimePointPipeline>(depth);
+  std::atomic_bool done = false;
+  int64_t total_latency_nanos = 0;
+  int64_t consumed = 0;
+
+  std::thread consumer([&]() {
+    auto on_consume = [&](std::unique_ptr<fml::TimePoint> produced) {
+      total_latency_nanos +=
+          (fml::TimePoint::Now() - *produced).ToNanoseconds();
+      consumed++;
+    };
+    while (!done.load(std::memory_order_acquire)) {
+      if (pipeline->Consume(on_consume) ==
+          PipelineConsumeResult::NoneAvailable) {
+        std::this_thread::yield();
+      }
+    }
+  });
+
+  for (auto _ : state) {
+    TimePointPipeline::ProducerContinuation continuation;
+    while (!(continuation = pipeline->Produce())) {
+      std::this_thread::yield();
+    }
+    PipelineProduceResult result = continuation.Complete(
+        std::make_unique<fml::TimePoint>(fml::TimePoint::Now()));
+    benchmark::DoNotOptimize(result);
+  }
+
+  done.store(true, std::memory_order_release);
+  consumer.join();
+
+  state.counters["latency_ns"] = benchmark::Counter(
+      consumed > 0 ? static_cast<double>(total_latency_nanos) / consumed : 0);
+  state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_PipelineProduceToConsumeLatency)
+    ->Arg(1)
+    ->Arg(2)
+    ->Arg(3)
+    ->UseRealTime();
+
+}  // namespace flutter
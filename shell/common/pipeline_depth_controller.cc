@@ -0,0 +1,81 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "flutter/shell/common/pipeline_depth_controller.h"
+
+#include <algorithm>
+#include <bitset>
+
+#include "flutter/fml/trace_event.h"
+
+namespace flutter {
+
+static_assert(PipelineDepthController::kIncreaseWindow <= 32,
+              "The increase window must fit the history bits.");
+
+PipelineDepthController::PipelineDepthController(uint32_t initial_depth)
+    : depth_(std::clamp(initial_depth, kMinDepth, kMaxDepth)) {}
+
+PipelineDepthController::~PipelineDepthController() = default;
+
+uint32_t PipelineDepthController::GetNeededDepth(
+    fml::TimeDelta build_duration,
+    fml::TimeDelta raster_duration,
+    fml::TimeDelta frame_budget) {
+  const int64_t budget = frame_budget.ToMicroseconds();
+  const int64_t build = build_duration.ToMicroseconds();
+  const int64_t raster = raster_duration.ToMicroseconds();
+  if (build + raster <= budget * kSerialBudgetFraction) {
+    return 1;
+  }
+  if (std::max(build, raster) <= budget) {
+    return 2;
+  }
+  return 3;
+}
+
+void PipelineDepthController::RecordFrame(fml::TimeDelta build_duration,
+                                          fml::TimeDelta raster_duration,
+                                          fml::TimeDelta frame_budget) {
+  const uint32_t depth = depth_.load(std::memory_order_relaxed);
+  const uint32_t needed_depth =
+      GetNeededDepth(build_duration, raster_duration, frame_budget);
+
+  needs_increase_history_ =
+      ((needs_increase_history_ << 1) | (needed_depth > depth ? 1 : 0)) &
+      ((1u << kIncreaseWindow) - 1);
+  if (std::bitset<32>(needs_increase_history_).count() >= kFramesToIncrease) {
+    SetDepth(depth + 1);
+    return;
+  }
+
+  if (needed_depth < depth) {
+    frames_fitting_lower_depth_++;
+  } else {
+    frames_fitting_lower_depth_ = 0;
+  }
+  if (frames_fitting_lower_depth_ >= kFramesToDecrease) {
+    SetDepth(depth - 1);
+  }
+}
+
+uint32_t PipelineDepthController::GetDepth() const {
+  return depth_.load(std::memory_order_relaxed);
+}
+
+void PipelineDepthController::SetDepth(uint32_t depth) {
+  depth = std::clamp(depth, kMinDepth, kMaxDepth);
+  needs_increase_history_ = 0;
+  frames_fitting_lower_depth_ = 0;
+  if (depth == depth_.load(std::memory_order_relaxed)) {
+    return;
+  }
+  depth_.store(depth, std::memory_order_relaxed);
+  FML_TRACE_COUNTER("flutter", "PipelineDepthController",
+                    reinterpret_cast<int64_t>(this),  //
+                    "depth", depth                    //
+  );
+}
+
+}  // namespace flutter
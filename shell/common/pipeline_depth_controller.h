@@ -0,0 +1,80 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef FLUTTER_SHELL_COMMON_PIPELINE_DEPTH_CONTROLLER_H_
+#define FLUTTER_SHELL_COMMON_PIPELINE_DEPTH_CONTROLLER_H_
+
+#include <atomic>
+#include <cstdint>
+
+#include "flutter/fml/macros.h"
+#include "flutter/fml/time/time_delta.h"
+
+namespace flutter {
+
+//------------------------------------------------------------------------------
+/// @brief      Picks the depth of the frame pipeline from measured build and
+///             raster durations.
+///
+///             At depth 1, the UI thread can't start building a frame until
+///             the previous one has been rasterized, which gives the lowest
+///             latency but only fits the frame budget if building and
+///             rasterizing together do. At depth 2, building and rasterizing
+///             overlap, so each only has to fit the budget on its own. Depth 3
+///             additionally absorbs occasional frames where even that fails.
+///
+///             The depth goes up as soon as a few recent frames need it and
+///             only comes down after a long run of frames that would have fit
+///             the lower depth, so that it doesn't oscillate.
+///
+///             Frames are recorded on the raster thread and the depth may be
+///             read from any thread.
+///
+class PipelineDepthController {
+ public:
+  static constexpr uint32_t kMinDepth = 1;
+  static constexpr uint32_t kMaxDepth = 3;
+
+  /// The number of frames within |kIncreaseWindow| that must need a larger
+  /// depth before it is increased.
+  static constexpr uint32_t kFramesToIncrease = 3;
+  static constexpr uint32_t kIncreaseWindow = 10;
+
+  /// The number of consecutive frames that must fit a smaller depth before it
+  /// is decreased.
+  static constexpr uint32_t kFramesToDecrease = 60;
+
+  /// The fraction of the frame budget that building and rasterizing must fit
+  /// in for a frame to be considered cheap enough for depth 1.
+  static constexpr double kSerialBudgetFraction = 0.8;
+
+  explicit PipelineDepthController(uint32_t initial_depth);
+
+  ~PipelineDepthController();
+
+  /// Records the durations of a rasterized frame and updates the depth.
+  void RecordFrame(fml::TimeDelta build_duration,
+                   fml::TimeDelta raster_duration,
+                   fml::TimeDelta frame_budget);
+
+  uint32_t GetDepth() const;
+
+ private:
+  std::atomic<uint32_t> depth_;
+  // Bit i is set if the i-th most recent frame needed a larger depth.
+  uint32_t needs_increase_history_ = 0;
+  uint32_t frames_fitting_lower_depth_ = 0;
+
+  static uint32_t GetNeededDepth(fml::TimeDelta build_duration,
+                                 fml::TimeDelta raster_duration,
+                                 fml::TimeDelta frame_budget);
+
+  void SetDepth(uint32_t depth);
+
+  FML_DISALLOW_COPY_AND_ASSIGN(PipelineDepthController);
+};
+
+}  // namespace flutter
+
+#endif  // FLUTTER_SHELL_COMMON_PIPELINE_DEPTH_CONTROLLER_H_
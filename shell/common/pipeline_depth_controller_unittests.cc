@@ -0,0 +1,88 @@
+// Copyright 2013 The Flutter Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#define FML_USED_ON_EMBEDDER
+
+#include "flutter/shell/common/pipeline_depth_controller.h"
+
+#include "gtest/gtest.h"
+
+namespace flutter {
+namespace testing {
+
+namespace {
+
+constexpr fml::TimeDelta kBudget = fml::TimeDelta::FromMilliseconds(16);
+
+void RecordFrames(PipelineDepthController& controller,
+                  size_t count,
+                  int64_t build_millis,
+                  int64_t raster_millis) {
+  for (size_t i = 0; i < count; i++) {
+    controller.RecordFrame(fml::TimeDelta::FromMilliseconds(build_millis),
+                           fml::TimeDelta::FromMilliseconds(raster_millis),
+                           kBudget);
+  }
+}
+
+}  // namespace
+
+TEST(PipelineDepthControllerTest, ClampsInitialDepth) {
+  EXPECT_EQ(PipelineDepthController(0).GetDepth(),
+            PipelineDepthController::kMinDepth);
+  EXPECT_EQ(PipelineDepthController(10).GetDepth(),
+            PipelineDepthController::kMaxDepth);
+}
+
+TEST(PipelineDepthControllerTest, IncreasesAfterSeveralSlowFrames) {
+  PipelineDepthController controller(1);
+  // Building and rasterizing together don't fit the budget, but each does.
+  RecordFrames(controller, 2, 10, 10);
+  EXPECT_EQ(controller.GetDepth(), 1u);
+  RecordFrames(controller, 1, 10, 10);
+  EXPECT_EQ(controller.GetDepth(), 2u);
+
+  // Rasterizing alone doesn't fit the budget.
+  RecordFrames(controller, 3, 4, 20);
+  EXPECT_EQ(controller.GetDepth(), 3u);
+  RecordFrames(controller, 10, 4, 40);
+  EXPECT_EQ(controller.GetDepth(), 3u);
+}
+
+TEST(PipelineDepthControllerTest, IgnoresIsolatedSlowFrames) {
+  PipelineDepthController controller(1);
+  for (int i = 0; i < 10; i++) {
+    RecordFrames(controller, 1, 10, 10);
+    RecordFrames(controller, 4, 2, 2);
+  }
+  EXPECT_EQ(controller.GetDepth(), 1u);
+}
+
+TEST(PipelineDepthControllerTest, DecreasesAfterManyCheapFrames) {
+  PipelineDepthController controller(3);
+  RecordFrames(controller, PipelineDepthController::kFramesToDecrease - 1, 2,
+               2);
+  EXPECT_EQ(controller.GetDepth(), 3u);
+  RecordFrames(controller, 1, 2, 2);
+  EXPECT_EQ(controller.GetDepth(), 2u);
+  RecordFrames(controller, PipelineDepthController::kFramesToDecrease, 2, 2);
+  EXPECT_EQ(controller.GetDepth(), 1u);
+  RecordFrames(controller, PipelineDepthController::kFramesToDecrease, 2, 2);
+  EXPECT_EQ(controller.GetDepth(), 1u);
+}
+
+TEST(PipelineDepthControllerTest, SlowFrameRestartsDecreaseCountdown) {
+  PipelineDepthController controller(2);
+  RecordFrames(controller, PipelineDepthController::kFramesToDecrease - 1, 2,
+               2);
+  RecordFrames(controller, 1, 10, 10);
+  RecordFrames(controller, PipelineDepthController::kFramesToDecrease - 1, 2,
+               2);
+  EXPECT_EQ(controller.GetDepth(), 2u);
+  RecordFrames(controller, 1, 2, 2);
+  EXPECT_EQ(controller.GetDepth(), 1u);
+}
+
+}  // namespace testing
+}  // namespace flutter
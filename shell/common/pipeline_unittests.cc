@@ -6,9 +6,15 @@
 
 #include "flutter/shell/common/pipeline.h"
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <functional>
 #include <future>
 #include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 #include "gtest/gtest.h"
 
@@ -144,5 +150,165 @@ TEST(PipelineTest, ProduceIfEmptySuccessfulIfQueueIsEmpty) {
   ASSERT_EQ(consume_result_1, PipelineConsumeResult::Done);
 }
 
+TEST(PipelineTest, FailedProduceIfEmptyReleasesItsSlot) {
+  const int depth = 2;
+  std::shared_ptr<IntPipeline> pipeline = std::make_shared<IntPipeline>(depth);
+
+  PipelineProduceResult result =
+      pipeline->Produce().Complete(std::make_unique<int>(1));
+  ASSERT_EQ(result.success, true);
+  result = pipeline->ProduceIfEmpty().Complete(std::make_unique<int>(2));
+  ASSERT_EQ(result.success, false);
+
+  result = pipeline->Produce().Complete(std::make_unique<int>(3));
+  ASSERT_EQ(result.success, true);
+  ASSERT_EQ(result.is_first_item, false);
+
+  std::vector<int> consumed;
+  auto consumer = [&consumed](std::unique_ptr<int> v) {
+    consumed.push_back(*v);
+  };
+  ASSERT_EQ(pipeline->Consume(consumer), PipelineConsumeResult::MoreAvailable);
+  ASSERT_EQ(pipeline->Consume(consumer), PipelineConsumeResult::Done);
+  ASSERT_EQ(consumed, std::vector<int>({1, 3}));
+}
+
+TEST(PipelineTest, ConcurrentProduceAndConsumePreservesOrder) {
+  const int depth = 2;
+  const int count = 10000;
+  std::shared_ptr<IntPipeline> pipeline = std::make_shared<IntPipeline>(depth);
+
+  std::thread producer([pipeline]() {
+    for (int i = 0; i < count;) {
+      Continuation continuation = pipeline->Produce();
+      if (!continuation) {
+        std::this_thread::yield();
+        continue;
+      }
+      ASSERT_TRUE(continuation.Complete(std::make_unique<int>(i)).success);
+      i++;
+    }
+  });
+
+  int expected = 0;
+  while (expected < count) {
+    auto result = pipeline->Consume([&expected](std::unique_ptr<int> v) {
+      ASSERT_EQ(*v, expected);
+      expected++;
+    });
+    if (result == PipelineConsumeResult::NoneAvailable) {
+      std::this_thread::yield();
+    }
+  }
+  producer.join();
+  ASSERT_EQ(pipeline->Consume([](std::unique_ptr<int> v) { FAIL(); }),
+            PipelineConsumeResult::NoneAvailable);
+}
+
+TEST(PipelineTest, DepthCanBeChangedUpToMaxDepth) {
+  std::shared_ptr<IntPipeline> pipeline = std::make_shared<IntPipeline>(1, 3);
+  ASSERT_EQ(pipeline->GetDepth(), 1u);
+
+  Continuation continuation_1 = pipeline->Produce();
+  ASSERT_TRUE(continuation_1);
+  ASSERT_FALSE(pipeline->Produce());
+
+  pipeline->SetDepth(3);
+  Continuation continuation_2 = pipeline->Produce();
+  Continuation continuation_3 = pipeline->Produce();
+  ASSERT_TRUE(continuation_2);
+  ASSERT_TRUE(continuation_3);
+  ASSERT_FALSE(pipeline->Produce());
+  ASSERT_TRUE(continuation_1.Complete(std::make_unique<int>(1)).success);
+  ASSERT_TRUE(continuation_2.Complete(std::make_unique<int>(2)).success);
+  ASSERT_TRUE(continuation_3.Complete(std::make_unique<int>(3)).success);
+
+  // Lowering the depth keeps the resources in flight.
+  pipeline->SetDepth(1);
+  std::vector<int> consumed;
+  auto consumer = [&consumed](std::unique_ptr<int> v) {
+    consumed.push_back(*v);
+  };
+  ASSERT_EQ(pipeline->Consume(consumer), PipelineConsumeResult::MoreAvailable);
+  ASSERT_FALSE(pipeline->Produce());
+  ASSERT_EQ(pipeline->Consume(consumer), PipelineConsumeResult::MoreAvailable);
+  ASSERT_EQ(pipeline->Consume(consumer), PipelineConsumeResult::Done);
+  ASSERT_EQ(consumed, std::vector<int>({1, 2, 3}));
+  ASSERT_TRUE(pipeline->Produce());
+}
+
+// Schedules the consumer the way the animator and the rasterizer do: the
+// producer only requests a consume when it committed the first item, and the
+// consumer requests another one when more items are available. Returns the
+// number of items consumed before the requests ran dry.
+static int ProduceAndConsumeWithScheduledConsumer(uint32_t depth, int count) {
+  std::shared_ptr<IntPipeline> pipeline = std::make_shared<IntPipeline>(depth);
+  std::mutex mutex;
+  std::condition_variable cv;
+  int requested = 0;
+  bool produced_all = false;
+  std::atomic<bool> stalled = false;
+
+  auto request_consume = [&]() {
+    std::scoped_lock lock(mutex);
+    requested++;
+    cv.notify_one();
+  };
+
+  std::thread producer([&]() {
+    for (int i = 0; i < count && !stalled;) {
+      Continuation continuation = pipeline->Produce();
+      if (!continuation) {
+        std::this_thread::yield();
+        continue;
+      }
+      PipelineProduceResult result =
+          continuation.Complete(std::make_unique<int>(i));
+      EXPECT_TRUE(result.success);
+      if (result.is_first_item) {
+        request_consume();
+      }
+      i++;
+    }
+    std::scoped_lock lock(mutex);
+    produced_all = true;
+    cv.notify_one();
+  });
+
+  int consumed = 0;
+  while (true) {
+    {
+      std::unique_lock lock(mutex);
+      // A lost request leaves items behind that no one will consume.
+      if (!cv.wait_for(lock, std::chrono::seconds(5), [&]() {
+            return requested > 0 || (produced_all && consumed == count);
+          })) {
+        stalled = true;
+        break;
+      }
+      if (requested == 0) {
+        break;
+      }
+      requested--;
+    }
+    PipelineConsumeResult result =
+        pipeline->Consume([&consumed](std::unique_ptr<int> v) {
+          EXPECT_EQ(*v, consumed);
+          consumed++;
+        });
+    if (result == PipelineConsumeResult::MoreAvailable) {
+      request_consume();
+    }
+  }
+  producer.join();
+  return consumed;
+}
+
+TEST(PipelineTest, EveryProducedItemIsConsumedWhenConsumesAreScheduled) {
+  const int count = 100000;
+  ASSERT_EQ(ProduceAndConsumeWithScheduledConsumer(2, count), count);
+  ASSERT_EQ(ProduceAndConsumeWithScheduledConsumer(3, count), count);
+}
+
 }  // namespace testing
 }  // namespace flutter
@@ -4,6 +4,8 @@
 
 #include "flutter/shell/common/pointer_data_dispatcher.h"
 
+#include <algorithm>
+
 #include "flutter/fml/trace_event.h"
 
 namespace flutter {
@@ -15,6 +17,10 @@ SmoothPointerDataDispatcher::SmoothPointerDataDispatcher(Delegate& delegate)
     : DefaultPointerDataDispatcher(delegate), weak_factory_(this) {}
 SmoothPointerDataDispatcher::~SmoothPointerDataDispatcher() = default;
 
+BatchingPointerDataDispatcher::BatchingPointerDataDispatcher(Delegate& delegate)
+    : DefaultPointerDataDispatcher(delegate), weak_factory_(this) {}
+BatchingPointerDataDispatcher::~BatchingPointerDataDispatcher() = default;
+
 void DefaultPointerDataDispatcher::DispatchPacket(
     std::unique_ptr<PointerDataPacket> packet,
     uint64_t trace_flow_id) {
@@ -72,4 +78,143 @@ void SmoothPointerDataDispatcher::DispatchPendingPacket() {
   ScheduleSecondaryVsyncCallback();
 }
 
+namespace {
+
+bool IsCoalescableMove(const PointerData& event) {
+  return (event.change == PointerData::Change::kMove ||
+          event.change == PointerData::Change::kHover) &&
+         event.signal_kind == PointerData::SignalKind::kNone;
+}
+
+}  // namespace
+
+void BatchingPointerDataDispatcher::DispatchPacket(
+    std::unique_ptr<PointerDataPacket> packet,
+    uint64_t trace_flow_id) {
+  TRACE_EVENT0_WITH_FLOW_IDS("flutter",
+                             "BatchingPointerDataDispatcher::DispatchPacket",
+                             /*flow_id_count=*/1, &trace_flow_id);
+  TRACE_FLOW_STEP("flutter", "PointerEvent", trace_flow_id);
+
+  const size_t length = packet->GetLength();
+  for (size_t i = 0; i < length; i++) {
+    AddEvent(packet->GetPointerData(i));
+  }
+  pending_trace_flow_ids_.push_back(trace_flow_id);
+  ScheduleSecondaryVsyncCallback();
+}
+
+void BatchingPointerDataDispatcher::AddEvent(const PointerData& event) {
+  auto move = std::find_if(
+      coalescing_moves_.begin(), coalescing_moves_.end(),
+      [&event](const CoalescingMove& move) {
+        return move.device == event.device;
+      });
+
+  if (!IsCoalescableMove(event)) {
+    if (move != coalescing_moves_.end()) {
+      coalescing_moves_.erase(move);
+    }
+    pending_events_.push_back(event);
+    return;
+  }
+
+  if (move != coalescing_moves_.end()) {
+    PointerData& last = pending_events_[move->index];
+    if (last.change == event.change && last.buttons == event.buttons &&
+        last.view_id == event.view_id) {
+      move->has_previous_sample = true;
+      move->previous_time_stamp = last.time_stamp;
+      move->previous_x = last.physical_x;
+      move->previous_y = last.physical_y;
+      const double delta_x = last.physical_delta_x + event.physical_delta_x;
+      const double delta_y = last.physical_delta_y + event.physical_delta_y;
+      last = event;
+      last.physical_delta_x = delta_x;
+      last.physical_delta_y = delta_y;
+      return;
+    }
+    coalescing_moves_.erase(move);
+  }
+
+  coalescing_moves_.push_back({
+      .device = event.device,
+      .index = pending_events_.size(),
+      .has_previous_sample = false,
+  });
+  pending_events_.push_back(event);
+}
+
+void BatchingPointerDataDispatcher::ResampleCoalescedMoves() {
+  int64_t sample_time = 0;
+  for (const PointerData& event : pending_events_) {
+    sample_time = std::max(sample_time, event.time_stamp);
+  }
+
+  for (const CoalescingMove& move : coalescing_moves_) {
+    PointerData& event = pending_events_[move.index];
+    const int64_t interval = event.time_stamp - move.previous_time_stamp;
+    if (!move.has_previous_sample || interval <= 0 ||
+        event.time_stamp >= sample_time) {
+      continue;
+    }
+    const int64_t extrapolation =
+        std::min(sample_time - event.time_stamp, interval);
+    const double factor = static_cast<double>(extrapolation) / interval;
+    const double offset_x = (event.physical_x - move.previous_x) * factor;
+    const double offset_y = (event.physical_y - move.previous_y) * factor;
+    event.time_stamp += extrapolation;
+    event.physical_x += offset_x;
+    event.physical_y += offset_y;
+  }
+}
+
+void BatchingPointerDataDispatcher::DispatchPendingEvents() {
+  TRACE_EVENT0("flutter",
+               "BatchingPointerDataDispatcher::DispatchPendingEvents");
+  if (pending_events_.empty()) {
+    for (uint64_t trace_flow_id : pending_trace_flow_ids_) {
+      TRACE_FLOW_END("flutter", "PointerEvent", trace_flow_id);
+    }
+    pending_trace_flow_ids_.clear();
+    return;
+  }
+
+  ResampleCoalescedMoves();
+
+  auto packet = std::make_unique<PointerDataPacket>(
+      reinterpret_cast<uint8_t*>(pending_events_.data()),
+      pending_events_.size() * sizeof(PointerData));
+
+  // The batch continues the flow of its last packet. The flows of the other
+  // packets end here.
+  const uint64_t trace_flow_id = pending_trace_flow_ids_.back();
+  pending_trace_flow_ids_.pop_back();
+  for (uint64_t merged_trace_flow_id : pending_trace_flow_ids_) {
+    TRACE_FLOW_END("flutter", "PointerEvent", merged_trace_flow_id);
+  }
+
+  pending_events_.clear();
+  pending_trace_flow_ids_.clear();
+  coalescing_moves_.clear();
+
+  DefaultPointerDataDispatcher::DispatchPacket(std::move(packet),
+                                               trace_flow_id);
+}
+
+void BatchingPointerDataDispatcher::ScheduleSecondaryVsyncCallback() {
+  if (is_vsync_callback_scheduled_) {
+    return;
+  }
+  is_vsync_callback_scheduled_ = true;
+  delegate_.ScheduleSecondaryVsyncCallback(
+      reinterpret_cast<uintptr_t>(this),
+      [dispatcher = weak_factory_.GetWeakPtr()]() {
+        if (dispatcher) {
+          dispatcher->is_vsync_callback_scheduled_ = false;
+          dispatcher->DispatchPendingEvents();
+        }
+      });
+}
+
 }  // namespace flutter
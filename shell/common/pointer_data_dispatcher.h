@@ -163,6 +163,72 @@ class SmoothPointerDataDispatcher : public DefaultPointerDataDispatcher {
   FML_DISALLOW_COPY_AND_ASSIGN(SmoothPointerDataDispatcher);
 };
 
+//------------------------------------------------------------------------------
+/// A dispatcher that holds all packets received within one VSYNC and
+/// dispatches them as a single packet at the next VSYNC.
+///
+/// Input devices that sample faster than the display refreshes (e.g. 240Hz or
+/// 360Hz touch panels on a 120Hz display) deliver several packets per frame.
+/// Dispatching each of them separately costs a UI thread task and a call into
+/// Dart per packet, even though the framework only needs the latest position
+/// of each pointer to build the next frame.
+///
+/// When the batch is dispatched:
+///
+///   * Consecutive move (or hover) events of the same device, with no other
+///     event of that device in between, are coalesced into a single event.
+///     Its deltas are the sum of the coalesced events' deltas.
+///   * Coalesced events are resampled to the time of the latest event in the
+///     batch, which is the closest the input clock gets to the frame time.
+///     Positions are extrapolated linearly from the last two samples of the
+///     device, by at most one sampling interval. Deltas are not extrapolated,
+///     so that they add up to the distance actually reported by the device.
+///   * All other events, including down, up, cancel and signal events, are
+///     kept as they are. The order of the events of each device is preserved.
+///
+/// This adds up to one frame of latency to events that arrive while the UI
+/// thread is idle, in exchange for one dispatch per frame.
+class BatchingPointerDataDispatcher : public DefaultPointerDataDispatcher {
+ public:
+  explicit BatchingPointerDataDispatcher(Delegate& delegate);
+
+  // |PointerDataDispatcer|
+  void DispatchPacket(std::unique_ptr<PointerDataPacket> packet,
+                      uint64_t trace_flow_id) override;
+
+  virtual ~BatchingPointerDataDispatcher();
+
+ private:
+  // The last event of a device in |pending_events_|, while it is a move that
+  // later moves of the device can be coalesced into.
+  struct CoalescingMove {
+    int64_t device;
+    size_t index;
+    // The sample before the one at |index|, if several were coalesced.
+    bool has_previous_sample;
+    int64_t previous_time_stamp;
+    double previous_x;
+    double previous_y;
+  };
+
+  void AddEvent(const PointerData& event);
+
+  void DispatchPendingEvents();
+
+  void ResampleCoalescedMoves();
+
+  void ScheduleSecondaryVsyncCallback();
+
+  std::vector<PointerData> pending_events_;
+  std::vector<uint64_t> pending_trace_flow_ids_;
+  std::vector<CoalescingMove> coalescing_moves_;
+  bool is_vsync_callback_scheduled_ = false;
+
+  // WeakPtrFactory must be the last member.
+  fml::WeakPtrFactory<BatchingPointerDataDispatcher> weak_factory_;
+  FML_DISALLOW_COPY_AND_ASSIGN(BatchingPointerDataDispatcher);
+};
+
 //--------------------------------------------------------------------------
 /// @brief      Signature for constructing PointerDataDispatcher.
 ///
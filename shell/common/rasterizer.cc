@@ -38,9 +38,10 @@
 #include "third_party/skia/include/gpu/ganesh/SkSurfaceGanesh.h"
 
 #if IMPELLER_SUPPORTS_RENDERING
-#include "impeller/aiks/aiks_context.h"           // nogncheck
-#include "impeller/core/formats.h"                // nogncheck
-#include "impeller/display_list/dl_dispatcher.h"  // nogncheck
+#include "impeller/aiks/aiks_context.h"            // nogncheck
+#include "impeller/core/formats.h"                 // nogncheck
+#include "impeller/display_list/dl_dispatcher.h"   // nogncheck
+#include "impeller/entity/tessellation_prepass.h"  // nogncheck
 #endif
 
 #include "flutter/fml/logging.h"
@@ -61,6 +62,12 @@ Rasterizer::Rasterizer(Delegate& delegate,
           SnapshotController::Make(*this, delegate.GetSettings())),
       weak_factory_(this) {
   FML_DCHECK(compositor_context_);
+  compositor_context_->raster_cache().SetMaxBytes(
+      delegate.GetSettings().raster_cache_max_bytes);
+  compositor_context_->raster_cache().SetDeferEntryRasterization(
+      delegate.GetSettings().defer_raster_cache_fills);
+  compositor_context_->raster_cache().SetUseAtlas(
+      delegate.GetSettings().enable_raster_cache_atlas);
 }
 
 Rasterizer::~Rasterizer() = default;
@@ -92,6 +99,14 @@ void Rasterizer::Setup(std::unique_ptr<Surface> surface) {
     compositor_context_->OnGrContextCreated();
   }
 
+#if IMPELLER_SUPPORTS_RENDERING
+  if (auto aiks_context = surface_->GetAiksContext()) {
+    aiks_context->GetContentContext()
+        .GetTessellationPrepass()
+        .SetWorkerTaskRunner(delegate_.GetConcurrentWorkerTaskRunner());
+  }
+#endif  // IMPELLER_SUPPORTS_RENDERING
+
   if (external_view_embedder_ &&
       external_view_embedder_->SupportsDynamicThreadMerging() &&
       !raster_thread_merger_) {
@@ -643,6 +658,8 @@ std::unique_ptr<FrameItem> Rasterizer::DrawToSurfacesUnsafe(
   frame_timings_recorder.RecordRasterEnd(&compositor_context_->raster_cache());
   FireNextFrameCallbackIfPresent();
 
+  RasterizeDeferredCacheEntries(frame_timings_recorder.GetVsyncTargetTime());
+
   if (surface_->GetContext()) {
     surface_->GetContext()->performDeferredCleanup(kSkiaCleanupExpiration);
   }
@@ -725,6 +742,7 @@ DrawSurfaceStatus Rasterizer::DrawToSurfaceUnsafe(
         damage->SetClipAlignment(
             frame->framebuffer_info().horizontal_clip_alignment,
             frame->framebuffer_info().vertical_clip_alignment);
+        damage->SetMaxDamageRects(delegate_.GetSettings().max_damage_rects);
       }
     }
 
@@ -748,6 +766,8 @@ DrawSurfaceStatus Rasterizer::DrawToSurfaceUnsafe(
     if (damage) {
       submit_info.frame_damage = damage->GetFrameDamage();
       submit_info.buffer_damage = damage->GetBufferDamage();
+      submit_info.frame_damage_region = damage->GetFrameDamageRegion();
+      submit_info.buffer_damage_region = damage->GetBufferDamageRegion();
     }
 
     frame->set_submit_info(submit_info);
@@ -1065,6 +1085,20 @@ void Rasterizer::FireNextFrameCallbackIfPresent() {
   callback();
 }
 
+void Rasterizer::RasterizeDeferredCacheEntries(fml::TimePoint deadline) {
+  RasterCache& raster_cache = compositor_context_->raster_cache();
+  if (!raster_cache.defers_entry_rasterization()) {
+    return;
+  }
+  // The frame has been submitted, which may have released the context the
+  // cache images are created in.
+  auto context_switch = surface_->MakeRenderContextCurrent();
+  if (!context_switch->GetResult()) {
+    return;
+  }
+  raster_cache.RasterizeDeferredEntries(deadline);
+}
+
 void Rasterizer::SetResourceCacheMaxBytes(size_t max_bytes, bool from_user) {
   user_override_resource_cache_bytes_ |= from_user;
 
@@ -18,6 +18,7 @@
 #include "flutter/flow/layers/layer_tree.h"
 #include "flutter/flow/surface.h"
 #include "flutter/fml/closure.h"
+#include "flutter/fml/concurrent_message_loop.h"
 #include "flutter/fml/memory/weak_ptr.h"
 #include "flutter/fml/raster_thread_merger.h"
 #include "flutter/fml/synchronization/sync_switch.h"
@@ -169,6 +170,11 @@ class Rasterizer final : public SnapshotDelegate,
 
     virtual const Settings& GetSettings() const = 0;
 
+    /// The task runner whose workers Impeller tessellates paths on before
+    /// rendering them, if any.
+    virtual const std::shared_ptr<fml::ConcurrentTaskRunner>
+    GetConcurrentWorkerTaskRunner() const = 0;
+
     virtual bool ShouldDiscardLayerTree(int64_t view_id,
                                         const flutter::LayerTree& tree) = 0;
   };
@@ -731,6 +737,10 @@ class Rasterizer final : public SnapshotDelegate,
 
   void FireNextFrameCallbackIfPresent();
 
+  // Rasterizes the raster cache entries that the frame deferred, in the time
+  // left until |deadline|.
+  void RasterizeDeferredCacheEntries(fml::TimePoint deadline);
+
   static bool ShouldResubmitFrame(const DoDrawResult& result);
   static DrawStatus ToDrawStatus(DoDrawStatus status);
 
@@ -21,7 +21,9 @@
 #include "flutter/fml/logging.h"
 #include "flutter/fml/make_copyable.h"
 #include "flutter/fml/message_loop.h"
+#include "flutter/fml/message_loop_task_queues.h"
 #include "flutter/fml/paths.h"
+#include "flutter/fml/time/timer_coalescer.h"
 #include "flutter/fml/trace_event.h"
 #include "flutter/runtime/dart_vm.h"
 #include "flutter/shell/common/base64.h"
@@ -143,6 +145,9 @@ void PerformInitializationTasks(Settings& settings) {
   });
 
   PersistentCache::SetCacheSkSL(settings.cache_sksl);
+  // The slack applies to the message loops of all the threads of the process,
+  // including the ones created before the shell.
+  fml::TimerCoalescer::SetSlack(settings.timer_slack);
 }
 
 }  // namespace
@@ -341,6 +346,8 @@ std::unique_ptr<Shell> Shell::CreateShellOnPlatformThread(
         // from the platform.
         auto animator = std::make_unique<Animator>(*shell, task_runners,
                                                    std::move(vsync_waiter));
+        animator->SetPipelineDepthController(
+            shell->pipeline_depth_controller_);
 
         engine_promise.set_value(on_create_engine(
             *shell,                               //
@@ -449,6 +456,8 @@ Shell::Shell(DartVMRef vm,
       vm_(std::move(vm)),
       is_gpu_disabled_sync_switch_(new fml::SyncSwitch(is_gpu_disabled)),
       volatile_path_tracker_(std::move(volatile_path_tracker)),
+      pipeline_depth_controller_(
+          std::make_shared<PipelineDepthController>(/*initial_depth=*/2)),
       weak_factory_gpu_(nullptr),
       weak_factory_(this) {
   FML_CHECK(!settings.enable_software_rendering || !settings.enable_impeller)
@@ -525,6 +534,11 @@ Shell::Shell(DartVMRef vm,
       task_runners_.GetPlatformTaskRunner(),
       std::bind(&Shell::OnServiceProtocolReloadAssetFonts, this,
                 std::placeholders::_1, std::placeholders::_2)};
+  service_protocol_handlers_
+      [ServiceProtocol::kGetTaskQueueStatsExtensionName] = {
+          task_runners_.GetPlatformTaskRunner(),
+          std::bind(&Shell::OnServiceProtocolGetTaskQueueStats, this,
+                    std::placeholders::_1, std::placeholders::_2)};
 }
 
 Shell::~Shell() {
@@ -1237,6 +1251,16 @@ void Shell::OnAnimatorBeginFrame(fml::TimePoint frame_target_time,
   }
 }
 
+// |Animator::Delegate|
+void Shell::OnAnimatorPredictFrameMiss(bool predicted_to_miss) {
+  FML_DCHECK(is_set_up_);
+  FML_DCHECK(task_runners_.GetUITaskRunner()->RunsTasksOnCurrentThread());
+
+  if (engine_) {
+    engine_->SetFrameMissPredicted(predicted_to_miss);
+  }
+}
+
 // |Animator::Delegate|
 void Shell::OnAnimatorNotifyIdle(fml::TimeDelta deadline) {
   FML_DCHECK(is_set_up_);
@@ -1567,6 +1591,13 @@ void Shell::OnFrameRasterized(const FrameTiming& timing) {
     settings_.frame_rasterized_callback(timing);
   }
 
+  pipeline_depth_controller_->RecordFrame(
+      timing.Get(FrameTiming::kBuildFinish) -
+          timing.Get(FrameTiming::kBuildStart),
+      timing.Get(FrameTiming::kRasterFinish) -
+          timing.Get(FrameTiming::kRasterStart),
+      fml::TimeDelta::FromMillisecondsF(GetFrameBudget().count()));
+
   if (!needs_report_timings_) {
     return;
   }
@@ -2114,6 +2145,77 @@ bool Shell::OnServiceProtocolReloadAssetFonts(
   return true;
 }
 
+static rapidjson::Value TimeHistogramToJson(
+    const fml::TimeHistogram& histogram,
+    rapidjson::MemoryPoolAllocator<>& allocator) {
+  rapidjson::Value value(rapidjson::kObjectType);
+  value.AddMember<uint64_t>("count", histogram.GetCount(), allocator);
+  value.AddMember<int64_t>("meanMicros",
+                           histogram.GetMean().ToMicroseconds(), allocator);
+  value.AddMember<int64_t>(
+      "p50Micros", histogram.GetPercentile(0.5).ToMicroseconds(), allocator);
+  value.AddMember<int64_t>(
+      "p90Micros", histogram.GetPercentile(0.9).ToMicroseconds(), allocator);
+  value.AddMember<int64_t>(
+      "p99Micros", histogram.GetPercentile(0.99).ToMicroseconds(), allocator);
+  value.AddMember<int64_t>("maxMicros", histogram.GetMax().ToMicroseconds(),
+                           allocator);
+  return value;
+}
+
+bool Shell::OnServiceProtocolGetTaskQueueStats(
+    const ServiceProtocol::Handler::ServiceProtocolMap& params,
+    rapidjson::Document* response) {
+  FML_DCHECK(task_runners_.GetPlatformTaskRunner()->RunsTasksOnCurrentThread());
+  auto task_queues = fml::MessageLoopTaskQueues::GetInstance();
+  const std::pair<const char*, fml::RefPtr<fml::TaskRunner>> runners[] = {
+      {"platform", task_runners_.GetPlatformTaskRunner()},
+      {"ui", task_runners_.GetUITaskRunner()},
+      {"raster", task_runners_.GetRasterTaskRunner()},
+      {"io", task_runners_.GetIOTaskRunner()},
+  };
+
+  auto enable = params.find("enable");
+  if (enable != params.end()) {
+    task_queues->SetStatsEnabled(enable->second == "true");
+  }
+  auto reset = params.find("reset");
+  if (reset != params.end() && reset->second == "true") {
+    for (const auto& [name, runner] : runners) {
+      task_queues->ResetStats(runner->GetTaskQueueId());
+    }
+  }
+
+  auto& allocator = response->GetAllocator();
+  response->SetObject();
+  response->AddMember("type", "TaskQueueStats", allocator);
+  response->AddMember("enabled", task_queues->IsStatsEnabled(), allocator);
+
+  static constexpr const char* kPriorityNames[fml::kTaskPriorityCount] = {
+      "frameCritical", "high", "normal", "low"};
+  rapidjson::Value queues(rapidjson::kObjectType);
+  for (const auto& [name, runner] : runners) {
+    const fml::TaskQueueStats stats =
+        task_queues->GetStats(runner->GetTaskQueueId());
+    rapidjson::Value queue(rapidjson::kObjectType);
+    queue.AddMember<uint64_t>("tasksRun", stats.tasks_run, allocator);
+    queue.AddMember<uint64_t>("maxPendingTasks", stats.max_pending_tasks,
+                              allocator);
+    queue.AddMember("runTime", TimeHistogramToJson(stats.run_time, allocator),
+                    allocator);
+    rapidjson::Value queue_delay(rapidjson::kObjectType);
+    for (size_t i = 0; i < fml::kTaskPriorityCount; i++) {
+      queue_delay.AddMember(
+          rapidjson::StringRef(kPriorityNames[i]),
+          TimeHistogramToJson(stats.queue_delay[i], allocator), allocator);
+    }
+    queue.AddMember("queueDelay", queue_delay, allocator);
+    queues.AddMember(rapidjson::StringRef(name), queue, allocator);
+  }
+  response->AddMember("queues", queues, allocator);
+  return true;
+}
+
 void Shell::AddView(int64_t view_id, const ViewportMetrics& viewport_metrics) {
   TRACE_EVENT0("flutter", "Shell::AddView");
   FML_DCHECK(is_set_up_);
@@ -36,6 +36,7 @@
 #include "flutter/shell/common/animator.h"
 #include "flutter/shell/common/display_manager.h"
 #include "flutter/shell/common/engine.h"
+#include "flutter/shell/common/pipeline_depth_controller.h"
 #include "flutter/shell/common/platform_view.h"
 #include "flutter/shell/common/rasterizer.h"
 #include "flutter/shell/common/resource_cache_limit_calculator.h"
@@ -442,8 +443,9 @@ class Shell final : public PlatformView::Delegate,
 
   const std::weak_ptr<VsyncWaiter> GetVsyncWaiter() const;
 
+  // |Rasterizer::Delegate|
   const std::shared_ptr<fml::ConcurrentTaskRunner>
-  GetConcurrentWorkerTaskRunner() const;
+  GetConcurrentWorkerTaskRunner() const override;
 
   // Infer the VM ref and the isolate snapshot based on the settings.
   //
@@ -485,6 +487,8 @@ class Shell final : public PlatformView::Delegate,
   std::shared_ptr<ShellIOManager> io_manager_;   // on IO task runner
   std::shared_ptr<fml::SyncSwitch> is_gpu_disabled_sync_switch_;
   std::shared_ptr<VolatilePathTracker> volatile_path_tracker_;
+  // Fed on the raster task runner, read by the animator on the UI task runner.
+  std::shared_ptr<PipelineDepthController> pipeline_depth_controller_;
   std::shared_ptr<PlatformMessageHandler> platform_message_handler_;
   std::atomic<bool> route_messages_through_platform_thread_ = false;
 
@@ -657,6 +661,9 @@ class Shell final : public PlatformView::Delegate,
   // |Animator::Delegate|
   void OnAnimatorNotifyIdle(fml::TimeDelta deadline) override;
 
+  // |Animator::Delegate|
+  void OnAnimatorPredictFrameMiss(bool predicted_to_miss) override;
+
   // |Animator::Delegate|
   void OnAnimatorUpdateLatestFrameTargetTime(
       fml::TimePoint frame_target_time) override;
@@ -796,6 +803,16 @@ class Shell final : public PlatformView::Delegate,
       const ServiceProtocol::Handler::ServiceProtocolMap& params,
       rapidjson::Document* response);
 
+  // Service protocol handler
+  //
+  // Responds with the queueing delay and run time histograms, task counts and
+  // queue depth high-water marks of the platform, UI, raster and IO task
+  // queues. Collection is toggled for the whole process with the "enable"
+  // parameter and the collected stats are cleared with "reset".
+  bool OnServiceProtocolGetTaskQueueStats(
+      const ServiceProtocol::Handler::ServiceProtocolMap& params,
+      rapidjson::Document* response);
+
   // Send a system font change notification.
   void SendFontChangeNotification();
 
@@ -7,6 +7,7 @@
 #include "flutter/benchmarking/benchmarking.h"
 #include "flutter/fml/logging.h"
 #include "flutter/runtime/dart_vm.h"
+#include "flutter/shell/common/pointer_data_dispatcher.h"
 #include "flutter/shell/common/thread_host.h"
 #include "flutter/testing/elf_loader.h"
 #include "flutter/testing/testing.h"
@@ -120,4 +121,96 @@ static void BM_ShellInitializationAndShutdown(benchmark::State& state) {
 
 BENCHMARK(BM_ShellInitializationAndShutdown);
 
+namespace {
+
+// Stands in for the engine. Dispatched packets are unpacked like the framework
+// would, and the secondary vsync callback runs when a frame is simulated.
+class BenchmarkPointerDataDispatcherDelegate
+    : public PointerDataDispatcher::Delegate {
+ public:
+  void DoDispatchPacket(std::unique_ptr<PointerDataPacket> packet,
+                        uint64_t trace_flow_id) override {
+    dispatch_count++;
+    const size_t length = packet->GetLength();
+    for (size_t i = 0; i < length; i++) {
+      position_checksum += packet->GetPointerData(i).physical_x;
+    }
+    event_count += length;
+  }
+
+  void ScheduleSecondaryVsyncCallback(uintptr_t id,
+                                      const fml::closure& callback) override {
+    vsync_callback_ = callback;
+  }
+
+  void SimulateVsync() {
+    fml::closure callback = std::move(vsync_callback_);
+    vsync_callback_ = nullptr;
+    if (callback) {
+      callback();
+    }
+  }
+
+  int64_t dispatch_count = 0;
+  int64_t event_count = 0;
+  double position_checksum = 0;
+
+ private:
+  fml::closure vsync_callback_;
+};
+
+}  // namespace
+
+// Simulates a touch panel that samples |state.range(0)| times per displayed
+// frame (e.g. 3 for 360Hz sampling on a 120Hz display), with
+// |state.range(1)| fingers moving, each sample delivered in its own packet.
+template <class Dispatcher>
+static void BM_PointerDataDispatcherHighRateStream(benchmark::State& state) {
+  const int64_t samples_per_frame = state.range(0);
+  const int64_t pointer_count = state.range(1);
+  BenchmarkPointerDataDispatcherDelegate delegate;
+  Dispatcher dispatcher(delegate);
+
+  PointerData data;
+  data.Clear();
+  data.change = PointerData::Change::kMove;
+  data.kind = PointerData::DeviceKind::kTouch;
+  data.signal_kind = PointerData::SignalKind::kNone;
+  data.physical_delta_x = 1.0;
+
+  int64_t time_stamp = 0;
+  uint64_t trace_flow_id = 0;
+  for (auto _ : state) {
+    for (int64_t sample = 0; sample < samples_per_frame; sample++) {
+      time_stamp += 1000;
+      auto packet = std::make_unique<PointerDataPacket>(pointer_count);
+      for (int64_t pointer = 0; pointer < pointer_count; pointer++) {
+        data.time_stamp = time_stamp;
+        data.device = pointer;
+        data.pointer_identifier = pointer;
+        data.physical_x = static_cast<double>(time_stamp) / 1000;
+        packet->SetPointerData(pointer, data);
+      }
+      dispatcher.DispatchPacket(std::move(packet), ++trace_flow_id);
+    }
+    delegate.SimulateVsync();
+  }
+  benchmark::DoNotOptimize(delegate.position_checksum);
+
+  state.counters["DispatchesPerFrame"] = benchmark::Counter(
+      delegate.dispatch_count, benchmark::Counter::kAvgIterations);
+  state.counters["EventsPerFrame"] = benchmark::Counter(
+      delegate.event_count, benchmark::Counter::kAvgIterations);
+}
+
+BENCHMARK_TEMPLATE(BM_PointerDataDispatcherHighRateStream,
+                   DefaultPointerDataDispatcher)
+    ->ArgsProduct({{2, 3}, {1, 5}});
+BENCHMARK_TEMPLATE(BM_PointerDataDispatcherHighRateStream,
+                   SmoothPointerDataDispatcher)
+    ->ArgsProduct({{2, 3}, {1, 5}});
+BENCHMARK_TEMPLATE(BM_PointerDataDispatcherHighRateStream,
+                   BatchingPointerDataDispatcher)
+    ->ArgsProduct({{2, 3}, {1, 5}});
+
 }  // namespace flutter
@@ -2554,6 +2554,43 @@ TEST_F(ShellTest, OnServiceProtocolEstimateRasterCacheMemoryWorks) {
   DestroyShell(std::move(shell));
 }
 
+TEST_F(ShellTest, OnServiceProtocolGetTaskQueueStatsWorks) {
+  Settings settings = CreateSettingsForFixture();
+  std::unique_ptr<Shell> shell = CreateShell(settings);
+  auto platform_task_runner = shell->GetTaskRunners().GetPlatformTaskRunner();
+
+  ServiceProtocol::Handler::ServiceProtocolMap params;
+  params["enable"] = "true";
+  params["reset"] = "true";
+  rapidjson::Document enable_response;
+  OnServiceProtocol(shell.get(), ServiceProtocolEnum::kGetTaskQueueStats,
+                    platform_task_runner, params, &enable_response);
+  ASSERT_TRUE(enable_response["enabled"].GetBool());
+
+  fml::AutoResetWaitableEvent latch;
+  shell->GetTaskRunners().GetUITaskRunner()->PostTask(
+      [&latch]() { latch.Signal(); });
+  latch.Wait();
+
+  params.clear();
+  params["enable"] = "false";
+  rapidjson::Document document;
+  OnServiceProtocol(shell.get(), ServiceProtocolEnum::kGetTaskQueueStats,
+                    platform_task_runner, params, &document);
+  DestroyShell(std::move(shell));
+
+  ASSERT_STREQ(document["type"].GetString(), "TaskQueueStats");
+  ASSERT_FALSE(document["enabled"].GetBool());
+  const auto& queues = document["queues"];
+  for (const char* name : {"platform", "ui", "raster", "io"}) {
+    ASSERT_TRUE(queues.HasMember(name)) << name;
+    ASSERT_TRUE(queues[name]["queueDelay"].HasMember("frameCritical"));
+    ASSERT_TRUE(queues[name]["runTime"].HasMember("p99Micros"));
+  }
+  ASSERT_GE(queues["ui"]["tasksRun"].GetUint64(), 1u);
+  ASSERT_GE(queues["ui"]["queueDelay"]["normal"]["count"].GetUint64(), 1u);
+}
+
 // ktz
 TEST_F(ShellTest, OnServiceProtocolRenderFrameWithRasterStatsWorks) {
   auto settings = CreateSettingsForFixture();
@@ -474,6 +474,15 @@ Settings SettingsFromCommandLine(const fml::CommandLine& command_line) {
   settings.enable_embedder_api =
       command_line.HasOption(FlagForSwitch(Switch::EnableEmbedderAPI));
 
+  settings.enable_pointer_batching =
+      command_line.HasOption(FlagForSwitch(Switch::EnablePointerBatching));
+
+  settings.defer_raster_cache_fills =
+      command_line.HasOption(FlagForSwitch(Switch::DeferRasterCacheFills));
+
+  settings.enable_raster_cache_atlas =
+      command_line.HasOption(FlagForSwitch(Switch::EnableRasterCacheAtlas));
+
   settings.prefetched_default_font_manager = command_line.HasOption(
       FlagForSwitch(Switch::PrefetchedDefaultFontManager));
 
@@ -520,6 +529,28 @@ Settings SettingsFromCommandLine(const fml::CommandLine& command_line) {
         std::stoi(resource_cache_max_bytes_threshold);
   }
 
+  if (command_line.HasOption(FlagForSwitch(Switch::MaxDamageRects))) {
+    std::string max_damage_rects;
+    command_line.GetOptionValue(FlagForSwitch(Switch::MaxDamageRects),
+                                &max_damage_rects);
+    settings.max_damage_rects = std::max(std::stoi(max_damage_rects), 1);
+  }
+
+  if (command_line.HasOption(FlagForSwitch(Switch::RasterCacheMaxBytes))) {
+    std::string raster_cache_max_bytes;
+    command_line.GetOptionValue(FlagForSwitch(Switch::RasterCacheMaxBytes),
+                                &raster_cache_max_bytes);
+    settings.raster_cache_max_bytes = std::stoull(raster_cache_max_bytes);
+  }
+
+  if (command_line.HasOption(FlagForSwitch(Switch::TimerSlackMs))) {
+    std::string timer_slack_ms;
+    command_line.GetOptionValue(FlagForSwitch(Switch::TimerSlackMs),
+                                &timer_slack_ms);
+    settings.timer_slack = fml::TimeDelta::FromMilliseconds(
+        std::max(std::stoi(timer_slack_ms), 0));
+  }
+
   if (command_line.HasOption(FlagForSwitch(Switch::MsaaSamples))) {
     std::string msaa_samples;
     command_line.GetOptionValue(FlagForSwitch(Switch::MsaaSamples),
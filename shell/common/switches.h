@@ -298,6 +298,35 @@ DEF_SWITCH(
 DEF_SWITCH(EnableEmbedderAPI,
            "enable-embedder-api",
            "Enable the embedder api. Defaults to false. iOS only.")
+DEF_SWITCH(EnablePointerBatching,
+           "enable-pointer-batching",
+           "Dispatch the pointer events received within a frame to the "
+           "framework as a single packet, with move events coalesced and "
+           "resampled. Defaults to false.")
+DEF_SWITCH(MaxDamageRects,
+           "max-damage-rects",
+           "The maximum number of rectangles repainted separately when a "
+           "frame is partially repainted. Defaults to 1.")
+DEF_SWITCH(RasterCacheMaxBytes,
+           "raster-cache-max-bytes",
+           "The maximum size in bytes of the images in the raster cache. "
+           "Entries that save the least rasterization time per byte are "
+           "evicted first. Defaults to 0, which means no limit.")
+DEF_SWITCH(DeferRasterCacheFills,
+           "defer-raster-cache-fills",
+           "Rasterize new raster cache entries after the frame that decides "
+           "to cache them has been submitted, in the remaining frame budget. "
+           "Defaults to false.")
+DEF_SWITCH(EnableRasterCacheAtlas,
+           "enable-raster-cache-atlas",
+           "Pack small raster cache entries into shared atlas pages and draw "
+           "neighboring entries from the same page in a single batch. "
+           "Defaults to false.")
+DEF_SWITCH(TimerSlackMs,
+           "timer-slack-ms",
+           "How many milliseconds later than requested the engine's message "
+           "loops may wake up for delayed tasks, so that nearby wakeups share "
+           "one timer fire. Defaults to 0, which wakes up at the exact time.")
 DEF_SWITCHES_END
 
 void PrintUsage(const std::string& executable_name);
@@ -104,6 +104,29 @@ TEST(SwitchesTest, EnableEmbedderAPI) {
   }
 }
 
+TEST(SwitchesTest, TimerSlackMs) {
+  {
+    // default
+    fml::CommandLine command_line =
+        fml::CommandLineFromInitializerList({"command"});
+    Settings settings = SettingsFromCommandLine(command_line);
+    EXPECT_EQ(settings.timer_slack, fml::TimeDelta::Zero());
+  }
+  {
+    fml::CommandLine command_line = fml::CommandLineFromInitializerList(
+        {"command", "--timer-slack-ms=4"});
+    Settings settings = SettingsFromCommandLine(command_line);
+    EXPECT_EQ(settings.timer_slack, fml::TimeDelta::FromMilliseconds(4));
+  }
+  {
+    // negative values are clamped
+    fml::CommandLine command_line = fml::CommandLineFromInitializerList(
+        {"command", "--timer-slack-ms=-1"});
+    Settings settings = SettingsFromCommandLine(command_line);
+    EXPECT_EQ(settings.timer_slack, fml::TimeDelta::Zero());
+  }
+}
+
 TEST(SwitchesTest, NoEnableImpeller) {
   {
     // enable
@@ -128,7 +128,14 @@ void VsyncWaiter::FireCallback(fml::TimePoint frame_start_time,
     fml::TaskQueueId ui_task_queue_id =
         task_runners_.GetUITaskRunner()->GetTaskQueueId();
 
-    task_runners_.GetUITaskRunner()->PostTask(
+    // The frame keeps its place behind the UI tasks that were posted before
+    // it, such as viewport metrics and lifecycle updates, so that it is built
+    // with them applied. Only once half of the frame interval has passed
+    // without the frame starting is it at risk of missing its target time,
+    // and it then runs ahead of the queued work.
+    const fml::TimePoint frame_at_risk_time =
+        frame_start_time + (frame_target_time - frame_start_time) / 2;
+    task_runners_.GetUITaskRunner()->PostTaskWithPriority(
         [ui_task_queue_id, callback, flow_identifier, frame_start_time,
          frame_target_time, pause_secondary_tasks]() {
           FML_TRACE_EVENT_WITH_FLOW_IDS(
@@ -144,7 +151,8 @@ void VsyncWaiter::FireCallback(fml::TimePoint frame_start_time,
           if (pause_secondary_tasks) {
             ResumeDartEventLoopTasks(ui_task_queue_id);
           }
-        });
+        },
+        fml::TaskPriority::kNormal, frame_at_risk_time);
   }
 
   for (auto& secondary_callback : secondary_callbacks) {
@@ -1,9 +1,15 @@
 #define FML_USED_ON_EMBEDDER
 
 #include <initializer_list>
+#include <string>
+#include <vector>
 
 #include "flutter/common/settings.h"
 #include "flutter/common/task_runners.h"
+#include "flutter/flow/frame_timings.h"
+#include "flutter/fml/message_loop.h"
+#include "flutter/fml/synchronization/waitable_event.h"
+#include "flutter/fml/thread.h"
 #include "flutter/shell/common/switches.h"
 
 #include "gtest/gtest.h"
@@ -20,6 +26,10 @@ class TestVsyncWaiter : public VsyncWaiter {
 
   int await_vsync_call_count_ = 0;
 
+  void Fire(fml::TimePoint frame_start_time, fml::TimePoint frame_target_time) {
+    FireCallback(frame_start_time, frame_target_time);
+  }
+
  protected:
   void AwaitVSync() override { await_vsync_call_count_++; }
 };
@@ -43,5 +53,56 @@ TEST(VsyncWaiterTest, NoUnneededAwaitVsync) {
   EXPECT_EQ(vsync_waiter.await_vsync_call_count_, 1);
 }
 
+namespace {
+
+// Fires a vsync on a UI thread that already has a task posted before the
+// vsync, and returns the order the task and the frame ran in.
+std::vector<std::string> RunFrameAfterQueuedTask(
+    fml::TimeDelta frame_start_offset,
+    fml::TimeDelta frame_target_offset) {
+  fml::Thread ui_thread("vsync_waiter_test.ui");
+  auto task_runner = ui_thread.GetTaskRunner();
+  const flutter::TaskRunners task_runners("vsync_waiter_test", task_runner,
+                                          task_runner, task_runner,
+                                          task_runner);
+  TestVsyncWaiter vsync_waiter(task_runners);
+  std::vector<std::string> run_order;
+
+  // Holds the UI thread until both the task and the frame are queued.
+  fml::AutoResetWaitableEvent queued;
+  task_runner->PostTask([&queued]() { queued.Wait(); });
+  task_runner->PostTask([&run_order]() { run_order.push_back("task"); });
+  vsync_waiter.AsyncWaitForVsync(
+      [&run_order](std::unique_ptr<FrameTimingsRecorder> recorder) {
+        run_order.push_back("frame");
+      });
+  auto now = fml::TimePoint::Now();
+  vsync_waiter.Fire(now + frame_start_offset, now + frame_target_offset);
+  queued.Signal();
+
+  fml::AutoResetWaitableEvent done;
+  task_runner->PostTask([&done]() { done.Signal(); });
+  done.Wait();
+  return run_order;
+}
+
+}  // namespace
+
+TEST(VsyncWaiterTest, FrameRunsAfterTasksPostedBeforeIt) {
+  // The frame is far from being at risk of missing its target time, so the
+  // task that was posted before it, e.g. a viewport metrics update, runs
+  // first.
+  EXPECT_EQ(RunFrameAfterQueuedTask(fml::TimeDelta::Zero(),
+                                    fml::TimeDelta::FromSeconds(10)),
+            std::vector<std::string>({"task", "frame"}));
+}
+
+TEST(VsyncWaiterTest, FrameAtRiskRunsBeforeTasksPostedBeforeIt) {
+  // More than half of the frame interval has passed when the vsync fires.
+  EXPECT_EQ(RunFrameAfterQueuedTask(fml::TimeDelta::FromMilliseconds(-16),
+                                    fml::TimeDelta::FromMilliseconds(1)),
+            std::vector<std::string>({"frame", "task"}));
+}
+
 }  // namespace testing
 }  // namespace flutter
@@ -8,6 +8,7 @@
 #include <optional>
 
 #include "flutter/common/graphics/gl_context_switch.h"
+#include "flutter/display_list/geometry/dl_region.h"
 #include "flutter/flow/embedded_views.h"
 #include "flutter/fml/macros.h"
 #include "third_party/skia/include/core/SkMatrix.h"
@@ -46,6 +47,12 @@ struct GLPresentInfo {
   // The buffer damage refers to the region that needs to be set as damaged
   // within the frame buffer.
   const std::optional<SkIRect>& buffer_damage;
+
+  // The frame and buffer damage split into the rects that were painted. Each
+  // lies within the respective rect above. When not set, the rect above is
+  // the only damage.
+  const std::optional<DlRegion>& frame_damage_region;
+  const std::optional<DlRegion>& buffer_damage_region;
 };
 
 class GPUSurfaceGLDelegate {
@@ -60,8 +67,11 @@ class GPUSurfaceGLDelegate {
   virtual bool GLContextClearCurrent() = 0;
 
   // Inform the GL Context that there's going to be no writing beyond
-  // the specified region
-  virtual void GLContextSetDamageRegion(const std::optional<SkIRect>& region) {}
+  // the specified region. When set, |region_rects| splits |region| into the
+  // rects that are going to be written.
+  virtual void GLContextSetDamageRegion(
+      const std::optional<SkIRect>& region,
+      const std::optional<DlRegion>& region_rects) {}
 
   // Called to present the main GL surface. This is only called for the main GL
   // context and not any of the contexts dedicated for IO.
@@ -71,6 +71,8 @@ std::unique_ptr<SurfaceFrame> GPUSurfaceGLImpeller::AcquireFrame(
           // presentation time to impeller backend.
           .presentation_time = std::nullopt,
           .buffer_damage = std::nullopt,
+          .frame_damage_region = std::nullopt,
+          .buffer_damage_region = std::nullopt,
       };
       delegate->GLContextPresent(present_info);
     }
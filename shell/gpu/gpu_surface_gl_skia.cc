@@ -269,7 +269,9 @@ bool GPUSurfaceGLSkia::PresentSurface(const SurfaceFrame& frame,
     return false;
   }
 
-  delegate_->GLContextSetDamageRegion(frame.submit_info().buffer_damage);
+  delegate_->GLContextSetDamageRegion(
+      frame.submit_info().buffer_damage,
+      frame.submit_info().buffer_damage_region);
 
   {
     TRACE_EVENT0("flutter", "GrDirectContext::flushAndSubmit");
@@ -281,6 +283,8 @@ bool GPUSurfaceGLSkia::PresentSurface(const SurfaceFrame& frame,
       .frame_damage = frame.submit_info().frame_damage,
       .presentation_time = frame.submit_info().presentation_time,
       .buffer_damage = frame.submit_info().buffer_damage,
+      .frame_damage_region = frame.submit_info().frame_damage_region,
+      .buffer_damage_region = frame.submit_info().buffer_damage_region,
   };
   if (!delegate_->GLContextPresent(present_info)) {
     return false;
@@ -64,7 +64,8 @@ class AndroidEGLSurfaceDamage {
 
   void SetDamageRegion(EGLDisplay display,
                        EGLSurface surface,
-                       const std::optional<SkIRect>& region) {}
+                       const std::optional<SkIRect>& region,
+                       const std::optional<DlRegion>& region_rects) {}
 
   /// This was disabled after discussion in
   /// https://github.com/flutter/flutter/issues/123353
@@ -76,7 +77,8 @@ class AndroidEGLSurfaceDamage {
 
   bool SwapBuffersWithDamage(EGLDisplay display,
                              EGLSurface surface,
-                             const std::optional<SkIRect>& damage) {
+                             const std::optional<SkIRect>& damage,
+                             const std::optional<DlRegion>& damage_rects) {
     return eglSwapBuffers(display, surface);
   }
 };
@@ -137,8 +139,10 @@ AndroidEGLSurfaceMakeCurrentStatus AndroidEGLSurface::MakeCurrent() const {
 }
 
 void AndroidEGLSurface::SetDamageRegion(
-    const std::optional<SkIRect>& buffer_damage) {
-  damage_->SetDamageRegion(display_, surface_, buffer_damage);
+    const std::optional<SkIRect>& buffer_damage,
+    const std::optional<DlRegion>& buffer_damage_region) {
+  damage_->SetDamageRegion(display_, surface_, buffer_damage,
+                           buffer_damage_region);
 }
 
 bool AndroidEGLSurface::SetPresentationTime(
@@ -152,9 +156,11 @@ bool AndroidEGLSurface::SetPresentationTime(
 }
 
 bool AndroidEGLSurface::SwapBuffers(
-    const std::optional<SkIRect>& surface_damage) {
+    const std::optional<SkIRect>& surface_damage,
+    const std::optional<DlRegion>& surface_damage_region) {
   TRACE_EVENT0("flutter", "AndroidContextGL::SwapBuffers");
-  return damage_->SwapBuffersWithDamage(display_, surface_, surface_damage);
+  return damage_->SwapBuffersWithDamage(display_, surface_, surface_damage,
+                                        surface_damage_region);
 }
 
 bool AndroidEGLSurface::SupportsPartialRepaint() const {
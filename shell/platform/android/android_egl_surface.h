@@ -10,6 +10,7 @@
 #include <KHR/khrplatform.h>
 #include <optional>
 
+#include "flutter/display_list/geometry/dl_region.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/time/time_point.h"
 #include "flutter/shell/platform/android/android_environment_gl.h"
@@ -78,8 +79,10 @@ class AndroidEGLSurface {
 
   //----------------------------------------------------------------------------
   /// @brief      Sets the damage region for current surface. Corresponds to
-  //              eglSetDamageRegionKHR
-  void SetDamageRegion(const std::optional<SkIRect>& buffer_damage);
+  //              eglSetDamageRegionKHR. When set, |buffer_damage_region|
+  //              splits |buffer_damage| into the rects that are passed.
+  void SetDamageRegion(const std::optional<SkIRect>& buffer_damage,
+                       const std::optional<DlRegion>& buffer_damage_region);
 
   //----------------------------------------------------------------------------
   /// @brief      Sets the presentation time for the current surface. This
@@ -93,7 +96,8 @@ class AndroidEGLSurface {
   ///
   /// @return     Whether the EGL surface color buffer was swapped.
   ///
-  bool SwapBuffers(const std::optional<SkIRect>& surface_damage);
+  bool SwapBuffers(const std::optional<SkIRect>& surface_damage,
+                   const std::optional<DlRegion>& surface_damage_region);
 
   //----------------------------------------------------------------------------
   /// @return     The size of an `EGLSurface`.
@@ -128,7 +128,8 @@ AndroidSurfaceGLImpeller::GLContextFramebufferInfo() const {
 
 // |GPUSurfaceGLDelegate|
 void AndroidSurfaceGLImpeller::GLContextSetDamageRegion(
-    const std::optional<SkIRect>& region) {
+    const std::optional<SkIRect>& region,
+    const std::optional<DlRegion>& region_rects) {
   // Not supported.
 }
 
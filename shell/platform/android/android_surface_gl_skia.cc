@@ -147,9 +147,10 @@ SurfaceFrame::FramebufferInfo AndroidSurfaceGLSkia::GLContextFramebufferInfo()
 }
 
 void AndroidSurfaceGLSkia::GLContextSetDamageRegion(
-    const std::optional<SkIRect>& region) {
+    const std::optional<SkIRect>& region,
+    const std::optional<DlRegion>& region_rects) {
   FML_DCHECK(IsValid());
-  onscreen_surface_->SetDamageRegion(region);
+  onscreen_surface_->SetDamageRegion(region, region_rects);
 }
 
 bool AndroidSurfaceGLSkia::GLContextPresent(const GLPresentInfo& present_info) {
@@ -158,7 +159,8 @@ bool AndroidSurfaceGLSkia::GLContextPresent(const GLPresentInfo& present_info) {
   if (present_info.presentation_time) {
     onscreen_surface_->SetPresentationTime(*present_info.presentation_time);
   }
-  return onscreen_surface_->SwapBuffers(present_info.frame_damage);
+  return onscreen_surface_->SwapBuffers(present_info.frame_damage,
+                                        present_info.frame_damage_region);
 }
 
 GLFBOInfo AndroidSurfaceGLSkia::GLContextFBO(GLFrameInfo frame_info) const {
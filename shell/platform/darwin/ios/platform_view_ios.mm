@@ -129,6 +129,11 @@ void PlatformViewIOS::attachView() {
 }
 
 PointerDataDispatcherMaker PlatformViewIOS::GetDispatcherMaker() {
+  if (delegate_.OnPlatformViewGetSettings().enable_pointer_batching) {
+    return [](DefaultPointerDataDispatcher::Delegate& delegate) {
+      return std::make_unique<BatchingPointerDataDispatcher>(delegate);
+    };
+  }
   return [](DefaultPointerDataDispatcher::Delegate& delegate) {
     return std::make_unique<SmoothPointerDataDispatcher>(delegate);
   };
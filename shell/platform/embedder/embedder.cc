@@ -302,6 +302,22 @@ static const SkIRect FlutterRectToSkIRect(FlutterRect flutter_rect) {
                   static_cast<int32_t>(flutter_rect.bottom)};
   return rect;
 }
+
+// Auxiliary function used to translate the damage of a frame to FlutterRects.
+// The rects of |region| are used when it splits |damage| into several rects.
+static std::vector<FlutterRect> DamageToFlutterRects(
+    const std::optional<SkIRect>& damage,
+    const std::optional<flutter::DlRegion>& region) {
+  std::vector<FlutterRect> rects;
+  if (region && region->isComplex()) {
+    for (const SkIRect& rect : region->getRects()) {
+      rects.push_back(SkIRectToFlutterRect(rect));
+    }
+  } else if (damage) {
+    rects.push_back(SkIRectToFlutterRect(*damage));
+  }
+  return rects;
+}
 #endif
 
 static inline flutter::Shell::CreateCallback<flutter::PlatformView>
@@ -331,33 +347,27 @@ InferOpenGLPlatformViewCreationCallback(
     if (present) {
       return present(user_data);
     } else {
-      // Format the frame and buffer damages accordingly. Note that, since the
-      // current compute damage algorithm only returns one rectangle for damage
-      // we are assuming the number of rectangles provided in frame and buffer
-      // damage are always 1. Once the function that computes damage implements
-      // support for multiple damage rectangles, GLPresentInfo should also
-      // contain the number of damage rectangles.
-
-      std::optional<FlutterRect> frame_damage_rect;
-      if (gl_present_info.frame_damage) {
-        frame_damage_rect =
-            SkIRectToFlutterRect(*(gl_present_info.frame_damage));
-      }
-      std::optional<FlutterRect> buffer_damage_rect;
-      if (gl_present_info.buffer_damage) {
-        buffer_damage_rect =
-            SkIRectToFlutterRect(*(gl_present_info.buffer_damage));
-      }
+      // Format the frame and buffer damages accordingly. The damage is a
+      // single rectangle unless the engine was allowed to split it with
+      // --max-damage-rects.
+      std::vector<FlutterRect> frame_damage_rects =
+          DamageToFlutterRects(gl_present_info.frame_damage,
+                               gl_present_info.frame_damage_region);
+      std::vector<FlutterRect> buffer_damage_rects =
+          DamageToFlutterRects(gl_present_info.buffer_damage,
+                               gl_present_info.buffer_damage_region);
 
       FlutterDamage frame_damage{
           .struct_size = sizeof(FlutterDamage),
-          .num_rects = frame_damage_rect ? size_t{1} : size_t{0},
-          .damage = frame_damage_rect ? &frame_damage_rect.value() : nullptr,
+          .num_rects = frame_damage_rects.size(),
+          .damage = frame_damage_rects.empty() ? nullptr
+                                               : frame_damage_rects.data(),
       };
       FlutterDamage buffer_damage{
           .struct_size = sizeof(FlutterDamage),
-          .num_rects = buffer_damage_rect ? size_t{1} : size_t{0},
-          .damage = buffer_damage_rect ? &buffer_damage_rect.value() : nullptr,
+          .num_rects = buffer_damage_rects.size(),
+          .damage = buffer_damage_rects.empty() ? nullptr
+                                                : buffer_damage_rects.data(),
       };
 
       // Construct the present information concerning the frame being rendered.
@@ -1430,6 +1430,26 @@ void render_gradient_retained() {
   PlatformDispatcher.instance.scheduleFrame();
 }
 
+@pragma('vm:entry-point')
+void render_corner_boxes_changing_color() {
+  int frame = 0;
+  PlatformDispatcher.instance.onBeginFrame = (Duration duration) {
+    final Color color = frame++ == 0
+        ? Color.fromARGB(255, 255, 0, 0)
+        : Color.fromARGB(255, 0, 0, 255);
+    final Size size = Size(100.0, 100.0);
+
+    final SceneBuilder builder = SceneBuilder();
+    builder.pushOffset(0.0, 0.0);
+    builder.addPicture(Offset(0.0, 0.0), CreateColoredBox(color, size));
+    builder.addPicture(Offset(700.0, 500.0), CreateColoredBox(color, size));
+    builder.pop();
+
+    PlatformDispatcher.instance.views.first.render(builder.build());
+  };
+  PlatformDispatcher.instance.scheduleFrame();
+}
+
 @pragma('vm:entry-point')
 void render_impeller_gl_test() {
   PlatformDispatcher.instance.onBeginFrame = (Duration duration) {
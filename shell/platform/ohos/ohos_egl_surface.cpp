@@ -15,8 +15,8 @@
 
 #include "flutter/shell/platform/ohos/ohos_egl_surface.h"
 
-#include <array>
 #include <list>
+#include <vector>
 
 #include "flutter/fml/trace_event.h"
 
@@ -94,10 +94,11 @@ class OhosEGLSurfaceDamage {
 
   void SetDamageRegion(EGLDisplay display,
                        EGLSurface surface,
-                       const std::optional<SkIRect>& region) {
+                       const std::optional<SkIRect>& region,
+                       const std::optional<DlRegion>& region_rects) {
     if (partial_redraw_supported_ && set_damage_region_ && region) {
-      auto rects = RectToInts(display, surface, *region);
-      set_damage_region_(display, surface, rects.data(), 1);
+      auto rects = RectsToInts(display, surface, *region, region_rects);
+      set_damage_region_(display, surface, rects.data(), rects.size() / 4);
     }
   }
 
@@ -131,28 +132,44 @@ class OhosEGLSurfaceDamage {
 
   bool SwapBuffersWithDamage(EGLDisplay display,
                              EGLSurface surface,
-                             const std::optional<SkIRect>& damage) {
+                             const std::optional<SkIRect>& damage,
+                             const std::optional<DlRegion>& damage_rects) {
     if (partial_redraw_supported_ && swap_buffers_with_damage_ && damage) {
       damage_history_.push_back(*damage);
       if (damage_history_.size() > kMaxHistorySize) {
         damage_history_.pop_front();
       }
-      auto rects = RectToInts(display, surface, *damage);
-      return swap_buffers_with_damage_(display, surface, rects.data(), 1);
+      auto rects = RectsToInts(display, surface, *damage, damage_rects);
+      return swap_buffers_with_damage_(display, surface, rects.data(),
+                                       rects.size() / 4);
     } else {
       return eglSwapBuffers(display, surface);
     }
   }
 
  private:
-  std::array<EGLint, 4> static RectToInts(EGLDisplay display,
-                                          EGLSurface surface,
-                                          const SkIRect& rect) {
+  // Returns the rects of |region| in the layout EGL expects, or just |bounds|
+  // when the region is a single rect or not set.
+  std::vector<EGLint> static RectsToInts(
+      EGLDisplay display,
+      EGLSurface surface,
+      const SkIRect& bounds,
+      const std::optional<DlRegion>& region) {
     EGLint height;
     eglQuerySurface(display, surface, EGL_HEIGHT, &height);
 
-    std::array<EGLint, 4> res{rect.left(), height - rect.bottom(), rect.width(),
-                              rect.height()};
+    std::vector<SkIRect> rects;
+    if (region && region->isComplex()) {
+      rects = region->getRects();
+    } else {
+      rects.push_back(bounds);
+    }
+    std::vector<EGLint> res;
+    res.reserve(rects.size() * 4);
+    for (const SkIRect& rect : rects) {
+      res.insert(res.end(), {rect.left(), height - rect.bottom(), rect.width(),
+                             rect.height()});
+    }
     return res;
   }
 
@@ -223,8 +240,10 @@ OhosEGLSurfaceMakeCurrentStatus OhosEGLSurface::MakeCurrent() const {
 }
 
 void OhosEGLSurface::SetDamageRegion(
-    const std::optional<SkIRect>& buffer_damage) {
-  damage_->SetDamageRegion(display_, surface_, buffer_damage);
+    const std::optional<SkIRect>& buffer_damage,
+    const std::optional<DlRegion>& buffer_damage_region) {
+  damage_->SetDamageRegion(display_, surface_, buffer_damage,
+                           buffer_damage_region);
 }
 
 bool OhosEGLSurface::SetPresentationTime(
@@ -237,9 +256,12 @@ bool OhosEGLSurface::SetPresentationTime(
   }
 }
 
-bool OhosEGLSurface::SwapBuffers(const std::optional<SkIRect>& surface_damage) {
+bool OhosEGLSurface::SwapBuffers(
+    const std::optional<SkIRect>& surface_damage,
+    const std::optional<DlRegion>& surface_damage_region) {
   TRACE_EVENT0("flutter", "OhosContextGL::SwapBuffers");
-  return damage_->SwapBuffersWithDamage(display_, surface_, surface_damage);
+  return damage_->SwapBuffersWithDamage(display_, surface_, surface_damage,
+                                        surface_damage_region);
 }
 
 bool OhosEGLSurface::SupportsPartialRepaint() const {
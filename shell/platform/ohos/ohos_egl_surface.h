@@ -22,6 +22,7 @@
 #include <KHR/khrplatform.h>
 #include <optional>
 
+#include "flutter/display_list/geometry/dl_region.h"
 #include "flutter/fml/macros.h"
 #include "flutter/fml/time/time_point.h"
 #include "flutter/shell/platform/ohos/ohos_environment_gl.h"
@@ -90,8 +91,10 @@ class OhosEGLSurface {
 
   //----------------------------------------------------------------------------
   /// @brief      Sets the damage region for current surface. Corresponds to
-  //              eglSetDamageRegionKHR
-  void SetDamageRegion(const std::optional<SkIRect>& buffer_damage);
+  //              eglSetDamageRegionKHR. When set, |buffer_damage_region|
+  //              splits |buffer_damage| into the rects that are passed.
+  void SetDamageRegion(const std::optional<SkIRect>& buffer_damage,
+                       const std::optional<DlRegion>& buffer_damage_region);
 
   //----------------------------------------------------------------------------
   /// @brief      Sets the presentation time for the current surface. This
@@ -105,7 +108,8 @@ class OhosEGLSurface {
   ///
   /// @return     Whether the EGL surface color buffer was swapped.
   ///
-  bool SwapBuffers(const std::optional<SkIRect>& surface_damage);
+  bool SwapBuffers(const std::optional<SkIRect>& surface_damage,
+                   const std::optional<DlRegion>& surface_damage_region);
 
   //----------------------------------------------------------------------------
   /// @return     The size of an `EGLSurface`.
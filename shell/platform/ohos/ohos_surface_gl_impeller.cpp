@@ -287,7 +287,8 @@ SurfaceFrame::FramebufferInfo OHOSSurfaceGLImpeller::GLContextFramebufferInfo()
 
 // |GPUSurfaceGLDelegate|
 void OHOSSurfaceGLImpeller::GLContextSetDamageRegion(
-    const std::optional<SkIRect>& region) {
+    const std::optional<SkIRect>& region,
+    const std::optional<DlRegion>& region_rects) {
   // 不支持
 }
 
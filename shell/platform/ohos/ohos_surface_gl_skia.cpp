@@ -201,9 +201,10 @@ SurfaceFrame::FramebufferInfo OhosSurfaceGLSkia::GLContextFramebufferInfo()
 }
 
 void OhosSurfaceGLSkia::GLContextSetDamageRegion(
-    const std::optional<SkIRect>& region) {
+    const std::optional<SkIRect>& region,
+    const std::optional<DlRegion>& region_rects) {
   FML_DCHECK(IsValid());
-  onscreen_surface_->SetDamageRegion(region);
+  onscreen_surface_->SetDamageRegion(region, region_rects);
 }
 
 bool OhosSurfaceGLSkia::GLContextPresent(const GLPresentInfo& present_info) {
@@ -218,7 +219,8 @@ bool OhosSurfaceGLSkia::GLContextPresent(const GLPresentInfo& present_info) {
         (OHNativeWindow*)native_window_->Gethandle(),
         SET_DESIRED_PRESENT_TIMESTAMP, present_time);
   }
-  return onscreen_surface_->SwapBuffers(present_info.frame_damage);
+  return onscreen_surface_->SwapBuffers(present_info.frame_damage,
+                                        present_info.frame_damage_region);
 }
 
 GLFBOInfo OhosSurfaceGLSkia::GLContextFBO(GLFrameInfo frame_info) const {
@@ -51,7 +51,8 @@ class OHOSUnifiedSurface : public GPUSurfaceGLDelegate, public OHOSSurface {
 
   bool GLContextClearCurrent() {}
 
-  void GLContextSetDamageRegion(const std::optional<SkIRect>& region) {}
+  void GLContextSetDamageRegion(const std::optional<SkIRect>& region,
+                                const std::optional<DlRegion>& region_rects) {}
 
   bool GLContextPresent(const GLPresentInfo& present_info) {}
 
@@ -553,6 +553,11 @@ void PlatformViewOHOS::FireFirstFrameCallback(bool is_preload) {
 }
 
 PointerDataDispatcherMaker PlatformViewOHOS::GetDispatcherMaker() {
+  if (delegate_.OnPlatformViewGetSettings().enable_pointer_batching) {
+    return [](DefaultPointerDataDispatcher::Delegate& delegate) {
+      return std::make_unique<BatchingPointerDataDispatcher>(delegate);
+    };
+  }
   return [](DefaultPointerDataDispatcher::Delegate& delegate) {
     return std::make_unique<SmoothPointerDataDispatcher>(delegate);
   };